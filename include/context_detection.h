@@ -0,0 +1,79 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ═══════════════════════════════════════════════════════════
+// 🌍 CONTEXT DETECTION - SENSOR INPUTS
+// ═══════════════════════════════════════════════════════════
+// Sensor and comms code post readings here as they arrive; the context
+// (getCurrentContext(), emergent_signal.h) changes on the reading that
+// crosses a threshold. Kept apart from the signal types so firmware with
+// its own (SPEEDIE) can feed it. Calls for one node belong to one task.
+
+void postDistanceReading(int distanceCm);   // <= 0 = no echo
+void postMotionDetected(bool detected);
+void postAcceleration(float magnitude);     // |a| - g, m/s^2
+void postMovingState(bool moving);
+void postTaskState(bool inProgress, bool successful);
+void postPeerContact();
+
+// The context as plain values, for firmware without the signal types:
+// getCurrentContext() and getMostFrequentRecentContext() as their
+// EnvironmentalContext value, and getContextStability() (0 = changing on
+// every reading, 1 = settled). Reading the current context also runs the
+// deadline edges (stuck, peer contact expiring), so poll it from the task
+// that posts the readings.
+uint8_t getCurrentContextId();
+uint8_t getMostFrequentContextId();
+float getContextStability();
+
+// EnvironmentalContext values SPEEDIE acts on
+#define CONTEXT_ID_OBSTACLE_NEAR 0x01
+#define CONTEXT_ID_OPEN_SPACE 0x02
+#define CONTEXT_ID_TASK_FAILURE 0x05
+#define CONTEXT_ID_UNKNOWN 0xFF
+
+#define CONTEXT_HISTORY_SIZE 20
+#define CONTEXT_TYPES 12                   // Contexts 0x00-0x0B (UNKNOWN is not counted)
+
+// Per-node state (SwarmNode::context), created on first use. Contexts
+// and emotions are kept as their EnvironmentalContext / EmotionalState
+// values so this header does not need the signal types.
+struct ContextDetectionState {
+  uint8_t currentContext;
+  int8_t currentEmotion;
+  unsigned long lastSuccessTime;
+  unsigned long lastFailureTime;
+  uint8_t consecutiveSuccesses;
+  uint8_t consecutiveFailures;
+
+  // Latest inputs (as posted) and the edge flags derived from them
+  int distanceCm;
+  bool motionDetected;
+  float accelerationMagnitude;
+  bool isMoving;
+  bool taskInProgress;
+  bool taskSuccessful;
+
+  bool obstacleNear;
+  bool pathClear;
+  bool roomAhead;
+  bool disturbed;
+  bool peerNearby;
+  bool stuck;
+  unsigned long peerContactUntil;
+  int progressDistance;
+  unsigned long lastProgressTime;
+
+  // Ring of context transitions, newest last
+  uint8_t history[CONTEXT_HISTORY_SIZE];
+  unsigned long historyTimes[CONTEXT_HISTORY_SIZE];
+  uint8_t historyIndex;
+  uint8_t historyCount;
+  uint8_t contextCounts[CONTEXT_TYPES];
+  uint8_t mostFrequentContext;
+  uint32_t transitionTotal;                // Transitions ever recorded
+  uint32_t stabilityWindowStart;           // Oldest transition number still in the window
+
+  ContextDetectionState();
+};
@@ -22,6 +22,10 @@
 #include <esp_now.h>
 #include <WiFi.h>
 #include <Arduino.h>
+#include "swarm_peer_registry.h"
+#include "signal_vocabulary.h"
+#include "signal_player.h"
+#include "context_detection.h"
 
 // ═══════════════════════════════════════════════════════════
 // 🧬 EMERGENT SIGNAL GENERATION SYSTEM
@@ -29,7 +33,7 @@
 
 // Maximum vocabulary size per bot (dynamic growth)
 #define MAX_SIGNAL_VOCABULARY 64
-#define MAX_SIGNAL_COMPONENTS 8
+#define MAX_SIGNAL_COMPONENTS SIGNAL_MAX_COMPONENTS
 #define MAX_CONTEXT_MEMORY 32
 #define SIGNAL_EVOLUTION_THRESHOLD 0.7f
 
@@ -70,41 +74,18 @@ enum EmotionalState {
   EMOTION_VERY_POSITIVE = 2      // Excited, highly successful
 };
 
-// ═══════════════════════════════════════════════════════════
-// 🎵 SIGNAL WORD STRUCTURE (Dynamic Vocabulary)
-// ═══════════════════════════════════════════════════════════
-
-struct SignalWord {
-  // === SEMANTIC PROPERTIES (What does this signal relate to?) ===
-  uint8_t contextType;           // EnvironmentalContext when created
-  int8_t emotionalValence;       // EmotionalState when created
-  uint16_t generation;           // When in bot's life was this created
-  
-  // === ACOUSTIC PROPERTIES (How does this sound?) ===
-  uint8_t componentCount;        // Number of signal components (1-8)
-  uint8_t components[MAX_SIGNAL_COMPONENTS]; // SignalComponent sequence
-  uint16_t durations[MAX_SIGNAL_COMPONENTS]; // Duration of each component (ms)
-  uint8_t intensities[MAX_SIGNAL_COMPONENTS]; // Intensity 0-255
-  
-  // === EVOLUTIONARY PROPERTIES (How successful is this signal?) ===
-  float utility;                 // Success rate (0.0-1.0)
-  uint32_t timesUsed;           // Usage frequency
-  uint32_t timesUnderstood;     // How often peers responded appropriately
-  uint32_t lastUsed;            // Timestamp of last usage
-  uint32_t createdAt;           // Timestamp of creation
-  
-  // === PERSONALITY TRAITS (Bot's unique signature) ===
-  uint8_t personalitySignature; // Unique acoustic "accent"
-  uint8_t complexityPreference; // Tendency toward simple/complex signals
-} __attribute__((packed));
+// Words are the shared SignalWord/SignalVocabulary (signal_vocabulary.h):
+// contextType is an EnvironmentalContext, emotionalValence an EmotionalState
 
 // ═══════════════════════════════════════════════════════════
 // 📡 EMERGENT ESP-NOW MESSAGE STRUCTURE
 // ═══════════════════════════════════════════════════════════
 
+#define EMERGENT_PROTOCOL_VERSION 0x03 // 3: shared SignalWord layout
+
 struct EmergentMessage {
   // === TRANSMISSION METADATA ===
-  uint8_t protocolVersion;      // Always 0x02 for emergent protocol
+  uint8_t protocolVersion;      // EMERGENT_PROTOCOL_VERSION
   uint8_t senderMac[6];         // Sender's MAC address
   uint32_t timestamp;           // Message timestamp
   uint8_t sequenceNumber;       // Message sequence (0-255)
@@ -140,10 +121,15 @@ struct SignalMemory {
   uint32_t timestamp;           // When did this happen?
 };
 
+#define MAX_PEER_SIGNALS 16
+
 struct PeerSignalProfile {
   uint8_t peerMac[6];           // Peer's MAC address
   uint8_t signalCount;          // How many different signals from this peer
-  SignalWord knownSignals[16];  // Signals we've learned from this peer
+  // Signals we've learned from this peer; patterns contiguous for the similarity kernel
+  uint8_t knownContexts[MAX_PEER_SIGNALS];
+  int8_t knownValences[MAX_PEER_SIGNALS];
+  SignalPattern knownPatterns[MAX_PEER_SIGNALS];
   float trustLevel;             // How much we trust signals from this peer (0.0-1.0)
   uint8_t personalitySignature; // This peer's acoustic "accent"
   uint32_t lastInteraction;     // Last time we communicated
@@ -155,12 +141,14 @@ struct PeerSignalProfile {
 
 class EmergentSignalGenerator {
 private:
-  SignalWord vocabulary[MAX_SIGNAL_VOCABULARY];
-  uint8_t vocabularySize;
+  SignalVocabulary<MAX_SIGNAL_VOCABULARY> vocabulary; // Valence scale: EmotionalState
   SignalMemory contextMemory[MAX_CONTEXT_MEMORY];
   uint8_t memorySize;
   PeerSignalProfile peerProfiles[8]; // Track up to 8 peers
   uint8_t peerCount;
+  int8_t profileSlot[PEER_REGISTRY_CAPACITY]; // PeerId -> peerProfiles index, -1 = none
+
+  PeerSignalProfile* findPeerProfile(const uint8_t* peerMac, bool create);
   
   // Bot's unique signal personality traits
   uint8_t personalitySignature;
@@ -172,13 +160,15 @@ public:
   EmergentSignalGenerator();
   
   // === CORE SIGNAL GENERATION ===
-  SignalWord* generateSignalForContext(EnvironmentalContext context, EmotionalState emotion);
-  SignalWord* findExistingSignal(EnvironmentalContext context, EmotionalState emotion);
+  // Vocabulary words are addressed by slot; -1 = none
+  int8_t generateSignalForContext(EnvironmentalContext context, EmotionalState emotion);
+  int8_t findExistingSignal(EnvironmentalContext context, EmotionalState emotion);
   SignalWord createNewSignal(EnvironmentalContext context, EmotionalState emotion);
+  void getSignal(uint8_t slot, SignalWord& word) const { vocabulary.get(slot, word); }
   
   // === SIGNAL EVOLUTION ===
-  void updateSignalUtility(SignalWord* signal, float outcome);
-  void mutateSignal(SignalWord* signal);
+  void updateSignalUtility(uint8_t slot, float outcome);
+  void mutateSignal(SignalPattern* pattern);
   void pruneUnusedSignals();
   
   // === PEER LEARNING ===
@@ -187,14 +177,14 @@ public:
   void updatePeerTrust(uint8_t* peerMac, float outcome);
   
   // === COMMUNICATION INTERFACE ===
-  bool sendEmergentMessage(SignalWord* signal, EnvironmentalContext context, EmotionalState emotion);
+  bool sendEmergentMessage(uint8_t slot, EnvironmentalContext context, EmotionalState emotion);
   void processReceivedMessage(EmergentMessage* message);
   
   // === ANALYTICS & DEBUG ===
   void printVocabularyStats();
-  uint8_t getVocabularySize() { return vocabularySize; }
+  uint8_t getVocabularySize() { return vocabulary.size(); }
   float getAverageUtility();
-  SignalWord* getMostUsedSignal();
+  int8_t getMostUsedSignal() const { return vocabulary.mostUsed(); }
 };
 
 // ═══════════════════════════════════════════════════════════
@@ -207,15 +197,24 @@ uint16_t generateRandomDuration();
 uint8_t generateRandomIntensity();
 
 // Signal comparison and analysis
+// Acoustic similarity is fixed point: Q8, 255 = identical. Per shared
+// component a matching type scores 4, durations within 2:1 score 3 and
+// intensities within 10:7 score 3, all by integer cross-multiplication.
+#define SIGNAL_SIMILARITY_MAX 255
+#define SIGNAL_MATCH_THRESHOLD 192        // Q8 (0.75): treat as the same signal
+void acousticSimilarityBatch(const SignalPattern& probe, const SignalPattern* patterns, uint8_t count, uint8_t* scores);
 float calculateAcousticSimilarity(SignalWord* sig1, SignalWord* sig2);
 float calculateSemanticSimilarity(SignalWord* sig1, SignalWord* sig2);
 
 // Context analysis
 EnvironmentalContext getCurrentContext();
 EmotionalState getCurrentEmotionalState();
+EnvironmentalContext getMostFrequentRecentContext();
+float getContextStability();
+// Context inputs (postDistanceReading() etc.): context_detection.h
 
-// Acoustic generation helpers
-void playSignalWord(SignalWord* signal);
+// Acoustic generation helpers (returns at once; see SignalPlayer)
+void playSignalWord(SignalWord* signal, uint8_t priority = SIGNAL_PRIORITY_EXPRESSION);
 String signalToString(SignalWord* signal);
 String contextToString(EnvironmentalContext context);
 String emotionToString(EmotionalState emotion);
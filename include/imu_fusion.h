@@ -0,0 +1,85 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <atomic>
+#include "swarm_lockfree.h"
+
+// ═══════════════════════════════════════════════════════════
+// 🧭 MPU-6050 FIFO IMU + ORIENTATION FILTER
+// ═══════════════════════════════════════════════════════════
+// The MPU-6050 samples accel + gyro on its own clock into its FIFO; the
+// data-ready interrupt only counts samples and timestamps the newest.
+// update() waits until a batch has built up, burst-reads it in one I2C
+// transaction and integrates every sample over the sensor's sample
+// period, so heading no longer depends on how often the loop runs.
+// - Heading: bias-corrected gyro Z; the bias is re-estimated whenever
+//   the bot is still, which is what keeps the heading from drifting
+// - Pitch/roll: complementary filter of gyro rate and accelerometer tilt
+// update()/current() belong to one task; readSnapshot() may be called
+// from any other task.
+
+#define IMU_SAMPLE_RATE_HZ 200
+#define IMU_FIFO_BATCH 8               // Samples per burst (8 x 12 bytes fits the Wire buffer)
+#define IMU_FIFO_SAMPLE_BYTES 12       // Accel XYZ + gyro XYZ, 16-bit big-endian
+#define IMU_COMPLEMENTARY_ALPHA 0.98f  // Gyro share of pitch/roll
+#define IMU_STILL_GYRO_DPS 2.0f        // Below this (and ~1 g) the bot counts as still
+#define IMU_STILL_ACCEL_MS2 0.3f
+#define IMU_BIAS_ADAPT 0.005f          // Per still sample (~1 s time constant)
+
+struct ImuSnapshot {
+  float headingDeg;           // 0-360, integrated yaw
+  float pitchDeg;
+  float rollDeg;
+  float yawRateDps;           // Newest bias-corrected Z rate
+  float linearAccel;          // |a| - g in m/s^2 (bumps, pushes, pick-ups)
+  float accelX, accelY, accelZ; // m/s^2, sensor frame
+  uint32_t timestampUs;       // micros() of the newest integrated sample
+  uint32_t sampleCount;
+  bool still;
+};
+
+class Mpu6050FifoImu {
+public:
+  bool begin(TwoWire& wire, uint8_t intPin, uint8_t address = 0x68);
+
+  // Call once per control tick: reads the FIFO once a batch is ready.
+  // Returns true if new samples were integrated.
+  bool update();
+
+  // Owning task: filter state after the last update()
+  const ImuSnapshot& current() const { return state; }
+
+  // Any other task: newest published state, false if none yet
+  bool readSnapshot(ImuSnapshot& out) const { return snapshots.read(out) != 0; }
+
+  void resetHeading(float headingDeg = 0.0f);
+
+  uint32_t getBurstCount() const { return burstCount; }
+  uint32_t getOverflowCount() const { return overflowCount; }
+
+private:
+  static void IRAM_ATTR dataReadyIsr(void* arg);
+
+  bool writeRegister(uint8_t reg, uint8_t value);
+  bool readRegisters(uint8_t reg, uint8_t* buffer, uint8_t length);
+  void resetFifo();
+  void integrate(const uint8_t* sample);
+
+  TwoWire* wire = nullptr;
+  uint8_t address = 0x68;
+  uint8_t intPin = 0;
+
+  // ISR -> owning task
+  std::atomic<uint32_t> readyCount{0};   // Data-ready edges seen
+  volatile uint32_t lastReadyUs = 0;
+
+  // Owning task only
+  uint32_t consumedCount = 0;            // Edges accounted for by FIFO reads
+  float gyroBiasZ = 0.0f;
+  ImuSnapshot state = {};
+  uint32_t burstCount = 0;
+  uint32_t overflowCount = 0;
+
+  SpscSlot<ImuSnapshot> snapshots;
+};
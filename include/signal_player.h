@@ -0,0 +1,88 @@
+#pragma once
+
+#include <Arduino.h>
+#include <esp_timer.h>
+#include "signal_vocabulary.h"
+
+// ═══════════════════════════════════════════════════════════
+// 🎶 SIGNAL PLAYER - TIMER-DRIVEN LED/BUZZER PLAYBACK
+// ═══════════════════════════════════════════════════════════
+// Plays flash/tone sequences from an esp_timer one-shot, so starting a
+// signal costs the caller a copy and nothing else: no delay(), no
+// per-tick polling. Every output write happens on the esp_timer task.
+//
+// Priorities:
+// - A sequence of equal or higher priority than the one playing
+//   replaces it immediately (the newest expression is the relevant one)
+// - A lower priority sequence waits and plays once the current one ends;
+//   only the latest sequence per level is kept
+// play()/stop() may be called from any task.
+
+#define SIGNAL_PLAYER_MAX_STEPS 10
+#define SIGNAL_PLAYER_DEFAULT_GAP_MS 20
+
+enum SignalPriority : uint8_t {
+  SIGNAL_PRIORITY_AMBIENT = 0,     // Idle chatter, may be starved
+  SIGNAL_PRIORITY_EXPRESSION,      // Emotional/contextual expression
+  SIGNAL_PRIORITY_ALERT,           // Danger, task failure
+  SIGNAL_PRIORITY_EMERGENCY,       // Emergency stop flash
+  SIGNAL_PRIORITY_LEVELS
+};
+
+struct SignalStep {
+  uint8_t r, g, b;        // 0 = off
+  uint16_t toneHz;        // 0 = silent
+  uint16_t holdMs;
+};
+
+struct SignalSequence {
+  SignalStep steps[SIGNAL_PLAYER_MAX_STEPS];
+  uint8_t count;
+  uint16_t gapMs;         // Outputs off between steps
+  bool endDark;           // Leave outputs off (true) or on the last step (false)
+};
+
+// Drives the actual hardware; called with all zeros for "off"
+typedef void (*SignalOutputFn)(uint8_t r, uint8_t g, uint8_t b, uint16_t toneHz);
+
+class SignalPlayer {
+public:
+  SignalPlayer();
+
+  bool begin(SignalOutputFn output);
+
+  // Returns immediately; false if not started or priority out of range
+  bool play(const SignalSequence& sequence, uint8_t priority);
+  bool play(const SignalWord& word, uint8_t priority);
+
+  // One step per pattern component, coloured by the word's LED colour
+  static void sequenceFromPattern(const SignalPattern& pattern, SignalSequence& sequence);
+
+  // Drop everything (playing and queued) and switch outputs off
+  void stop();
+
+  bool isPlaying() const { return currentLevel >= 0; }
+  int8_t getCurrentPriority() const { return currentLevel; }
+
+private:
+  esp_timer_handle_t timer;
+  SignalOutputFn output;
+  portMUX_TYPE lock;
+
+  // Shared with the timer task, guarded by lock
+  SignalSequence current;
+  volatile int8_t currentLevel;        // -1 = idle
+  uint8_t step;
+  bool inGap;
+  bool restart;                        // current was replaced, start from step 0
+  int64_t deadlineUs;                  // When the current step/gap ends
+  SignalSequence pending[SIGNAL_PRIORITY_LEVELS];
+  bool hasPending[SIGNAL_PRIORITY_LEVELS];
+
+  static void onTimer(void* arg);
+  void advance();
+  bool startPending();
+  void kick();
+};
+
+extern SignalPlayer signalPlayer;
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <Arduino.h>
+#include "vocabulary_index.h"
+
+// ═══════════════════════════════════════════════════════════
+// 📚 SIGNAL VOCABULARY - SHARED WORD STORAGE
+// ═══════════════════════════════════════════════════════════
+// One word format and one container for every emergent vocabulary (the
+// EmergentSignalGenerator library and SPEEDIE's firmware). Lookups only
+// read context, valence and utility, so those live in parallel arrays;
+// the pattern a word plays sits in a separate table that is touched once
+// a word has been chosen. SignalWord is the flat form used on the wire,
+// in NVS records and for peer copies; the container never stores it.
+//
+// Valence scale is the owner's (passed to the constructor): -2..+2 for
+// the library's EmotionalState, -100..+100 for SPEEDIE.
+
+#define SIGNAL_MAX_COMPONENTS 8
+#define SIGNAL_CONTEXT_BINS 13            // Contexts 0-11 get their own bin, anything else shares the last
+#define SIGNAL_EMOTION_BINS 5
+#define SIGNAL_BUCKETS (SIGNAL_CONTEXT_BINS * SIGNAL_EMOTION_BINS)
+
+// What a word sounds and looks like
+struct SignalPattern {
+  uint8_t length;                             // Elements used (1-SIGNAL_MAX_COMPONENTS)
+  uint8_t components[SIGNAL_MAX_COMPONENTS];  // SignalComponent, 0 = plain tone
+  uint16_t tones[SIGNAL_MAX_COMPONENTS];      // Hz, 0 = component default
+  uint16_t durations[SIGNAL_MAX_COMPONENTS];  // ms
+  uint8_t intensities[SIGNAL_MAX_COMPONENTS]; // 0-255
+  uint8_t r, g, b;                            // Associated LED colour
+  uint8_t personalitySignature;               // Creator's acoustic "accent"
+  uint8_t complexityPreference;
+} __attribute__((packed));
+
+struct SignalWord {
+  // === SEMANTIC PROPERTIES (What does this signal relate to?) ===
+  uint8_t contextType;           // Owner's context enum when created
+  int8_t emotionalValence;       // Owner's valence scale when created
+  uint16_t generation;           // When in bot's life was this created
+
+  // === EVOLUTIONARY PROPERTIES (How successful is this signal?) ===
+  float utility;                 // Success rate (0.0-1.0)
+  uint16_t timesUsed;            // Usage frequency (saturating)
+  uint16_t timesUnderstood;      // How often peers responded appropriately
+  uint32_t lastUsed;             // Timestamp of last usage
+  uint32_t createdAt;            // Timestamp of creation
+
+  // === ACOUSTIC/VISUAL PROPERTIES (How does this sound?) ===
+  SignalPattern pattern;
+} __attribute__((packed));
+
+template <uint8_t N>
+class SignalVocabulary {
+private:
+  // Hot: read by every lookup (utility lives in the index, sorted)
+  uint8_t contexts[N];
+  int8_t valences[N];
+  uint16_t useCounts[N];
+  uint32_t lastUses[N];
+  VocabularyIndex<N, SIGNAL_BUCKETS> index;
+
+  // Cold: read once a word is chosen
+  SignalPattern patterns[N];
+  uint16_t generations[N];
+  uint16_t understood[N];
+  uint32_t createdAts[N];
+
+  uint8_t count;
+  int8_t mostUsedSlot;           // Highest timesUsed, -1 = empty
+  int8_t valenceMin;
+  int16_t valenceSpan;
+
+  void noteUsage(uint8_t slot) {
+    if (mostUsedSlot < 0 || useCounts[slot] > useCounts[mostUsedSlot]) mostUsedSlot = slot;
+  }
+
+  void rescanMostUsed() {
+    mostUsedSlot = -1;
+    for (uint8_t i = 0; i < count; i++) noteUsage(i);
+  }
+
+  void write(uint8_t slot, const SignalWord& word) {
+    contexts[slot] = word.contextType;
+    valences[slot] = word.emotionalValence;
+    useCounts[slot] = word.timesUsed;
+    lastUses[slot] = word.lastUsed;
+    patterns[slot] = word.pattern;
+    generations[slot] = word.generation;
+    understood[slot] = word.timesUnderstood;
+    createdAts[slot] = word.createdAt;
+    index.insert(slot, bucketOf(word.contextType, word.emotionalValence), word.utility);
+  }
+
+public:
+  SignalVocabulary(int8_t minValence, int8_t maxValence)
+    : count(0), mostUsedSlot(-1), valenceMin(minValence), valenceSpan(maxValence - minValence + 1) {}
+
+  void clear() {
+    index.clear();
+    count = 0;
+    mostUsedSlot = -1;
+  }
+
+  uint8_t size() const { return count; }
+  bool isFull() const { return count >= N; }
+
+  // Append, or when full replace the lowest-utility word. Returns the slot.
+  uint8_t add(const SignalWord& word) {
+    if (count < N) {
+      write(count, word);
+      noteUsage(count);
+      return count++;
+    }
+    uint8_t slot = index.weakest();
+    set(slot, word);
+    return slot;
+  }
+
+  void set(uint8_t slot, const SignalWord& word) {
+    index.remove(slot);
+    write(slot, word);
+    if (slot == mostUsedSlot) rescanMostUsed(); else noteUsage(slot);
+  }
+
+  // Swap-remove: the last word moves into the freed slot
+  void remove(uint8_t slot) {
+    index.remove(slot);
+    uint8_t last = count - 1;
+    if (slot != last) {
+      contexts[slot] = contexts[last];
+      valences[slot] = valences[last];
+      useCounts[slot] = useCounts[last];
+      lastUses[slot] = lastUses[last];
+      patterns[slot] = patterns[last];
+      generations[slot] = generations[last];
+      understood[slot] = understood[last];
+      createdAts[slot] = createdAts[last];
+      index.move(last, slot);
+    }
+    count--;
+    if (mostUsedSlot == slot) rescanMostUsed();
+    else if (mostUsedSlot == last) mostUsedSlot = slot;
+  }
+
+  // Flat copy (persistence, transmission)
+  void get(uint8_t slot, SignalWord& word) const {
+    word.contextType = contexts[slot];
+    word.emotionalValence = valences[slot];
+    word.generation = generations[slot];
+    word.utility = index.utility(slot);
+    word.timesUsed = useCounts[slot];
+    word.timesUnderstood = understood[slot];
+    word.lastUsed = lastUses[slot];
+    word.createdAt = createdAts[slot];
+    word.pattern = patterns[slot];
+  }
+
+  // === HOT FIELDS ===
+  uint8_t context(uint8_t slot) const { return contexts[slot]; }
+  int8_t valence(uint8_t slot) const { return valences[slot]; }
+  float utility(uint8_t slot) const { return index.utility(slot); }
+  void setUtility(uint8_t slot, float utility) { index.update(slot, utility); }
+  uint16_t timesUsed(uint8_t slot) const { return useCounts[slot]; }
+  uint32_t lastUsed(uint8_t slot) const { return lastUses[slot]; }
+  void recordUse(uint8_t slot, uint32_t now) {
+    if (useCounts[slot] < UINT16_MAX) useCounts[slot]++;
+    lastUses[slot] = now;
+    noteUsage(slot);
+  }
+
+  // === COLD FIELDS ===
+  SignalPattern& pattern(uint8_t slot) { return patterns[slot]; }
+  const SignalPattern* patternTable() const { return patterns; }
+  uint16_t generation(uint8_t slot) const { return generations[slot]; }
+  void setGeneration(uint8_t slot, uint16_t generation) { generations[slot] = generation; }
+  uint16_t timesUnderstood(uint8_t slot) const { return understood[slot]; }
+  void recordUnderstood(uint8_t slot) { if (understood[slot] < UINT16_MAX) understood[slot]++; }
+  uint32_t createdAt(uint8_t slot) const { return createdAts[slot]; }
+
+  // === BUCKETS ===
+  // Words in one bucket share context bin and valence bin; each bucket is
+  // sorted by utility, best first (see VocabularyIndex)
+  static uint8_t contextBin(uint8_t context) {
+    return (context < SIGNAL_CONTEXT_BINS - 1) ? context : SIGNAL_CONTEXT_BINS - 1;
+  }
+
+  // Lookup order: the query's own context bin, then the rest ascending
+  static uint8_t contextBinForPass(uint8_t pass, uint8_t ownBin) {
+    return (pass == 0) ? ownBin : (pass - 1 < ownBin ? pass - 1 : pass);
+  }
+
+  uint8_t emotionBin(int valence) const {
+    return constrain((valence - valenceMin) * SIGNAL_EMOTION_BINS / valenceSpan, 0, SIGNAL_EMOTION_BINS - 1);
+  }
+
+  uint8_t bucketOf(uint8_t context, int valence) const {
+    return contextBin(context) * SIGNAL_EMOTION_BINS + emotionBin(valence);
+  }
+
+  // Valences a bin can hold; the edge bins are open-ended
+  void valenceRange(uint8_t bin, int& low, int& high) const {
+    low = (bin == 0) ? INT16_MIN : valenceMin + (valenceSpan * bin + SIGNAL_EMOTION_BINS - 1) / SIGNAL_EMOTION_BINS;
+    high = (bin == SIGNAL_EMOTION_BINS - 1) ? INT16_MAX :
+           valenceMin + (valenceSpan * (bin + 1) + SIGNAL_EMOTION_BINS - 1) / SIGNAL_EMOTION_BINS - 1;
+  }
+
+  int8_t head(uint8_t bucket) const { return index.head(bucket); }
+  int8_t tail(uint8_t bucket) const { return index.tail(bucket); }
+  int8_t next(uint8_t slot) const { return index.next(slot); }
+  int8_t prev(uint8_t slot) const { return index.prev(slot); }
+  int8_t weakest() const { return index.weakest(); }
+  int8_t mostUsed() const { return mostUsedSlot; }
+};
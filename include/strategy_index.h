@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ═══════════════════════════════════════════════════════════
+// 🧭 STRATEGY DISTANCE-BAND INDEX
+// ═══════════════════════════════════════════════════════════
+// Indexes a strategy library (entries keep their array position) by the
+// obstacle distance they were learned at:
+// - One STRATEGY_BAND_CM band per distance range, each with a list of
+//   its entries and a cached best score
+// - best() reads 2 * matchBands + 1 cached band bests, whatever the
+//   library size, so obstacle response does not scan the library
+// - set()/remove() keep the caches current; only losing a band's best
+//   rescans that one band
+// The library owner calls set() whenever an entry's distance or score
+// changes, and clear() + set() for every entry after reshuffling it.
+// Not thread-safe: on SPEEDIE it belongs to the control core.
+
+#define STRATEGY_BAND_CM 20
+#define STRATEGY_MAX_BANDS 32           // 0-640 cm; farther falls in the last band
+#define STRATEGY_INDEX_CAPACITY 64
+#define STRATEGY_NO_ENTRY 0xFF
+
+class StrategyBandIndex {
+public:
+  StrategyBandIndex();
+
+  void clear();
+  // Entry i at this distance; tag is matched by findSimilar() (e.g. turn direction)
+  void set(uint8_t i, int distance, uint8_t tag, float score);
+  void remove(uint8_t i);
+
+  // Best entry in the bands within matchBands of the distance's band, -1 if none
+  int best(int distance, uint8_t matchBands) const;
+  // Lowest-index entry with |learned distance - distance| < tolerance and this tag, -1 if none
+  int findSimilar(int distance, int tolerance, uint8_t tag) const;
+
+  uint8_t getCount() const { return count; }
+  static uint8_t bandOf(int distance);
+
+private:
+  int16_t distance[STRATEGY_INDEX_CAPACITY];
+  uint8_t tag[STRATEGY_INDEX_CAPACITY];
+  float score[STRATEGY_INDEX_CAPACITY];
+  uint8_t band[STRATEGY_INDEX_CAPACITY];  // STRATEGY_NO_ENTRY = not indexed
+  uint8_t next[STRATEGY_INDEX_CAPACITY];  // Next entry in the same band
+
+  uint8_t head[STRATEGY_MAX_BANDS];
+  uint8_t bandBest[STRATEGY_MAX_BANDS];
+  uint8_t count;
+
+  void unlink(uint8_t i);
+  void rescanBand(uint8_t b);
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <Arduino.h>
+#include "swarm_espnow.h"
+
+// ═══════════════════════════════════════════════════════════
+// 📦 MULTI-MESSAGE BUNDLES
+// ═══════════════════════════════════════════════════════════
+// A MSG_BUNDLE frame packs several small payloads into one ESP-NOW
+// frame, up to the 250-byte limit:
+//   [MessageHeader][type][len][payload...][type][len][payload...]...
+// Unpacked records inherit the bundle's header (sender, sequence,
+// timestamp), so handleSwarmMessage() cannot tell them apart from
+// standalone frames. Bundles never nest.
+
+struct BundleRecordHeader {
+  uint8_t messageType;      // MessageType of the embedded payload
+  uint8_t length;           // Payload bytes that follow
+} __attribute__((packed));
+
+class SwarmBundleBuilder {
+private:
+  SwarmMessage message;
+  size_t used;              // Bytes of message.payload filled so far
+  uint8_t recordCount;
+  uint8_t firstType;        // Needed to unwrap a single-record bundle
+  uint8_t priority;         // Highest priority of any record
+
+public:
+  SwarmBundleBuilder() { begin(BOT_UNKNOWN); }
+
+  void begin(uint8_t senderType) {
+    memset(&message.header, 0, sizeof(MessageHeader));
+    message.header.messageType = MSG_BUNDLE;
+    message.header.senderType = senderType;
+    used = 0;
+    recordCount = 0;
+    firstType = 0;
+    priority = PRIORITY_LOW;
+  }
+
+  // Append one payload; false (and the bundle is unchanged) if it does not fit
+  bool add(uint8_t messageType, uint8_t recordPriority, const void* payload, size_t length) {
+    if (messageType == MSG_BUNDLE) return false;
+    if (length > 255 || used + sizeof(BundleRecordHeader) + length > SWARM_MAX_PAYLOAD_SIZE) return false;
+
+    BundleRecordHeader record = { messageType, (uint8_t)length };
+    memcpy(message.payload.rawData + used, &record, sizeof(record));
+    memcpy(message.payload.rawData + used + sizeof(record), payload, length);
+    used += sizeof(record) + length;
+
+    if (recordCount == 0) firstType = messageType;
+    recordCount++;
+    if (recordPriority > priority) priority = recordPriority;
+    return true;
+  }
+
+  uint8_t getRecordCount() const { return recordCount; }
+  bool isEmpty() const { return recordCount == 0; }
+
+  // Finalize for transmission, returns the frame length (0 if empty).
+  // A lone record goes out as a plain message: smaller, and readable by
+  // peers that do not know MSG_BUNDLE.
+  size_t finish(uint8_t sequenceNumber, uint32_t timestamp) {
+    if (recordCount == 0) return 0;
+
+    message.header.priority = priority;
+    message.header.sequenceNumber = sequenceNumber;
+    message.header.timestamp = timestamp;
+
+    if (recordCount == 1) {
+      size_t length = used - sizeof(BundleRecordHeader);
+      memmove(message.payload.rawData, message.payload.rawData + sizeof(BundleRecordHeader), length);
+      message.header.messageType = firstType;
+      return finalizeSwarmMessage(&message, length);
+    }
+
+    message.header.messageType = MSG_BUNDLE;
+    return finalizeSwarmMessage(&message, used);
+  }
+
+  const SwarmMessage* getMessage() const { return &message; }
+};
+
+// Unpack the next valid record of a decoded bundle into out, starting at
+// offset (begin with 0). Records with an invalid type or a short payload
+// are skipped. Returns false at the end; offset then equals
+// header.payloadLength unless the bundle was truncated or corrupt.
+inline bool nextBundleRecord(const SwarmMessage* bundle, size_t& offset, SwarmMessage* out) {
+  size_t total = bundle->header.payloadLength;
+
+  while (offset + sizeof(BundleRecordHeader) <= total) {
+    BundleRecordHeader record;
+    memcpy(&record, bundle->payload.rawData + offset, sizeof(record));
+    size_t start = offset + sizeof(record);
+    if (start + record.length > total) return false; // Overruns the frame
+
+    offset = start + record.length;
+    if (record.messageType == MSG_BUNDLE) continue;
+    if (record.length < minPayloadSize(record.messageType)) continue;
+
+    out->header = bundle->header;
+    out->header.messageType = record.messageType;
+    out->header.payloadLength = record.length;
+    memcpy(out->payload.rawData, bundle->payload.rawData + start, record.length);
+    memset(out->payload.rawData + record.length, 0, sizeof(out->payload.rawData) - record.length);
+    if (!isValidMessage(out)) continue;
+    return true;
+  }
+
+  return false;
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ═══════════════════════════════════════════════════════════
+// 🗳️ SWARM CONSENSUS ENGINE - BATCHED, EARLY-RESOLVING VOTES
+// ═══════════════════════════════════════════════════════════
+// Several proposals can be open at once. Each keeps a running tally
+// (vote count or weight per choice, plus leader and runner-up), so a
+// vote costs the same whatever the swarm size, and the outcome is
+// re-checked after every vote:
+// - A proposal resolves as soon as the remaining votes can no longer
+//   change its result, not when the deadline passes
+// - It fails as soon as consensus has become impossible
+// - At the deadline, only the voters who answered count
+// A bot sends one MSG_CONSENSUS_VOTE batch holding its vote for every
+// open proposal (and announcing the ones it proposed); receiving it
+// twice is harmless, so batches are simply repeated until resolution.
+// The proposer's tally decides. Once it resolves, its batches carry the
+// outcome instead of its vote for as long as the proposal is retained,
+// and every other bot adopts that outcome. Voters never resolve on their
+// own tally unless the outcome is still missing CONSENSUS_OUTCOME_WAIT_MS
+// after the deadline (e.g. the proposer went down); votes that reached
+// only some bots cannot split the swarm otherwise.
+// Emergency proposals use a short deadline and mark the batch urgent so
+// it is sent at once rather than on the next comms tick.
+//
+// Voters are small indices chosen by the caller (e.g. PeerId, with one
+// spare index for this bot). Not thread-safe: one task owns it.
+
+enum ConsensusType {
+  CONSENSUS_SIMPLE_MAJORITY = 0x01,   // >50% agreement
+  CONSENSUS_SUPERMAJORITY = 0x02,     // >66% agreement
+  CONSENSUS_UNANIMOUS = 0x03,         // 100% agreement
+  CONSENSUS_WEIGHTED_VOTE = 0x04,     // Fitness-weighted voting
+  CONSENSUS_EXPERT_DECISION = 0x05    // Specialist bot decides
+};
+
+enum DecisionTopic {
+  DECIDE_EXPLORATION_AREA = 0x01,     // Where to explore next
+  DECIDE_FORMATION_CHANGE = 0x02,     // Change swarm formation
+  DECIDE_LEADER_SELECTION = 0x03,     // Select new leader
+  DECIDE_TASK_PRIORITY = 0x04,        // Prioritize tasks
+  DECIDE_RESOURCE_ALLOCATION = 0x05,  // Allocate resources
+  DECIDE_EMERGENCY_RESPONSE = 0x06,   // Emergency protocols
+  DECIDE_LEARNING_STRATEGY = 0x07     // Learning approach
+};
+
+#define MAX_CONSENSUS_PROPOSALS 8
+#define VOTING_TIMEOUT 15000        // 15 second voting window
+#define EMERGENCY_VOTING_TIMEOUT 500 // DECIDE_EMERGENCY_RESPONSE window
+#define MIN_CONSENSUS_PARTICIPANTS 2
+#define CONSENSUS_MAX_CHOICES 8     // Choices are 0..7
+#define CONSENSUS_MAX_VOTERS 64     // Voter indices are 0..63
+#define CONSENSUS_NO_CHOICE 0xFF    // Unresolved, failed, or "no vote in this entry"
+#define CONSENSUS_NO_VOTER 0xFF
+#define CONSENSUS_REPEAT_INTERVAL 1000 // Re-send open votes this often (ms)
+#define CONSENSUS_RETAIN_MS 5000    // Resolved proposals stay readable (and announced) this long
+#define CONSENSUS_OUTCOME_WAIT_MS 3000 // Past the deadline, voters wait this long for the proposer's outcome
+
+#define CONSENSUS_ENTRY_PROPOSER 0x01 // Batch entry flag: the sender made this proposal
+#define CONSENSUS_ENTRY_OUTCOME 0x02  // ...and resolved it: choice is the result, confidence its share
+
+struct ConsensusProposal {
+  uint16_t proposalId;            // Unique proposal ID
+  DecisionTopic topic;            // Decision topic
+  ConsensusType consensusType;    // Type of consensus needed
+  uint8_t expertVoter;            // EXPERT_DECISION: whose vote decides (the proposer)
+  uint32_t createdTime;           // When proposal was made
+  uint32_t votingDeadline;        // Voting deadline
+  uint32_t resolvedTime;          // When it resolved (slot recycled CONSENSUS_RETAIN_MS later)
+  uint8_t totalVoters;            // Expected number of voters
+  uint8_t votesReceived;          // Votes received so far
+  uint64_t voterMask;             // Who has voted (bit per voter index)
+  float score[CONSENSUS_MAX_CHOICES]; // Votes, or summed weight for WEIGHTED_VOTE
+  uint8_t choiceMask;             // Choices that received any vote
+  uint8_t leader;                 // Highest score so far
+  uint8_t runnerUp;               // Second highest
+  uint8_t winningChoice;          // CONSENSUS_NO_CHOICE until resolved (and if it failed)
+  float winningConfidence;        // Winner's share of the votes cast
+  uint8_t myChoice;               // Our vote, CONSENSUS_NO_CHOICE if none
+  uint8_t myConfidence;           // 0-255
+  uint8_t myWeight;               // 0-255, confidence x fitness
+  bool isMine;                    // We proposed it
+  bool isResolved;                // Consensus reached (or failed)
+  bool isActive;                  // Slot in use
+};
+
+struct ConsensusBatchEntry {
+  uint16_t proposalId;
+  uint8_t topic;                  // DecisionTopic
+  uint8_t consensusType;          // ConsensusType
+  uint8_t flags;                  // CONSENSUS_ENTRY_*
+  uint8_t totalVoters;
+  uint16_t remainingMs;           // Until the deadline, sender's view
+  uint8_t choice;                 // CONSENSUS_NO_CHOICE = announcement only
+  uint8_t confidence;             // 0-255
+  uint8_t weight;                 // 0-255, confidence x fitness
+} __attribute__((packed));
+
+// MSG_CONSENSUS_VOTE payload; only entryCount entries are sent
+struct ConsensusBatchPayload {
+  uint8_t entryCount;
+  ConsensusBatchEntry entries[MAX_CONSENSUS_PROPOSALS];
+} __attribute__((packed));
+
+struct ConsensusStats {
+  uint32_t proposals;
+  uint32_t votesTallied;
+  uint32_t resolvedEarly;         // Decided before the deadline
+  uint32_t resolvedAtDeadline;
+  uint32_t failed;                // No consensus
+  uint32_t adopted;               // Any of the above, taken from the proposer's outcome
+  uint32_t batchesSent;
+};
+
+// Called once when a proposal resolves (winningChoice may be CONSENSUS_NO_CHOICE)
+typedef void (*ConsensusResolvedListener)(const ConsensusProposal& proposal);
+
+class SwarmConsensus {
+public:
+  SwarmConsensus();
+
+  void begin(const uint8_t* selfMac, uint8_t selfVoter);
+  void setResolvedListener(ConsensusResolvedListener listener) { resolvedListener = listener; }
+
+  // Returns the proposal id, 0 if every slot is busy
+  uint16_t propose(DecisionTopic topic, ConsensusType type, uint8_t expectedVoters, unsigned long now);
+  // Our own vote: tallied now and queued for the next batch
+  bool castVote(uint16_t proposalId, uint8_t choice, float confidence, float fitness, unsigned long now);
+  // A vote from anyone; duplicates are ignored. Only the proposer resolves on it
+  bool tally(uint16_t proposalId, uint8_t voter, uint8_t choice, float weight, unsigned long now);
+
+  // Deadlines (the proposer's, or the outcome wait for everyone else) and slot recycling
+  void update(unsigned long now);
+
+  // Batch of everything we have to say; false if nothing is due
+  bool isBatchDue(unsigned long now) const;
+  bool isBatchUrgent() const { return urgent; }
+  size_t buildBatch(ConsensusBatchPayload& batch, unsigned long now);
+  void mergeBatch(uint8_t senderVoter, const ConsensusBatchPayload& batch, size_t length, unsigned long now);
+
+  const ConsensusProposal* find(uint16_t proposalId) const;
+  uint8_t getOpenCount() const;
+  const ConsensusStats& getStats() const { return stats; }
+
+private:
+  ConsensusProposal proposals[MAX_CONSENSUS_PROPOSALS];
+  uint8_t idPrefix;               // Low MAC byte, keeps ids from different bots apart
+  uint8_t nextSequence;
+  uint8_t selfVoter;
+  bool changed;                   // Something new to send
+  bool urgent;                    // ...and it cannot wait
+  unsigned long lastBatch;
+  ConsensusResolvedListener resolvedListener;
+  ConsensusStats stats;
+
+  ConsensusProposal* findMutable(uint16_t proposalId);
+  ConsensusProposal* allocate(uint16_t proposalId, DecisionTopic topic, ConsensusType type,
+                              uint8_t expectedVoters, uint32_t deadline, unsigned long now);
+  void evaluate(ConsensusProposal& p, unsigned long now, bool deadlinePassed);
+  void resolve(ConsensusProposal& p, uint8_t choice, float confidence, unsigned long now, bool early);
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <Arduino.h>
+#include "swarm_espnow.h"
+#include "swarm_spatial.h"
+
+// ═══════════════════════════════════════════════════════════
+// 🧭 SHARED COVERAGE MAP - DELTA SYNC OVER MSG_AREA_SHARE
+// ═══════════════════════════════════════════════════════════
+// Every bot's explored bitmap (SwarmSpatialIndex) only ever gains bits,
+// so merging a peer's map is a bitwise OR and any two maps converge no
+// matter how often or in what order frames arrive.
+// - Deltas: each share carries only the rows that gained bits since our
+//   last share, as sparse (row, 32-bit word) pairs; empty rows cost nothing
+// - Version vector: the map is split into tiles of COVERAGE_TILE_ROWS
+//   rows and every share carries one summary per tile (explored-cell
+//   count + fingerprint). Counts only grow, so comparing summaries tells
+//   a receiver which tiles it is behind on, ahead on, or both
+// - Anti-entropy: tiles we are ahead on go out in full with our next
+//   share; tiles we are behind on are asked for in wantTiles
+// The whole 32 x 32 map is 32 rows, so even a full share fits one frame.
+// Comms core only.
+
+#define COVERAGE_TILE_ROWS 4
+#define COVERAGE_TILES (SPATIAL_GRID_DIM / COVERAGE_TILE_ROWS)
+#define COVERAGE_SYNC_INTERVAL 2000      // Deltas go out this often (ms)
+#define COVERAGE_SUMMARY_INTERVAL 10000  // Summary-only share when nothing changed (ms)
+#define COVERAGE_REPLY_SPACING 250       // Anti-entropy replies at most this often (ms)
+
+#define COVERAGE_SHARE_REPLY 0x01        // Share flag: triggered by a peer's summary
+
+struct CoverageRow {
+  uint8_t row;
+  uint32_t bits;
+} __attribute__((packed));
+
+struct CoverageTileSummary {
+  uint8_t count;                         // Explored cells in the tile (0-128)
+  uint16_t fingerprint;                  // Fold of the tile's bits
+} __attribute__((packed));
+
+#define COVERAGE_SHARE_HEADER_SIZE (3 + COVERAGE_TILES * sizeof(CoverageTileSummary))
+#define COVERAGE_MAX_ROWS SPATIAL_GRID_DIM
+
+// MSG_AREA_SHARE payload; only rowCount rows are sent
+struct CoverageSharePayload {
+  uint8_t flags;                         // COVERAGE_SHARE_*
+  uint8_t wantTiles;                     // Tiles the sender wants in full (bit per tile)
+  CoverageTileSummary tiles[COVERAGE_TILES];
+  uint8_t rowCount;
+  CoverageRow rows[COVERAGE_MAX_ROWS];
+} __attribute__((packed));
+
+static_assert(COVERAGE_TILES <= 8, "wantTiles is one bit per tile");
+static_assert(sizeof(CoverageSharePayload) <= SWARM_MAX_PAYLOAD_SIZE, "A full coverage share must fit one frame");
+
+struct CoverageStats {
+  uint32_t sharesSent;
+  uint32_t sharesReceived;
+  uint32_t rowsSent;
+  uint32_t cellsLearned;                 // Cells first heard of from peers
+};
+
+class SwarmCoverageSync {
+public:
+  explicit SwarmCoverageSync(SwarmSpatialIndex& index);
+
+  // Something worth sending (delta, pending tiles, or summary due)?
+  bool isShareDue(unsigned long now) const;
+  // Fills share and returns its payload length; 0 if there is nothing to say
+  size_t buildShare(CoverageSharePayload& share, unsigned long now);
+  // Merges a received share; returns true if a reply share should go out soon
+  bool mergeShare(const CoverageSharePayload& share, size_t length);
+
+  const CoverageStats& getStats() const { return stats; }
+
+private:
+  SwarmSpatialIndex& index;
+  uint32_t shared[SPATIAL_GRID_DIM];     // Bits already sent or heard from peers
+  uint8_t pushTiles;                     // Tiles to send in full next share
+  uint8_t wantTiles;                     // Tiles to ask for next share
+  unsigned long lastShare;
+  CoverageStats stats;
+
+  CoverageTileSummary summarize(uint8_t tile) const;
+  bool hasDelta() const;
+};
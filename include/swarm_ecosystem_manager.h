@@ -4,18 +4,39 @@
 #include <vector>
 #include <map>
 #include "swarm_espnow.h"
+#include "swarm_peer_registry.h"
+#include "swarm_node.h"
 
 // ═══════════════════════════════════════════════════════════
 // 🌐 SWARM ECOSYSTEM MANAGER - LAYER 3 INTELLIGENCE
 // ═══════════════════════════════════════════════════════════
+// Profiles and trust are indexed by PeerId (swarm_peer_registry.h):
+// botProfiles[id] and one lower-triangle trust matrix cell per pair.
+// Both live in one pool allocated by the constructor (about 20 KB at 32
+// peers, since the matrix grows with the square of the registry).
+// Reputation, data accuracy and trust are updated in O(1) whenever one
+// of their inputs changes, so shouldTrustBot() is always current. The
+// remaining per-profile work (timeouts, analysis) is a round-robin sweep
+// that update() advances within ECOSYSTEM_UPDATE_BUDGET_US.
 
-#define MAX_BOT_PROFILES 16
-#define MAX_RELATIONSHIPS 64
-#define REPUTATION_UPDATE_INTERVAL 600000  // 10 minutes
+#define MAX_BOT_PROFILES PEER_REGISTRY_CAPACITY
+#define TRUST_MATRIX_CELLS (MAX_BOT_PROFILES * (MAX_BOT_PROFILES - 1) / 2)
+#define BOT_TIMEOUT_MS 30000              // Silence counted as a failed check-in
 #define ECOSYSTEM_ANALYSIS_INTERVAL 3600000  // 1 hour
+#define ECOSYSTEM_UPDATE_BUDGET_US 500    // Sweep time per update() call
+#define ECOSYSTEM_SWEEP_STEPS 2           // Profiles visited per update() call, at most
 #define MIN_TRUST_SCORE 0.3f
 #define DATA_VERIFICATION_WINDOW 30000  // 30 seconds
 
+// Verification log lookups. Entries are chained per hash bucket, and two
+// Bloom filters, each covering half the window, answer "never seen this
+// data" in VERIFICATION_BLOOM_PROBES bit tests without touching the log.
+#define VERIFICATION_LOG_SIZE 100
+#define VERIFICATION_HASH_BUCKETS 64      // Power of two
+#define VERIFICATION_BLOOM_BITS 512       // Per filter, power of two
+#define VERIFICATION_BLOOM_PROBES 3
+#define VERIFICATION_NO_ENTRY 0xFF
+
 // ═══════════════════════════════════════════════════════════
 // 📊 BOT HEALTH & REPUTATION TRACKING
 // ═══════════════════════════════════════════════════════════
@@ -40,6 +61,7 @@ struct BotProfile {
   // IDENTITY
   // ═══════════════════════════════════════
   uint8_t botMAC[6];              // Unique ESP32 MAC address
+  bool isRegistered;              // Slot in use (index = PeerId)
   char botName[16];               // e.g., "WHEELIE", "SPEEDIE"
   BotType botType;                // SCOUT, MANIPULATOR, etc.
   uint32_t serialNumber;          // Manufacturing/build number
@@ -70,6 +92,7 @@ struct BotProfile {
   // ═══════════════════════════════════════
   float reputationScore;          // 0.0-100.0 (composite)
   uint32_t lastReputationUpdate;  // Timestamp
+  bool hasLocalEvidence;          // Reputation comes from our own observations
   
   // ═══════════════════════════════════════
   // HEALTH STATUS
@@ -83,7 +106,9 @@ struct BotProfile {
   // ═══════════════════════════════════════
   uint32_t lastSeenTimestamp;     // Last communication
   uint32_t consecutiveFailures;   // Failed communications in a row
+  uint32_t lastTimeoutCheck;      // Sweep: last check-in window counted
   bool needsInspection;           // Flag for human attention
+  bool needsUpgrade;              // Set by generateUpgradeRecommendations()
   bool isBlacklisted;             // Excluded from critical tasks
 };
 
@@ -106,36 +131,31 @@ enum InteractionResult {
   RESULT_CONTRADICTED = 3         // Data proven wrong by others
 };
 
+// One trust matrix cell; the pair is implied by its position.
+// Trust is not stored: it is the Beta(1,1) mean of time-decayed success
+// and failure evidence, (success + 1) / (success + failure + 2). Evidence
+// halves every TRUST_HALF_LIFE_MS, so old behaviour fades and trust
+// drifts back towards 0.5 without new interactions. 32 bytes per pair.
+#define TRUST_HALF_LIFE_MS 600000         // Evidence weight halves every 10 minutes
+#define TRUST_HISTORY_LENGTH 8            // Quantized recent interactions kept
+
+// History byte: [7:5] log2 seconds since the previous entry, [4:3] result, [2:0] type
+#define TRUST_HISTORY_ENTRY(type, result, ageCode) \
+  (uint8_t)(((ageCode) << 5) | (((result) & 0x03) << 3) | ((type) & 0x07))
+
 struct BotRelationship {
-  uint8_t botA_MAC[6];
-  uint8_t botB_MAC[6];
-  
-  // ═══════════════════════════════════════
-  // TRUST METRICS
-  // ═══════════════════════════════════════
-  float trustScore;               // 0.0-1.0
-  uint32_t interactionCount;      // Total interactions
-  uint32_t successfulInteractions; // Went well
-  uint32_t failedInteractions;    // Went poorly
-  
-  // ═══════════════════════════════════════
-  // INTERACTION HISTORY
-  // ═══════════════════════════════════════
-  InteractionType recentInteractions[10]; // Last 10 interactions
-  InteractionResult recentResults[10];    // Results of last 10
-  uint32_t recentTimestamps[10];          // When they occurred
-  uint8_t interactionIndex;               // Circular buffer index
-  
-  // ═══════════════════════════════════════
-  // DATA QUALITY TRACKING
-  // ═══════════════════════════════════════
-  uint32_t dataPointsShared;      // Total data points shared
-  uint32_t dataPointsVerified;    // Confirmed accurate
-  uint32_t dataPointsContradicted; // Proven wrong
-  
+  float successWeight;            // Decayed evidence, as of lastInteraction
+  float failureWeight;
   uint32_t lastInteraction;       // Timestamp of last interaction
-  bool isActive;                  // Relationship actively tracked
+  uint16_t interactionCount;      // Lifetime totals (saturating)
+  uint16_t successfulInteractions;
+  uint16_t failedInteractions;
+  uint8_t historyHead;            // Next history slot
+  uint8_t historyCount;
+  uint8_t history[TRUST_HISTORY_LENGTH]; // TRUST_HISTORY_ENTRY, oldest first from historyHead
+  bool isActive;                  // At least one interaction recorded
 };
+static_assert(sizeof(BotRelationship) <= 32, "BotRelationship should stay within half a cache line");
 
 struct DataVerificationEntry {
   uint8_t senderMAC[6];           // Who sent the data
@@ -144,6 +164,14 @@ struct DataVerificationEntry {
   bool isVerification;            // true = verified, false = contradicted
   uint32_t timestamp;             // When verification occurred
   float dataConfidence;           // Confidence in verification (0.0-1.0)
+  uint8_t nextInBucket;           // Log slot of the next entry in this hash bucket
+};
+
+// What the window knows about one piece of data from one sender
+struct VerificationSummary {
+  uint8_t verified;               // Distinct verifiers that confirmed it
+  uint8_t contradicted;           // Distinct verifiers that contradicted it
+  float confidence;               // Mean confidence of those verdicts
 };
 
 // ═══════════════════════════════════════════════════════════
@@ -152,33 +180,65 @@ struct DataVerificationEntry {
 
 class SwarmEcosystemManager {
 private:
-  BotProfile botProfiles[MAX_BOT_PROFILES];
+  BotProfile* botProfiles;        // MAX_BOT_PROFILES, indexed by PeerId; start of the pool
   uint8_t botCount;
+  uint8_t wheelieCount;           // Running type counts for identifyCapabilityGaps()
+  uint8_t speedieCount;
+  PeerId selfId;
   
-  BotRelationship relationships[MAX_RELATIONSHIPS];
-  uint8_t relationshipCount;
+  BotRelationship* trustMatrix;   // TRUST_MATRIX_CELLS, lower triangle, see relationshipIndex()
+  uint16_t relationshipCount;
   
-  DataVerificationEntry verificationLog[100];
+  DataVerificationEntry verificationLog[VERIFICATION_LOG_SIZE];
   uint8_t verificationLogIndex;
+  uint8_t verificationLogCount;
+  uint8_t verificationBuckets[VERIFICATION_HASH_BUCKETS]; // First log slot, VERIFICATION_NO_ENTRY = empty
+  uint32_t verificationBloom[2][VERIFICATION_BLOOM_BITS / 32];
+  uint8_t currentBloom;           // Filter new hashes go into
+  unsigned long bloomRotatedAt;
   
-  unsigned long lastReputationUpdate;
   unsigned long lastEcosystemAnalysis;
+  PeerId sweepCursor;             // Next profile the sweep visits
+  PeerId analysisStart;           // Where the running analysis pass began, -1 = idle
+  
+  static int relationshipIndex(PeerId a, PeerId b);
+  static float trustOf(const BotRelationship* relationship, unsigned long now);
+  BotRelationship* getRelationship(PeerId a, PeerId b);
+  void countType(BotType type, int delta);
+  void refreshReputation(BotProfile* profile);
+  void sweepProfile(PeerId id, unsigned long now);
+  bool checkWeakBot(BotProfile* profile);
+  bool checkUpgradeNeeds(BotProfile* profile);
+  static uint8_t verificationBucket(uint32_t dataHash);
+  void rotateVerificationBloom(unsigned long now);
+  void bloomInsert(uint32_t dataHash);
+  bool bloomMayContain(uint32_t dataHash) const;
+  void unlinkVerification(uint8_t slot);
+  DataVerificationEntry* findVerification(const uint8_t* sender, const uint8_t* verifier,
+                                          uint32_t dataHash, unsigned long now);
   
 public:
   // ═══════════════════════════════════════
   // INITIALIZATION & SETUP
   // ═══════════════════════════════════════
   SwarmEcosystemManager();
+  ~SwarmEcosystemManager();
+  SwarmEcosystemManager(const SwarmEcosystemManager&) = delete;
+  SwarmEcosystemManager& operator=(const SwarmEcosystemManager&) = delete;
+  bool hasStorage() const { return botProfiles != nullptr; }
   void initialize();
   
   // ═══════════════════════════════════════
   // BOT PROFILE MANAGEMENT
   // ═══════════════════════════════════════
-  void registerBot(uint8_t* mac, BotType type, const char* name);
+  PeerId registerBot(uint8_t* mac, BotType type, const char* name);
+  void setSelf(PeerId id) { selfId = id; }
   void updateBotStatus(uint8_t* mac, uint32_t generation, float fitness);
   void updateBotHealth(uint8_t* mac, BotHealth health);
   BotProfile* getBotProfile(uint8_t* mac);
+  BotProfile* getBotProfile(PeerId id);
   void deactivateBot(uint8_t* mac);
+  void forgetPeer(PeerId id);     // Registry release: clear profile and trust row
   
   // ═══════════════════════════════════════
   // TRUST & RELATIONSHIP MANAGEMENT
@@ -187,6 +247,9 @@ public:
                         InteractionType type, InteractionResult result);
   void recordDataVerification(uint8_t* sender, uint8_t* verifier, 
                              uint32_t dataHash, bool isCorrect, float confidence);
+  // Verdicts on this data from this sender within DATA_VERIFICATION_WINDOW.
+  // Returns false (summary untouched) if nobody has checked it.
+  bool getVerificationSummary(uint8_t* sender, uint32_t dataHash, VerificationSummary* summary);
   float getTrustScore(uint8_t* botA, uint8_t* botB);
   bool shouldTrustBot(uint8_t* mac, float minTrustThreshold = MIN_TRUST_SCORE);
   
@@ -217,6 +280,8 @@ public:
   // ═══════════════════════════════════════
   // TASK ASSIGNMENT INTELLIGENCE  
   // ═══════════════════════════════════════
+  // 0-1 from reputation, accuracy, success rate, health and our trust; < 0 = exclude
+  float getTaskSuitability(PeerId id);
   uint8_t* selectBestBotForTask(TaskType task, uint8_t* candidateMACs, uint8_t candidateCount);
   bool shouldExcludeFromCriticalTasks(uint8_t* mac);
   void blacklistBot(uint8_t* mac, const char* reason);
@@ -304,11 +369,9 @@ struct EcosystemAlertPayload {
 // 🔧 INTEGRATION HELPERS
 // ═══════════════════════════════════════════════════════════
 
-// Global ecosystem manager instance (to be created in main.cpp)
-extern SwarmEcosystemManager* ecosystemManager;
-
-// Helper functions for integration with existing ESP-NOW code
-void initializeEcosystemManager();
+// The manager is per node (swarmNode->ecosystem, swarm_node.h), created
+// by initializeEcosystemManager(); the helpers below act on that node's
+void initializeEcosystemManager(BotType selfType, const char* selfName);
 void handleEcosystemMessage(const uint8_t* senderMac, SwarmMessage* message);
 bool verifyDataWithEcosystem(uint8_t* senderMac, uint32_t dataHash, float* trustMultiplier);
 void reportInteractionToEcosystem(uint8_t* peerMac, InteractionType type, InteractionResult result);
\ No newline at end of file
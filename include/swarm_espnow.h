@@ -10,6 +10,7 @@
  * - Message prioritization and routing
  * - Swarm intelligence coordination
  * - Emergent behavior protocols
+ * - Variable-length, versioned frames (header + active payload only)
  * 
  * Author: Project Jumbo Team
  * Version: 1.0.0
@@ -48,6 +49,11 @@ enum MessageType {
   MSG_PAIRING_REQUEST = 0x02, // Request to pair
   MSG_PAIRING_RESPONSE = 0x03, // Response to pairing
   MSG_HEARTBEAT = 0x04,      // Keep-alive signal
+  MSG_GOSSIP_DIGEST = 0x05,  // Membership digest (swarm_membership.h)
+  MSG_GOSSIP_UPDATE = 0x06,  // Member status the digest sender was missing
+  
+  // Transport
+  MSG_BUNDLE = 0x08,         // Several payloads in one frame (swarm_bundle.h)
   
   // Status & Data Sharing
   MSG_STATUS_UPDATE = 0x10,  // General status info
@@ -91,6 +97,18 @@ enum MessagePriority {
 // 📦 MESSAGE STRUCTURES
 // ═══════════════════════════════════════════════════════════
 
+// ═══════════════════════════════════════════════════════════
+// 📏 WIRE FORMAT
+// ═══════════════════════════════════════════════════════════
+// Version 1 frames are header + only the active payload:
+//   [MessageHeader (11 bytes)][payloadLength bytes]
+// and are usually 27-42 bytes instead of the legacy 211.
+// Version 0 (legacy) frames always carried a 200-byte union and had
+// version/payloadLength left at zero; they are still accepted.
+#define SWARM_PROTOCOL_VERSION 1
+#define SWARM_LEGACY_PAYLOAD_SIZE 200
+#define SWARM_MAX_MESSAGE_TYPE 0x6F  // 0x60-0x6F: ecosystem messages (swarm_ecosystem_manager.h)
+
 // Base message header (all messages start with this)
 struct MessageHeader {
   uint8_t messageType;      // MessageType enum
@@ -98,10 +116,16 @@ struct MessageHeader {
   uint8_t senderType;       // BotType enum
   uint8_t sequenceNumber;   // Message sequence (0-255)
   uint32_t timestamp;       // Milliseconds since boot
-  uint8_t checksum;         // Simple checksum for integrity
-  uint8_t reserved[2];      // Future expansion
+  uint8_t checksum;         // XOR of header (checksum = 0) + payload
+  uint8_t version;          // SWARM_PROTOCOL_VERSION (0 = legacy fixed-size frame)
+  uint8_t payloadLength;    // Bytes of payload that follow the header
 } __attribute__((packed));
 
+static_assert(sizeof(MessageHeader) == 11, "MessageHeader layout is part of the wire format");
+
+// Largest payload that still fits one ESP-NOW frame
+#define SWARM_MAX_PAYLOAD_SIZE (ESP_NOW_MAX_DATA_LEN - sizeof(MessageHeader))
+
 // Discovery message payload
 struct DiscoveryPayload {
   uint8_t botType;          // BotType enum
@@ -189,7 +213,7 @@ struct SwarmMessage {
     TaskPayload task;
     GenomePayload genome;
     LocalizationPayload localization; // Audio beacon ranging data
-    uint8_t rawData[200];   // Raw data buffer
+    uint8_t rawData[SWARM_MAX_PAYLOAD_SIZE]; // Raw data buffer / bundle records
   } payload;
 } __attribute__((packed));
 
@@ -210,7 +234,8 @@ struct SwarmPeer {
   bool isActive;            // Peer active flag
 };
 
-#define MAX_SWARM_PEERS 8    // Maximum peers in swarm
+#define MAX_SWARM_PEERS 8    // Direct peers tracked at once (larger swarms: swarm_membership.h)
+#define MAX_SWARM_MEMBERS 32 // Whole-swarm size, direct or not (gossip membership)
 #define DISCOVERY_INTERVAL 5000  // Discovery broadcast interval (ms)
 #define HEARTBEAT_INTERVAL 2000  // Heartbeat interval (ms)
 #define PEER_TIMEOUT 10000   // Peer timeout (ms)
@@ -258,7 +283,7 @@ enum DecisionCriteria {
 // Message validation
 inline bool isValidMessage(const SwarmMessage* msg) {
   if (!msg) return false;
-  if (msg->header.messageType == 0 || msg->header.messageType > 0x50) return false;
+  if (msg->header.messageType == 0 || msg->header.messageType > SWARM_MAX_MESSAGE_TYPE) return false;
   if (msg->header.priority == 0 || msg->header.priority > 4) return false;
   return true;
 }
@@ -272,6 +297,67 @@ inline uint8_t calculateChecksum(const uint8_t* data, size_t length) {
   return checksum;
 }
 
+// Minimum payload size for each message type (0 = no payload required).
+// Longer payloads are accepted so newer senders can append fields.
+inline size_t minPayloadSize(uint8_t messageType) {
+  switch (messageType) {
+    case MSG_DISCOVERY:             return sizeof(DiscoveryPayload);
+    case MSG_PAIRING_RESPONSE:      return sizeof(StatusPayload);
+    case MSG_STATUS_UPDATE:         return sizeof(StatusPayload);
+    case MSG_SENSOR_DATA:           return sizeof(SensorPayload);
+    case MSG_POSITION_UPDATE:       return sizeof(PositionPayload);
+    case MSG_TASK_ASSIGNMENT:       return sizeof(TaskPayload);
+    case MSG_GENOME_SHARE:          return sizeof(GenomePayload);
+    case MSG_LOCALIZATION_REQUEST:
+    case MSG_LOCALIZATION_RESPONSE:
+    case MSG_BEACON_PING:
+    case MSG_POSITION_SHARE:        return sizeof(LocalizationPayload);
+    default:                        return 0;
+  }
+}
+
+// Stamp version/length/checksum on an outgoing message.
+// Returns the number of bytes to transmit.
+inline size_t finalizeSwarmMessage(SwarmMessage* msg, size_t payloadLength) {
+  if (payloadLength > sizeof(msg->payload)) payloadLength = sizeof(msg->payload);
+  
+  msg->header.version = SWARM_PROTOCOL_VERSION;
+  msg->header.payloadLength = (uint8_t)payloadLength;
+  msg->header.checksum = 0;
+  
+  size_t frameLength = sizeof(MessageHeader) + payloadLength;
+  msg->header.checksum = calculateChecksum((const uint8_t*)msg, frameLength);
+  return frameLength;
+}
+
+// Decode a received frame into a full SwarmMessage (unused payload bytes
+// are zeroed). Rejects truncated, oversize, corrupt or unknown frames.
+inline bool decodeSwarmFrame(const uint8_t* data, int len, SwarmMessage* out) {
+  if (data == nullptr || out == nullptr) return false;
+  if (len < (int)sizeof(MessageHeader) || len > (int)sizeof(SwarmMessage)) return false;
+  
+  memcpy(out, data, len);
+  memset((uint8_t*)out + len, 0, sizeof(SwarmMessage) - len);
+  
+  if (out->header.version == 0) {
+    // Legacy fixed-size frame: no length field, checksum never enforced
+    if (len != (int)(sizeof(MessageHeader) + SWARM_LEGACY_PAYLOAD_SIZE)) return false;
+  } else {
+    if (out->header.payloadLength != len - (int)sizeof(MessageHeader)) return false;
+    
+    uint8_t received = out->header.checksum;
+    out->header.checksum = 0;
+    uint8_t expected = calculateChecksum((const uint8_t*)out, len);
+    out->header.checksum = received;
+    if (received != expected) return false;
+  }
+  
+  if (!isValidMessage(out)) return false;
+  
+  size_t available = len - sizeof(MessageHeader);
+  return available >= minPayloadSize(out->header.messageType);
+}
+
 // MAC address comparison
 inline bool macEquals(const uint8_t* mac1, const uint8_t* mac2) {
   return memcmp(mac1, mac2, 6) == 0;
@@ -300,6 +386,8 @@ struct CommStats {
   uint8_t maxPeers;             // Maximum peers seen
   float averageRssi;            // Average signal strength
   uint32_t commErrors;          // Communication errors
+  uint32_t bundlesSent;         // MSG_BUNDLE frames carrying 2+ records
+  uint32_t bundleRecordsReceived; // Records unpacked from received bundles
 };
 
 #endif // SWARM_ESPNOW_H
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <Arduino.h>
+#include "swarm_espnow.h"
+
+// ═══════════════════════════════════════════════════════════
+// 🧬 SWARM GENE POOL - ISLAND-MODEL EVOLUTION
+// ═══════════════════════════════════════════════════════════
+// Every bot is an island that evaluates its own candidate genome each
+// evolution interval, all at the same time. The evaluated result
+// (genes + fitness) is broadcast as MSG_GENOME_SHARE, so each island's
+// pool holds the best recent results of every bot it hears (migration):
+// - breed(): tournament selection over the pool (own result included),
+//   uniform crossover of two parents, then per-gene mutation within
+//   the genome's bounds
+// - Entries older than GENE_POOL_TTL_MS drop out, so results from bots
+//   that left, or from long ago, stop breeding
+// A swarm of N bots evaluates N genomes per interval; with nobody else
+// in the pool the caller falls back to its own hill climbing.
+//
+// Genes are int16 values described by a GeneBounds table; the layout id
+// keeps genomes of different bot types apart. Not thread-safe: on
+// SPEEDIE it belongs to the comms core, like the genome itself.
+
+#define GENE_POOL_SIZE 8
+#define GENOME_MAX_GENES 16             // Fills GenomePayload.parameters
+#define GENE_POOL_TTL_MS 600000         // 10 minutes
+#define GENE_TOURNAMENT_SIZE 3
+#define GENE_MUTATION_PERCENT 20        // Chance per gene
+#define GENE_SHARE_REPEAT_MS 15000      // Re-share our result for joiners and lost frames
+
+struct GeneBounds {
+  int16_t minValue;
+  int16_t maxValue;
+  int16_t mutationStep;           // Mutation adds up to ± this
+};
+
+struct GenePoolEntry {
+  uint8_t mac[6];
+  int16_t genes[GENOME_MAX_GENES];
+  float fitness;
+  uint16_t generation;
+  uint32_t evaluatedAt;           // Local receive time
+  bool isActive;
+};
+
+struct GenePoolStats {
+  uint32_t evaluations;           // Our own results recorded
+  uint32_t migrantsReceived;
+  uint32_t migrantsRejected;      // Different layout or malformed
+  uint32_t offspring;             // breed() results
+  uint32_t crossovers;            // ...from two different parents
+};
+
+class SwarmGenePool {
+public:
+  SwarmGenePool(const GeneBounds* bounds, uint8_t geneCount, uint8_t layoutId);
+
+  void begin(const uint8_t* selfMac);
+
+  // Our candidate's result at the end of its evaluation window; kept only
+  // if it beats something in the pool
+  void recordEvaluation(const int16_t* genes, float fitness, uint16_t generation, unsigned long now);
+  // A migrant; false if it is not our genome layout
+  bool mergeShare(const uint8_t* senderMac, const GenomePayload& share, unsigned long now);
+
+  bool isShareDue(unsigned long now) const;
+  // Our latest result, while it is in the pool; false otherwise
+  bool buildShare(GenomePayload& out, unsigned long now);
+
+  // Fresh entries, ours included / from other bots only
+  uint8_t getPopulation(unsigned long now) const;
+  uint8_t getMigrantCount(unsigned long now) const;
+  const GenePoolEntry* getBest(unsigned long now) const;
+
+  // Next candidate for this island; false if the pool has no other bot in it
+  bool breed(int16_t* child, unsigned long now);
+
+  const GenePoolStats& getStats() const { return stats; }
+
+private:
+  const GeneBounds* bounds;
+  uint8_t geneCount;
+  uint8_t layoutId;
+  uint8_t selfMac[6];
+  GenePoolEntry entries[GENE_POOL_SIZE];
+  int8_t selfEntry;               // Our latest result's slot, -1 = not in the pool
+  bool shareDirty;                // New result not yet shared
+  unsigned long lastShare;
+  GenePoolStats stats;
+
+  bool isFresh(const GenePoolEntry& entry, unsigned long now) const;
+  bool isSameGenome(const GenePoolEntry& entry, const uint8_t* mac, const int16_t* genes) const;
+  int8_t slotFor(const uint8_t* mac, const int16_t* genes, float fitness, unsigned long now);
+  int8_t tournament(unsigned long now, int8_t exclude) const;
+  int16_t clampGene(uint8_t gene, int32_t value) const;
+  int16_t mutateGene(uint8_t gene, int16_t value) const;
+};
@@ -20,36 +20,15 @@
 #define SWARM_INTELLIGENCE_H
 
 #include "swarm_espnow.h"
+#include "swarm_consensus.h"
+#include "swarm_leadership.h"
+#include "swarm_task_scheduler.h"
 
 // ═══════════════════════════════════════════════════════════
 // 🏆 LEADER ELECTION ALGORITHMS
 // ═══════════════════════════════════════════════════════════
-
-enum LeadershipCriteria {
-  ELECT_BY_FITNESS = 0x01,        // Highest fitness score leads
-  ELECT_BY_GENERATION = 0x02,     // Most evolved bot leads
-  ELECT_BY_BATTERY = 0x03,        // Highest battery leads
-  ELECT_BY_SENSOR_QUALITY = 0x04, // Best sensor coverage leads
-  ELECT_BY_EXPERIENCE = 0x05,     // Most strategies learned leads
-  ELECT_BY_RANDOM = 0x06,         // Random selection for fairness
-  ELECT_BY_CONSENSUS = 0x07       // Democratic voting system
-};
-
-struct LeadershipBid {
-  uint8_t candidateMac[6];        // Candidate's MAC address
-  BotType botType;                // Type of bot
-  uint16_t generation;            // Evolution generation
-  float fitnessScore;             // Current fitness
-  uint8_t batteryLevel;           // Battery percentage
-  uint16_t strategiesLearned;     // Number of strategies
-  uint32_t uptime;               // Time since boot
-  uint8_t votes;                  // Votes received
-  uint32_t bidTimestamp;          // When bid was made
-};
-
-#define MAX_LEADERSHIP_CANDIDATES 8
-#define LEADERSHIP_TIMEOUT 10000    // 10 second election cycle
-#define MIN_VOTES_REQUIRED 2        // Minimum votes to become leader
+// LeadershipCriteria, LeadershipBid and the lease-based election engine
+// live in swarm_leadership.h
 
 // ═══════════════════════════════════════════════════════════
 // 🗺️ COLLABORATIVE EXPLORATION STRATEGIES
@@ -83,97 +62,14 @@ struct ExplorationZone {
 // 🎯 TASK DISTRIBUTION SYSTEM
 // ═══════════════════════════════════════════════════════════
 
-enum TaskCategory {
-  TASK_CAT_EXPLORATION = 0x01,    // Area exploration tasks
-  TASK_CAT_SURVEILLANCE = 0x02,   // Monitoring and patrol
-  TASK_CAT_RESCUE = 0x03,         // Search and rescue ops
-  TASK_CAT_MAINTENANCE = 0x04,    // System maintenance
-  TASK_CAT_LEARNING = 0x05,       // Collaborative learning
-  TASK_CAT_EMERGENCY = 0x06       // Emergency response
-};
-
-enum TaskStatus {
-  TASK_STATUS_PENDING = 0x01,     // Waiting for assignment
-  TASK_STATUS_ASSIGNED = 0x02,    // Assigned to bot
-  TASK_STATUS_ACTIVE = 0x03,      // Currently executing
-  TASK_STATUS_COMPLETED = 0x04,   // Successfully completed
-  TASK_STATUS_FAILED = 0x05,      // Failed or aborted
-  TASK_STATUS_CANCELLED = 0x06    // Cancelled by coordinator
-};
-
-struct SwarmTask {
-  uint16_t taskId;                // Unique task identifier
-  TaskCategory category;          // Task category
-  TaskType taskType;              // Specific task type
-  uint8_t priority;               // Priority level (1-10)
-  uint8_t assignedBot[6];         // Assigned bot MAC
-  uint8_t requesterBot[6];        // Bot that requested task
-  TaskStatus status;              // Current status
-  uint32_t createdTime;           // Creation timestamp
-  uint32_t deadlineTime;          // Deadline timestamp
-  uint32_t startTime;             // Start execution time
-  uint32_t completionTime;        // Completion timestamp
-  float parameters[8];            // Task-specific parameters
-  uint8_t progressPercent;        // Progress (0-100%)
-  uint8_t retryCount;             // Number of retries
-  bool requiresConfirmation;      // Needs completion confirmation
-};
-
-#define MAX_SWARM_TASKS 32
-#define TASK_TIMEOUT 30000          // 30 second task timeout
-#define MAX_TASK_RETRIES 3
+// TaskCategory, TaskStatus, SwarmTask and the deadline-ordered scheduler
+// live in swarm_task_scheduler.h
 
 // ═══════════════════════════════════════════════════════════
 // 🗳️ CONSENSUS AND DECISION MAKING
 // ═══════════════════════════════════════════════════════════
 
-enum ConsensusType {
-  CONSENSUS_SIMPLE_MAJORITY = 0x01,   // >50% agreement
-  CONSENSUS_SUPERMAJORITY = 0x02,     // >66% agreement  
-  CONSENSUS_UNANIMOUS = 0x03,         // 100% agreement
-  CONSENSUS_WEIGHTED_VOTE = 0x04,     // Fitness-weighted voting
-  CONSENSUS_EXPERT_DECISION = 0x05    // Specialist bot decides
-};
-
-enum DecisionTopic {
-  DECIDE_EXPLORATION_AREA = 0x01,     // Where to explore next
-  DECIDE_FORMATION_CHANGE = 0x02,     // Change swarm formation
-  DECIDE_LEADER_SELECTION = 0x03,     // Select new leader
-  DECIDE_TASK_PRIORITY = 0x04,        // Prioritize tasks
-  DECIDE_RESOURCE_ALLOCATION = 0x05,  // Allocate resources
-  DECIDE_EMERGENCY_RESPONSE = 0x06,   // Emergency protocols
-  DECIDE_LEARNING_STRATEGY = 0x07     // Learning approach
-};
-
-struct ConsensusVote {
-  uint16_t proposalId;            // Proposal identifier
-  DecisionTopic topic;            // What we're deciding
-  uint8_t voterMac[6];            // Voter's MAC address
-  uint8_t choice;                 // Vote choice (0-255)
-  float confidence;               // Vote confidence (0.0-1.0)
-  uint32_t timestamp;             // Vote timestamp
-  bool isValid;                   // Vote validity flag
-};
-
-struct ConsensusProposal {
-  uint16_t proposalId;            // Unique proposal ID
-  DecisionTopic topic;            // Decision topic
-  uint8_t proposerMac[6];         // Who proposed this
-  ConsensusType consensusType;    // Type of consensus needed
-  uint32_t createdTime;           // When proposal was made
-  uint32_t votingDeadline;        // Voting deadline
-  uint8_t totalVoters;            // Expected number of voters
-  uint8_t votesReceived;          // Votes received so far
-  ConsensusVote votes[MAX_SWARM_PEERS]; // All votes
-  uint8_t winningChoice;          // Current winning choice
-  float winningConfidence;        // Confidence in winning choice
-  bool isResolved;                // Consensus reached
-  bool isActive;                  // Proposal active
-};
-
-#define MAX_CONSENSUS_PROPOSALS 8
-#define VOTING_TIMEOUT 15000        // 15 second voting window
-#define MIN_CONSENSUS_PARTICIPANTS 2
+// Types, tallying and vote batches: swarm_consensus.h
 
 // ═══════════════════════════════════════════════════════════
 // 🔄 FORMATION CONTROL PATTERNS
@@ -204,7 +100,7 @@ struct SwarmFormation {
   float centerX, centerY;         // Formation center
   float scale;                    // Formation scale factor
   float heading;                  // Formation heading
-  FormationPosition positions[MAX_SWARM_PEERS]; // Position assignments
+  FormationPosition positions[MAX_SWARM_MEMBERS]; // Position assignments
   uint8_t activeBots;             // Number of bots in formation
   bool isActive;                  // Formation active
   uint32_t lastUpdate;            // Last formation update
@@ -262,15 +158,52 @@ struct LearningShare {
 
 #define MAX_LEARNING_SHARES 64
 
+// ═══════════════════════════════════════════════════════════
+// 🌊 PER-NODE STATE
+// ═══════════════════════════════════════════════════════════
+
+// Everything below acts on the running node's state (SwarmNode::intelligence),
+// created on first use. Reports about the bot itself (type, fitness,
+// active peers) come from swarmNode->self.
+struct SwarmIntelligenceState {
+  // Leadership
+  LeadershipBid leadershipCandidates[MAX_LEADERSHIP_CANDIDATES];
+  int candidateCount;
+  uint8_t currentLeader[6];
+  bool isLeader;
+  SwarmLeaderElection leaderElection;
+  bool leaderElectionStarted;
+
+  SwarmTaskScheduler taskScheduler;
+
+  ExplorationZone explorationZones[MAX_EXPLORATION_ZONES];
+  uint16_t activeZones;             // Bit per explorationZones slot in use
+
+  SwarmFormation currentFormation;
+  FormationPosition myPosition;
+  EmergentState emergentState;
+
+  SwarmConsensus swarmConsensus;
+  bool consensusStarted;
+
+  SwarmIntelligenceState();
+};
+
+SwarmIntelligenceState& swarmIntelligence();
+
 // ═══════════════════════════════════════════════════════════
 // 🔧 SWARM INTELLIGENCE API
 // ═══════════════════════════════════════════════════════════
 
-// Leadership functions
+// Comms tick: leader lease, task deadlines, consensus deadlines and vote batches
+void updateSwarmIntelligence();
+
+// Leadership functions (leaderElection; heartbeats and bids travel in MSG_LEADER_ELECTION)
 bool initiateLeaderElection(LeadershipCriteria criteria);
 void submitLeadershipBid(LeadershipBid* bid);
 uint8_t* electLeader(LeadershipBid candidates[], int candidateCount);
 void transferLeadership(uint8_t* newLeaderMac);
+void handleLeaderElection(const uint8_t* senderMac, const SwarmMessage* message);
 
 // Exploration coordination
 bool assignExplorationZone(uint8_t* botMac, ExplorationZone* zone);
@@ -282,12 +215,14 @@ uint16_t createSwarmTask(TaskCategory category, TaskType type, uint8_t priority)
 bool assignTask(uint16_t taskId, uint8_t* botMac);
 void reportTaskProgress(uint16_t taskId, uint8_t progressPercent);
 void completeTask(uint16_t taskId, bool successful);
+SwarmTask* findTask(uint16_t taskId);
 
-// Consensus protocols
+// Consensus protocols (swarmConsensus; votes travel in MSG_CONSENSUS_VOTE batches)
 uint16_t proposeDecision(DecisionTopic topic, ConsensusType type);
 void castVote(uint16_t proposalId, uint8_t choice, float confidence);
 bool checkConsensusReached(uint16_t proposalId);
 uint8_t getConsensusResult(uint16_t proposalId);
+void handleConsensusVotes(const uint8_t* senderMac, const SwarmMessage* message);
 
 // Formation control
 void setFormation(FormationType type, float scale);
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <Arduino.h>
+#include "swarm_espnow.h"
+
+// ═══════════════════════════════════════════════════════════
+// 👑 LEASE-BASED LEADER ELECTION
+// ═══════════════════════════════════════════════════════════
+// The leader holds a lease that it renews with a heartbeat every
+// LEADER_HEARTBEAT_INTERVAL; a follower whose lease runs out (three
+// heartbeats missed) starts an election for the next term:
+//   round 1: candidacy {term, bid} broadcast; everyone who hears a newer
+//            term answers once with its own bid, everyone ranks the bids
+//            by the term's LeadershipCriteria as they arrive
+//   round 2: after LEADER_ELECTION_WINDOW the best bidder heartbeats as
+//            leader; a better candidate that hears a worse one claim
+//            the term heartbeats over it (bully), and the worse one yields
+// Failover takes about a lease plus one window, instead of waiting for
+// the next periodic election. A working leader is never unseated:
+// - A bot that joins listens for a lease first
+// - A follower whose lease is still live ignores candidacies (pre-vote);
+//   only the leader itself can call an election past it
+// - A leader that hears a candidacy (someone lost its heartbeats) adopts
+//   the term and heartbeats at once, and a candidate follows the leader
+//   it lost when that leader claims the new term, however the bids rank
+// Not thread-safe: one task owns it.
+
+enum LeadershipCriteria {
+  ELECT_BY_FITNESS = 0x01,        // Highest fitness score leads
+  ELECT_BY_GENERATION = 0x02,     // Most evolved bot leads
+  ELECT_BY_BATTERY = 0x03,        // Highest battery leads
+  ELECT_BY_SENSOR_QUALITY = 0x04, // Best sensor coverage leads
+  ELECT_BY_EXPERIENCE = 0x05,     // Most strategies learned leads
+  ELECT_BY_RANDOM = 0x06,         // Random selection for fairness
+  ELECT_BY_CONSENSUS = 0x07       // Democratic voting system
+};
+
+struct LeadershipBid {
+  uint8_t candidateMac[6];        // Candidate's MAC address
+  BotType botType;                // Type of bot
+  uint16_t generation;            // Evolution generation
+  float fitnessScore;             // Current fitness
+  uint8_t batteryLevel;           // Battery percentage
+  uint16_t strategiesLearned;     // Number of strategies
+  uint32_t uptime;               // Time since boot
+  uint8_t votes;                  // Votes received
+  uint32_t bidTimestamp;          // When bid was made
+};
+
+#define MAX_LEADERSHIP_CANDIDATES 8
+#define LEADERSHIP_TIMEOUT 10000    // 10 second election cycle
+#define MIN_VOTES_REQUIRED 2        // Minimum votes to become leader
+
+#define LEADER_HEARTBEAT_INTERVAL 500   // Lease renewal period (ms)
+#define LEADER_LEASE_MS 1500            // Followers wait this long without a heartbeat
+#define LEADER_ELECTION_WINDOW 200      // Bids collected this long before deciding (ms)
+
+enum LeaderMessageType : uint8_t {
+  LEADER_MSG_NONE = 0,
+  LEADER_MSG_HEARTBEAT = 1,       // "I lead this term", renews the lease
+  LEADER_MSG_CANDIDATE = 2        // Bid for this term
+};
+
+enum LeaderRole : uint8_t {
+  LEADER_ROLE_FOLLOWER = 0,
+  LEADER_ROLE_CANDIDATE,
+  LEADER_ROLE_LEADER
+};
+
+// MSG_LEADER_ELECTION payload; the candidate is the sender
+struct LeaderElectionPayload {
+  uint8_t type;                   // LeaderMessageType
+  uint8_t criteria;               // LeadershipCriteria of this term
+  uint16_t term;
+  uint16_t leaseMs;               // Heartbeat: lease granted by it
+  uint8_t botType;
+  uint8_t batteryLevel;
+  uint16_t generation;
+  uint16_t fitness;               // fitnessScore * 1000
+  uint16_t strategiesLearned;
+  uint32_t uptime;
+} __attribute__((packed));
+
+struct LeaderElectionStats {
+  uint32_t elections;             // Elections this bot started
+  uint32_t termsLed;
+  uint32_t leaderChanges;
+  uint32_t lastElectionMs;        // Joining an election to knowing the new leader, last time
+};
+
+// Called when the leader changes; mac is all zeros while there is none
+typedef void (*LeaderChangeListener)(const uint8_t* leaderMac, bool isSelf);
+
+class SwarmLeaderElection {
+public:
+  SwarmLeaderElection();
+
+  void begin(const uint8_t* selfMac, LeadershipCriteria criteria, unsigned long now);
+  void setCriteria(LeadershipCriteria criteria) { this->criteria = criteria; }
+  void setLeaderChangeListener(LeaderChangeListener listener) { changeListener = listener; }
+
+  // Own bid, refreshed by the caller whenever its stats change
+  void setSelfBid(const LeadershipBid& bid);
+
+  // Start an election now (e.g. on request), whatever the lease says
+  void startElection(unsigned long now);
+  // Timers: heartbeats, lease expiry, election window
+  void update(unsigned long now);
+  void handleMessage(const uint8_t* senderMac, const LeaderElectionPayload& message, unsigned long now);
+
+  // Outgoing message waiting to be broadcast, if any
+  bool pollMessage(LeaderElectionPayload& out);
+
+  bool isLeader() const { return role == LEADER_ROLE_LEADER; }
+  bool hasLeader(unsigned long now) const;
+  const uint8_t* getLeader() const { return leaderMac; }
+  uint16_t getTerm() const { return term; }
+  LeadershipCriteria getCriteria() const { return criteria; }
+  LeaderRole getRole() const { return role; }
+  const LeaderElectionStats& getStats() const { return stats; }
+
+  // > 0 if a should lead rather than b; the term salts ELECT_BY_RANDOM
+  static int compareBids(const LeadershipBid& a, const LeadershipBid& b,
+                         LeadershipCriteria criteria, uint16_t term);
+
+private:
+  uint8_t selfMac[6];
+  LeadershipBid selfBid;
+  LeadershipCriteria criteria;
+  LeaderRole role;
+  uint16_t term;
+  uint16_t bidTerm;               // Term we last sent a candidacy for
+  uint8_t leaderMac[6];
+  uint8_t formerLeader[6];        // Leader we followed before the current election
+  LeadershipBid bestBid;          // Best bid heard this term
+  unsigned long leaseExpiry;
+  unsigned long electionDeadline;
+  unsigned long lastHeartbeat;
+  unsigned long electionStart;    // 0 = not in an election
+  uint8_t pending;                // LeaderMessageType to send next
+  LeaderChangeListener changeListener;
+  LeaderElectionStats stats;
+
+  void adoptTerm(uint16_t newTerm, LeadershipCriteria newCriteria);
+  void becomeCandidate(unsigned long now);
+  void becomeLeader(unsigned long now);
+  void followLeader(const uint8_t* mac, unsigned long leaseMs, unsigned long now);
+  void setLeader(const uint8_t* mac, unsigned long now);
+  void considerBid(const LeadershipBid& bid);
+  static void bidFromMessage(const uint8_t* mac, const LeaderElectionPayload& message, LeadershipBid& bid);
+};
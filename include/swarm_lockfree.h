@@ -0,0 +1,129 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <type_traits>
+
+// ═══════════════════════════════════════════════════════════
+// 🔒 LOCK-FREE SHARED STATE PRIMITIVES
+// ═══════════════════════════════════════════════════════════
+// Safe hand-off between exactly one producer (ISR, Wi-Fi callback or
+// task) and exactly one consumer, without disabling interrupts.
+
+#define SWARM_FORCE_INLINE inline __attribute__((always_inline))
+
+// ═══════════════════════════════════════════════════════════
+// 📮 SPSC SLOT - LATEST VALUE MAILBOX
+// ═══════════════════════════════════════════════════════════
+// Double-buffered seqlock: the producer always writes the buffer the
+// consumer is NOT reading, so the consumer only retries if two whole
+// publishes land during one copy. The producer never waits.
+
+template <typename T>
+class SpscSlot {
+  static_assert(std::is_trivially_copyable<T>::value, "SpscSlot needs a POD payload");
+
+private:
+  T buffers[2];
+  std::atomic<uint32_t> sequence{0};   // Newest value lives in buffers[sequence & 1]
+
+public:
+  // Producer only (inlined so it is safe to call from an IRAM ISR)
+  SWARM_FORCE_INLINE void publish(const T& value) {
+    uint32_t next = sequence.load(std::memory_order_relaxed) + 1;
+    std::atomic_thread_fence(std::memory_order_release);
+    buffers[next & 1] = value;
+    sequence.store(next, std::memory_order_release);
+  }
+
+  // Consumer only: copy the newest value, returns its sequence (0 = never published)
+  uint32_t read(T& out) const {
+    uint32_t before, after;
+    do {
+      before = sequence.load(std::memory_order_acquire);
+      if (before == 0) return 0;
+      out = buffers[before & 1];
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = sequence.load(std::memory_order_relaxed);
+    } while (after != before);
+    return before;
+  }
+
+  // Consumer only: copy the newest value only if it is newer than lastSeen
+  bool readIfNew(T& out, uint32_t& lastSeen) const {
+    if (sequence.load(std::memory_order_acquire) == lastSeen) return false;
+    uint32_t seq = read(out);
+    if (seq == lastSeen) return false;
+    lastSeen = seq;
+    return true;
+  }
+
+  uint32_t getSequence() const {
+    return sequence.load(std::memory_order_acquire);
+  }
+};
+
+// ═══════════════════════════════════════════════════════════
+// 🔁 SPSC RING - BOUNDED FIFO
+// ═══════════════════════════════════════════════════════════
+// Classic head/tail ring. N must be a power of two; one slot is never
+// wasted because head and tail are free-running counters. push() fails
+// (and the caller counts a drop) instead of blocking when full.
+
+template <typename T, size_t N>
+class SpscRing {
+  static_assert((N & (N - 1)) == 0, "SpscRing size must be a power of two");
+  static_assert(std::is_trivially_copyable<T>::value, "SpscRing needs a POD payload");
+
+private:
+  T items[N];
+  std::atomic<uint32_t> head{0};   // Written by producer only
+  std::atomic<uint32_t> tail{0};   // Written by consumer only
+
+public:
+  // Producer only
+  SWARM_FORCE_INLINE bool push(const T& item) {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) >= N) return false;
+    items[h & (N - 1)] = item;
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Producer only: fill the next slot in place (avoids a second copy of large items)
+  template <typename Fill>
+  SWARM_FORCE_INLINE bool emplace(Fill fill) {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) >= N) return false;
+    fill(items[h & (N - 1)]);
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer only
+  bool pop(T& out) {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire)) return false;
+    out = items[t & (N - 1)];
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer only: look at the oldest item without copying, then release()
+  const T* peek() const {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire)) return nullptr;
+    return &items[t & (N - 1)];
+  }
+
+  void release() {
+    tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  size_t size() const {
+    return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+  }
+
+  bool empty() const { return size() == 0; }
+  constexpr size_t capacity() const { return N; }
+};
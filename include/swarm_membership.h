@@ -0,0 +1,168 @@
+#pragma once
+
+#include <Arduino.h>
+#include "swarm_espnow.h"
+#include "swarm_peer_registry.h"
+
+// ═══════════════════════════════════════════════════════════
+// 🗣️ GOSSIP MEMBERSHIP (LARGE SWARMS)
+// ═══════════════════════════════════════════════════════════
+// All-to-all discovery and status broadcasts cost every bot O(N) frames
+// per interval. Past MAX_SWARM_PEERS members the swarm switches to
+// gossip instead:
+// - Every member owns a heartbeat (bumped each round) and a status
+//   version (bumped when its status changes); nobody else writes them
+// - Each round a bot sends a digest {MAC, heartbeat, status version} to
+//   1 + log2(N) targets (at most GOSSIP_MAX_FANOUT), picked from its
+//   neighbour set: the GOSSIP_NEIGHBOUR_COUNT strongest-RSSI bots it
+//   hears directly, plus one random direct bot for mixing
+// - The receiver adopts newer heartbeats, pushes back full status for
+//   anything the sender is missing or has stale (MSG_GOSSIP_UPDATE), and
+//   answers with its own digest only if it is missing something itself
+// Per-bot load is O(log N) frames per round; news reaches the whole
+// swarm in O(log N) rounds. A member whose heartbeat has not advanced
+// for GOSSIP_FAIL_TIMEOUT_MS is marked failed and kept, so stale gossip
+// cannot resurrect it, for GOSSIP_CLEANUP_MS more.
+//
+// Member state lives in one pool sized by begin(); MACs are indexed by
+// a private SwarmPeerRegistry of the same capacity. Comms core only.
+
+#define GOSSIP_INTERVAL 1000            // Gossip round period (ms)
+#define GOSSIP_MAX_FANOUT 4             // Digests sent per round, at most
+#define GOSSIP_NEIGHBOUR_COUNT MAX_SWARM_PEERS // Neighbour set size (strongest RSSI)
+#define GOSSIP_MIN_NEIGHBOURS 2         // Keep broadcasting discovery below this
+#define GOSSIP_DIRECT_TIMEOUT_MS PEER_TIMEOUT // Not heard directly since: not a neighbour
+#define GOSSIP_FAIL_TIMEOUT_MS 15000    // Heartbeat stalled this long: failed
+#define GOSSIP_CLEANUP_MS 30000         // Failed members are forgotten after this
+#define GOSSIP_MODE_HOLD_MS 30000       // Stay in gossip mode this long after hearing gossip
+#define GOSSIP_RSSI_UNKNOWN -127
+
+#define GOSSIP_DIGEST_REPLY 0x01        // Digest flag: answer to a digest, do not answer again
+
+struct GossipStatus {
+  uint8_t botType;                      // BotType
+  uint8_t role;                         // SwarmRole
+  uint16_t generation;
+  uint16_t fitness;                     // fitnessScore * 1000
+  uint8_t reputation;                   // Self-profile reputation, 0-100
+  uint8_t health;                       // BotHealth
+} __attribute__((packed));
+
+struct GossipDigestEntry {
+  uint8_t mac[6];
+  uint16_t heartbeat;
+  uint8_t statusVersion;                // 0 = no status known
+} __attribute__((packed));
+
+struct GossipUpdateEntry {
+  uint8_t mac[6];
+  uint16_t heartbeat;
+  uint8_t statusVersion;
+  GossipStatus status;
+} __attribute__((packed));
+
+#define GOSSIP_DIGEST_HEADER_SIZE 3
+#define GOSSIP_MAX_DIGEST_ENTRIES ((SWARM_MAX_PAYLOAD_SIZE - GOSSIP_DIGEST_HEADER_SIZE) / sizeof(GossipDigestEntry))
+#define GOSSIP_MAX_UPDATE_ENTRIES ((SWARM_MAX_PAYLOAD_SIZE - 1) / sizeof(GossipUpdateEntry))
+
+// MSG_GOSSIP_DIGEST payload; only entryCount entries are sent
+struct GossipDigestPayload {
+  uint8_t flags;                        // GOSSIP_DIGEST_*
+  uint8_t memberCount;                  // Live members the sender knows (may exceed entryCount)
+  uint8_t entryCount;
+  GossipDigestEntry entries[GOSSIP_MAX_DIGEST_ENTRIES];
+} __attribute__((packed));
+
+// MSG_GOSSIP_UPDATE payload; only entryCount entries are sent
+struct GossipUpdatePayload {
+  uint8_t entryCount;
+  GossipUpdateEntry entries[GOSSIP_MAX_UPDATE_ENTRIES];
+} __attribute__((packed));
+
+enum GossipMemberState : uint8_t {
+  MEMBER_FREE = 0,
+  MEMBER_ALIVE,
+  MEMBER_FAILED                         // Tombstone until GOSSIP_CLEANUP_MS
+};
+
+struct GossipMember {
+  uint16_t heartbeat;
+  uint8_t statusVersion;
+  GossipMemberState state;
+  GossipStatus status;
+  uint32_t lastAdvance;                 // Local millis() when heartbeat last moved
+  uint32_t lastDirect;                  // Local millis() when last heard over the air
+  int8_t rssi;                          // Smoothed, GOSSIP_RSSI_UNKNOWN if never heard
+  bool isNeighbour;
+};
+
+struct GossipStats {
+  uint32_t rounds;
+  uint32_t digestsSent;
+  uint32_t digestsReceived;
+  uint32_t updatesSent;
+  uint32_t entriesApplied;              // Status entries that were news
+  uint32_t membersFailed;
+};
+
+// Called when a member's status changed (mac, status)
+typedef void (*GossipStatusListener)(const uint8_t* mac, const GossipStatus& status);
+
+class SwarmMembership {
+public:
+  SwarmMembership();
+  ~SwarmMembership();
+
+  bool begin(const uint8_t* selfMac, uint8_t capacity = MAX_SWARM_MEMBERS);
+  void setStatusListener(GossipStatusListener listener) { statusListener = listener; }
+
+  // Own status; the version only moves when something actually changed
+  void setSelfStatus(const GossipStatus& status);
+
+  // Every frame heard over the air: liveness and link quality
+  void observeDirect(const uint8_t* mac, int8_t rssi);
+
+  // Start a round: bump our heartbeat, expire members, refresh the
+  // neighbour set. Returns how many digest targets were written.
+  uint8_t beginRound(uint8_t targets[][6], uint8_t maxTargets);
+
+  // Payload builders/mergers; lengths are payload bytes
+  size_t buildDigest(GossipDigestPayload& digest, uint8_t flags);
+  // Merges heartbeats and fills update with what the sender lacks.
+  // Returns true if the sender knows something we do not (send a reply digest).
+  bool mergeDigest(const GossipDigestPayload& digest, size_t length,
+                   GossipUpdatePayload& update, size_t& updateLength);
+  void mergeUpdate(const GossipUpdatePayload& update, size_t length);
+
+  // Large swarm, or a peer is gossiping at us: use gossip instead of broadcasts
+  bool isGossipMode() const;
+  bool isNeighbour(const uint8_t* mac) const;
+  int8_t getRssi(const uint8_t* mac) const;  // Smoothed, GOSSIP_RSSI_UNKNOWN if never heard
+  uint8_t getMemberCount() const { return aliveCount; }
+  uint8_t getNeighbourCount() const { return neighbourCount; }
+  const GossipStats& getStats() const { return stats; }
+  void printMembers() const;
+
+private:
+  SwarmPeerRegistry* index;
+  GossipMember* members;                // Pool, indexed by the private PeerId
+  uint8_t capacity;
+  PeerId selfId;
+  uint8_t aliveCount;
+  uint8_t neighbourCount;
+  uint8_t digestCursor;                 // Rotates partial digests over all members
+  uint8_t updateCursor;
+  unsigned long lastGossipHeard;
+  GossipStatusListener statusListener;
+  GossipStats stats;
+
+  static bool isNewer(uint16_t a, uint16_t b) { return (int16_t)(a - b) > 0; }
+  static bool isNewerVersion(uint8_t a, uint8_t b);
+
+  PeerId lookup(const uint8_t* mac, bool create);
+  void markAlive(PeerId id);
+  bool mergeHeartbeat(PeerId id, uint16_t heartbeat);
+  void expireMembers();
+  void selectNeighbours();
+  bool appendUpdate(GossipUpdatePayload& update, PeerId id) const;
+};
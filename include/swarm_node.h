@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Arduino.h>
+#include "swarm_espnow.h"
+#include "swarm_peer_registry.h"
+#include "swarm_spatial.h"
+
+class SwarmEcosystemManager;
+struct ContextDetectionState;
+struct SwarmIntelligenceState;
+
+// ═══════════════════════════════════════════════════════════
+// 🤖 SWARM NODE - PER-BOT STATE OF THE SHARED MODULES
+// ═══════════════════════════════════════════════════════════
+// Everything the shared swarm modules (peer registry, spatial index,
+// ecosystem, context detection, swarm intelligence) keep per bot lives in one SwarmNode,
+// reached through swarmNode:
+// - The firmware has one node, set up before setup() runs
+// - The simulator owns one per virtual bot and points swarmNode at the
+//   bot whose code it is about to run, next to halSetNode()
+// State that only one module knows about is created by that module on
+// first use and freed with the node.
+
+// What the modules need to know about the bot itself (leadership bids,
+// vote weights, frame headers). The firmware fills it from its genome
+// and peer table; nothing in the modules writes it.
+struct SwarmSelfReport {
+  BotType botType;
+  uint16_t generation;
+  float fitness;
+  uint16_t strategiesLearned;
+  uint8_t activePeers;                      // Heard from within PEER_TIMEOUT
+};
+
+struct SwarmNode {
+  SwarmSelfReport self;
+  SwarmPeerRegistry peerRegistry;
+  SwarmSpatialIndex spatialIndex;
+  SwarmEcosystemManager* ecosystem;         // initializeEcosystemManager()
+  ContextDetectionState* context;           // context_detection.cpp
+  SwarmIntelligenceState* intelligence;     // swarm_intelligence.cpp
+
+  SwarmNode();
+  ~SwarmNode();
+  SwarmNode(const SwarmNode&) = delete;
+  SwarmNode& operator=(const SwarmNode&) = delete;
+};
+
+// The node whose code is running; never null
+extern SwarmNode* swarmNode;
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ═══════════════════════════════════════════════════════════
+// 🗂️ CANONICAL PEER REGISTRY (MAC → COMPACT PEER ID)
+// ═══════════════════════════════════════════════════════════
+// Every subsystem that tracks peers (swarm peers, localization, signal
+// learning, ecosystem profiles and trust) indexes its own arrays by the
+// PeerId handed out here instead of scanning MACs:
+// - Open-addressed hash of the MAC (linear probing, backward-shift
+//   deletion), so lookup cost does not grow with the peer count
+// - Ids are stable until released; a full registry reclaims the least
+//   recently seen id once it has been quiet for PEER_RECLAIM_AFTER_MS,
+//   and release listeners reset their per-id state
+// - With a retention rank set, a full registry with nobody quiet that
+//   long evicts the lowest-ranked id (stalest among equals) for a
+//   newcomer that ranks higher, so a later, stronger neighbour is not
+//   locked out by whoever happened to be heard first
+// Not thread-safe: on SPEEDIE it belongs to the comms core.
+//
+// Storage is one block sized by the constructor, so other tables keyed
+// by MAC (e.g. swarm_membership.h) can run their own instance with a
+// different capacity. Each SwarmNode's peerRegistry is PEER_REGISTRY_CAPACITY.
+
+#define PEER_REGISTRY_CAPACITY 32     // Peer ids 0..31 (self included)
+#define PEER_REGISTRY_MAX_CAPACITY 64 // Largest capacity any instance may ask for
+#define PEER_RECLAIM_AFTER_MS 60000   // Quiet time before an id may be reused
+#define PEER_MAX_RELEASE_LISTENERS 4
+
+typedef int8_t PeerId;
+#define INVALID_PEER_ID ((PeerId)-1)
+
+typedef void (*PeerReleaseListener)(PeerId id);
+// How much a MAC is worth keeping when the registry is full; higher wins,
+// PEER_RANK_KEEP is never evicted
+typedef int16_t (*PeerRetentionRank)(const uint8_t* mac);
+#define PEER_RANK_KEEP INT16_MAX
+
+class SwarmPeerRegistry {
+private:
+  uint8_t capacity;
+  uint8_t slotMask;                     // Slot count - 1 (power of two, >= 2 * capacity)
+  uint8_t (*macs)[6];
+  uint32_t* lastSeen;
+  bool* used;
+  int8_t* slots;                        // Peer id, -1 = empty
+  uint8_t count;
+
+  PeerReleaseListener listeners[PEER_MAX_RELEASE_LISTENERS];
+  uint8_t listenerCount;
+  PeerRetentionRank retentionRank;
+
+  static uint32_t hashMac(const uint8_t* mac);
+  int findSlot(const uint8_t* mac) const;
+  PeerId reclaimOldest();
+  PeerId evictWeakest(const uint8_t* newcomer);
+
+public:
+  explicit SwarmPeerRegistry(uint8_t capacity = PEER_REGISTRY_CAPACITY);
+  ~SwarmPeerRegistry();
+  SwarmPeerRegistry(const SwarmPeerRegistry&) = delete;
+  SwarmPeerRegistry& operator=(const SwarmPeerRegistry&) = delete;
+
+  PeerId find(const uint8_t* mac) const;
+  // Registers unknown MACs; also marks the peer as seen now
+  PeerId findOrAdd(const uint8_t* mac);
+  void touch(PeerId id);
+  void release(PeerId id);
+
+  bool isValid(PeerId id) const { return id >= 0 && id < capacity && used[id]; }
+  const uint8_t* getMac(PeerId id) const { return isValid(id) ? macs[id] : nullptr; }
+  uint32_t getLastSeen(PeerId id) const { return isValid(id) ? lastSeen[id] : 0; }
+  uint8_t getCount() const { return count; }
+  uint8_t getCapacity() const { return capacity; }
+
+  // Called with the id before it is freed, e.g. to clear a trust row
+  bool addReleaseListener(PeerReleaseListener listener);
+  // Lets findOrAdd() evict when full; without it only quiet ids are reclaimed
+  void setRetentionRank(PeerRetentionRank rank) { retentionRank = rank; }
+};
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Preferences.h>
+
+// ═══════════════════════════════════════════════════════════
+// 💾 INCREMENTAL PERSISTENT STORE (NVS-BACKED)
+// ═══════════════════════════════════════════════════════════
+// Replaces whole-image EEPROM.commit() writes:
+// - One NVS key per record (genome, metrics, each strategy, each word),
+//   so a change rewrites only that record. NVS is log-structured and
+//   spreads writes across all pages of its partition (wear levelling)
+// - Every record carries a CRC32 trailer; corrupt or truncated records
+//   fail load() instead of restoring garbage
+// - stage() only compares CRCs and marks the record dirty; flash is
+//   touched later, by flush(), within a time budget
+// Records point at caller-owned memory that must stay valid and must
+// only be changed by the task that calls stage()/flush().
+//
+// Image layout: each namespace holds a manifest ("toc" key) with a
+// schema version and one entry per record written (key hash, length,
+// layout version). begin() validates the manifest in one read; load()
+// then reads a record only if the manifest says its layout matches the
+// running firmware, so a changed struct is never reinterpreted. Bump a
+// record's version when its struct changes, or the schema version to
+// drop the whole namespace.
+
+#define STORE_MAX_RECORDS 96
+#define STORE_KEY_LENGTH 16          // NVS limit: 15 characters + NUL
+#define STORE_MAX_RECORD_SIZE 128    // Largest single record payload
+#define STORE_MANIFEST_MAGIC 0x4A4D4253 // "JMBS"
+#define STORE_FORMAT_VERSION 1
+
+struct StoreRecord {
+  char key[STORE_KEY_LENGTH];
+  uint32_t keyHash;
+  void* data;
+  uint16_t length;
+  uint8_t version;                   // Layout version of the struct behind data
+  uint32_t storedCrc;                // CRC of what is on flash
+  unsigned long dirtySince;          // millis() when first staged
+  bool stored;                       // storedCrc is valid
+  bool dirty;
+};
+
+struct StoreManifestHeader {
+  uint32_t magic;
+  uint8_t formatVersion;             // This file's on-flash format
+  uint8_t reserved;
+  uint16_t schemaVersion;            // Owner's namespace-wide version
+  uint16_t entryCount;
+  uint16_t reserved2;
+  uint32_t entriesCrc;
+} __attribute__((packed));
+
+struct StoreManifestEntry {
+  uint32_t keyHash;
+  uint16_t length;
+  uint8_t version;
+  uint8_t reserved;
+} __attribute__((packed));
+
+// Stored as one blob: header followed by entryCount entries
+struct StoreManifest {
+  StoreManifestHeader header;
+  StoreManifestEntry entries[STORE_MAX_RECORDS];
+} __attribute__((packed));
+
+enum StoreManifestState : uint8_t {
+  MANIFEST_MISSING,                  // Namespace never written (fresh or pre-manifest)
+  MANIFEST_VALID,
+  MANIFEST_SCHEMA_CHANGED,           // Written by firmware with another schema
+  MANIFEST_CORRUPT
+};
+
+struct StoreStats {
+  uint32_t writes;
+  uint32_t bytesWritten;
+  uint32_t unchangedSkips;           // stage() calls that found nothing new
+  uint32_t loadFailures;             // Short or CRC-mismatched records
+  uint32_t layoutMismatches;         // Records skipped because their layout changed
+  uint32_t writeErrors;
+  uint32_t maxFlushUs;
+};
+
+class SwarmPersistentStore {
+public:
+  SwarmPersistentStore();
+
+  // Opens the namespace and validates its manifest (one NVS read)
+  bool begin(const char* nameSpace, uint16_t schemaVersion);
+  bool isOpen() const { return opened; }
+  StoreManifestState getManifestState() const { return manifestState; }
+
+  // Register a record; returns its id or -1. Does not touch flash.
+  int addRecord(const char* key, void* data, size_t length, uint8_t version = 1);
+
+  // Flash -> destination (the record's own data by default). Returns false,
+  // leaving destination untouched, if absent, stale or corrupt.
+  bool load(int record, void* destination = nullptr);
+  bool isStored(int record) const;
+
+  // Mark the record dirty if its data differs from flash. No flash I/O.
+  bool stage(int record);
+
+  // Write dirty records (oldest first) until budgetUs is spent; at least
+  // one record is written per call. Returns records still dirty.
+  size_t flush(uint32_t budgetUs);
+  size_t flushAll() { return flush(UINT32_MAX); }
+
+  size_t getDirtyCount() const;
+  unsigned long getOldestDirtyAge() const;   // ms, 0 if nothing dirty
+  size_t getRecordCount() const { return recordCount; }
+  const StoreStats& getStats() const { return stats; }
+  void printStats() const;
+
+private:
+  Preferences prefs;
+  bool opened;
+  StoreRecord records[STORE_MAX_RECORDS];
+  int recordCount;
+  uint8_t scratch[STORE_MAX_RECORD_SIZE + sizeof(uint32_t)];
+  StoreStats stats;
+
+  StoreManifest manifest;
+  StoreManifestState manifestState;
+  bool manifestDirty;
+
+  static uint32_t checksum(const void* data, size_t length);
+  int oldestDirty() const;
+  bool writeRecord(StoreRecord& record);
+
+  void readManifest(uint16_t schemaVersion);
+  int findManifestEntry(uint32_t keyHash) const;
+  void updateManifestEntry(const StoreRecord& record);
+  bool writeManifest();
+};
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ═══════════════════════════════════════════════════════════
+// ⏱️ COOPERATIVE TASK SCHEDULER
+// ═══════════════════════════════════════════════════════════
+// Fixed-rate, non-preemptive scheduler driven by micros().
+// Every task must return quickly (no delay()) - long behaviours are
+// written as tick-driven state machines that remember their phase and
+// deadline between calls. Per-task timing stats make the achieved loop
+// rate measurable from the serial console.
+
+#define MAX_SCHEDULED_TASKS 10
+
+typedef void (*ScheduledTaskFn)();
+
+struct ScheduledTask {
+  const char* name;
+  ScheduledTaskFn fn;
+  uint32_t periodUs;          // Desired period between runs
+  uint32_t nextRunUs;         // Next release time (micros)
+  uint32_t lastRuntimeUs;     // How long the last run took
+  uint32_t maxRuntimeUs;      // Worst-case runtime since last reset
+  uint32_t maxLatenessUs;     // Worst release jitter since last reset
+  uint32_t runCount;
+  uint32_t overrunCount;      // Runs that missed their next release
+  bool enabled;
+};
+
+class CooperativeScheduler {
+private:
+  ScheduledTask tasks[MAX_SCHEDULED_TASKS];
+  int taskCount = 0;
+
+public:
+  // Register a task, returns its id or -1 if the table is full
+  int addTask(const char* name, ScheduledTaskFn fn, uint32_t periodMs) {
+    if (taskCount >= MAX_SCHEDULED_TASKS || fn == nullptr) return -1;
+
+    ScheduledTask& t = tasks[taskCount];
+    t.name = name;
+    t.fn = fn;
+    t.periodUs = periodMs * 1000UL;
+    t.nextRunUs = micros();
+    t.lastRuntimeUs = 0;
+    t.maxRuntimeUs = 0;
+    t.maxLatenessUs = 0;
+    t.runCount = 0;
+    t.overrunCount = 0;
+    t.enabled = true;
+    return taskCount++;
+  }
+
+  void setEnabled(int id, bool enabled) {
+    if (id < 0 || id >= taskCount) return;
+    if (enabled && !tasks[id].enabled) tasks[id].nextRunUs = micros();
+    tasks[id].enabled = enabled;
+  }
+
+  // Run every task that is due, in registration order (= priority order)
+  void run() {
+    for (int i = 0; i < taskCount; i++) {
+      ScheduledTask& t = tasks[i];
+      if (!t.enabled) continue;
+
+      uint32_t start = micros();
+      int32_t lateness = (int32_t)(start - t.nextRunUs);
+      if (lateness < 0) continue;
+
+      t.fn();
+
+      uint32_t end = micros();
+      t.lastRuntimeUs = end - start;
+      if (t.lastRuntimeUs > t.maxRuntimeUs) t.maxRuntimeUs = t.lastRuntimeUs;
+      if ((uint32_t)lateness > t.maxLatenessUs) t.maxLatenessUs = lateness;
+      t.runCount++;
+
+      // Keep a fixed release grid; if we fell a whole period behind,
+      // count the overrun and resynchronise instead of bursting
+      t.nextRunUs += t.periodUs;
+      if ((int32_t)(end - t.nextRunUs) >= 0) {
+        t.overrunCount++;
+        t.nextRunUs = end + t.periodUs;
+      }
+    }
+  }
+
+  int getTaskCount() const { return taskCount; }
+
+  const ScheduledTask* getTask(int id) const {
+    return (id >= 0 && id < taskCount) ? &tasks[id] : nullptr;
+  }
+
+  void resetStats() {
+    for (int i = 0; i < taskCount; i++) {
+      tasks[i].maxRuntimeUs = 0;
+      tasks[i].maxLatenessUs = 0;
+      tasks[i].runCount = 0;
+      tasks[i].overrunCount = 0;
+    }
+  }
+
+  void printStats() const {
+    Serial.println("⏱️ Scheduler stats (period / runs / max run / max late / overruns):");
+    for (int i = 0; i < taskCount; i++) {
+      const ScheduledTask& t = tasks[i];
+      Serial.printf("  %-10s %6luus %8lu %6luus %6luus %5lu\n",
+                    t.name, (unsigned long)t.periodUs, (unsigned long)t.runCount,
+                    (unsigned long)t.maxRuntimeUs, (unsigned long)t.maxLatenessUs,
+                    (unsigned long)t.overrunCount);
+    }
+  }
+};
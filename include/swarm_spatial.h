@@ -0,0 +1,85 @@
+#pragma once
+
+#include <Arduino.h>
+#include "swarm_peer_registry.h"
+
+// ═══════════════════════════════════════════════════════════
+// 🗺️ SWARM SPATIAL INDEX - UNIFORM GRID OF THE ARENA
+// ═══════════════════════════════════════════════════════════
+// One grid shared by exploration, formation and localization code so
+// spatial questions are answered from the cells around a point instead
+// of scanning every zone, slot or peer:
+// - Coverage: one explored bit per cell, one 32-bit word per row
+// - Peers: spatial hash of PeerId by cell (buckets chained through the
+//   per-peer arrays), searched in rings outward from the query point
+// - Zones: a 16-bit zone mask per block of cells, checked exactly only
+//   for the zones a rectangle's blocks mention
+// Coordinates are the swarm's position units (cm), origin at the centre
+// of the arena. Points outside the arena clamp to the edge cells.
+// Not thread-safe: on SPEEDIE it belongs to the comms core.
+
+#define SPATIAL_CELL_SIZE 50.0f          // cm per cell side
+#define SPATIAL_GRID_DIM 32              // Cells per side (16 m arena); one row = one uint32_t
+#define SPATIAL_ZONE_BLOCK 4             // Cells per side of a zone-mask block
+#define SPATIAL_ZONE_DIM (SPATIAL_GRID_DIM / SPATIAL_ZONE_BLOCK)
+#define SPATIAL_MAX_ZONES 16             // Matches MAX_EXPLORATION_ZONES
+#define SPATIAL_PEER_BUCKETS 32          // Power of two
+
+struct SpatialRect {
+  float minX, minY;
+  float maxX, maxY;
+};
+
+class SwarmSpatialIndex {
+public:
+  SwarmSpatialIndex();
+  void clear();
+
+  // === COVERAGE ===
+  void markExplored(float x, float y);
+  void markExplored(const SpatialRect& rect);
+  bool isExplored(float x, float y) const;
+  float exploredFraction(const SpatialRect& rect) const;
+  // Centre of the closest unexplored cell; false when everything is explored
+  bool nearestUnexplored(float x, float y, float& outX, float& outY) const;
+  const uint32_t* exploredRows() const { return explored; }
+  // OR a row in (shared coverage); returns the bits that were news
+  uint32_t mergeExploredRow(uint8_t row, uint32_t bits);
+
+  // === PEERS (keyed by PeerId) ===
+  void updatePeer(PeerId id, float x, float y);
+  void removePeer(PeerId id);
+  bool hasPeer(PeerId id) const { return id >= 0 && id < PEER_REGISTRY_CAPACITY && peerCell[id] >= 0; }
+  // Closest tracked peer within maxRange (cm), INVALID_PEER_ID if none
+  PeerId nearestPeer(float x, float y, float maxRange, PeerId exclude = INVALID_PEER_ID) const;
+  uint8_t peersInRect(const SpatialRect& rect, PeerId* out, uint8_t maxOut) const;
+
+  // === ZONES (keyed by zone index) ===
+  void setZone(uint8_t zone, const SpatialRect& rect);
+  void clearZone(uint8_t zone);
+  // Bitmask of zones whose rectangle intersects rect
+  uint16_t zonesOverlapping(const SpatialRect& rect) const;
+
+  static void cellOf(float x, float y, int& cx, int& cy);
+  static void cellCenter(int cx, int cy, float& x, float& y);
+
+private:
+  uint32_t explored[SPATIAL_GRID_DIM];
+
+  int8_t peerBuckets[SPATIAL_PEER_BUCKETS];
+  int8_t peerNext[PEER_REGISTRY_CAPACITY];
+  int16_t peerCell[PEER_REGISTRY_CAPACITY];   // cy * DIM + cx, -1 = not tracked
+  float peerX[PEER_REGISTRY_CAPACITY];
+  float peerY[PEER_REGISTRY_CAPACITY];
+
+  uint16_t zoneMasks[SPATIAL_ZONE_DIM][SPATIAL_ZONE_DIM];
+  SpatialRect zoneRects[SPATIAL_MAX_ZONES];
+  uint16_t activeZones;
+
+  static uint8_t bucketOf(int16_t cell);
+  static uint32_t rowMask(int minX, int maxX);
+  static bool intersects(const SpatialRect& a, const SpatialRect& b);
+  static void cellRange(const SpatialRect& rect, int& minX, int& minY, int& maxX, int& maxY);
+  void unlinkPeer(PeerId id);
+  void addZoneMask(uint8_t zone, const SpatialRect& rect, bool set);
+};
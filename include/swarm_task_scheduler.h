@@ -0,0 +1,159 @@
+#pragma once
+
+#include <Arduino.h>
+#include "swarm_espnow.h"
+#include "swarm_peer_registry.h"
+
+// ═══════════════════════════════════════════════════════════
+// 🎯 SWARM TASK SCHEDULER
+// ═══════════════════════════════════════════════════════════
+// Tasks live in fixed slots; nothing walks the slot array:
+// - Lookup by id goes through a small open-addressed id → slot table
+// - Every live task sits in a min-heap keyed by its deadline (for a
+//   finished task: when its slot is recycled), so expiry only looks at
+//   the tasks that are actually due
+// - Pending tasks are a bit per slot; assignPending() hands them all out
+//   in one pass per tick, highest priority first, scoring each candidate
+//   by trust x capability, less a penalty per task it already holds
+// A task whose deadline passes before it completes goes back to pending
+// with a fresh deadline, up to MAX_TASK_RETRIES times, avoiding the bot
+// that let it lapse; after that it fails.
+// Not thread-safe: one task owns it.
+
+enum TaskCategory {
+  TASK_CAT_EXPLORATION = 0x01,    // Area exploration tasks
+  TASK_CAT_SURVEILLANCE = 0x02,   // Monitoring and patrol
+  TASK_CAT_RESCUE = 0x03,         // Search and rescue ops
+  TASK_CAT_MAINTENANCE = 0x04,    // System maintenance
+  TASK_CAT_LEARNING = 0x05,       // Collaborative learning
+  TASK_CAT_EMERGENCY = 0x06       // Emergency response
+};
+
+enum TaskStatus {
+  TASK_STATUS_PENDING = 0x01,     // Waiting for assignment
+  TASK_STATUS_ASSIGNED = 0x02,    // Assigned to bot
+  TASK_STATUS_ACTIVE = 0x03,      // Currently executing
+  TASK_STATUS_COMPLETED = 0x04,   // Successfully completed
+  TASK_STATUS_FAILED = 0x05,      // Failed or aborted
+  TASK_STATUS_CANCELLED = 0x06    // Cancelled by coordinator
+};
+
+struct SwarmTask {
+  uint16_t taskId;                // Unique task identifier
+  TaskCategory category;          // Task category
+  TaskType taskType;              // Specific task type
+  uint8_t priority;               // Priority level (1-10)
+  uint8_t assignedBot[6];         // Assigned bot MAC
+  uint8_t requesterBot[6];        // Bot that requested task
+  TaskStatus status;              // Current status
+  uint32_t createdTime;           // Creation timestamp
+  uint32_t deadlineTime;          // Deadline timestamp
+  uint32_t startTime;             // Start execution time
+  uint32_t completionTime;        // Completion timestamp
+  float parameters[8];            // Task-specific parameters
+  uint8_t progressPercent;        // Progress (0-100%)
+  uint8_t retryCount;             // Number of retries
+  bool requiresConfirmation;      // Needs completion confirmation
+};
+
+#define MAX_SWARM_TASKS 32          // One bit per slot in the pending mask
+#define TASK_TIMEOUT 30000          // 30 second task timeout
+#define MAX_TASK_RETRIES 3
+#define TASK_RETAIN_MS 5000         // Finished tasks stay readable this long
+#define TASK_ID_BUCKETS 64          // Power of two, >= 2 * MAX_SWARM_TASKS
+#define TASK_NO_SLOT 0xFF
+#define TASK_LOAD_PENALTY 0.5f      // Score divisor grows by this per task held
+#define TASK_RETRY_PENALTY 0.25f    // Score factor for the bot that let the task lapse
+
+// One bot that may take work this tick
+struct TaskCandidate {
+  PeerId peer;
+  BotType botType;
+  float suitability;              // 0-1 from trust and reputation; < 0 = never assign
+};
+
+struct TaskAssignment {
+  uint16_t taskId;
+  PeerId peer;
+};
+
+struct TaskSchedulerStats {
+  uint32_t created;
+  uint32_t assigned;
+  uint32_t completed;
+  uint32_t retried;               // Deadline passed, back to pending
+  uint32_t failed;                // Out of retries, or reported failed
+  uint32_t rejected;              // create() with every slot busy
+};
+
+// Called when a deadline passes: the task is pending again or has failed
+typedef void (*TaskExpiredListener)(const SwarmTask& task);
+
+class SwarmTaskScheduler {
+public:
+  SwarmTaskScheduler();
+
+  void setExpiredListener(TaskExpiredListener listener) { expiredListener = listener; }
+
+  // nullptr if every slot is busy
+  SwarmTask* create(TaskCategory category, TaskType type, uint8_t priority,
+                    const uint8_t* requesterMac, unsigned long now);
+  SwarmTask* find(uint16_t taskId);
+  const SwarmTask* find(uint16_t taskId) const;
+
+  // Manual assignment of one pending task
+  bool assign(uint16_t taskId, PeerId peer, const uint8_t* botMac, unsigned long now);
+  bool reportProgress(uint16_t taskId, uint8_t progressPercent, unsigned long now);
+  bool complete(uint16_t taskId, bool successful, unsigned long now);
+
+  // Retries, failures and slot recycling for every task that is due
+  void expire(unsigned long now);
+  // Hands out every pending task it can in one pass; returns how many
+  uint8_t assignPending(const TaskCandidate* candidates, uint8_t candidateCount,
+                        TaskAssignment* out, uint8_t maxOut, unsigned long now);
+
+  uint8_t getTaskCount() const { return taskCount; }
+  uint8_t getPendingCount() const;
+  uint8_t getCount(TaskStatus status) const { return statusCount[status]; }
+  uint8_t getHighPriorityCount() const { return highPriorityCount; }  // Priority >= 7, not finished
+  uint8_t getPeerLoad(PeerId peer) const;
+  const TaskSchedulerStats& getStats() const { return stats; }
+
+  // How well a bot type fits a task type, 0-1
+  static float capabilityFit(BotType botType, TaskType taskType);
+
+private:
+  SwarmTask tasks[MAX_SWARM_TASKS];
+  PeerId assignee[MAX_SWARM_TASKS];
+  PeerId lapsedBy[MAX_SWARM_TASKS];       // Assignee when the deadline last passed
+  uint8_t idTable[TASK_ID_BUCKETS];       // Slot, TASK_NO_SLOT = empty
+  uint8_t heap[MAX_SWARM_TASKS];          // Slots, earliest deadline first
+  uint8_t heapIndex[MAX_SWARM_TASKS];
+  uint8_t heapSize;
+  uint32_t freeMask;                      // Bit per free slot
+  uint32_t pendingMask;                   // Bit per pending slot
+  uint8_t taskCount;
+  uint8_t statusCount[TASK_STATUS_CANCELLED + 1];
+  uint8_t highPriorityCount;
+  uint8_t peerLoad[PEER_REGISTRY_CAPACITY];
+  uint16_t nextTaskId;
+  TaskExpiredListener expiredListener;
+  TaskSchedulerStats stats;
+
+  uint8_t slotOf(uint16_t taskId) const;
+  void idInsert(uint16_t taskId, uint8_t slot);
+  void idRemove(uint16_t taskId);
+
+  bool heapLess(uint8_t a, uint8_t b) const;
+  void heapSwap(uint8_t i, uint8_t j);
+  void heapUp(uint8_t i);
+  void heapDown(uint8_t i);
+  void heapPush(uint8_t slot);
+  void heapRemove(uint8_t slot);
+  void reschedule(uint8_t slot, uint32_t deadline);
+
+  void setStatus(uint8_t slot, TaskStatus status);
+  void setAssignee(uint8_t slot, PeerId peer);
+  void finish(uint8_t slot, TaskStatus status, unsigned long now);
+  void release(uint8_t slot);
+};
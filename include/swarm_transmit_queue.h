@@ -0,0 +1,110 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <esp_now.h>
+#include "swarm_espnow.h"
+
+// ═══════════════════════════════════════════════════════════
+// 📤 PRIORITY-AWARE ESP-NOW TRANSMIT QUEUE
+// ═══════════════════════════════════════════════════════════
+// All outbound frames go through here instead of esp_now_send():
+// - One FIFO per MessagePriority; the highest non-empty queue always
+//   transmits next, so MSG_EMERGENCY_STOP never waits behind heartbeats
+// - Exactly one frame in flight, paced by the send-complete callback
+// - Failed unicast frames go back to the head of their queue, at most
+//   MAX_RETRIES times (broadcasts are not acknowledged, never retried)
+// - A PRIORITY_LOW frame replaces an older queued frame of the same
+//   type to the same destination, so stale status/sensor data is never
+//   sent twice
+// enqueue()/service() belong to one task (the comms task);
+// onSendComplete() may be called from the Wi-Fi task.
+
+#define TX_POOL_SIZE 16            // Frames buffered across all priorities
+#define TX_PRIORITY_LEVELS 4       // PRIORITY_LOW .. PRIORITY_URGENT
+#define TX_SEND_TIMEOUT_MS 100     // Give up waiting for a lost send callback
+
+struct TxFrame {
+  uint8_t destMac[6];
+  uint8_t messageType;
+  uint8_t priority;
+  uint8_t retriesLeft;
+  uint8_t length;
+  uint8_t data[ESP_NOW_MAX_DATA_LEN];
+};
+
+struct TxQueueStats {
+  uint32_t enqueued;
+  uint32_t sent;          // Frames handed to esp_now_send()
+  uint32_t delivered;     // Send callback reported success
+  uint32_t failed;        // Gave up after retries
+  uint32_t retries;
+  uint32_t coalesced;     // Low-priority frames replaced in place
+  uint32_t dropped;       // Rejected or evicted because the pool was full
+  uint32_t timeouts;      // No send callback within TX_SEND_TIMEOUT_MS
+  uint32_t lateCallbacks; // Callbacks that answered no waiting send (ignored)
+  uint32_t maxQueued;
+};
+
+class SwarmTransmitQueue {
+public:
+  SwarmTransmitQueue();
+
+  // Copy a frame into the queue; priority comes from the header
+  // (MSG_EMERGENCY_STOP is always treated as PRIORITY_URGENT)
+  bool enqueue(const uint8_t* destMac, const void* frame, size_t length);
+
+  // Call from the esp_now send callback
+  void onSendComplete(const uint8_t* mac, esp_now_send_status_t status);
+
+  // Call often from the owning task: completes, retries and starts sends
+  void service();
+
+  size_t getQueuedCount() const;
+  size_t getQueuedCount(MessagePriority priority) const;
+  bool isIdle() const { return inFlight < 0 && getQueuedCount() == 0; }
+  const TxQueueStats& getStats() const { return stats; }
+  void printStats() const;
+
+private:
+  // In-flight slot; the Wi-Fi task may only move it out of SEND_PENDING
+  enum SendState : uint8_t {
+    SEND_IDLE = 0,                     // Nothing awaits a callback
+    SEND_PENDING,
+    SEND_OK,
+    SEND_FAILED
+  };
+
+  TxFrame pool[TX_POOL_SIZE];
+  uint8_t freeList[TX_POOL_SIZE];
+  uint8_t freeCount;
+
+  // Per-priority circular FIFOs of pool indices
+  uint8_t queues[TX_PRIORITY_LEVELS][TX_POOL_SIZE];
+  uint8_t queueHead[TX_PRIORITY_LEVELS];
+  uint8_t queueCount[TX_PRIORITY_LEVELS];
+
+  int inFlight;                        // Pool index being transmitted, -1 if idle
+  unsigned long inFlightSince;
+  std::atomic<uint8_t> sendState;      // SendState of the in-flight slot
+  uint8_t inFlightMac[6];              // Copy for the Wi-Fi task; pool slots get reused
+  std::atomic<uint32_t> inFlightSend;  // Number of the send in flight, 0 = none
+  uint32_t sendsAccepted;              // Sends esp_now_send() took (owning task)
+  std::atomic<uint32_t> callbacksSeen; // Send callbacks so far; resynced on a timeout
+  std::atomic<uint32_t> lateCallbacks;
+
+  TxQueueStats stats;
+
+  static bool isBroadcast(const uint8_t* mac);
+  static int priorityLevel(uint8_t priority);
+
+  int allocateFrame();
+  void freeFrame(int index);
+  bool evictLowestPriority(int belowLevel);
+  int findCoalescable(const uint8_t* destMac, uint8_t messageType);
+  void pushBack(int level, int index);
+  void pushFront(int level, int index);
+  int popFront(int level);
+  void startNextSend();
+  void completeInFlight(bool success);
+};
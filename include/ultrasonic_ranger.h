@@ -0,0 +1,68 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include "swarm_lockfree.h"
+
+// ═══════════════════════════════════════════════════════════
+// 📏 ASYNC HC-SR04 ULTRASONIC RANGER (INTERRUPT DRIVEN)
+// ═══════════════════════════════════════════════════════════
+// Replaces pulseIn(): update() fires the 10us trigger and expires
+// missed echoes, a CHANGE interrupt on the echo pin timestamps both
+// edges, and finished readings are handed to the control loop through
+// an SpscSlot. No call ever waits for the echo.
+
+#define ULTRASONIC_ECHO_TIMEOUT_US 30000   // ~5 m round trip, same as the old pulseIn timeout
+#define ULTRASONIC_DEFAULT_CYCLE_US 25000  // Minimum trigger spacing (lets stray echoes die out)
+
+struct RangeReading {
+  int32_t distanceMm;      // Valid only if valid == true
+  uint32_t echoUs;         // Echo pulse width
+  uint32_t timestampUs;    // micros() at the falling edge (or at timeout)
+  bool valid;              // false = echo missed / timed out
+};
+
+class AsyncUltrasonicRanger {
+public:
+  bool begin(uint8_t trigPin, uint8_t echoPin, uint32_t cycleUs = ULTRASONIC_DEFAULT_CYCLE_US);
+
+  // Call once per control tick: triggers a new ping when idle, expires lost echoes
+  void update();
+
+  // Consumer side: true when a measurement cycle finished since the last call
+  bool poll(RangeReading& out);
+
+  // Last finished measurement (valid or timeout), false if none yet
+  bool getLatest(RangeReading& out) const;
+
+  uint32_t getReadingCount() const { return results.getSequence(); }
+  uint32_t getTimeoutCount() const { return timeoutCount; }
+
+private:
+  enum EchoState : uint8_t {
+    ECHO_IDLE = 0,
+    ECHO_WAIT_RISE,
+    ECHO_WAIT_FALL
+  };
+
+  static void IRAM_ATTR echoIsr(void* arg);
+
+  uint8_t trigPin = 0;
+  uint8_t echoPin = 0;
+  uint32_t cycleUs = ULTRASONIC_DEFAULT_CYCLE_US;
+
+  // Shared between ISR and update(); ownership changes only by compare-exchange
+  std::atomic<uint8_t> echoState{ECHO_IDLE};
+  volatile uint32_t triggerUs = 0;
+  volatile uint32_t riseUs = 0;
+
+  // ISR -> consumer
+  SpscSlot<RangeReading> results;
+
+  // Consumer-only state
+  uint32_t lastSeenSequence = 0;
+  bool pendingTimeout = false;
+  RangeReading lastResult = {0, 0, 0, false};
+  bool hasResult = false;
+  uint32_t timeoutCount = 0;
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ═══════════════════════════════════════════════════════════
+// 📇 VOCABULARY INDEX - CONTEXT × EMOTION BUCKETS
+// ═══════════════════════════════════════════════════════════
+// Words are grouped into buckets by (context, emotion bin), each bucket a
+// doubly linked list of vocabulary slots kept sorted by utility, best
+// first. Every word in a bucket scores the same on context and emotion
+// bin, so a lookup only reads bucket heads and walks a bucket while its
+// utility can still beat the best match. Tails give the weakest words
+// for pruning and eviction.
+//
+// The index stores slot numbers and a copy of each word's utility; the
+// owner calls insert/update/remove/move whenever it changes a word.
+
+template <uint8_t N, uint8_t BUCKETS>
+class VocabularyIndex {
+  static_assert(N < 127 && BUCKETS < 127, "VocabularyIndex links are int8_t");
+
+private:
+  int8_t heads[BUCKETS];
+  int8_t tails[BUCKETS];
+  int8_t nexts[N];
+  int8_t prevs[N];
+  uint8_t buckets[N];
+  float utilities[N];
+
+  void link(uint8_t slot) {
+    uint8_t bucket = buckets[slot];
+    int8_t after = -1;
+    int8_t before = heads[bucket];
+    while (before >= 0 && utilities[before] >= utilities[slot]) {
+      after = before;
+      before = nexts[before];
+    }
+    prevs[slot] = after;
+    nexts[slot] = before;
+    if (after >= 0) nexts[after] = slot; else heads[bucket] = slot;
+    if (before >= 0) prevs[before] = slot; else tails[bucket] = slot;
+  }
+
+  void unlink(uint8_t slot) {
+    uint8_t bucket = buckets[slot];
+    if (prevs[slot] >= 0) nexts[prevs[slot]] = nexts[slot]; else heads[bucket] = nexts[slot];
+    if (nexts[slot] >= 0) prevs[nexts[slot]] = prevs[slot]; else tails[bucket] = prevs[slot];
+  }
+
+public:
+  VocabularyIndex() { clear(); }
+
+  void clear() {
+    memset(heads, -1, sizeof(heads));
+    memset(tails, -1, sizeof(tails));
+  }
+
+  void insert(uint8_t slot, uint8_t bucket, float utility) {
+    buckets[slot] = bucket;
+    utilities[slot] = utility;
+    link(slot);
+  }
+
+  void remove(uint8_t slot) { unlink(slot); }
+
+  // Utility changed: re-sort within the bucket (usually a short hop)
+  void update(uint8_t slot, float utility) {
+    if (utilities[slot] == utility) return;
+    unlink(slot);
+    utilities[slot] = utility;
+    link(slot);
+  }
+
+  // A word was moved from one vocabulary slot to another (compaction)
+  void move(uint8_t from, uint8_t to) {
+    if (from == to) return;
+    buckets[to] = buckets[from];
+    utilities[to] = utilities[from];
+    prevs[to] = prevs[from];
+    nexts[to] = nexts[from];
+    uint8_t bucket = buckets[to];
+    if (prevs[to] >= 0) nexts[prevs[to]] = to; else heads[bucket] = to;
+    if (nexts[to] >= 0) prevs[nexts[to]] = to; else tails[bucket] = to;
+  }
+
+  // Best (head) or weakest (tail) slot in a bucket, -1 if empty
+  int8_t head(uint8_t bucket) const { return heads[bucket]; }
+  int8_t tail(uint8_t bucket) const { return tails[bucket]; }
+  int8_t next(uint8_t slot) const { return nexts[slot]; }
+  int8_t prev(uint8_t slot) const { return prevs[slot]; }
+  float utility(uint8_t slot) const { return utilities[slot]; }
+  uint8_t bucketOf(uint8_t slot) const { return buckets[slot]; }
+
+  // Lowest-utility slot overall: one read per bucket
+  int8_t weakest() const {
+    int8_t worst = -1;
+    for (uint8_t b = 0; b < BUCKETS; b++) {
+      int8_t slot = tails[b];
+      if (slot >= 0 && (worst < 0 || utilities[slot] < utilities[worst])) worst = slot;
+    }
+    return worst;
+  }
+};
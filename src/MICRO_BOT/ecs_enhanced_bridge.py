@@ -25,6 +25,7 @@ from collections import defaultdict, deque
 # Add the src directory to the path to import ECS
 sys.path.append(os.path.join(os.path.dirname(__file__), '..'))
 from evolutionary_code_system import EvolutionaryCodeSystem, MutationType
+from ecs_wire_protocol import ECSReassembler, encode_command, encode_command_json
 
 # Set up logging
 logging.basicConfig(
@@ -94,6 +95,11 @@ class ECSEnhancedBridge:
         self.ecs = EvolutionaryCodeSystem("bridge_evolution_corpus.json")
         logger.info("🧬 ECS v2.0 initialized")
         
+        # Binary ECS frames (set ECS_JSON_DEBUG=1 for firmware built with ECS_JSON_DEBUG)
+        self.reassembler = ECSReassembler()
+        self.json_debug = os.environ.get('ECS_JSON_DEBUG', '0') == '1'
+        self.command_sequence = 0
+        
         # Evolution tracking
         self.evolution_sessions: Dict[str, Dict] = {}
         self.swarm_metrics = {
@@ -128,7 +134,14 @@ class ECSEnhancedBridge:
             
             async for message in websocket:
                 try:
-                    if message.startswith('{'):
+                    if isinstance(message, bytes):
+                        # Binary ECS frame forwarded verbatim from ESP-NOW
+                        data = self.reassembler.feed(message, bot_ip)
+                        if data is not None:
+                            await self.process_enhanced_bot_message(data, bot_ip, websocket)
+                        else:
+                            self.stats['messages_filtered'] += 1
+                    elif message.startswith('{'):
                         # JSON message (includes ECS messages)
                         data = json.loads(message)
                         await self.process_enhanced_bot_message(data, bot_ip, websocket)
@@ -195,6 +208,14 @@ class ECSEnhancedBridge:
             'timestamp': time.time()
         })
     
+    async def send_bot_command(self, bot_ws, command: Dict):
+        """Send an ECS command in the wire format the bot firmware expects"""
+        self.command_sequence = (self.command_sequence + 1) & 0xFFFF
+        if self.json_debug:
+            await bot_ws.send(encode_command_json(command, self.command_sequence))
+        else:
+            await bot_ws.send(encode_command(command, self.command_sequence))
+    
     async def handle_performance_report(self, bot: EnhancedBotStatus, data: Dict):
         """Handle performance metrics from bot"""
         if 'metrics' in data:
@@ -312,7 +333,7 @@ class ECSEnhancedBridge:
                     'generation': bot.generation + 1
                 }
                 
-                await websocket.send(json.dumps(parameter_update))
+                await self.send_bot_command(websocket, parameter_update)
                 self.stats['mutations_applied'] += 1
                 
                 # Track mutation in bot history
@@ -547,10 +568,10 @@ class ECSEnhancedBridge:
         for bot_ws in self.bot_clients:
             if bot_ws.remote_address[0] == bot.ip_address:
                 try:
-                    await bot_ws.send(json.dumps({
+                    await self.send_bot_command(bot_ws, {
                         'type': 'evolution_trigger',
                         'reason': 'Manual trigger from PC'
-                    }))
+                    })
                     
                     await websocket.send(json.dumps({
                         'type': 'evolution_triggered',
@@ -668,10 +689,10 @@ class ECSEnhancedBridge:
                     for bot_ws in self.bot_clients:
                         if bot_ws.remote_address[0] == bot.ip_address:
                             try:
-                                await bot_ws.send(json.dumps({
+                                await self.send_bot_command(bot_ws, {
                                     'type': 'evolution_trigger',
                                     'reason': evolution_reason
-                                }))
+                                })
                                 logger.info(f"🧬 Auto-evolution triggered for {bot_id}: {evolution_reason}")
                                 break
                             except Exception as e:
@@ -18,6 +18,12 @@ import matplotlib.pyplot as plt
 from matplotlib.backends.backend_tkagg import FigureCanvasTkAgg
 from matplotlib.figure import Figure
 import time
+import sys
+import os
+
+# Shared ECS wire-format decoder lives in src/
+sys.path.append(os.path.join(os.path.dirname(__file__), '..'))
+from ecs_wire_protocol import ECSReassembler
 
 # Set up logging
 logging.basicConfig(
@@ -44,7 +50,8 @@ class BotData:
     def update(self, data):
         """Update bot data from message"""
         self.generation = data.get('generation', self.generation)
-        self.fitness_score = data.get('fitness_score', self.fitness_score)
+        # ECS reports call it 'fitness', standard bot messages 'fitness_score'
+        self.fitness_score = data.get('fitness_score', data.get('fitness', self.fitness_score))
         self.emotional_state = data.get('emotional_state', self.emotional_state)
         self.sensor_data = data.get('sensor_data', self.sensor_data)
         self.last_seen = datetime.now()
@@ -120,6 +127,7 @@ class PCMCUApp:
         self.connected = False
         self.running = True
         self.message_log = deque(maxlen=1000)
+        self.ecs_reassembler = ECSReassembler()
         
         # Connection settings
         self.micro_bot_ip = "192.168.1.207"  # Pi's current IP
@@ -323,7 +331,19 @@ class PCMCUApp:
         """Listen for messages from MICRO BOT"""
         try:
             async for message in self.websocket:
-                data = json.loads(message)
+                if isinstance(message, bytes):
+                    # Raw binary ECS frame: decode into the same shape the bridge forwards
+                    report = self.ecs_reassembler.feed(message)
+                    if report is None:
+                        continue
+                    data = {
+                        'type': 'bot_message',
+                        'bot_id': report.get('bot_id', 'unknown'),
+                        'data': report,
+                        'timestamp': time.time()
+                    }
+                else:
+                    data = json.loads(message)
                 self.root.after(0, lambda d=data: self.handle_message(d))
                 
         except websockets.exceptions.ConnectionClosed:
@@ -380,7 +400,8 @@ class PCMCUApp:
         """Handle individual bot messages"""
         bot_id = data.get('bot_id')
         if bot_id and bot_id in self.bots:
-            self.bots[bot_id].update(data)
+            # Bridge wraps the decoded bot report in 'data'
+            self.bots[bot_id].update(data.get('data', data))
             
     def handle_status_update(self, data):
         """Handle status updates from bridge"""
@@ -0,0 +1,190 @@
+#include "imu_fusion.h"
+
+// ═══════════════════════════════════════════════════════════
+// 🧭 MPU-6050 FIFO IMU IMPLEMENTATION
+// ═══════════════════════════════════════════════════════════
+// Register map: MPU-6000/6050 Register Map rev 4.2. Only the registers
+// this driver touches are named here.
+
+#define MPU_REG_SMPLRT_DIV    0x19
+#define MPU_REG_CONFIG        0x1A
+#define MPU_REG_GYRO_CONFIG   0x1B
+#define MPU_REG_ACCEL_CONFIG  0x1C
+#define MPU_REG_FIFO_EN       0x23
+#define MPU_REG_INT_PIN_CFG   0x37
+#define MPU_REG_INT_ENABLE    0x38
+#define MPU_REG_USER_CTRL     0x6A
+#define MPU_REG_PWR_MGMT_1    0x6B
+#define MPU_REG_FIFO_COUNT_H  0x72
+#define MPU_REG_FIFO_R_W      0x74
+#define MPU_REG_WHO_AM_I      0x75
+
+#define MPU_FIFO_SIZE 1024
+#define MPU_GRAVITY 9.80665f
+#define MPU_ACCEL_LSB_PER_G 4096.0f      // +-8 g
+#define MPU_GYRO_LSB_PER_DPS 65.5f       // +-500 deg/s
+
+static const float IMU_SAMPLE_PERIOD_S = 1.0f / IMU_SAMPLE_RATE_HZ;
+static const uint32_t IMU_SAMPLE_PERIOD_US = 1000000UL / IMU_SAMPLE_RATE_HZ;
+
+bool Mpu6050FifoImu::begin(TwoWire& bus, uint8_t pin, uint8_t addr) {
+  wire = &bus;
+  intPin = pin;
+  address = addr;
+
+  uint8_t whoAmI = 0;
+  if (!readRegisters(MPU_REG_WHO_AM_I, &whoAmI, 1)) return false;
+
+  writeRegister(MPU_REG_PWR_MGMT_1, 0x80);    // Device reset
+  delay(100);
+  writeRegister(MPU_REG_PWR_MGMT_1, 0x01);    // Wake, clock from gyro X PLL
+  writeRegister(MPU_REG_CONFIG, 0x04);        // DLPF 21 Hz, gyro output 1 kHz
+  writeRegister(MPU_REG_SMPLRT_DIV, 1000 / IMU_SAMPLE_RATE_HZ - 1);
+  writeRegister(MPU_REG_GYRO_CONFIG, 0x08);   // +-500 deg/s
+  writeRegister(MPU_REG_ACCEL_CONFIG, 0x10);  // +-8 g
+  writeRegister(MPU_REG_INT_PIN_CFG, 0x00);   // Active high, 50 us pulse per sample
+  writeRegister(MPU_REG_INT_ENABLE, 0x01);    // Data ready
+  resetFifo();
+
+  pinMode(intPin, INPUT);
+  attachInterruptArg(digitalPinToInterrupt(intPin), dataReadyIsr, this, RISING);
+
+  Serial.printf("🧭 MPU-6050 (0x%02X) FIFO at %d Hz, data-ready on pin %d\n",
+                whoAmI, IMU_SAMPLE_RATE_HZ, intPin);
+  return true;
+}
+
+void IRAM_ATTR Mpu6050FifoImu::dataReadyIsr(void* arg) {
+  Mpu6050FifoImu* self = static_cast<Mpu6050FifoImu*>(arg);
+  self->lastReadyUs = micros();
+  self->readyCount.fetch_add(1, std::memory_order_release);
+}
+
+// ═══════════════════════════════════════════════════════════
+// 🔌 I2C ACCESS
+// ═══════════════════════════════════════════════════════════
+
+bool Mpu6050FifoImu::writeRegister(uint8_t reg, uint8_t value) {
+  wire->beginTransmission(address);
+  wire->write(reg);
+  wire->write(value);
+  return wire->endTransmission() == 0;
+}
+
+bool Mpu6050FifoImu::readRegisters(uint8_t reg, uint8_t* buffer, uint8_t length) {
+  wire->beginTransmission(address);
+  wire->write(reg);
+  if (wire->endTransmission(false) != 0) return false;
+  if (wire->requestFrom(address, length) != length) return false;
+  for (uint8_t i = 0; i < length; i++) buffer[i] = wire->read();
+  return true;
+}
+
+void Mpu6050FifoImu::resetFifo() {
+  writeRegister(MPU_REG_USER_CTRL, 0x04);     // FIFO reset
+  writeRegister(MPU_REG_FIFO_EN, 0x78);       // Accel + gyro XYZ
+  writeRegister(MPU_REG_USER_CTRL, 0x40);     // FIFO enable
+  consumedCount = readyCount.load(std::memory_order_acquire);
+}
+
+// ═══════════════════════════════════════════════════════════
+// 📥 BATCHED FIFO READS
+// ═══════════════════════════════════════════════════════════
+
+bool Mpu6050FifoImu::update() {
+  if (wire == nullptr) return false;
+
+  // The interrupt tells us how much is waiting without touching the bus
+  uint32_t ready = readyCount.load(std::memory_order_acquire);
+  if (ready - consumedCount < IMU_FIFO_BATCH) return false;
+
+  uint8_t countBytes[2];
+  if (!readRegisters(MPU_REG_FIFO_COUNT_H, countBytes, 2)) return false;
+  uint16_t fifoBytes = ((uint16_t)countBytes[0] << 8) | countBytes[1];
+
+  if (fifoBytes + IMU_FIFO_SAMPLE_BYTES > MPU_FIFO_SIZE) {
+    // Overflowed: the oldest samples are gone and the frame alignment with them
+    overflowCount++;
+    resetFifo();
+    return false;
+  }
+
+  uint16_t available = fifoBytes / IMU_FIFO_SAMPLE_BYTES;
+  uint8_t samples = min(available, (uint16_t)IMU_FIFO_BATCH);
+  if (samples == 0) {
+    consumedCount = ready;                    // Edges without data (e.g. after a reset)
+    return false;
+  }
+
+  uint8_t buffer[IMU_FIFO_BATCH * IMU_FIFO_SAMPLE_BYTES];
+  if (!readRegisters(MPU_REG_FIFO_R_W, buffer, samples * IMU_FIFO_SAMPLE_BYTES)) return false;
+  burstCount++;
+
+  for (uint8_t i = 0; i < samples; i++) {
+    integrate(&buffer[i * IMU_FIFO_SAMPLE_BYTES]);
+  }
+
+  // Re-sync with the interrupt count: whatever is still queued is unread
+  uint16_t left = available - samples;
+  consumedCount = ready - min((uint32_t)left, ready - consumedCount);
+  state.timestampUs = lastReadyUs - left * IMU_SAMPLE_PERIOD_US;
+  snapshots.publish(state);
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════
+// 🧮 ORIENTATION FILTER
+// ═══════════════════════════════════════════════════════════
+
+static inline int16_t readBigEndian(const uint8_t* bytes) {
+  return (int16_t)(((uint16_t)bytes[0] << 8) | bytes[1]);
+}
+
+void Mpu6050FifoImu::integrate(const uint8_t* sample) {
+  float ax = readBigEndian(&sample[0]) * (MPU_GRAVITY / MPU_ACCEL_LSB_PER_G);
+  float ay = readBigEndian(&sample[2]) * (MPU_GRAVITY / MPU_ACCEL_LSB_PER_G);
+  float az = readBigEndian(&sample[4]) * (MPU_GRAVITY / MPU_ACCEL_LSB_PER_G);
+  float gx = readBigEndian(&sample[6]) / MPU_GYRO_LSB_PER_DPS;
+  float gy = readBigEndian(&sample[8]) / MPU_GYRO_LSB_PER_DPS;
+  float gz = readBigEndian(&sample[10]) / MPU_GYRO_LSB_PER_DPS;
+
+  float accelNorm = sqrtf(ax * ax + ay * ay + az * az);
+  float linearAccel = accelNorm - MPU_GRAVITY;
+
+  // Still: learn the Z bias (the only correction yaw gets without a magnetometer)
+  bool still = fabsf(gz - gyroBiasZ) < IMU_STILL_GYRO_DPS &&
+               fabsf(gx) < IMU_STILL_GYRO_DPS && fabsf(gy) < IMU_STILL_GYRO_DPS &&
+               fabsf(linearAccel) < IMU_STILL_ACCEL_MS2;
+  if (still) gyroBiasZ += IMU_BIAS_ADAPT * (gz - gyroBiasZ);
+
+  float yawRate = gz - gyroBiasZ;
+  float heading = state.headingDeg + yawRate * IMU_SAMPLE_PERIOD_S;
+  if (heading >= 360.0f) heading -= 360.0f;
+  if (heading < 0.0f) heading += 360.0f;
+
+  // Complementary filter: gyro for fast changes, gravity direction for the long term
+  float pitchAccel = atan2f(-ax, sqrtf(ay * ay + az * az)) * RAD_TO_DEG;
+  float rollAccel = atan2f(ay, az) * RAD_TO_DEG;
+  if (state.sampleCount == 0) {
+    state.pitchDeg = pitchAccel;
+    state.rollDeg = rollAccel;
+  }
+  state.pitchDeg = IMU_COMPLEMENTARY_ALPHA * (state.pitchDeg + gy * IMU_SAMPLE_PERIOD_S) +
+                   (1.0f - IMU_COMPLEMENTARY_ALPHA) * pitchAccel;
+  state.rollDeg = IMU_COMPLEMENTARY_ALPHA * (state.rollDeg + gx * IMU_SAMPLE_PERIOD_S) +
+                  (1.0f - IMU_COMPLEMENTARY_ALPHA) * rollAccel;
+
+  state.headingDeg = heading;
+  state.yawRateDps = yawRate;
+  state.linearAccel = linearAccel;
+  state.accelX = ax;
+  state.accelY = ay;
+  state.accelZ = az;
+  state.still = still;
+  state.sampleCount++;
+}
+
+void Mpu6050FifoImu::resetHeading(float headingDeg) {
+  state.headingDeg = headingDeg;
+  snapshots.publish(state);
+}
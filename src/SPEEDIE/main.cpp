@@ -17,17 +17,33 @@
  * - Ultra-fast obstacle avoidance and learning
  * - 10kHz PWM for smooth high-speed motor control
  * - Rapid evolution cycles (20s-2min adaptive intervals)
+ * - Dual-core: 100 Hz control task on core 1, comms/evolution on core 0
  */
 
 #include <Arduino.h>
-#include <Adafruit_MPU6050.h>
-#include <Adafruit_Sensor.h>
 #include <Wire.h>
 #include <WiFi.h>
 #include <esp_now.h>
 #include <esp_wifi.h>
 #include "swarm_espnow.h"
 #include "swarm_ecosystem_manager.h"
+#include "swarm_peer_registry.h"
+#include "swarm_node.h"
+#include "swarm_membership.h"
+#include "swarm_scheduler.h"
+#include "ultrasonic_ranger.h"
+#include "imu_fusion.h"
+#include "context_detection.h"
+#include "swarm_lockfree.h"
+#include "swarm_transmit_queue.h"
+#include "swarm_bundle.h"
+#include "swarm_persistent_store.h"
+#include "signal_vocabulary.h"
+#include "signal_player.h"
+#include "swarm_spatial.h"
+#include "swarm_coverage.h"
+#include "strategy_index.h"
+#include "swarm_evolution.h"
 #include <EEPROM.h>
 
 // ═══════════════════════════════════════════════════════════
@@ -69,7 +85,9 @@ const int PWM_CH_R_G = 7;        // Right GREEN LED PWM channel
 
 const int ULTRASONIC_TRIG_PIN = 18;   // HC-SR04 Trigger pin
 const int ULTRASONIC_ECHO_PIN = 19;   // HC-SR04 Echo pin
-Adafruit_MPU6050 mpu;                 // IMU for sensor fusion
+const int MPU_INT_PIN = 27;           // MPU-6050 INT (data ready), free since the motion sensor went
+Mpu6050FifoImu imu;                   // FIFO-batched MPU-6050 + orientation filter
+AsyncUltrasonicRanger ultrasonicRanger; // Interrupt-driven HC-SR04 (no pulseIn)
 
 // == MOTOR PINS & PWM ==
 const int LEFT_MOTOR_PIN1 = 26;
@@ -105,7 +123,7 @@ struct EvolvingGenome {
   // SPEEDIE-specific parameters
   int maxAcceleration = 50;     // How fast to ramp up speed
   int corneringSpeed = 160;     // Speed when turning
-  float gyroSensitivity = 2.0;  // IMU turning sensitivity
+  float gyroSensitivity = 2.0;  // Legacy: heading now integrates real sample time
   
   // Evolution metadata
   unsigned long successCount = 0;
@@ -114,25 +132,25 @@ struct EvolvingGenome {
   unsigned long generation = 0;
 };
 
-// ═══════════════════════════════════════════════════════════
-// 🌐 ECOSYSTEM MANAGER (LAYER 3 INTELLIGENCE)
-// ═══════════════════════════════════════════════════════════
-SwarmEcosystemManager* ecosystemManager = nullptr;
-
 // 🗣️ EMERGENT LANGUAGE STRUCTURES (Same as WHEELIE)
 const int MAX_VOCABULARY = 50;
 const int BUZZER_PIN = -1; // No buzzer for SPEEDIE (speed focused)
 
-struct SignalWord {
-  int contextType;           // 0=obstacle, 1=success, 2=trapped, 3=clear, 4=evolving
-  int emotionalValence;      // -100 to +100
-  int generation;           // When this signal was created
-  float utility;            // 0.0-1.0 how useful this signal is
+// Words are the shared SignalWord (signal_vocabulary.h). Contexts:
+// 0=obstacle, 1=success, 2=trapped, 3=clear, 4=evolving; valence -100..+100
+const int SPEEDIE_PATTERN_LENGTH = 6;
+
+// Pre-NVS EEPROM word layout, only read by loadLegacyEEPROM()
+struct LegacySignalWord {
+  int contextType;
+  int emotionalValence;
+  int generation;
+  float utility;
   unsigned long timesUsed;
   int patternLength;
-  int tonePattern[6];       // Frequencies for each tone
-  int durationPattern[6];   // Durations for each tone
-  uint8_t r, g, b;          // Associated RGB color for this signal
+  int tonePattern[6];
+  int durationPattern[6];
+  uint8_t r, g, b;
 };
 
 struct EmotionalState {
@@ -145,8 +163,7 @@ struct EmotionalState {
 };
 
 // Global variables for emergent language
-SignalWord vocabulary[MAX_VOCABULARY];
-int vocabularySize = 0;
+SignalVocabulary<MAX_VOCABULARY> vocabulary(-100, 100);
 EmotionalState currentState;
 bool hasBuzzer = false;
 
@@ -165,16 +182,21 @@ struct LearnedStrategy {
 };
 
 const int MAX_STRATEGIES = 25; // More strategies for SPEEDIE
+const int LEGACY_MAX_STRATEGIES = 25; // EEPROM image layout, fixed whatever MAX_STRATEGIES is
+const uint8_t STRATEGY_MATCH_BANDS = 3; // getBestStrategy(): ±3 bands of 20cm (60-80cm)
 LearnedStrategy strategyLibrary[MAX_STRATEGIES];
 int strategyCount = 0;
+StrategyBandIndex strategyIndex;  // Control-owned, like strategyLibrary
+static_assert(MAX_STRATEGIES <= STRATEGY_INDEX_CAPACITY, "Strategy index too small for the library");
 
 // ═══════════════════════════════════════════════════════════
 // 📡 ESP-NOW SWARM COMMUNICATION SYSTEM (SPEEDIE)
 // ═══════════════════════════════════════════════════════════
-SwarmPeer swarmPeers[MAX_SWARM_PEERS];
-int activePeerCount = 0;
+SwarmPeer swarmPeers[PEER_REGISTRY_CAPACITY]; // Indexed by PeerId (peerRegistry)
+int activePeerCount = 0;                      // At most MAX_SWARM_PEERS active at once
 SwarmRole currentSwarmRole = ROLE_GUARDIAN; // SPEEDIE default role: fast response guardian
 BotType myBotType = BOT_SPEEDIE;
+uint8_t myMacAddress[6] = {0};
 uint8_t sequenceNumber = 0;
 CommStats commStats = {0};
 
@@ -191,7 +213,12 @@ SwarmBehavior currentBehavior = BEHAVIOR_PATROL_FORMATION; // SPEEDIE patrols by
 
 // Communication buffers
 SwarmMessage outgoingMessage;
-SwarmMessage incomingMessage;
+SwarmTransmitQueue txQueue;   // Every send path goes through here (comms core only)
+SwarmBundleBuilder telemetryBundle; // Periodic traffic, one frame per comms tick
+SwarmMembership swarmMembership;    // Whole-swarm view; replaces broadcasts in large swarms
+unsigned long lastGossipRound = 0;
+SwarmCoverageSync coverageSync(swarmNode->spatialIndex); // Explored map, shared over MSG_AREA_SHARE
+const uint8_t SENSOR_TYPE_ULTRASONIC = 2; // SensorPayload.sensorType (1 = WHEELIE VL53L0X)
 
 // ═══════════════════════════════════════════════════════════
 // 🌱 EVOLUTION STATE (SPEEDIE VERSION)
@@ -203,6 +230,27 @@ unsigned long lastEvolutionTime = 0;
 const unsigned long EVOLUTION_INTERVAL_BASE = 45000; // Faster evolution (45s base)
 unsigned long EVOLUTION_INTERVAL = EVOLUTION_INTERVAL_BASE;
 
+// Island-model evolution: each SPEEDIE evaluates its own candidate and
+// breeds the next one from every SPEEDIE's latest result (MSG_GENOME_SHARE)
+const uint8_t SPEEDIE_GENOME_LAYOUT = 0x02;   // Gene order below; bump when it changes
+const GeneBounds SPEEDIE_GENE_BOUNDS[] = {
+  {180, 255, 20},   // motorSpeed
+  {120, 220, 15},   // turnSpeed
+  {200, 800, 50},   // backupDuration
+  {150, 400, 30},   // turnDuration
+  {80, 300, 20},    // obstacleThreshold
+  {150, 400, 30},   // clearThreshold
+  {50, 300, 30},    // scanDelay
+  {2, 5, 1},        // aggressiveBackupMultiplier
+  {180, 359, 45},   // spinDegreesWhenTrapped
+  {20, 100, 10},    // maxAcceleration
+  {100, 200, 20},   // corneringSpeed
+  {50, 500, 50}     // gyroSensitivity x 100
+};
+const uint8_t SPEEDIE_GENE_COUNT = sizeof(SPEEDIE_GENE_BOUNDS) / sizeof(GeneBounds);
+static_assert(sizeof(SPEEDIE_GENE_BOUNDS) / sizeof(GeneBounds) <= GENOME_MAX_GENES, "Genome does not fit GenomePayload");
+SwarmGenePool genePool(SPEEDIE_GENE_BOUNDS, SPEEDIE_GENE_COUNT, SPEEDIE_GENOME_LAYOUT);
+
 // ═══════════════════════════════════════════════════════════
 // 📊 PERFORMANCE TRACKING (SPEEDIE METRICS)
 // ═══════════════════════════════════════════════════════════
@@ -219,15 +267,29 @@ struct PerformanceMetrics {
 };
 
 PerformanceMetrics metrics;
+PerformanceMetrics evaluationBaseline;  // Comms side: metrics when the current candidate started
 unsigned long currentObstacleStartTime = 0;
 
 // ═══════════════════════════════════════════════════════════
-// 💾 EEPROM PERSISTENCE (SPEEDIE LAYOUT)
-// ═══════════════════════════════════════════════════════════
+// 💾 PERSISTENCE (NVS RECORDS, LEGACY EEPROM LAYOUT)
+// ═══════════════════════════════════════════════════════════
+// Live data is kept in per-record NVS keys (see swarm_persistent_store.h).
+// Bump a *_LAYOUT_VERSION when its struct changes, so old records are
+// skipped instead of reinterpreted. The old single-image EEPROM layout
+// below (offsets derived from sizeof) is only read once, to migrate bots
+// that were flashed before the NVS store existed.
+const char* PERSIST_NAMESPACE = "speedie";
+const uint16_t PERSIST_SCHEMA_VERSION = 1;
+const uint8_t GENOME_LAYOUT_VERSION = 1;
+const uint8_t METRICS_LAYOUT_VERSION = 1;
+const uint8_t STRATEGY_LAYOUT_VERSION = 1;
+const uint8_t VOCABULARY_LAYOUT_VERSION = 2;    // 2: shared narrowed SignalWord
+const uint32_t PERSIST_FLUSH_BUDGET_US = 4000;   // Flash time per persist tick
+const unsigned long PERSIST_MAX_DEFER_MS = 30000; // Escapes may postpone writes this long
 const int EEPROM_SIZE = 4096;
 const int GENOME_ADDRESS = 0;
 const int STRATEGIES_ADDRESS = sizeof(EvolvingGenome);
-const int METRICS_ADDRESS = STRATEGIES_ADDRESS + (sizeof(LearnedStrategy) * MAX_STRATEGIES);
+const int METRICS_ADDRESS = STRATEGIES_ADDRESS + (sizeof(LearnedStrategy) * LEGACY_MAX_STRATEGIES);
 const int VOCABULARY_ADDRESS = METRICS_ADDRESS + sizeof(PerformanceMetrics);
 
 // Other state variables
@@ -240,11 +302,203 @@ int consecutiveSensorErrors = 0;
 const int MAX_CONSECUTIVE_ERRORS = 3; // Less tolerance for errors
 int trappedAttempts = 0;
 const int MAX_TRAPPED_ATTEMPTS = 2; // Escape faster
+const int UNEXPLORED_SIDE_BONUS_MM = 100; // Scan credit for the side facing unexplored ground
+const float CONTEXT_SETTLED_STABILITY = 0.7; // Context stability that counts as a settled area
+const int CLUTTERED_SPEED_PERCENT = 75;      // Cruise speed where obstacles keep coming
+unsigned long emergencyStopUntil = 0; // Motors held off until this time
+
+// Context detection (context_detection.h), read once per control tick
+uint8_t controlContext = CONTEXT_ID_UNKNOWN;
+float controlContextStability = 0.5;
+
+// Filtered distance, refreshed once per control tick
+int latestDistance = SENSOR_ERROR_VALUE;
+int filteredDistance = SENSOR_ERROR_VALUE;
+int previousRawDistance = SENSOR_ERROR_VALUE;
+unsigned long lastRangeTime = 0;
+const unsigned long RANGE_STALE_MS = 200; // No finished ping for this long = sensor error
+
+// ═══════════════════════════════════════════════════════════
+// ⏱️ SPEEDIE TASK LAYOUT (DUAL-CORE, NON-BLOCKING)
+// ═══════════════════════════════════════════════════════════
+// Core 1: control task - sensors, motors, escape, signals, strategies,
+//         vocabulary. Runs every CONTROL_PERIOD_MS via vTaskDelayUntil.
+// Core 0: comms task - cooperative scheduler for ESP-NOW, ecosystem,
+//         evolution (owns the master genome) and flash writes.
+// Nothing here may delay(); every behaviour is a tick-driven state
+// machine. State crosses cores only through the lock-free slots/rings
+// below, never through shared globals.
+const uint32_t CONTROL_PERIOD_MS = 10;        // 100 Hz sense-act cycle
+const uint32_t TX_SERVICE_PERIOD_MS = 1;      // Transmit queue pacing/retries
+const uint32_t RX_DRAIN_PERIOD_MS = 5;        // Received frame ring -> handlers
+const uint32_t COMMS_PERIOD_MS = 20;          // ESP-NOW discovery/status/timeouts
+const uint32_t POSITION_PERIOD_MS = 100;      // Dead reckoning from the IMU snapshot
+const uint32_t BUZZER_PERIOD_MS = 10;         // Localization tone steps
+const uint32_t ECOSYSTEM_PERIOD_MS = 100;     // Layer 3 bookkeeping
+const uint32_t EVOLUTION_PERIOD_MS = 1000;    // evolutionCycle() gates itself on EVOLUTION_INTERVAL
+const uint32_t PERSIST_PERIOD_MS = 250;       // Snapshot -> NVS dirty records -> flash
+const uint32_t DIAGNOSTICS_PERIOD_MS = 30000; // Timing report
+const BaseType_t CONTROL_CORE = 1;
+const BaseType_t COMMS_CORE = 0;
+CooperativeScheduler commsScheduler;
+TaskHandle_t controlTaskHandle = nullptr;
+TaskHandle_t commsTaskHandle = nullptr;
+
+// Control task timing (written by control, reported via ControlSnapshot)
+struct ControlLoopStats {
+  uint32_t ticks = 0;
+  uint32_t maxRuntimeUs = 0;
+  uint32_t maxPeriodUs = 0;   // Worst observed tick-to-tick spacing
+  uint32_t overruns = 0;      // Ticks that took longer than the period
+};
+ControlLoopStats controlStats;
+
+// Control -> comms: everything comms needs to know about the control side
+struct ControlSnapshot {
+  PerformanceMetrics metrics;
+  EmotionalState emotions;
+  ControlLoopStats loopStats;
+  int trappedAttempts;
+  int vocabularySize;
+  int strategyCount;
+  int latestDistance;
+  float heading;
+  int driveSpeed;
+  bool isAwake;
+  bool isAvoiding;
+};
+SpscSlot<ControlSnapshot> controlSnapshotSlot;
+ControlSnapshot latestControl;   // Comms-side copy, refreshed on every comms pass
+
+// Comms -> control: the master genome lives on core 0, control drives from this copy
+EvolvingGenome controlGenome;
+SpscSlot<EvolvingGenome> genomeSlot;
+uint32_t genomeSequenceSeen = 0;
+
+// Comms -> control: requests that must run where the data lives
+enum ControlCommandType : uint8_t {
+  CMD_EXPRESS_STATE = 1,     // expressState(a, b)
+  CMD_EVOLVE_VOCABULARY,     // evolveVocabulary()
+  CMD_PRUNE_STRATEGIES       // pruneWeakStrategies()
+};
+struct ControlCommand {
+  uint8_t type;
+  int16_t a;
+  int16_t b;
+};
+SpscRing<ControlCommand, 16> controlCommands;
+std::atomic<bool> emergencyStopRequested{false}; // Never dropped, unlike a full ring
+std::atomic<uint32_t> droppedControlCommands{0};
+
+// Comms -> control: which way the closest unexplored cell lies, for the escape scan
+enum ExploreSide : uint8_t {
+  EXPLORE_SIDE_LEFT = 0,     // Same numbering as the scan directions
+  EXPLORE_SIDE_RIGHT = 1,
+  EXPLORE_SIDE_NONE = 0xFF   // No position yet, or the whole arena is explored
+};
+std::atomic<uint8_t> unexploredSide{EXPLORE_SIDE_NONE};
+
+// Control -> comms: persistence snapshots of control-owned memory
+struct StrategySnapshot {
+  LearnedStrategy strategies[MAX_STRATEGIES];
+  int count;
+};
+struct VocabularySnapshot {
+  SignalWord words[MAX_VOCABULARY];
+  int size;
+};
+SpscSlot<StrategySnapshot> strategySnapshotSlot;
+SpscSlot<VocabularySnapshot> vocabularySnapshotSlot;
+uint32_t strategySequenceSaved = 0;
+uint32_t vocabularySequenceSaved = 0;
+
+enum PersistRequest : uint8_t {
+  PERSIST_GENOME = 0x01,
+  PERSIST_METRICS = 0x02
+};
+std::atomic<uint8_t> persistRequests{0};
+
+// Comms-owned persisted copies; store records point straight into these
+StrategySnapshot persistedStrategies;
+VocabularySnapshot persistedVocabulary;
+PerformanceMetrics persistedMetrics;
+SwarmPersistentStore persistentStore;
+int genomeRecord = -1;
+int metricsRecord = -1;
+int strategyCountRecord = -1;
+int strategyRecords[MAX_STRATEGIES];
+int vocabularySizeRecord = -1;
+int vocabularyRecords[MAX_VOCABULARY];
+static_assert(sizeof(SignalWord) <= STORE_MAX_RECORD_SIZE, "SignalWord too large for one store record");
+static_assert(sizeof(EvolvingGenome) <= STORE_MAX_RECORD_SIZE, "Genome too large for one store record");
+static_assert(4 + MAX_STRATEGIES + MAX_VOCABULARY <= STORE_MAX_RECORDS, "Too many store records");
+static_assert(MAX_STRATEGIES <= 100 && MAX_VOCABULARY <= 100, "Record keys carry two digits");
+
+// Wi-Fi task -> comms: received frames (replaces the racy global incomingMessage)
+struct ReceivedFrame {
+  uint8_t mac[6];
+  uint8_t length;
+  int8_t rssi;                 // GOSSIP_RSSI_UNKNOWN if not captured
+  uint8_t data[sizeof(SwarmMessage)];
+};
+SpscRing<ReceivedFrame, 16> receivedFrames;
+std::atomic<uint32_t> rxRingOverflows{0};
+std::atomic<uint32_t> rxOversizeFrames{0};
+
+// Obstacle escape phases (each one ends at a deadline, never in a delay)
+enum EscapePhase {
+  ESCAPE_IDLE = 0,
+  ESCAPE_PAUSE,              // Brake before backing up
+  ESCAPE_BACKUP,
+  ESCAPE_SETTLE,
+  ESCAPE_LEARNED_TURN,       // Learned strategy turn
+  ESCAPE_LEARNED_SCAN,
+  ESCAPE_LOOK_LEFT,          // Exploration scan
+  ESCAPE_SAMPLE_LEFT,
+  ESCAPE_CENTER_FROM_LEFT,
+  ESCAPE_SETTLE_LEFT,
+  ESCAPE_LOOK_RIGHT,
+  ESCAPE_SAMPLE_RIGHT,
+  ESCAPE_CENTER_FROM_RIGHT,
+  ESCAPE_SETTLE_RIGHT,
+  ESCAPE_EXPLORE_TURN,
+  ESCAPE_EXPLORE_SCAN,
+  ESCAPE_CHARGE,             // Forward dash after a clear check
+  ESCAPE_QUICK_BACKUP,       // No clear path, not yet trapped
+  ESCAPE_TRAP_BACKUP,        // Aggressive escape when trapped
+  ESCAPE_TRAP_SETTLE,
+  ESCAPE_TRAP_SPIN,
+  ESCAPE_TRAP_SETTLE_SPIN,
+  ESCAPE_TRAP_CHARGE,
+  ESCAPE_TRAP_STOP
+};
+
+struct ObstacleEscape {
+  EscapePhase phase = ESCAPE_IDLE;
+  unsigned long phaseDeadline = 0;
+  unsigned long startTime = 0;       // When the obstacle was detected
+  unsigned long trapStartTime = 0;   // When the aggressive escape began
+  bool useLearned = false;
+  int initialDistance = 0;
+  int backupTime = 0;
+  int turnTime = 0;
+  int spinTime = 0;
+  int direction = 0;
+  int bestDirection = 0;
+  int bestDistance = 0;
+  bool clearPathFound = false;
+  int chargeSpeed = 0;
+};
+ObstacleEscape escape;
 
 // IMU data
 float currentHeading = 0.0;
 float targetHeading = 0.0;
 
+// Motor state: signed PWM of the last straight-line command (0 = stopped or turning)
+int driveSpeed = 0;
+bool motorsRunning = false;
+
 // ═══════════════════════════════════════════════════════════
 // � FUNCTION FORWARD DECLARATIONS
 // ═══════════════════════════════════════════════════════════
@@ -264,9 +518,26 @@ void handleStatusUpdate(const uint8_t* senderMac, StatusPayload* payload);
 void handleSensorDataShare(const uint8_t* senderMac, SensorPayload* payload);
 void handleTaskAssignment(const uint8_t* senderMac, TaskPayload* payload);
 void handleEmergencyStop();
+void handleBundle(const uint8_t* senderMac, const SwarmMessage* bundle);
 void sendPairingResponse(const uint8_t* targetMac);
 int findPeer(const uint8_t* mac);
 int findOrCreatePeer(const uint8_t* mac);
+void releaseSwarmPeer(PeerId id);
+int16_t peerRetentionRank(const uint8_t* mac);
+void handleGossipDigest(const uint8_t* senderMac, const SwarmMessage* message);
+void handleGossipUpdate(const SwarmMessage* message);
+void onGossipStatus(const uint8_t* mac, const GossipStatus& status);
+void appendCoverageShare(unsigned long now);
+void handleAreaShare(const SwarmMessage* message);
+void appendGenomeShare(unsigned long now);
+void handleGenomeShare(const uint8_t* senderMac, const GenomePayload* payload);
+
+// Scheduler / non-blocking behaviour functions
+void initializeScheduler();
+void abortObstacleEscape();
+
+// Strategy library index (control core)
+void rebuildStrategyIndex();
 
 // Localization functions
 void sendLocalizationRequest(const uint8_t* targetMac);
@@ -284,133 +555,261 @@ void handlePositionShare(const uint8_t* senderMac, LocalizationPayload* payload)
 // �🗣️ EMERGENT LANGUAGE & PERSISTENCE FUNCTIONS (SPEEDIE VERSION)
 // ═══════════════════════════════════════════════════════════
 
-void saveGenomeToEEPROM() {
-  EEPROM.put(GENOME_ADDRESS, currentGenome);
-  EEPROM.commit();
-  Serial.println("💾 SPEEDIE Genome saved to persistent memory");
+void registerPersistentRecords() {
+  char key[STORE_KEY_LENGTH];
+  
+  genomeRecord = persistentStore.addRecord("genome", &currentGenome, sizeof(currentGenome),
+                                          GENOME_LAYOUT_VERSION);
+  metricsRecord = persistentStore.addRecord("metrics", &persistedMetrics, sizeof(persistedMetrics),
+                                           METRICS_LAYOUT_VERSION);
+  
+  // Counts share their array's version: a new layout invalidates both
+  strategyCountRecord = persistentStore.addRecord("stratN", &persistedStrategies.count, sizeof(int),
+                                                 STRATEGY_LAYOUT_VERSION);
+  for (int i = 0; i < MAX_STRATEGIES; i++) {
+    snprintf(key, sizeof(key), "strat%02d", i);
+    strategyRecords[i] = persistentStore.addRecord(key, &persistedStrategies.strategies[i],
+                                                   sizeof(LearnedStrategy), STRATEGY_LAYOUT_VERSION);
+  }
+  
+  vocabularySizeRecord = persistentStore.addRecord("vocabN", &persistedVocabulary.size, sizeof(int),
+                                                  VOCABULARY_LAYOUT_VERSION);
+  for (int i = 0; i < MAX_VOCABULARY; i++) {
+    snprintf(key, sizeof(key), "voc%02d", i);
+    vocabularyRecords[i] = persistentStore.addRecord(key, &persistedVocabulary.words[i],
+                                                     sizeof(SignalWord), VOCABULARY_LAYOUT_VERSION);
+  }
 }
 
-void loadGenomeFromEEPROM() {
-  EEPROM.get(GENOME_ADDRESS, currentGenome);
-  Serial.println("📖 SPEEDIE Genome loaded from memory");
-  Serial.print("Generation: ");
-  Serial.println(currentGenome.generation);
-  Serial.print("Fitness: ");
-  Serial.println(currentGenome.fitnessScore);
+// Comms side: mark changed records dirty. Nothing here touches flash;
+// persistenceTask() flushes dirty records within PERSIST_FLUSH_BUDGET_US.
+void stageGenome() {
+  if (persistentStore.stage(genomeRecord)) {
+    Serial.println("💾 SPEEDIE Genome queued for persistent memory");
+  }
 }
 
-void saveStrategiesToEEPROM() {
-  for (int i = 0; i < strategyCount && i < MAX_STRATEGIES; i++) {
-    EEPROM.put(STRATEGIES_ADDRESS + (i * sizeof(LearnedStrategy)), strategyLibrary[i]);
-  }
-  EEPROM.put(STRATEGIES_ADDRESS + (MAX_STRATEGIES * sizeof(LearnedStrategy)), strategyCount);
-  EEPROM.commit();
-  Serial.print("💾 Saved ");
-  Serial.print(strategyCount);
-  Serial.println(" SPEEDIE strategies to memory");
+void stageMetrics(const PerformanceMetrics& snapshot) {
+  persistedMetrics = snapshot;
+  persistentStore.stage(metricsRecord);
 }
 
-void loadStrategiesFromEEPROM() {
-  EEPROM.get(STRATEGIES_ADDRESS + (MAX_STRATEGIES * sizeof(LearnedStrategy)), strategyCount);
-  if (strategyCount > MAX_STRATEGIES) strategyCount = 0;
-  
-  for (int i = 0; i < strategyCount; i++) {
-    EEPROM.get(STRATEGIES_ADDRESS + (i * sizeof(LearnedStrategy)), strategyLibrary[i]);
+// Expects persistedStrategies to hold the new library; only records
+// that differ from flash become dirty
+void stageStrategies() {
+  int changed = persistentStore.stage(strategyCountRecord) ? 1 : 0;
+  for (int i = 0; i < persistedStrategies.count && i < MAX_STRATEGIES; i++) {
+    if (persistentStore.stage(strategyRecords[i])) changed++;
+  }
+  if (changed > 0) {
+    Serial.printf("💾 %d of %d SPEEDIE strategy records changed\n", changed, persistedStrategies.count);
   }
-  Serial.print("📖 Loaded ");
-  Serial.print(strategyCount);
-  Serial.println(" SPEEDIE strategies from memory");
 }
 
-void saveMetricsToEEPROM() {
-  EEPROM.put(METRICS_ADDRESS, metrics);
-  EEPROM.commit();
+void stageVocabulary() {
+  int changed = persistentStore.stage(vocabularySizeRecord) ? 1 : 0;
+  for (int i = 0; i < persistedVocabulary.size && i < MAX_VOCABULARY; i++) {
+    if (persistentStore.stage(vocabularyRecords[i])) changed++;
+  }
+  if (changed > 0) {
+    Serial.printf("💾 %d of %d SPEEDIE vocabulary records changed\n", changed, persistedVocabulary.size);
+  }
 }
 
-void loadMetricsFromEEPROM() {
-  EEPROM.get(METRICS_ADDRESS, metrics);
+void printLoadedMemory() {
+  Serial.println("📖 SPEEDIE Genome loaded from memory");
+  Serial.print("Generation: ");
+  Serial.println(currentGenome.generation);
+  Serial.print("Fitness: ");
+  Serial.println(currentGenome.fitnessScore);
+  Serial.print("📖 Loaded ");
+  Serial.print(strategyCount);
+  Serial.println(" SPEEDIE strategies from memory");
+  Serial.print("📖 Loaded ");
+  Serial.print(vocabulary.size());
+  Serial.println(" SPEEDIE words from vocabulary");
 }
 
-void saveVocabularyToEEPROM() {
-  for (int i = 0; i < vocabularySize && i < MAX_VOCABULARY; i++) {
-    EEPROM.put(VOCABULARY_ADDRESS + (i * sizeof(SignalWord)), vocabulary[i]);
+SignalWord fromLegacyWord(const LegacySignalWord& legacy) {
+  SignalWord word;
+  memset(&word, 0, sizeof(word));
+  word.contextType = legacy.contextType;
+  word.emotionalValence = constrain(legacy.emotionalValence, -100, 100);
+  word.generation = legacy.generation;
+  word.utility = legacy.utility;
+  word.timesUsed = min(legacy.timesUsed, (unsigned long)UINT16_MAX);
+  word.pattern.length = constrain(legacy.patternLength, 0, SPEEDIE_PATTERN_LENGTH);
+  for (int i = 0; i < word.pattern.length; i++) {
+    word.pattern.tones[i] = constrain(legacy.tonePattern[i], 0, UINT16_MAX);
+    word.pattern.durations[i] = constrain(legacy.durationPattern[i], 0, UINT16_MAX);
+  }
+  word.pattern.r = legacy.r;
+  word.pattern.g = legacy.g;
+  word.pattern.b = legacy.b;
+  return word;
+}
+
+// Pre-NVS image: genome, strategies + count, metrics, vocabulary + size.
+// Returns false on a blank (erased) EEPROM, leaving the defaults alone.
+bool loadLegacyEEPROM() {
+  EEPROM.begin(EEPROM_SIZE);
+  
+  bool blank = true;
+  for (int i = 0; i < (int)sizeof(EvolvingGenome); i++) {
+    if (EEPROM.read(GENOME_ADDRESS + i) != 0xFF) {
+      blank = false;
+      break;
+    }
   }
-  EEPROM.put(VOCABULARY_ADDRESS + (MAX_VOCABULARY * sizeof(SignalWord)), vocabularySize);
-  EEPROM.commit();
-  Serial.print("💾 Saved ");
-  Serial.print(vocabularySize);
-  Serial.println(" SPEEDIE words to vocabulary");
-}
-
-void loadVocabularyFromEEPROM() {
-  EEPROM.get(VOCABULARY_ADDRESS + (MAX_VOCABULARY * sizeof(SignalWord)), vocabularySize);
-  if (vocabularySize > MAX_VOCABULARY) vocabularySize = 0;
   
-  for (int i = 0; i < vocabularySize; i++) {
-    EEPROM.get(VOCABULARY_ADDRESS + (i * sizeof(SignalWord)), vocabulary[i]);
+  if (!blank) {
+    EEPROM.get(GENOME_ADDRESS, currentGenome);
+    EEPROM.get(METRICS_ADDRESS, metrics);
+    
+    EEPROM.get(STRATEGIES_ADDRESS + (LEGACY_MAX_STRATEGIES * sizeof(LearnedStrategy)), strategyCount);
+    if (strategyCount < 0 || strategyCount > min(LEGACY_MAX_STRATEGIES, MAX_STRATEGIES)) strategyCount = 0;
+    for (int i = 0; i < strategyCount; i++) {
+      EEPROM.get(STRATEGIES_ADDRESS + (i * sizeof(LearnedStrategy)), strategyLibrary[i]);
+    }
+    
+    int legacySize;
+    EEPROM.get(VOCABULARY_ADDRESS + (MAX_VOCABULARY * sizeof(LegacySignalWord)), legacySize);
+    if (legacySize < 0 || legacySize > MAX_VOCABULARY) legacySize = 0;
+    vocabulary.clear();
+    for (int i = 0; i < legacySize; i++) {
+      LegacySignalWord legacy;
+      EEPROM.get(VOCABULARY_ADDRESS + (i * sizeof(LegacySignalWord)), legacy);
+      vocabulary.add(fromLegacyWord(legacy));
+    }
   }
-  Serial.print("📖 Loaded ");
-  Serial.print(vocabularySize);
-  Serial.println(" SPEEDIE words from vocabulary");
+  
+  EEPROM.end(); // Frees the 4KB RAM mirror; nothing writes EEPROM any more
+  return !blank;
 }
 
-// Generate SPEEDIE-specific signals (faster, more energetic patterns)
-void createNewSignal(int contextType, int emotionalValence) {
-  if (vocabularySize >= MAX_VOCABULARY) {
-    int worstIndex = 0;
-    float worstUtility = vocabulary[0].utility;
-    for (int i = 1; i < vocabularySize; i++) {
-      if (vocabulary[i].utility < worstUtility) {
-        worstUtility = vocabulary[i].utility;
-        worstIndex = i;
+// Setup only (single-threaded): fill the live control state from NVS,
+// migrating the legacy EEPROM image on first boot. begin() validates the
+// manifest in one read; records whose layout changed are never read.
+void loadPersistentMemory() {
+  persistentStore.begin(PERSIST_NAMESPACE, PERSIST_SCHEMA_VERSION);
+  registerPersistentRecords();
+  
+  if (persistentStore.getManifestState() == MANIFEST_MISSING) {
+    if (loadLegacyEEPROM()) {
+      Serial.println("🔁 Migrating SPEEDIE EEPROM image to NVS records...");
+    }
+    
+    persistedMetrics = metrics;
+    memcpy(persistedStrategies.strategies, strategyLibrary, sizeof(strategyLibrary));
+    persistedStrategies.count = strategyCount;
+    for (int i = 0; i < vocabulary.size(); i++) vocabulary.get(i, persistedVocabulary.words[i]);
+    persistedVocabulary.size = vocabulary.size();
+    
+    stageGenome();
+    stageMetrics(persistedMetrics);
+    stageStrategies();
+    stageVocabulary();
+    persistentStore.flushAll();
+    rebuildStrategyIndex();
+    printLoadedMemory();
+    return;
+  }
+  
+  // Each section falls back to its defaults on its own
+  persistentStore.load(genomeRecord);
+  if (persistentStore.load(metricsRecord)) {
+    metrics = persistedMetrics;
+  }
+  
+  // A corrupt record drops that one entry instead of the whole library
+  strategyCount = 0;
+  if (persistentStore.load(strategyCountRecord) &&
+      persistedStrategies.count >= 0 && persistedStrategies.count <= MAX_STRATEGIES) {
+    for (int i = 0; i < persistedStrategies.count; i++) {
+      if (persistentStore.load(strategyRecords[i])) {
+        strategyLibrary[strategyCount++] = persistedStrategies.strategies[i];
+      }
+    }
+  }
+  rebuildStrategyIndex();
+  
+  vocabulary.clear();
+  if (persistentStore.load(vocabularySizeRecord) &&
+      persistedVocabulary.size >= 0 && persistedVocabulary.size <= MAX_VOCABULARY) {
+    for (int i = 0; i < persistedVocabulary.size; i++) {
+      if (persistentStore.load(vocabularyRecords[i])) {
+        vocabulary.add(persistedVocabulary.words[i]);
       }
     }
-    vocabularySize = worstIndex;
   }
   
+  printLoadedMemory();
+}
+
+// Control side: hand a copy of control-owned memory to the comms core,
+// which stages it for the NVS store (see persistenceTask)
+void requestStrategySave() {
+  static StrategySnapshot snapshot; // Static: keeps ~1KB off the control task stack
+  memcpy(snapshot.strategies, strategyLibrary, sizeof(strategyLibrary));
+  snapshot.count = strategyCount;
+  strategySnapshotSlot.publish(snapshot);
+}
+
+void requestVocabularySave() {
+  static VocabularySnapshot snapshot; // Static: keeps ~4KB off the control task stack
+  for (int i = 0; i < vocabulary.size(); i++) vocabulary.get(i, snapshot.words[i]);
+  snapshot.size = vocabulary.size();
+  vocabularySnapshotSlot.publish(snapshot);
+}
+
+// Generate SPEEDIE-specific signals (faster, more energetic patterns).
+// When the vocabulary is full the lowest-utility word makes room.
+int createNewSignal(int contextType, int emotionalValence) {
   SignalWord newWord;
+  memset(&newWord, 0, sizeof(newWord));
   newWord.contextType = contextType;
-  newWord.emotionalValence = emotionalValence;
-  newWord.generation = currentGenome.generation;
+  newWord.emotionalValence = constrain(emotionalValence, -100, 100);
+  newWord.generation = controlGenome.generation;
   newWord.utility = 0.5;
   newWord.timesUsed = 0;
+  newWord.createdAt = millis();
   
-  newWord.patternLength = random(3, 6); // SPEEDIE prefers shorter, punchier signals
+  SignalPattern& pattern = newWord.pattern;
+  pattern.length = random(3, 6); // SPEEDIE prefers shorter, punchier signals
   
   // SPEEDIE color patterns - more vibrant and energetic
   if (emotionalValence < -30) { // Fast distress - bright reds
-    newWord.r = random(40, 80);
-    newWord.g = random(0, 5);
-    newWord.b = random(0, 5);
+    pattern.r = random(40, 80);
+    pattern.g = random(0, 5);
+    pattern.b = random(0, 5);
   } else if (emotionalValence > 30) { // Success - bright blues/greens
-    newWord.r = random(0, 5);
-    newWord.g = random(30, 70);
-    newWord.b = random(40, 80);
+    pattern.r = random(0, 5);
+    pattern.g = random(30, 70);
+    pattern.b = random(40, 80);
   } else { // Neutral - bright whites/cyans
-    newWord.r = random(20, 50);
-    newWord.g = random(30, 60);
-    newWord.b = random(40, 70);
+    pattern.r = random(20, 50);
+    pattern.g = random(30, 60);
+    pattern.b = random(40, 70);
   }
   
-  for (int i = 0; i < newWord.patternLength; i++) {
+  for (int i = 0; i < pattern.length; i++) {
     if (emotionalValence < -30) {
       // SPEEDIE distress - very fast, very high
-      newWord.tonePattern[i] = random(2000, 4000);
-      newWord.durationPattern[i] = random(30, 80);
+      pattern.tones[i] = random(2000, 4000);
+      pattern.durations[i] = random(30, 80);
     } else if (emotionalValence > 30) {
       // SPEEDIE success - rapid ascending patterns
       int baseFreq = random(800, 1500);
-      newWord.tonePattern[i] = baseFreq + (i * 150);
-      newWord.durationPattern[i] = random(50, 120);
+      pattern.tones[i] = baseFreq + (i * 150);
+      pattern.durations[i] = random(50, 120);
     } else {
       // SPEEDIE neutral - moderate but quick
-      newWord.tonePattern[i] = random(1000, 2500);
-      newWord.durationPattern[i] = random(60, 150);
+      pattern.tones[i] = random(1000, 2500);
+      pattern.durations[i] = random(60, 150);
     }
   }
   
-  vocabulary[vocabularySize] = newWord;
-  vocabularySize++;
+  int slot = vocabulary.add(newWord);
   
   Serial.println("⚡ SPEEDIE created new high-energy signal!");
   Serial.print("  Context: ");
@@ -418,7 +817,8 @@ void createNewSignal(int contextType, int emotionalValence) {
   Serial.print(" | Valence: ");
   Serial.print(emotionalValence);
   Serial.print(" | Pattern length: ");
-  Serial.println(newWord.patternLength);
+  Serial.println(pattern.length);
+  return slot;
 }
 
 // ═══════════════════════════════════════════════════════════
@@ -453,19 +853,42 @@ struct PeerLocation {
 
 // Localization state
 Position myPosition;
-PeerLocation peerLocations[MAX_SWARM_PEERS];
-bool isLocalizationActive = false;
+PeerLocation peerLocations[PEER_REGISTRY_CAPACITY]; // Indexed by PeerId
+const float DEAD_RECKONING_MPS_PER_PWM = 1.5 / 255; // ~1.5 m/s flat out (uncalibrated, no encoders)
+const float POSITION_UNIT_CM = 100.0;         // Positions are in metres, the spatial index in cm
+const unsigned long PEER_LOCATION_TIMEOUT = 10000; // Location with no fresh ranging is dropped
+const float PEER_SEARCH_RANGE_CM = SPATIAL_GRID_DIM * SPATIAL_CELL_SIZE; // Whole arena
 
 // Audio beacon settings
 const int BEACON_FREQUENCY = 2000;    // 2kHz tone for beacon
 const int BEACON_DURATION = 200;      // 200ms beacon pulse
-const int BEACON_INTERVAL = 3000;     // Beacon every 3 seconds
 // Using #define LOCALIZATION_FREQUENCY from top of file
 const int PING_DURATION = 100;        // Shorter ping for ranging
+const float PEER_ARRIVAL_M = 0.5;     // navigateToPeer() stops this close
+
+// Tones play from the scheduler's buzzer task, one step at a time
+struct BuzzerStep {
+  uint16_t frequency;        // 0 = silence
+  uint16_t durationMs;
+  uint16_t gapMs;            // Silence after the tone
+};
+
+// Identification: 3 short pulses, then a long one for distance measurement
+const BuzzerStep BEACON_PATTERN[] = {
+  {BEACON_FREQUENCY, 50, 50},
+  {BEACON_FREQUENCY, 50, 50},
+  {BEACON_FREQUENCY, 50, 50},
+  {BEACON_FREQUENCY, BEACON_DURATION, 0}
+};
+// Ping: give the ESP-NOW request a head start, then the ranging tone
+const BuzzerStep PING_PATTERN[] = {
+  {0, 0, 50},
+  {LOCALIZATION_FREQUENCY, PING_DURATION, 0}
+};
 
-unsigned long lastBeaconTime = 0;
-unsigned long lastLocalizationPing = 0;
-bool isBeaconMode = true;  // SPEEDIE acts as beacon by default
+const BuzzerStep* buzzerStep = nullptr;
+uint8_t buzzerStepsLeft = 0;
+unsigned long buzzerNextStep = 0;
 
 // ═══════════════════════════════════════════════════════════
 // 🔊 AUDIO BEACON FUNCTIONS
@@ -479,52 +902,44 @@ void enableBuzzer() {
   }
 }
 
+// Start a pattern; replaces whatever was still playing
+void playBuzzerPattern(const BuzzerStep* pattern, uint8_t steps) {
+  buzzerStep = pattern;
+  buzzerStepsLeft = steps;
+  buzzerNextStep = millis();
+}
+
+// Scheduler task: starts the next step once the previous tone and gap are over
+void buzzerTask() {
+  if (buzzerStepsLeft == 0 || (long)(millis() - buzzerNextStep) < 0) return;
+  
+  const BuzzerStep& step = *buzzerStep++;
+  buzzerStepsLeft--;
+  if (step.frequency > 0) {
+    tone(BUZZER_PIN, step.frequency, step.durationMs);
+  } else {
+    noTone(BUZZER_PIN);
+  }
+  buzzerNextStep = millis() + step.durationMs + step.gapMs;
+}
+
 // Send audio beacon for other bots to locate SPEEDIE
 void sendAudioBeacon() {
   if (!hasBuzzer || BUZZER_PIN < 0) return;
   
   Serial.println("📍 SPEEDIE sending location beacon...");
-  
-  // Send identification pattern: 3 short pulses at beacon frequency
-  for (int i = 0; i < 3; i++) {
-    tone(BUZZER_PIN, BEACON_FREQUENCY, 50);
-    delay(60);
-    noTone(BUZZER_PIN);
-    delay(40);
-  }
-  
-  // Send longer beacon pulse for distance measurement
-  tone(BUZZER_PIN, BEACON_FREQUENCY, BEACON_DURATION);
-  delay(BEACON_DURATION);
-  noTone(BUZZER_PIN);
-  
-  // Flash green LED during beacon
-  setSpeedieColor(0, 255); // Green
-  delay(100);
-  setSpeedieColor(0, 0);   // Off
+  playBuzzerPattern(BEACON_PATTERN, sizeof(BEACON_PATTERN) / sizeof(BEACON_PATTERN[0]));
 }
 
 // Send localization ping to specific peer
-void sendLocalizationPing(uint8_t* targetMac) {
+void sendLocalizationPing(const uint8_t* targetMac) {
   if (!hasBuzzer || BUZZER_PIN < 0) return;
   
   Serial.printf("📍 Sending ping to %s\n", macToString(targetMac).c_str());
   
-  // Send ping notification via ESP-NOW first
+  // Send ping notification via ESP-NOW first; the tone follows it
   sendLocalizationRequest(targetMac);
-  
-  // Small delay then send audio ping
-  delay(50);
-  
-  // Send distinct localization ping
-  tone(BUZZER_PIN, LOCALIZATION_FREQUENCY, PING_DURATION);
-  delay(PING_DURATION);
-  noTone(BUZZER_PIN);
-  
-  // Flash blue-ish (both LEDs) during ping
-  setSpeedieColor(128, 128);
-  delay(50);
-  setSpeedieColor(0, 0);
+  playBuzzerPattern(PING_PATTERN, sizeof(PING_PATTERN) / sizeof(PING_PATTERN[0]));
 }
 
 // Update peer location based on distance measurement
@@ -547,36 +962,36 @@ void updatePeerLocation(uint8_t* peerMac, float distance, float bearing) {
   peer->bearing = bearing;
   peer->lastSeen = millis();
   peer->isActive = true;
+  swarmNode->spatialIndex.updatePeer(peerIndex, peerX * POSITION_UNIT_CM, peerY * POSITION_UNIT_CM);
   
-  Serial.printf("📍 Updated %s location: (%.1f, %.1f) dist:%.1fcm\n", 
+  Serial.printf("📍 Updated %s location: (%.2f, %.2f) dist:%.2fm\n", 
                 macToString(peerMac).c_str(), peerX, peerY, distance);
 }
 
+// Last known location of a peer, or nullptr
+PeerLocation* getPeerLocation(const uint8_t* peerMac) {
+  PeerId id = swarmNode->peerRegistry.find(peerMac);
+  if (id == INVALID_PEER_ID || !peerLocations[id].isActive) return nullptr;
+  return &peerLocations[id];
+}
+
 // Get distance to peer based on last known location
 float getDistanceToPeer(uint8_t* peerMac) {
-  for (int i = 0; i < MAX_SWARM_PEERS; i++) {
-    if (peerLocations[i].isActive && macEquals(peerLocations[i].peerMac, peerMac)) {
-      return peerLocations[i].distance;
-    }
-  }
-  return -1.0; // Unknown distance
+  PeerLocation* location = getPeerLocation(peerMac);
+  return location ? location->distance : -1.0; // -1 = unknown distance
 }
 
 // Get bearing to peer based on last known location
 float getBearingToPeer(uint8_t* peerMac) {
-  for (int i = 0; i < MAX_SWARM_PEERS; i++) {
-    if (peerLocations[i].isActive && macEquals(peerLocations[i].peerMac, peerMac)) {
-      return peerLocations[i].bearing;
-    }
-  }
-  return -1.0; // Unknown bearing
+  PeerLocation* location = getPeerLocation(peerMac);
+  return location ? location->bearing : -1.0; // -1 = unknown bearing
 }
 
 // ═══════════════════════════════════════════════════════════
 // 📡 LOCALIZATION ESP-NOW MESSAGES
 // ═══════════════════════════════════════════════════════════
 
-void sendLocalizationRequest(uint8_t* targetMac) {
+void sendLocalizationRequest(const uint8_t* targetMac) {
   memset(&outgoingMessage, 0, sizeof(SwarmMessage));
   
   outgoingMessage.header.messageType = MSG_LOCALIZATION_REQUEST;
@@ -592,9 +1007,9 @@ void sendLocalizationRequest(uint8_t* targetMac) {
   outgoingMessage.payload.localization.requestType = 1; // Audio ping request
   outgoingMessage.payload.localization.beaconFrequency = LOCALIZATION_FREQUENCY;
   
-  outgoingMessage.header.checksum = calculateChecksum((uint8_t*)&outgoingMessage, sizeof(SwarmMessage) - 1);
+  size_t frameLength = finalizeSwarmMessage(&outgoingMessage, sizeof(LocalizationPayload));
   
-  esp_now_send(targetMac, (uint8_t*)&outgoingMessage, sizeof(SwarmMessage));
+  txQueue.enqueue(targetMac, &outgoingMessage, frameLength);
 }
 
 // Old sendLocalizationResponse removed - using new version with timestamp parameter below
@@ -612,111 +1027,89 @@ void initializeLocalization() {
   myPosition.isValid = true;
   
   // Clear peer locations
-  for (int i = 0; i < MAX_SWARM_PEERS; i++) {
+  for (int i = 0; i < PEER_REGISTRY_CAPACITY; i++) {
     peerLocations[i].isActive = false;
   }
   
   enableBuzzer();
-  isLocalizationActive = true;
   
   Serial.println("📍 SPEEDIE localization system initialized");
   Serial.printf("📍 SPEEDIE position: (%.1f, %.1f) heading: %.1f°\n", 
                 myPosition.x, myPosition.y, myPosition.heading);
 }
 
+// Dead reckoning on the comms core, every POSITION_PERIOD_MS: heading from
+// the IMU snapshot, distance from the control core's last drive command.
+// Rough without wheel encoders, but good enough for coverage and ranging.
 void updateMyPosition() {
-  // Simple dead reckoning based on movement
-  // This is rough estimation - could be improved with wheel encoders
-  
   unsigned long now = millis();
   float deltaTime = (now - myPosition.lastUpdate) / 1000.0; // Convert to seconds
+  myPosition.lastUpdate = now;
   
-  if (deltaTime > 0.1) { // Update every 100ms
-    // Estimate movement based on current motor commands
-    // This is very simplified - actual implementation would need encoder feedback
-    
-    myPosition.heading = currentHeading; // Use IMU heading
-    myPosition.lastUpdate = now;
-    
-    // Dead reckoning would go here - for now just update timestamp
-    // In a real implementation, you'd track wheel rotations and calculate displacement
+  ImuSnapshot imuState;
+  if (!imu.readSnapshot(imuState)) return; // No heading yet: hold position
+  myPosition.heading = imuState.headingDeg;
+  myPosition.isValid = true;
+  
+  float step = latestControl.driveSpeed * DEAD_RECKONING_MPS_PER_PWM * deltaTime;
+  myPosition.x += step * cos(radians(myPosition.heading));
+  myPosition.y += step * sin(radians(myPosition.heading));
+}
+
+// Forget where a peer was once ranging has gone quiet
+void ageOutPeerLocations() {
+  unsigned long now = millis();
+  for (int i = 0; i < PEER_REGISTRY_CAPACITY; i++) {
+    if (peerLocations[i].isActive && (now - peerLocations[i].lastSeen > PEER_LOCATION_TIMEOUT)) {
+      peerLocations[i].isActive = false;
+      swarmNode->spatialIndex.removePeer(i);
+      Serial.printf("📍 Aged out location for peer %d\n", i);
+    }
   }
 }
 
-// Navigate towards a peer using their known location
-bool navigateToPeer(uint8_t* peerMac) {
-  float distance = getDistanceToPeer(peerMac);
-  float bearing = getBearingToPeer(peerMac);
+// Navigate towards a peer using their known location; nullptr heads for
+// the closest peer we have a location for. One motor command per call:
+// the caller runs it every tick until it returns true.
+bool navigateToPeer(const uint8_t* peerMac) {
+  if (peerMac == nullptr) {
+    PeerId nearest = swarmNode->spatialIndex.nearestPeer(myPosition.x * POSITION_UNIT_CM,
+                                                         myPosition.y * POSITION_UNIT_CM,
+                                                         PEER_SEARCH_RANGE_CM);
+    if (nearest == INVALID_PEER_ID) return false;
+    peerMac = swarmNode->peerRegistry.getMac(nearest);
+  }
   
-  if (distance < 0 || bearing < 0) {
+  PeerLocation* location = getPeerLocation(peerMac);
+  if (location == nullptr) {
     Serial.printf("📍 No location data for %s - sending ping\n", macToString(peerMac).c_str());
     sendLocalizationPing(peerMac);
     return false;
   }
   
-  Serial.printf("📍 Navigating to %s: %.1fcm at %.1f°\n", 
-                macToString(peerMac).c_str(), distance, bearing);
-  
   // Calculate turn needed
-  float headingError = bearing - myPosition.heading;
+  float headingError = location->bearing - myPosition.heading;
   while (headingError > 180) headingError -= 360;
   while (headingError < -180) headingError += 360;
   
-  // Turn towards peer if needed
+  // Turn towards peer if needed; the next call checks the heading again
   if (abs(headingError) > 15) { // 15 degree tolerance
     if (headingError > 0) {
       turnRight();
-      delay(100);
     } else {
       turnLeft();
-      delay(100);
     }
-    stopMotors();
     return false; // Still turning
   }
   
   // Move towards peer if reasonably aligned
-  if (distance > 50) { // Stop at 50cm distance
+  if (location->distance > PEER_ARRIVAL_M) {
     moveForward();
-    delay(200);
-    stopMotors();
-  }
-  
-  return (distance <= 50); // Return true if we've reached the peer
-}
-
-// Update localization system
-void updateLocalization() {
-  if (!isLocalizationActive) return;
-  
-  updateMyPosition();
-  
-  unsigned long now = millis();
-  
-  // Send beacon periodically if in beacon mode
-  if (isBeaconMode && (now - lastBeaconTime > BEACON_INTERVAL)) {
-    sendAudioBeacon();
-    lastBeaconTime = now;
-  }
-  
-  // Send localization ping to peers periodically
-  if (now - lastLocalizationPing > 5000) { // Every 5 seconds
-    for (int i = 0; i < MAX_SWARM_PEERS; i++) {
-      if (swarmPeers[i].isActive) {
-        sendLocalizationPing(swarmPeers[i].macAddress);
-        delay(100); // Stagger pings
-      }
-    }
-    lastLocalizationPing = now;
+    return false;
   }
   
-  // Age out old peer locations
-  for (int i = 0; i < MAX_SWARM_PEERS; i++) {
-    if (peerLocations[i].isActive && (now - peerLocations[i].lastSeen > 10000)) {
-      peerLocations[i].isActive = false;
-      Serial.printf("📍 Aged out location for peer %d\n", i);
-    }
-  }
+  stopMotors();
+  return true;
 }
 
 void setSpeedieColor(uint8_t red_intensity, uint8_t green_intensity) {
@@ -730,70 +1123,96 @@ void setSpeedieColor(uint8_t red_intensity, uint8_t green_intensity) {
   ledcWrite(PWM_CH_R_G, green_value);  // Right GREEN LED
 }
 
-void emitSignal(SignalWord* word) {
-  if (word == nullptr) return;
+void writeSignalLeds(uint8_t redValue, uint8_t greenValue) {
+  // Raw PWM values for all 4 individual LEDs (Common Anode: 0=ON, 255=OFF)
+  ledcWrite(PWM_CH_L_R, redValue);    // Left RED LED
+  ledcWrite(PWM_CH_L_G, greenValue);  // Left GREEN LED  
+  ledcWrite(PWM_CH_R_R, redValue);    // Right RED LED
+  ledcWrite(PWM_CH_R_G, greenValue);  // Right GREEN LED
+}
+
+// SignalPlayer output (esp_timer task): any colour channel lit = that LED on
+void writeSignalOutput(uint8_t r, uint8_t g, uint8_t b, uint16_t toneHz) {
+  writeSignalLeds(r > 0 ? 0 : 255, g > 0 ? 0 : 255);
+}
+
+void emitSignal(int slot, uint8_t priority) {
+  if (slot < 0) return;
+  const SignalPattern& pattern = vocabulary.pattern(slot);
   
   // SPEEDIE uses simple Red/Green LED patterns for speed
   // Convert RGB emotions to Red/Green binary states
-  bool isRed = (word->r > word->g); // Red if more red than green
-  bool isGreen = (word->g > word->r); // Green if more green than red
-  
-  // Set LED states based on emotion (Common Anode: 0=ON, 255=OFF)
-  uint8_t red_intensity = isRed ? 0 : 255;    // Turn RED LEDs ON/OFF
-  uint8_t green_intensity = isGreen ? 0 : 255; // Turn GREEN LEDs ON/OFF
-
-  // Control all 4 individual LEDs simultaneously
-  ledcWrite(PWM_CH_L_R, red_intensity);    // Left RED LED
-  ledcWrite(PWM_CH_L_G, green_intensity);  // Left GREEN LED  
-  ledcWrite(PWM_CH_R_R, red_intensity);    // Right RED LED
-  ledcWrite(PWM_CH_R_G, green_intensity);  // Right GREEN LED
-
-  // Quick flash pattern for SPEEDIE
-  for (int i = 0; i < word->patternLength; i++) {
-    delay(word->durationPattern[i] / 2); // Half duration for speed
-    // Quick flash off (both LEDs off)
-    ledcWrite(PWM_CH_L_R, 255); ledcWrite(PWM_CH_L_G, 255);
-    ledcWrite(PWM_CH_R_R, 255); ledcWrite(PWM_CH_R_G, 255);
-    delay(20);
-    // Back to color
-    ledcWrite(PWM_CH_L_R, red_intensity); ledcWrite(PWM_CH_L_G, green_intensity);
-    ledcWrite(PWM_CH_R_R, red_intensity); ledcWrite(PWM_CH_R_G, green_intensity);
+  bool isRed = (pattern.r > pattern.g); // Red if more red than green
+  bool isGreen = (pattern.g > pattern.r); // Green if more green than red
+  
+  // Quick flash pattern for SPEEDIE, left lit when done
+  SignalSequence flash;
+  flash.count = min((int)pattern.length, SPEEDIE_PATTERN_LENGTH);
+  for (int i = 0; i < flash.count; i++) {
+    flash.steps[i] = {(uint8_t)(isRed ? 255 : 0), (uint8_t)(isGreen ? 255 : 0), 0, 0,
+                      (uint16_t)(pattern.durations[i] / 2)}; // Half duration for speed
   }
+  flash.gapMs = SIGNAL_PLAYER_DEFAULT_GAP_MS;
+  flash.endDark = false;
+  signalPlayer.play(flash, priority);
   
   Serial.print("⚡ SPEEDIE SIGNAL: ");
-  for (int i = 0; i < word->patternLength; i++) {
-    Serial.print(word->tonePattern[i]);
+  for (int i = 0; i < pattern.length; i++) {
+    Serial.print(pattern.tones[i]);
     Serial.print("Hz/");
-    Serial.print(word->durationPattern[i]);
+    Serial.print(pattern.durations[i]);
     Serial.print("ms ");
   }
   Serial.println();
   
-  word->timesUsed++;
+  vocabulary.recordUse(slot, millis());
   currentState.lastCommunication = millis();
 }
 
-// Find best matching signal for current context
-SignalWord* findSignalForContext(int contextType, int emotionalValence) {
-  SignalWord* bestMatch = nullptr;
+// Find best matching signal for current context (slot, -1 = none). Same
+// score as a full scan, but buckets are visited own context first and
+// skipped (or their walk cut short) once even their best utility cannot
+// beat the match.
+int findSignalForContext(int contextType, int emotionalValence) {
+  int bestMatch = -1;
   float bestScore = -1.0;
+  uint8_t ownContextBin = vocabulary.contextBin(contextType);
   
-  for (int i = 0; i < vocabularySize; i++) {
-    float contextMatch = (vocabulary[i].contextType == contextType) ? 1.0 : 0.3;
-    float emotionSimilarity = 1.0 - (abs(vocabulary[i].emotionalValence - emotionalValence) / 200.0);
-    float utilityBonus = vocabulary[i].utility * 0.5;
+  for (uint8_t pass = 0; pass < SIGNAL_CONTEXT_BINS; pass++) {
+    uint8_t contextBin = vocabulary.contextBinForPass(pass, ownContextBin);
+    float contextBound = (contextBin == ownContextBin) ? 1.0 : 0.3;
     
-    float score = (contextMatch * 0.5) + (emotionSimilarity * 0.3) + utilityBonus;
-    
-    if (score > bestScore) {
-      bestScore = score;
-      bestMatch = &vocabulary[i];
+    for (uint8_t emotionBin = 0; emotionBin < SIGNAL_EMOTION_BINS; emotionBin++) {
+      int8_t i = vocabulary.head(contextBin * SIGNAL_EMOTION_BINS + emotionBin);
+      if (i < 0) continue;
+      
+      // Closest valence this bin can hold
+      int low, high;
+      vocabulary.valenceRange(emotionBin, low, high);
+      int distance = 0;
+      if (emotionalValence < low) distance = low - emotionalValence;
+      if (emotionalValence > high) distance = emotionalValence - high;
+      float bound = (contextBound * 0.5) + ((1.0 - distance / 200.0) * 0.3);
+      
+      for (; i >= 0; i = vocabulary.next(i)) {
+        if (bound + vocabulary.utility(i) * 0.5 <= bestScore) break; // Rest of the bucket scores lower
+        
+        float contextMatch = (vocabulary.context(i) == contextType) ? 1.0 : 0.3;
+        float emotionSimilarity = 1.0 - (abs(vocabulary.valence(i) - emotionalValence) / 200.0);
+        float utilityBonus = vocabulary.utility(i) * 0.5;
+        
+        float score = (contextMatch * 0.5) + (emotionSimilarity * 0.3) + utilityBonus;
+        
+        if (score > bestScore) {
+          bestScore = score;
+          bestMatch = i;
+        }
+      }
     }
   }
   
-  if (bestScore < 0.5 && vocabularySize < MAX_VOCABULARY) {
-    createNewSignal(contextType, emotionalValence);
-    return &vocabulary[vocabularySize - 1];
+  if (bestScore < 0.5 && !vocabulary.isFull()) {
+    return createNewSignal(contextType, emotionalValence);
   }
   
   return bestMatch;
@@ -802,18 +1221,18 @@ SignalWord* findSignalForContext(int contextType, int emotionalValence) {
 // SPEEDIE emotional state (more aggressive/confident baseline)
 void updateEmotionalState() {
   currentState.frustrationLevel = min(100, trappedAttempts * 35 + 
-                                     (int)(currentGenome.failureCount * 3));
+                                     (int)(controlGenome.failureCount * 3));
   
   if (metrics.obstaclesEncountered > 0) {
     float successRate = (float)metrics.obstaclesCleared / metrics.obstaclesEncountered;
-    currentState.confidenceLevel = (int)(successRate * 60 + currentGenome.fitnessScore * 40);
+    currentState.confidenceLevel = (int)(successRate * 60 + controlGenome.fitnessScore * 40);
   }
   
   currentState.curiosityLevel = 70 - (currentState.frustrationLevel / 3);
   currentState.curiosityLevel = constrain(currentState.curiosityLevel, 30, 90);
   
   currentState.isDistressed = (currentState.frustrationLevel > 60); // Lower threshold
-  currentState.isTriumphant = (currentGenome.fitnessScore > 0.7 && 
+  currentState.isTriumphant = (controlGenome.fitnessScore > 0.7 && 
                               metrics.obstaclesCleared > 3);
 }
 
@@ -827,45 +1246,45 @@ void expressState(int contextType, int emotionalValence) {
   Serial.print(" Curiosity=");
   Serial.println(currentState.curiosityLevel);
   
-  SignalWord* signal = findSignalForContext(contextType, emotionalValence);
-  if (signal != nullptr) {
-    emitSignal(signal);
+  int signal = findSignalForContext(contextType, emotionalValence);
+  if (signal >= 0) {
+    // Obstacle/trapped signals cut off whatever mood was still showing
+    bool urgent = (contextType == 0 || contextType == 2);
+    emitSignal(signal, urgent ? SIGNAL_PRIORITY_ALERT : SIGNAL_PRIORITY_EXPRESSION);
   }
 }
 
 void evolveVocabulary() {
   Serial.println("⚡ SPEEDIE evolving vocabulary...");
   
-  for (int i = 0; i < vocabularySize; i++) {
-    if (vocabulary[i].timesUsed > 0) {
-      float usageBonus = min(1.0, vocabulary[i].timesUsed / 8.0); // Faster usage bonus
+  for (int i = 0; i < vocabulary.size(); i++) {
+    if (vocabulary.timesUsed(i) > 0) {
+      float usageBonus = min(1.0, vocabulary.timesUsed(i) / 8.0); // Faster usage bonus
       
-      float fitnessAlignment = (currentGenome.fitnessScore > 0.5) ? 
-        ((vocabulary[i].emotionalValence > 0) ? 0.3 : -0.1) :
-        ((vocabulary[i].emotionalValence < 0) ? 0.3 : -0.1);
+      float fitnessAlignment = (controlGenome.fitnessScore > 0.5) ? 
+        ((vocabulary.valence(i) > 0) ? 0.3 : -0.1) :
+        ((vocabulary.valence(i) < 0) ? 0.3 : -0.1);
       
-      vocabulary[i].utility = constrain(usageBonus + fitnessAlignment, 0.0, 1.0);
+      vocabulary.setUtility(i, constrain(usageBonus + fitnessAlignment, 0.0, 1.0));
     }
   }
   
-  if (random(0, 100) < 40 && vocabularySize > 0) { // More mutation for SPEEDIE
-    int mutateIndex = random(0, vocabularySize);
-    int elementToMutate = random(0, vocabulary[mutateIndex].patternLength);
+  if (random(0, 100) < 40 && vocabulary.size() > 0) { // More mutation for SPEEDIE
+    int mutateIndex = random(0, vocabulary.size());
+    SignalPattern& pattern = vocabulary.pattern(mutateIndex);
+    int elementToMutate = random(0, pattern.length);
     
-    vocabulary[mutateIndex].tonePattern[elementToMutate] += random(-300, 301);
-    vocabulary[mutateIndex].tonePattern[elementToMutate] = constrain(
-      vocabulary[mutateIndex].tonePattern[elementToMutate], 300, 5000
-    );
+    pattern.tones[elementToMutate] = constrain(pattern.tones[elementToMutate] + random(-300, 301), 300, 5000);
     
     Serial.print("⚡ SPEEDIE mutated signal #");
     Serial.println(mutateIndex);
   }
   
-  saveVocabularyToEEPROM();
+  requestVocabularySave();
 }
 
 void initializeDefaultVocabulary() {
-  if (vocabularySize == 0) {
+  if (vocabulary.size() == 0) {
     Serial.println("⚡ Creating SPEEDIE default vocabulary...");
     
     createNewSignal(0, -50);  // Obstacle detected
@@ -874,7 +1293,7 @@ void initializeDefaultVocabulary() {
     createNewSignal(3, 50);   // Clear path
     createNewSignal(4, 40);   // System/evolving
     
-    saveVocabularyToEEPROM();
+    requestVocabularySave();
   }
 }
 
@@ -981,11 +1400,55 @@ void mutateGenome() {
   Serial.println(currentGenome.generation);
 }
 
+// Gene vector for the swarm gene pool, in SPEEDIE_GENE_BOUNDS order
+void encodeGenome(const EvolvingGenome& genome, int16_t* genes) {
+  genes[0] = genome.motorSpeed;
+  genes[1] = genome.turnSpeed;
+  genes[2] = genome.backupDuration;
+  genes[3] = genome.turnDuration;
+  genes[4] = genome.obstacleThreshold;
+  genes[5] = genome.clearThreshold;
+  genes[6] = genome.scanDelay;
+  genes[7] = genome.aggressiveBackupMultiplier;
+  genes[8] = genome.spinDegreesWhenTrapped;
+  genes[9] = genome.maxAcceleration;
+  genes[10] = genome.corneringSpeed;
+  genes[11] = (int16_t)(genome.gyroSensitivity * 100);
+}
+
+// Parameters only; metadata (counts, fitness, generation) stays ours
+void decodeGenome(const int16_t* genes, EvolvingGenome& genome) {
+  genome.motorSpeed = genes[0];
+  genome.turnSpeed = genes[1];
+  genome.backupDuration = genes[2];
+  genome.turnDuration = genes[3];
+  genome.obstacleThreshold = genes[4];
+  genome.clearThreshold = genes[5];
+  genome.scanDelay = genes[6];
+  genome.aggressiveBackupMultiplier = genes[7];
+  genome.spinDegreesWhenTrapped = genes[8];
+  genome.maxAcceleration = genes[9];
+  genome.corneringSpeed = genes[10];
+  genome.gyroSensitivity = genes[11] / 100.0;
+}
+
 // ═══════════════════════════════════════════════════════════
 // 📊 SPEEDIE FITNESS CALCULATION (SPEED-FOCUSED)
 // ═══════════════════════════════════════════════════════════
 
-void calculateFitness() {
+// What happened since the current candidate took over. The fastest
+// clearance is a lifetime best and cannot be windowed.
+PerformanceMetrics evaluationWindow(const PerformanceMetrics& total) {
+  PerformanceMetrics window = total;
+  window.obstaclesEncountered = total.obstaclesEncountered - evaluationBaseline.obstaclesEncountered;
+  window.obstaclesCleared = total.obstaclesCleared - evaluationBaseline.obstaclesCleared;
+  window.timesTrapped = total.timesTrapped - evaluationBaseline.timesTrapped;
+  window.trapEscapes = total.trapEscapes - evaluationBaseline.trapEscapes;
+  window.totalDistanceTraveled = total.totalDistanceTraveled - evaluationBaseline.totalDistanceTraveled;
+  return window;
+}
+
+void calculateFitness(const PerformanceMetrics& metrics) {
   float successRate = 0.0;
   if (metrics.obstaclesEncountered > 0) {
     successRate = (float)metrics.obstaclesCleared / (float)metrics.obstaclesEncountered;
@@ -1022,7 +1485,26 @@ void calculateFitness() {
 // 🧠 SPEEDIE MEMORY & CONSTRAINT MANAGEMENT
 // ═══════════════════════════════════════════════════════════
 
+// Index score: SPEEDIE weighs both success rate and speed
+float strategyScore(const LearnedStrategy& strategy) {
+  float successScore = strategy.successRate;
+  float speedScore = 1.0 / max(strategy.avgCompletionTime, 100.0f); // Favor faster strategies
+  return (successScore * 0.7) + (speedScore * 0.3);
+}
+
+void indexStrategy(int i) {
+  const LearnedStrategy& strategy = strategyLibrary[i];
+  strategyIndex.set(i, strategy.contextDistance, strategy.turnDirection, strategyScore(strategy));
+}
+
+// After anything that moves entries around; O(strategyCount)
+void rebuildStrategyIndex() {
+  strategyIndex.clear();
+  for (int i = 0; i < strategyCount; i++) indexStrategy(i);
+}
+
 void pruneWeakStrategies() {
+  int before = strategyCount;
   for (int i = strategyCount - 1; i >= 0; i--) {
     if (strategyLibrary[i].timesUsed >= 2 &&  // Lower threshold for SPEEDIE
         strategyLibrary[i].successRate < 0.4) {
@@ -1035,6 +1517,7 @@ void pruneWeakStrategies() {
       strategyCount--;
     }
   }
+  if (strategyCount != before) rebuildStrategyIndex();
 }
 
 void compactStrategyArray() {
@@ -1047,7 +1530,10 @@ void compactStrategyArray() {
       writeIndex++;
     }
   }
-  strategyCount = writeIndex;
+  if (strategyCount != writeIndex) {
+    strategyCount = writeIndex;
+    rebuildStrategyIndex();
+  }
   Serial.print("⚡ Compacted SPEEDIE strategy array to ");
   Serial.print(strategyCount);
   Serial.println(" strategies");
@@ -1066,6 +1552,20 @@ void applyEvolutionaryConstraints() {
 // ═══════════════════════════════════════════════════════════
 // 🔄 SPEEDIE EVOLUTION ENGINE (FASTER CYCLES)
 // ═══════════════════════════════════════════════════════════
+// Runs on the comms core. It owns currentGenome; anything touching
+// control-owned state (signals, vocabulary, strategies) is posted to
+// the control core as a ControlCommand.
+
+void postControlCommand(ControlCommandType type, int a, int b) {
+  ControlCommand command = {(uint8_t)type, (int16_t)a, (int16_t)b};
+  if (!controlCommands.push(command)) {
+    droppedControlCommands++;
+  }
+}
+
+void postExpressState(int contextType, int emotionalValence) {
+  postControlCommand(CMD_EXPRESS_STATE, contextType, emotionalValence);
+}
 
 void evolutionCycle() {
   if (!evolutionEnabled) return;
@@ -1084,16 +1584,31 @@ void evolutionCycle() {
   Serial.println("       SPEEDIE EVOLUTION CYCLE TRIGGERED");
   Serial.println("═══════════════════════════════════════ ⚡\n");
   
-  expressState(4, 10); // Context: evolving, slightly positive
+  postExpressState(4, 10); // Context: evolving, slightly positive
   
-  calculateFitness();
+  // Each candidate is judged on its own window, so results compare across bots
+  calculateFitness(evaluationWindow(latestControl.metrics));
+  evaluationBaseline = latestControl.metrics;
   
-  if (currentGenome.generation > 0) {
+  int16_t genes[GENOME_MAX_GENES];
+  encodeGenome(currentGenome, genes);
+  genePool.recordEvaluation(genes, currentGenome.fitnessScore, currentGenome.generation, now);
+  
+  if (genePool.breed(genes, now)) {
+    // Island mode: the next candidate comes from the swarm-wide population
+    Serial.printf("🧬 Breeding from swarm gene pool (%d genomes, best %.3f)\n",
+                  genePool.getPopulation(now), genePool.getBest(now)->fitness);
+    previousGenome = currentGenome;
+    decodeGenome(genes, currentGenome);
+    currentGenome.generation++;
+    
+    postExpressState(1, 40);
+  } else if (currentGenome.generation > 0) {
     if (currentGenome.fitnessScore >= previousGenome.fitnessScore) {
       Serial.println("⚡ SPEEDIE Mutation SUCCESSFUL - keeping changes");
       currentGenome.successCount++;
       
-      expressState(1, 90); // Very positive for success
+      postExpressState(1, 90); // Very positive for success
       
       if (random(0, 100) < 40) { // Higher chance for bonus mutation
         Serial.println("⚡ Bonus SPEEDIE mutation for successful genome");
@@ -1105,21 +1620,24 @@ void evolutionCycle() {
       currentGenome.failureCount++;
       currentGenome.generation++;
       
-      expressState(1, -50); // More negative reaction
+      postExpressState(1, -50); // More negative reaction
     }
   } else {
     mutateGenome();
   }
   
-  if (vocabularySize > 0) {
-    evolveVocabulary();
+  if (latestControl.vocabularySize > 0) {
+    postControlCommand(CMD_EVOLVE_VOCABULARY, 0, 0);
   }
   
-  saveGenomeToEEPROM();
-  saveMetricsToEEPROM();
+  stageGenome();
+  stageMetrics(latestControl.metrics);
   
   applyEvolutionaryConstraints();
-  pruneWeakStrategies();
+  postControlCommand(CMD_PRUNE_STRATEGIES, 0, 0);
+  
+  // Hand the new genome to the control core
+  genomeSlot.publish(currentGenome);
   
   Serial.println("\n⚡ Current SPEEDIE Genome:");
   Serial.print("  Motor Speed: ");
@@ -1129,7 +1647,7 @@ void evolutionCycle() {
   Serial.print("  Max Acceleration: ");
   Serial.println(currentGenome.maxAcceleration);
   Serial.print("  Vocabulary Size: ");
-  Serial.println(vocabularySize);
+  Serial.println(latestControl.vocabularySize);
   Serial.println("\n═══════════════════════════════════════\n");
 }
 
@@ -1140,14 +1658,8 @@ void evolutionCycle() {
 // ═══════════════════════════════════════════════════════════
 
 void learnStrategy(int distance, int direction, int backupTime, int turnTime, bool succeeded, unsigned long completionTime) {
-  int similarIndex = -1;
-  for (int i = 0; i < strategyCount; i++) {
-    if (abs(strategyLibrary[i].contextDistance - distance) < 40 && // Tighter matching for SPEEDIE
-        strategyLibrary[i].turnDirection == direction) {
-      similarIndex = i;
-      break;
-    }
-  }
+  // Tighter matching for SPEEDIE; only the neighbouring bands are searched
+  int similarIndex = strategyIndex.findSimilar(distance, 40, direction);
   
   if (similarIndex >= 0) {
     strategyLibrary[similarIndex].timesUsed++;
@@ -1160,6 +1672,7 @@ void learnStrategy(int distance, int direction, int backupTime, int turnTime, bo
     strategyLibrary[similarIndex].successRate = 
       (float)strategyLibrary[similarIndex].timesSucceeded / 
       (float)strategyLibrary[similarIndex].timesUsed;
+    indexStrategy(similarIndex);
     
     Serial.print("⚡ Updated SPEEDIE strategy #");
     Serial.print(similarIndex);
@@ -1176,6 +1689,7 @@ void learnStrategy(int distance, int direction, int backupTime, int turnTime, bo
     strategyLibrary[strategyCount].timesSucceeded = succeeded ? 1 : 0;
     strategyLibrary[strategyCount].successRate = succeeded ? 1.0 : 0.0;
     strategyLibrary[strategyCount].avgCompletionTime = completionTime;
+    indexStrategy(strategyCount);
     
     Serial.print("⚡ Learned new SPEEDIE strategy #");
     Serial.println(strategyCount);
@@ -1194,6 +1708,7 @@ void learnStrategy(int distance, int direction, int backupTime, int turnTime, bo
       strategyLibrary[strategyCount].timesSucceeded = succeeded ? 1 : 0;
       strategyLibrary[strategyCount].successRate = succeeded ? 1.0 : 0.0;
       strategyLibrary[strategyCount].avgCompletionTime = completionTime;
+      indexStrategy(strategyCount);
       
       Serial.print("⚡ Added SPEEDIE strategy after cleanup #");
       Serial.println(strategyCount);
@@ -1202,29 +1717,16 @@ void learnStrategy(int distance, int direction, int backupTime, int turnTime, bo
   }
   
   if (random(0, 100) < 30) { // Higher save frequency for SPEEDIE
-    saveStrategiesToEEPROM();
+    requestStrategySave();
   }
 }
 
+// Constant time: reads the cached best of each nearby distance band
 LearnedStrategy* getBestStrategy(int currentDistance) {
   if (strategyCount == 0) return nullptr;
   
-  int bestIndex = -1;
-  float bestScore = -1.0;
-  
-  // SPEEDIE considers both success rate and speed
-  for (int i = 0; i < strategyCount; i++) {
-    if (abs(strategyLibrary[i].contextDistance - currentDistance) < 80) {
-      float successScore = strategyLibrary[i].successRate;
-      float speedScore = 1.0 / max(strategyLibrary[i].avgCompletionTime, 100.0f); // Favor faster strategies
-      float combinedScore = (successScore * 0.7) + (speedScore * 0.3);
-      
-      if (combinedScore > bestScore && strategyLibrary[i].timesUsed >= 1) { // Lower threshold
-        bestScore = combinedScore;
-        bestIndex = i;
-      }
-    }
-  }
+  // SPEEDIE considers both success rate and speed (strategyScore)
+  int bestIndex = strategyIndex.best(currentDistance, STRATEGY_MATCH_BANDS);
   
   if (bestIndex >= 0) {
     Serial.print("⚡ Using fast SPEEDIE strategy #");
@@ -1245,6 +1747,8 @@ LearnedStrategy* getBestStrategy(int currentDistance) {
 // ═══════════════════════════════════════════════════════════
 
 void stopMotorsBrake() {
+  driveSpeed = 0;
+  motorsRunning = false;
   ledcWrite(PWM_CHANNEL_LEFT1, 255);
   ledcWrite(PWM_CHANNEL_LEFT2, 255);
   ledcWrite(PWM_CHANNEL_RIGHT1, 255);
@@ -1252,6 +1756,8 @@ void stopMotorsBrake() {
 }
 
 void stopMotorsCoast() {
+  driveSpeed = 0;
+  motorsRunning = false;
   ledcWrite(PWM_CHANNEL_LEFT1, 0);
   ledcWrite(PWM_CHANNEL_LEFT2, 0);
   ledcWrite(PWM_CHANNEL_RIGHT1, 0);
@@ -1263,34 +1769,42 @@ void stopMotors() {
 }
 
 void moveForward() {
-  ledcWrite(PWM_CHANNEL_LEFT1, currentGenome.motorSpeed);
+  driveSpeed = controlGenome.motorSpeed;
+  motorsRunning = true;
+  ledcWrite(PWM_CHANNEL_LEFT1, controlGenome.motorSpeed);
   ledcWrite(PWM_CHANNEL_LEFT2, 0);
-  ledcWrite(PWM_CHANNEL_RIGHT1, currentGenome.motorSpeed);
+  ledcWrite(PWM_CHANNEL_RIGHT1, controlGenome.motorSpeed);
   ledcWrite(PWM_CHANNEL_RIGHT2, 0);
   lastActivityTime = millis();
 }
 
 void moveBackward() {
+  driveSpeed = -controlGenome.motorSpeed;
+  motorsRunning = true;
   ledcWrite(PWM_CHANNEL_LEFT1, 0);
-  ledcWrite(PWM_CHANNEL_LEFT2, currentGenome.motorSpeed);
+  ledcWrite(PWM_CHANNEL_LEFT2, controlGenome.motorSpeed);
   ledcWrite(PWM_CHANNEL_RIGHT1, 0);
-  ledcWrite(PWM_CHANNEL_RIGHT2, currentGenome.motorSpeed);
+  ledcWrite(PWM_CHANNEL_RIGHT2, controlGenome.motorSpeed);
   lastActivityTime = millis();
 }
 
 void turnLeft() {
+  driveSpeed = 0;
+  motorsRunning = true;
   ledcWrite(PWM_CHANNEL_LEFT1, 0);
-  ledcWrite(PWM_CHANNEL_LEFT2, currentGenome.corneringSpeed);
-  ledcWrite(PWM_CHANNEL_RIGHT1, currentGenome.corneringSpeed);
+  ledcWrite(PWM_CHANNEL_LEFT2, controlGenome.corneringSpeed);
+  ledcWrite(PWM_CHANNEL_RIGHT1, controlGenome.corneringSpeed);
   ledcWrite(PWM_CHANNEL_RIGHT2, 0);
   lastActivityTime = millis();
 }
 
 void turnRight() {
-  ledcWrite(PWM_CHANNEL_LEFT1, currentGenome.corneringSpeed);
+  driveSpeed = 0;
+  motorsRunning = true;
+  ledcWrite(PWM_CHANNEL_LEFT1, controlGenome.corneringSpeed);
   ledcWrite(PWM_CHANNEL_LEFT2, 0);
   ledcWrite(PWM_CHANNEL_RIGHT1, 0);
-  ledcWrite(PWM_CHANNEL_RIGHT2, currentGenome.corneringSpeed);
+  ledcWrite(PWM_CHANNEL_RIGHT2, controlGenome.corneringSpeed);
   lastActivityTime = millis();
 }
 
@@ -1303,6 +1817,8 @@ void accelerateForward(int targetSpeed, int acceleration) {
   } else if (currentSpeed > targetSpeed) {
     currentSpeed = max(currentSpeed - acceleration, targetSpeed);
   }
+  driveSpeed = currentSpeed;
+  motorsRunning = currentSpeed > 0;
   
   ledcWrite(PWM_CHANNEL_LEFT1, currentSpeed);
   ledcWrite(PWM_CHANNEL_LEFT2, 0);
@@ -1328,69 +1844,75 @@ int median(int arr[], int n) {
   return arr[n/2];
 }
 
-int readUltrasonicDistance() {
-  digitalWrite(ULTRASONIC_TRIG_PIN, LOW);
-  delayMicroseconds(2);
-  digitalWrite(ULTRASONIC_TRIG_PIN, HIGH);
-  delayMicroseconds(10);
-  digitalWrite(ULTRASONIC_TRIG_PIN, LOW);
+// Non-blocking: true when a ping finished since the last call (mm or SENSOR_ERROR_VALUE)
+bool readUltrasonicDistance(int& distanceMm) {
+  ultrasonicRanger.update();
   
-  unsigned long duration = pulseIn(ULTRASONIC_ECHO_PIN, HIGH, 30000); // 30ms timeout
-  if (duration == 0) return SENSOR_ERROR_VALUE;
+  RangeReading reading;
+  if (!ultrasonicRanger.poll(reading)) return false; // Ping still in flight
   
-  int distance = duration * 0.034 / 2; // Convert to mm
-  return distance * 10; // Convert cm to mm for consistency
+  distanceMm = reading.valid ? reading.distanceMm : SENSOR_ERROR_VALUE;
+  return true;
 }
 
 void updateIMU() {
-  sensors_event_t a, g, temp;
-  if (mpu.getEvent(&a, &g, &temp)) {
-    // Simple gyro integration for heading
-    currentHeading += g.gyro.z * currentGenome.gyroSensitivity * 0.1; // Rough integration
-    
-    // Keep heading in 0-360 range
-    while (currentHeading >= 360.0) currentHeading -= 360.0;
-    while (currentHeading < 0.0) currentHeading += 360.0;
+  // Only touches the bus once a FIFO batch is waiting
+  if (imu.update()) {
+    const ImuSnapshot& state = imu.current();
+    currentHeading = state.headingDeg;
+    postAcceleration(state.linearAccel);
+    postMotionDetected(!state.still); // SPEEDIE's only motion sensor
   }
 }
 
-int readDistanceFused() {
+bool readDistanceFused(int& distance) {
   // SPEEDIE uses ultrasonic primarily, IMU for confirmation
-  int ultrasonicReading = readUltrasonicDistance();
-  
   updateIMU();
   
+  int ultrasonicReading;
+  if (!readUltrasonicDistance(ultrasonicReading)) return false;
+  
   if (ultrasonicReading == SENSOR_ERROR_VALUE) {
     consecutiveSensorErrors++;
-    if (consecutiveSensorErrors >= MAX_CONSECUTIVE_ERRORS) {
+    if (consecutiveSensorErrors == MAX_CONSECUTIVE_ERRORS && !isAvoiding) {
+      // One brake per error burst; the control loop then creeps at cautious speed
       Serial.println("⚡ SPEEDIE sensor recovery...");
       stopMotors();
-      delay(50); // Shorter delay for SPEEDIE
     }
-    return SENSOR_ERROR_VALUE;
+    distance = SENSOR_ERROR_VALUE;
+    return true;
   }
   
   consecutiveSensorErrors = 0;
-  return ultrasonicReading;
+  distance = ultrasonicReading;
+  return true;
 }
 
 int readDistance() {
-  // Multiple sensor readings for reliability (but faster for SPEEDIE)
-  int distances[2]; // Only 2 readings for speed
-  for(int i = 0; i < 2; i++) {
-    distances[i] = readDistanceFused();
-    delay(5); // Shorter delay
-  }
-  
-  if (distances[0] == SENSOR_ERROR_VALUE && distances[1] == SENSOR_ERROR_VALUE) {
-    return SENSOR_ERROR_VALUE;
-  } else if (distances[0] == SENSOR_ERROR_VALUE) {
-    return distances[1];
-  } else if (distances[1] == SENSOR_ERROR_VALUE) {
-    return distances[0];
+  // Running 2-sample filter over finished pings; between pings the last
+  // estimate is held so every control tick sees a current value
+  int current;
+  if (!readDistanceFused(current)) {
+    if (millis() - lastRangeTime > RANGE_STALE_MS) {
+      filteredDistance = SENSOR_ERROR_VALUE; // Ranger has gone quiet
+    }
+    return filteredDistance;
+  }
+  
+  lastRangeTime = millis();
+  int previous = previousRawDistance;
+  previousRawDistance = current;
+  
+  if (current == SENSOR_ERROR_VALUE && previous == SENSOR_ERROR_VALUE) {
+    filteredDistance = SENSOR_ERROR_VALUE;
+  } else if (current == SENSOR_ERROR_VALUE) {
+    filteredDistance = previous;
+  } else if (previous == SENSOR_ERROR_VALUE) {
+    filteredDistance = current;
   } else {
-    return (distances[0] + distances[1]) / 2; // Simple average for speed
+    filteredDistance = (current + previous) / 2; // Simple average for speed
   }
+  return filteredDistance;
 }
 
 // ═══════════════════════════════════════════════════════════
@@ -1403,9 +1925,9 @@ void checkSleepTimeout() {
     isAwake = false;
     trappedAttempts = 0;
     
-    saveGenomeToEEPROM();
-    saveStrategiesToEEPROM();
-    saveMetricsToEEPROM();
+    // Genome/metrics are written by the comms core from its own copies
+    persistRequests.fetch_or(PERSIST_GENOME | PERSIST_METRICS);
+    requestStrategySave();
     
     stopMotorsCoast();
   }
@@ -1415,252 +1937,355 @@ void checkSleepTimeout() {
 // 🆘 SPEEDIE AGGRESSIVE ESCAPE (ULTRA-FAST)
 // ═══════════════════════════════════════════════════════════
 
-void aggressiveEscape() {
+void enterEscapePhase(EscapePhase phase, unsigned long durationMs) {
+  escape.phase = phase;
+  escape.phaseDeadline = millis() + durationMs;
+}
+
+void finishObstacleEscape() {
+  escape.phase = ESCAPE_IDLE;
+  isAvoiding = false;
+}
+
+void startAggressiveEscape() {
   Serial.println("\n⚡ === SPEEDIE TRAPPED! ULTRA-FAST ESCAPE ===");
   metrics.timesTrapped++;
   
   expressState(2, -95); // Very negative
   
-  unsigned long escapeStart = millis();
+  escape.trapStartTime = millis();
   
-  int backupTime = currentGenome.backupDuration * currentGenome.aggressiveBackupMultiplier;
-  int spinTime = (currentGenome.spinDegreesWhenTrapped * currentGenome.turnDuration) / 180;
+  int backupTime = controlGenome.backupDuration * controlGenome.aggressiveBackupMultiplier;
+  escape.spinTime = (controlGenome.spinDegreesWhenTrapped * controlGenome.turnDuration) / 180;
   
   // SPEEDIE's ultra-fast escape sequence
   Serial.print("⚡ Fast backing up for ");
   Serial.print(backupTime / 2); // Half time for speed
   Serial.println("ms");
   moveBackward();
-  delay(backupTime / 2);
-  stopMotors();
-  delay(100); // Shorter pause
-  
-  Serial.print("⚡ Rapid spinning ");
-  Serial.print(currentGenome.spinDegreesWhenTrapped);
-  Serial.println(" degrees");
-  turnRight();
-  delay(spinTime / 2); // Half time for speed
-  stopMotors();
-  delay(100);
-  
-  Serial.println("⚡ Power charging forward!");
-  accelerateForward(255, currentGenome.maxAcceleration);
-  delay(800); // Shorter charge
-  stopMotors();
-  delay(100);
-  
-  unsigned long escapeTime = millis() - escapeStart;
+  enterEscapePhase(ESCAPE_TRAP_BACKUP, backupTime / 2);
+}
+
+void finishAggressiveEscape() {
+  unsigned long escapeTime = millis() - escape.trapStartTime;
   metrics.averageEscapeTime = (metrics.averageEscapeTime + escapeTime) / 2.0;
   
-  int checkDistance = readDistance();
-  if (checkDistance > currentGenome.clearThreshold) {
+  if (latestDistance > controlGenome.clearThreshold) {
     Serial.println("⚡ SPEEDIE escape successful!");
     metrics.trapEscapes++;
     trappedAttempts = 0;
+    postTaskState(true, true);
     
     expressState(1, 85); // Very positive
   } else {
     Serial.println("⚡ Still trapped, SPEEDIE will retry");
     expressState(2, -85);
   }
+  
+  finishObstacleEscape();
 }
 
 // ═══════════════════════════════════════════════════════════
 // 🎯 SPEEDIE OBSTACLE AVOIDANCE (SPEED-OPTIMIZED)
 // ═══════════════════════════════════════════════════════════
+// handleObstacle() only picks the plan and starts the first phase;
+// updateObstacleEscape() advances it from the control task, so the
+// sensor, comms and ecosystem keep running while SPEEDIE manoeuvres.
 
 void handleObstacle() {
   if (isAvoiding) return;
   
   isAvoiding = true;
   metrics.obstaclesEncountered++;
-  unsigned long obstacleStartTime = millis();
+  escape.startTime = millis();
+  escape.initialDistance = latestDistance;
+  escape.clearPathFound = false;
+  escape.bestDirection = 0;
+  escape.bestDistance = 0;
   
-  int initialDistance = readDistance();
   Serial.println("\n⚡ === SPEEDIE OBSTACLE DETECTED ===");
   Serial.print("Distance: ");
-  Serial.println(initialDistance);
+  Serial.println(escape.initialDistance);
   
   expressState(0, -40);
   
-  LearnedStrategy* learnedMove = getBestStrategy(initialDistance);
-  bool useLearnedStrategy = (learnedMove != nullptr && random(0, 100) < 85); // Higher confidence
+  // Learned moves suit a settled area; where the context keeps changing,
+  // or escapes here mostly get stuck, look around more often instead
+  int learnedChance = 85; // Higher confidence
+  if (getMostFrequentContextId() == CONTEXT_ID_TASK_FAILURE) {
+    learnedChance = 30;
+  } else if (controlContextStability < CONTEXT_SETTLED_STABILITY) {
+    learnedChance = 60;
+  }
   
-  bool succeeded = false;
-  int backupTime, turnTime, direction;
+  LearnedStrategy* learnedMove = getBestStrategy(escape.initialDistance);
+  escape.useLearned = (learnedMove != nullptr && random(0, 100) < learnedChance);
   
-  if (useLearnedStrategy) {
+  if (escape.useLearned) {
     Serial.println("⚡ Applying fast learned strategy...");
     
     expressState(1, 30);
     
-    backupTime = learnedMove->backupTime / 2; // Faster execution
-    turnTime = learnedMove->turnTime / 2;
-    direction = learnedMove->turnDirection;
-    
-    stopMotors();
-    delay(50); // Minimal pause
-    
-    moveBackward();
-    delay(backupTime);
-    stopMotors();
-    delay(100);
-    
-    if (direction == 0) {
-      turnLeft();
-    } else {
-      turnRight();
-    }
-    delay(turnTime);
-    stopMotors();
-    delay(currentGenome.scanDelay);
-    
-    int finalCheck = readDistance();
-    if (finalCheck > currentGenome.clearThreshold || finalCheck == SENSOR_ERROR_VALUE) {
-      Serial.println("⚡ Fast strategy worked!");
-      accelerateForward(currentGenome.motorSpeed, currentGenome.maxAcceleration);
-      delay(400);
-      succeeded = true;
-      metrics.obstaclesCleared++;
-      
-      unsigned long completionTime = millis() - obstacleStartTime;
-      if (completionTime < metrics.fastestObstacleTime) {
-        metrics.fastestObstacleTime = completionTime;
-        Serial.print("⚡ NEW SPEED RECORD: ");
-        Serial.println(completionTime);
-      }
-      
-      expressState(1, 75);
-    } else {
-      Serial.println("❌ Fast strategy failed");
-      trappedAttempts++;
-      expressState(0, -60);
-    }
-    
-    learnStrategy(initialDistance, direction, backupTime * 2, turnTime * 2, succeeded, millis() - obstacleStartTime);
-    
+    escape.backupTime = learnedMove->backupTime / 2; // Faster execution
+    escape.turnTime = learnedMove->turnTime / 2;
+    escape.direction = learnedMove->turnDirection;
   } else {
     Serial.println("⚡ SPEEDIE exploring new fast approach...");
     
     expressState(3, 10);
     
-    stopMotors();
-    delay(50);
-    
-    backupTime = currentGenome.backupDuration / 2; // Faster backup
-    moveBackward();
-    delay(backupTime);
-    stopMotors();
-    delay(100);
-    
-    // Quick scan (fewer positions for speed)
-    bool clearPathFound = false;
-    int bestDirection = 0;
-    int bestDistance = 0;
-    
-    // Quick left scan
-    turnLeft();
-    delay(currentGenome.turnDuration / 2);
-    stopMotors();
-    delay(currentGenome.scanDelay / 2);
-    
-    int leftDistance = readDistance();
-    if (leftDistance == SENSOR_ERROR_VALUE) leftDistance = 0;
-    
-    if (leftDistance > currentGenome.clearThreshold && leftDistance > bestDistance) {
-      bestDistance = leftDistance;
-      bestDirection = 0;
-      clearPathFound = true;
-    }
-    
-    // Return to center quickly
-    turnRight();
-    delay(currentGenome.turnDuration);
-    stopMotors();
-    delay(currentGenome.scanDelay / 2);
-    
-    // Quick right scan if needed
-    if (!clearPathFound) {
-      turnRight();
-      delay(currentGenome.turnDuration / 2);
-      stopMotors();
-      delay(currentGenome.scanDelay / 2);
-      
-      int rightDistance = readDistance();
-      if (rightDistance == SENSOR_ERROR_VALUE) rightDistance = 0;
-      
-      if (rightDistance > currentGenome.clearThreshold && rightDistance > bestDistance) {
-        bestDistance = rightDistance;
-        bestDirection = 1;
-        clearPathFound = true;
-      }
-      
-      // Return to center
-      turnLeft();
-      delay(currentGenome.turnDuration);
-      stopMotors();
-      delay(currentGenome.scanDelay / 2);
-    }
-    
-    // Execute maneuver
-    if (clearPathFound) {
-      expressState(3, 60);
-      
-      turnTime = currentGenome.turnDuration;
-      direction = bestDirection;
-      
-      if (bestDirection == 0) {
+    escape.backupTime = controlGenome.backupDuration / 2; // Faster backup
+  }
+  
+  stopMotors();
+  enterEscapePhase(ESCAPE_PAUSE, 50); // Minimal pause
+}
+
+// Record a successful clearance once the forward dash has finished
+void completeObstacleClearance() {
+  metrics.obstaclesCleared++;
+  postTaskState(true, true);
+  
+  unsigned long completionTime = millis() - escape.startTime;
+  if (completionTime < metrics.fastestObstacleTime) {
+    metrics.fastestObstacleTime = completionTime;
+    Serial.print(escape.useLearned ? "⚡ NEW SPEED RECORD: " : "⚡ NEW EXPLORATION SPEED RECORD: ");
+    Serial.println(completionTime);
+  }
+  
+  if (escape.useLearned) {
+    expressState(1, 75);
+    learnStrategy(escape.initialDistance, escape.direction, escape.backupTime * 2,
+                  escape.turnTime * 2, true, completionTime);
+  } else {
+    trappedAttempts = 0;
+    expressState(1, 80);
+    learnStrategy(escape.initialDistance, escape.direction, escape.backupTime * 2,
+                  escape.turnTime, true, completionTime);
+  }
+  
+  finishObstacleEscape();
+}
+
+// Final check after a turn: dash forward if clear, otherwise give up this attempt
+void verifyEscapeTurn() {
+  int finalCheck = latestDistance;
+  if (finalCheck > controlGenome.clearThreshold || finalCheck == SENSOR_ERROR_VALUE) {
+    if (escape.useLearned) Serial.println("⚡ Fast strategy worked!");
+    escape.chargeSpeed = controlGenome.motorSpeed;
+    accelerateForward(escape.chargeSpeed, controlGenome.maxAcceleration);
+    enterEscapePhase(ESCAPE_CHARGE, 400);
+    return;
+  }
+  
+  trappedAttempts++;
+  if (escape.useLearned) {
+    Serial.println("❌ Fast strategy failed");
+    expressState(0, -60);
+    learnStrategy(escape.initialDistance, escape.direction, escape.backupTime * 2,
+                  escape.turnTime * 2, false, millis() - escape.startTime);
+  } else {
+    expressState(0, -50);
+    learnStrategy(escape.initialDistance, escape.direction, escape.backupTime * 2,
+                  escape.turnTime, false, millis() - escape.startTime);
+  }
+  
+  finishObstacleEscape();
+}
+
+void sampleScanDirection(int direction) {
+  int scanDistance = latestDistance;
+  if (scanDistance == SENSOR_ERROR_VALUE) scanDistance = 0;
+  
+  if (scanDistance <= controlGenome.clearThreshold) return;
+  
+  // A clear side facing unexplored ground beats a slightly longer one
+  if (direction == unexploredSide.load()) scanDistance += UNEXPLORED_SIDE_BONUS_MM;
+  if (scanDistance > escape.bestDistance) {
+    escape.bestDistance = scanDistance;
+    escape.bestDirection = direction;
+    escape.clearPathFound = true;
+  }
+}
+
+void beginExploreManoeuvre() {
+  expressState(3, 60);
+  
+  escape.turnTime = controlGenome.turnDuration;
+  escape.direction = escape.bestDirection;
+  
+  if (escape.bestDirection == 0) {
+    turnLeft();
+  } else {
+    turnRight();
+  }
+  enterEscapePhase(ESCAPE_EXPLORE_TURN, escape.turnTime);
+}
+
+void handleNoClearPath() {
+  trappedAttempts++;
+  expressState(2, -70);
+  
+  if (trappedAttempts >= MAX_TRAPPED_ATTEMPTS) {
+    startAggressiveEscape();
+  } else {
+    Serial.println("⚡ No clear path, quick backup");
+    moveBackward();
+    enterEscapePhase(ESCAPE_QUICK_BACKUP, 500);
+  }
+}
+
+// Advance the escape manoeuvre - called once per control tick
+void updateObstacleEscape() {
+  if (escape.phase == ESCAPE_IDLE) return;
+  
+  // Forward dashes keep ramping every tick and are cut short by a new obstacle
+  if (escape.phase == ESCAPE_CHARGE || escape.phase == ESCAPE_TRAP_CHARGE) {
+    if (latestDistance < controlGenome.obstacleThreshold) {
+      escape.phaseDeadline = millis();
+    } else {
+      accelerateForward(escape.chargeSpeed, controlGenome.maxAcceleration);
+    }
+  }
+  
+  if ((long)(millis() - escape.phaseDeadline) < 0) return;
+  
+  switch (escape.phase) {
+    // Shared opening: brake, back up, settle
+    case ESCAPE_PAUSE:
+      moveBackward();
+      enterEscapePhase(ESCAPE_BACKUP, escape.backupTime);
+      break;
+    case ESCAPE_BACKUP:
+      stopMotors();
+      enterEscapePhase(ESCAPE_SETTLE, 100);
+      break;
+    case ESCAPE_SETTLE:
+      if (escape.useLearned) {
+        if (escape.direction == 0) {
+          turnLeft();
+        } else {
+          turnRight();
+        }
+        enterEscapePhase(ESCAPE_LEARNED_TURN, escape.turnTime);
+      } else {
+        // Quick left scan (fewer positions for speed)
         turnLeft();
+        enterEscapePhase(ESCAPE_LOOK_LEFT, controlGenome.turnDuration / 2);
+      }
+      break;
+      
+    // Learned strategy: single turn then verify
+    case ESCAPE_LEARNED_TURN:
+      stopMotors();
+      enterEscapePhase(ESCAPE_LEARNED_SCAN, controlGenome.scanDelay);
+      break;
+    case ESCAPE_LEARNED_SCAN:
+      verifyEscapeTurn();
+      break;
+      
+    // Exploration: look left, recentre, optionally look right, recentre
+    case ESCAPE_LOOK_LEFT:
+      stopMotors();
+      enterEscapePhase(ESCAPE_SAMPLE_LEFT, controlGenome.scanDelay / 2);
+      break;
+    case ESCAPE_SAMPLE_LEFT:
+      sampleScanDirection(0);
+      turnRight();
+      enterEscapePhase(ESCAPE_CENTER_FROM_LEFT, controlGenome.turnDuration);
+      break;
+    case ESCAPE_CENTER_FROM_LEFT:
+      stopMotors();
+      enterEscapePhase(ESCAPE_SETTLE_LEFT, controlGenome.scanDelay / 2);
+      break;
+    case ESCAPE_SETTLE_LEFT:
+      // Clear on the left will do, unless the unexplored ground is to the right
+      if (escape.clearPathFound && unexploredSide.load() != EXPLORE_SIDE_RIGHT) {
+        beginExploreManoeuvre();
       } else {
         turnRight();
+        enterEscapePhase(ESCAPE_LOOK_RIGHT, controlGenome.turnDuration / 2);
       }
-      delay(turnTime);
+      break;
+    case ESCAPE_LOOK_RIGHT:
       stopMotors();
-      delay(50);
-      
-      int finalCheck = readDistance();
-      if (finalCheck > currentGenome.clearThreshold || finalCheck == SENSOR_ERROR_VALUE) {
-        accelerateForward(currentGenome.motorSpeed, currentGenome.maxAcceleration);
-        delay(400);
-        succeeded = true;
-        metrics.obstaclesCleared++;
-        trappedAttempts = 0;
-        
-        unsigned long completionTime = millis() - obstacleStartTime;
-        if (completionTime < metrics.fastestObstacleTime) {
-          metrics.fastestObstacleTime = completionTime;
-          Serial.print("⚡ NEW EXPLORATION SPEED RECORD: ");
-          Serial.println(completionTime);
-        }
-        
-        expressState(1, 80);
+      enterEscapePhase(ESCAPE_SAMPLE_RIGHT, controlGenome.scanDelay / 2);
+      break;
+    case ESCAPE_SAMPLE_RIGHT:
+      sampleScanDirection(1);
+      turnLeft();
+      enterEscapePhase(ESCAPE_CENTER_FROM_RIGHT, controlGenome.turnDuration);
+      break;
+    case ESCAPE_CENTER_FROM_RIGHT:
+      stopMotors();
+      enterEscapePhase(ESCAPE_SETTLE_RIGHT, controlGenome.scanDelay / 2);
+      break;
+    case ESCAPE_SETTLE_RIGHT:
+      if (escape.clearPathFound) {
+        beginExploreManoeuvre();
       } else {
-        trappedAttempts++;
-        expressState(0, -50);
+        handleNoClearPath();
       }
+      break;
+    case ESCAPE_EXPLORE_TURN:
+      stopMotors();
+      enterEscapePhase(ESCAPE_EXPLORE_SCAN, 50);
+      break;
+    case ESCAPE_EXPLORE_SCAN:
+      verifyEscapeTurn();
+      break;
       
-      learnStrategy(initialDistance, direction, backupTime * 2, turnTime, succeeded, millis() - obstacleStartTime);
+    // Clear path: forward dash finished
+    case ESCAPE_CHARGE:
+      completeObstacleClearance();
+      break;
+    case ESCAPE_QUICK_BACKUP:
+      stopMotors();
+      finishObstacleEscape();
+      break;
       
-    } else {
-      trappedAttempts++;
-      expressState(2, -70);
+    // Trapped: long backup, big spin, power charge
+    case ESCAPE_TRAP_BACKUP:
+      stopMotors();
+      enterEscapePhase(ESCAPE_TRAP_SETTLE, 100); // Shorter pause
+      break;
+    case ESCAPE_TRAP_SETTLE:
+      Serial.print("⚡ Rapid spinning ");
+      Serial.print(controlGenome.spinDegreesWhenTrapped);
+      Serial.println(" degrees");
+      turnRight();
+      enterEscapePhase(ESCAPE_TRAP_SPIN, escape.spinTime / 2); // Half time for speed
+      break;
+    case ESCAPE_TRAP_SPIN:
+      stopMotors();
+      enterEscapePhase(ESCAPE_TRAP_SETTLE_SPIN, 100);
+      break;
+    case ESCAPE_TRAP_SETTLE_SPIN:
+      Serial.println("⚡ Power charging forward!");
+      escape.chargeSpeed = 255;
+      accelerateForward(escape.chargeSpeed, controlGenome.maxAcceleration);
+      enterEscapePhase(ESCAPE_TRAP_CHARGE, 800); // Shorter charge
+      break;
+    case ESCAPE_TRAP_CHARGE:
+      stopMotors();
+      enterEscapePhase(ESCAPE_TRAP_STOP, 100);
+      break;
+    case ESCAPE_TRAP_STOP:
+      finishAggressiveEscape();
+      break;
       
-      if (trappedAttempts >= MAX_TRAPPED_ATTEMPTS) {
-        aggressiveEscape();
-      } else {
-        Serial.println("⚡ No clear path, quick backup");
-        moveBackward();
-        delay(500);
-        stopMotors();
-      }
-    }
+    default:
+      stopMotors();
+      finishObstacleEscape();
+      break;
   }
-  
-  isAvoiding = false;
-  
-  if (random(0, 100) < 15) { // Higher evolution chance for SPEEDIE
-    evolutionCycle();
+}
+
+void abortObstacleEscape() {
+  if (escape.phase != ESCAPE_IDLE) {
+    Serial.println("⚡ Escape manoeuvre aborted");
   }
+  finishObstacleEscape();
 }
 
 // ═══════════════════════════════════════════════════════════
@@ -1668,39 +2293,76 @@ void handleObstacle() {
 // ═══════════════════════════════════════════════════════════
 
 // ESP-NOW message received callback (SPEEDIE optimized)
+// Runs in the Wi-Fi task: copy the frame into the ring and return immediately.
+// Validation and dispatch happen on the comms core in drainReceivedFrames().
+// The ESP-NOW receive callback carries no RSSI. Promiscuous mode sees
+// the same action frame just before it (both in the Wi-Fi task), so the
+// last management frame's transmitter and RSSI are kept here.
+static uint8_t lastMgmtFrameMac[6];
+static int8_t lastMgmtFrameRssi = GOSSIP_RSSI_UNKNOWN;
+
+void onPromiscuousFrame(void* buffer, wifi_promiscuous_pkt_type_t type) {
+  if (type != WIFI_PKT_MGMT) return;
+  const wifi_promiscuous_pkt_t* packet = (const wifi_promiscuous_pkt_t*)buffer;
+  memcpy(lastMgmtFrameMac, packet->payload + 10, 6); // 802.11 addr2: transmitter
+  lastMgmtFrameRssi = packet->rx_ctrl.rssi;
+}
+
 void onDataReceived(const uint8_t *mac, const uint8_t *incomingData, int len) {
-  if (len != sizeof(SwarmMessage)) {
-    Serial.println("⚠️ Invalid message size");
-    commStats.commErrors++;
+  if (len <= 0 || len > (int)sizeof(SwarmMessage)) {
+    rxOversizeFrames++;
     return;
   }
   
-  memcpy(&incomingMessage, incomingData, sizeof(SwarmMessage));
+  bool queued = receivedFrames.emplace([&](ReceivedFrame& frame) {
+    memcpy(frame.mac, mac, 6);
+    frame.length = (uint8_t)len;
+    frame.rssi = (memcmp(lastMgmtFrameMac, mac, 6) == 0) ? lastMgmtFrameRssi : GOSSIP_RSSI_UNKNOWN;
+    memcpy(frame.data, incomingData, len);
+  });
   
-  if (!isValidMessage(&incomingMessage)) {
-    Serial.println("⚠️ Invalid message");
-    commStats.commErrors++;
-    return;
+  if (!queued) {
+    rxRingOverflows++;
   }
+}
+
+// Comms core: validate and dispatch every queued frame
+void drainReceivedFrames() {
+  static SwarmMessage message; // Comms-task only
   
-  commStats.messagesReceived++;
-  commStats.lastMessageTime = millis();
-  
-  String macStr = macToString(mac);
-  Serial.printf("📨 Msg from %s: Type=0x%02X\n", 
-                macStr.c_str(), incomingMessage.header.messageType);
-  
-  // SPEEDIE processes messages quickly
-  handleSwarmMessage(mac, &incomingMessage);
+  const ReceivedFrame* frame;
+  while ((frame = receivedFrames.peek()) != nullptr) {
+    uint8_t senderMac[6];
+    memcpy(senderMac, frame->mac, 6);
+    int len = frame->length;
+    int8_t rssi = frame->rssi;
+    bool decoded = decodeSwarmFrame(frame->data, len, &message);
+    receivedFrames.release();
+    
+    if (!decoded) {
+      Serial.printf("⚠️ Invalid message (%d bytes)\n", len);
+      commStats.commErrors++;
+      continue;
+    }
+    
+    commStats.messagesReceived++;
+    commStats.lastMessageTime = millis();
+    swarmMembership.observeDirect(senderMac, rssi); // First, so a new sender is ranked by its RSSI
+    swarmNode->peerRegistry.findOrAdd(senderMac); // Keeps the sender's id from being reclaimed
+    
+    String macStr = macToString(senderMac);
+    Serial.printf("📨 Msg from %s: Type=0x%02X\n", 
+                  macStr.c_str(), message.header.messageType);
+    
+    // SPEEDIE processes messages quickly
+    handleSwarmMessage(senderMac, &message);
+  }
 }
 
 // ESP-NOW message sent callback
 void onDataSent(const uint8_t *mac_addr, esp_now_send_status_t status) {
-  if (status == ESP_NOW_SEND_SUCCESS) {
-    commStats.messagesSent++;
-  } else {
-    commStats.messagesDropped++;
-  }
+  // Runs in the Wi-Fi task: just release the transmit queue for its next frame
+  txQueue.onSendComplete(mac_addr, status);
 }
 
 // Initialize ESP-NOW communication (SPEEDIE version)
@@ -1717,11 +2379,24 @@ void initializeSwarmCommunication() {
   esp_now_register_recv_cb(onDataReceived);
   esp_wifi_set_protocol(WIFI_IF_STA, WIFI_PROTOCOL_LR);
   
+  // Management frames only: enough to read the RSSI of ESP-NOW frames
+  wifi_promiscuous_filter_t filter = { WIFI_PROMIS_FILTER_MASK_MGMT };
+  esp_wifi_set_promiscuous_filter(&filter);
+  esp_wifi_set_promiscuous_rx_cb(onPromiscuousFrame);
+  esp_wifi_set_promiscuous(true);
+  
   Serial.println("✅ ESP-NOW (SPEEDIE mode) ready");
   
-  for (int i = 0; i < MAX_SWARM_PEERS; i++) {
+  for (int i = 0; i < PEER_REGISTRY_CAPACITY; i++) {
     swarmPeers[i].isActive = false;
   }
+  swarmNode->peerRegistry.addReleaseListener(releaseSwarmPeer);
+  swarmNode->peerRegistry.setRetentionRank(peerRetentionRank);
+  
+  WiFi.macAddress(myMacAddress);
+  swarmMembership.begin(myMacAddress, MAX_SWARM_MEMBERS);
+  genePool.begin(myMacAddress);
+  swarmMembership.setStatusListener(onGossipStatus);
   
   isSwarmActive = true;
   lastDiscoveryTime = millis() - DISCOVERY_INTERVAL;
@@ -1738,6 +2413,21 @@ void handleSwarmMessage(const uint8_t* senderMac, SwarmMessage* message) {
     case MSG_PAIRING_REQUEST:
       handlePairingRequest(senderMac);
       break;
+    case MSG_BUNDLE:
+      handleBundle(senderMac, message);
+      break;
+    case MSG_GOSSIP_DIGEST:
+      handleGossipDigest(senderMac, message);
+      break;
+    case MSG_GOSSIP_UPDATE:
+      handleGossipUpdate(message);
+      break;
+    case MSG_AREA_SHARE:
+      handleAreaShare(message);
+      break;
+    case MSG_GENOME_SHARE:
+      handleGenomeShare(senderMac, &message->payload.genome);
+      break;
     case MSG_STATUS_UPDATE:
       handleStatusUpdate(senderMac, &message->payload.status);
       break;
@@ -1767,6 +2457,163 @@ void handleSwarmMessage(const uint8_t* senderMac, SwarmMessage* message) {
   }
 }
 
+// Fan a bundle's records out through the normal handlers in one pass
+void handleBundle(const uint8_t* senderMac, const SwarmMessage* bundle) {
+  static SwarmMessage record; // Comms-task only
+  
+  size_t offset = 0;
+  while (nextBundleRecord(bundle, offset, &record)) {
+    commStats.bundleRecordsReceived++;
+    handleSwarmMessage(senderMac, &record);
+  }
+  
+  if (offset != bundle->header.payloadLength) {
+    Serial.println("⚠️ Truncated bundle");
+    commStats.commErrors++;
+  }
+}
+
+// ═══════════════════════════════════════════════════════════
+// 🗣️ GOSSIP MEMBERSHIP (LARGE SWARMS)
+// ═══════════════════════════════════════════════════════════
+
+// Unicast needs an ESP-NOW peer entry; the driver holds at most 20, so
+// gossip recycles its own entries oldest-first
+#define GOSSIP_ESPNOW_PEERS 10
+uint8_t gossipEspNowPeers[GOSSIP_ESPNOW_PEERS][6];
+uint8_t gossipEspNowPeerCount = 0;
+uint8_t gossipEspNowPeerNext = 0;
+
+bool ensureUnicastPeer(const uint8_t* mac) {
+  if (esp_now_is_peer_exist(mac)) return true;
+  
+  if (gossipEspNowPeerCount == GOSSIP_ESPNOW_PEERS) {
+    esp_now_del_peer(gossipEspNowPeers[gossipEspNowPeerNext]);
+  } else {
+    gossipEspNowPeerCount++;
+  }
+  
+  esp_now_peer_info_t peerInfo;
+  memset(&peerInfo, 0, sizeof(peerInfo));
+  memcpy(peerInfo.peer_addr, mac, 6);
+  peerInfo.channel = 0;
+  peerInfo.encrypt = false;
+  if (esp_now_add_peer(&peerInfo) != ESP_OK) return false;
+  
+  memcpy(gossipEspNowPeers[gossipEspNowPeerNext], mac, 6);
+  gossipEspNowPeerNext = (gossipEspNowPeerNext + 1) % GOSSIP_ESPNOW_PEERS;
+  return true;
+}
+
+// Gossip frames are unicast. Digests are PRIORITY_LOW so the queue
+// coalesces a newer digest to the same bot over an unsent older one;
+// updates are PRIORITY_NORMAL so one never replaces another.
+void sendGossipFrame(const uint8_t* targetMac, MessageType type, const void* payload, size_t length) {
+  if (!ensureUnicastPeer(targetMac)) {
+    commStats.commErrors++;
+    return;
+  }
+  
+  memset(&outgoingMessage.header, 0, sizeof(MessageHeader));
+  outgoingMessage.header.messageType = type;
+  outgoingMessage.header.priority = (type == MSG_GOSSIP_UPDATE) ? PRIORITY_NORMAL : PRIORITY_LOW;
+  outgoingMessage.header.senderType = myBotType;
+  outgoingMessage.header.sequenceNumber = sequenceNumber++;
+  outgoingMessage.header.timestamp = millis();
+  memcpy(outgoingMessage.payload.rawData, payload, length);
+  
+  size_t frameLength = finalizeSwarmMessage(&outgoingMessage, length);
+  if (!txQueue.enqueue(targetMac, &outgoingMessage, frameLength)) {
+    commStats.commErrors++;
+  }
+}
+
+void fillGossipStatus(GossipStatus& status) {
+  memset(&status, 0, sizeof(status));
+  status.botType = myBotType;
+  status.role = currentSwarmRole;
+  status.generation = currentGenome.generation;
+  status.fitness = (uint16_t)(constrain(currentGenome.fitnessScore, 0.0f, 65.0f) * 1000);
+  status.reputation = 50;
+  status.health = HEALTH_GOOD;
+  
+  BotProfile* self = (swarmNode->ecosystem != nullptr) ? swarmNode->ecosystem->getBotProfile(myMacAddress) : nullptr;
+  if (self != nullptr) {
+    status.reputation = (uint8_t)constrain(self->reputationScore, 0.0f, 100.0f);
+    status.health = self->health;
+  }
+}
+
+// What the shared modules read about us (swarm_node.h)
+void updateSelfReport() {
+  SwarmSelfReport& self = swarmNode->self;
+  self.botType = myBotType;
+  self.generation = currentGenome.generation;
+  self.fitness = currentGenome.fitnessScore;
+  self.strategiesLearned = strategyCount;
+  self.activePeers = activePeerCount;
+}
+
+// One round: digests to 1 + log2(N) neighbours
+void runGossipRound() {
+  GossipStatus status;
+  fillGossipStatus(status);
+  swarmMembership.setSelfStatus(status);
+  
+  uint8_t targets[GOSSIP_MAX_FANOUT][6];
+  uint8_t targetCount = swarmMembership.beginRound(targets, GOSSIP_MAX_FANOUT);
+  
+  static GossipDigestPayload digest; // Comms-task only
+  for (uint8_t i = 0; i < targetCount; i++) {
+    size_t length = swarmMembership.buildDigest(digest, 0);
+    sendGossipFrame(targets[i], MSG_GOSSIP_DIGEST, &digest, length);
+  }
+}
+
+void handleGossipDigest(const uint8_t* senderMac, const SwarmMessage* message) {
+  static GossipUpdatePayload update; // Comms-task only
+  static GossipDigestPayload reply;
+  
+  size_t updateLength = 0;
+  bool wantReply = swarmMembership.mergeDigest(*(const GossipDigestPayload*)message->payload.rawData,
+                                               message->header.payloadLength, update, updateLength);
+  
+  if (updateLength > 0) {
+    sendGossipFrame(senderMac, MSG_GOSSIP_UPDATE, &update, updateLength);
+  }
+  if (wantReply) {
+    size_t length = swarmMembership.buildDigest(reply, GOSSIP_DIGEST_REPLY);
+    sendGossipFrame(senderMac, MSG_GOSSIP_DIGEST, &reply, length);
+  }
+}
+
+void handleGossipUpdate(const SwarmMessage* message) {
+  swarmMembership.mergeUpdate(*(const GossipUpdatePayload*)message->payload.rawData,
+                              message->header.payloadLength);
+}
+
+// A member's status changed somewhere in the swarm
+void onGossipStatus(const uint8_t* mac, const GossipStatus& status) {
+  int peerIndex = findPeer(mac);
+  if (peerIndex >= 0) {
+    SwarmPeer* peer = &swarmPeers[peerIndex];
+    peer->currentRole = (SwarmRole)status.role;
+    peer->generation = status.generation;
+    peer->fitnessScore = status.fitness / 1000.0f;
+  }
+  
+  // Only bots we already profile: indirect members must not churn peer ids
+  SwarmEcosystemManager* ecosystem = swarmNode->ecosystem;
+  if (ecosystem == nullptr) return;
+  BotProfile* profile = ecosystem->getBotProfile((uint8_t*)mac);
+  if (profile == nullptr) return;
+  ecosystem->updateBotStatus((uint8_t*)mac, status.generation, status.fitness / 1000.0f);
+  if (!profile->hasLocalEvidence) {
+    // No first-hand evidence yet: start from what the swarm reports
+    profile->reputationScore = status.reputation;
+  }
+}
+
 // Handle discovery (SPEEDIE responds quickly)
 void handleDiscoveryMessage(const uint8_t* senderMac, DiscoveryPayload* payload) {
   Serial.printf("🔍 Discovery: %s (Gen:%d, Fit:%.3f)\n", 
@@ -1785,6 +2632,14 @@ void handleDiscoveryMessage(const uint8_t* senderMac, DiscoveryPayload* payload)
     
     sendPairingResponse(senderMac);
   }
+  
+  SwarmEcosystemManager* ecosystem = swarmNode->ecosystem;
+  if (ecosystem != nullptr) {
+    const char* name = (payload->botType == BOT_WHEELIE) ? "WHEELIE" :
+                       (payload->botType == BOT_SPEEDIE) ? "SPEEDIE" : "UNKNOWN";
+    ecosystem->registerBot((uint8_t*)senderMac, (BotType)payload->botType, name);
+    ecosystem->updateBotStatus((uint8_t*)senderMac, payload->generation, payload->fitnessScore);
+  }
 }
 
 // Handle pairing requests (SPEEDIE fast response)
@@ -1809,6 +2664,10 @@ void handleStatusUpdate(const uint8_t* senderMac, StatusPayload* payload) {
     peer->fitnessScore = payload->fitnessScore;
     peer->lastSeen = millis();
   }
+  
+  if (swarmNode->ecosystem != nullptr) {
+    swarmNode->ecosystem->updateBotStatus((uint8_t*)senderMac, payload->generation, payload->fitnessScore);
+  }
 }
 
 // Handle sensor data (SPEEDIE uses for rapid threat assessment)
@@ -1846,43 +2705,92 @@ void handleTaskAssignment(const uint8_t* senderMac, TaskPayload* payload) {
   }
 }
 
-// Handle emergency stop (SPEEDIE immediate response)
+// Handle emergency stop (SPEEDIE immediate response) - comms core
 void handleEmergencyStop() {
   Serial.println("🛑 EMERGENCY STOP!");
+  emergencyStopRequested.store(true);
+}
+
+// Control core: picked up on the next control tick
+void applyEmergencyStop() {
   stopMotors();
+  abortObstacleEscape();
   isAwake = false;
-  // Flash red LEDs rapidly for emergency
-  for (int i = 0; i < 10; i++) {
-    setSpeedieColor(255, 0); // Red
-    delay(100);
-    setSpeedieColor(0, 0);   // Off
-    delay(100);
-  }
+  emergencyStopUntil = millis() + 2000; // Hold for the length of the flash sequence
+  
+  // Flash red LEDs rapidly for emergency (10 x 100ms on / 100ms off)
+  SignalSequence flash;
+  flash.count = 10;
+  for (int i = 0; i < flash.count; i++) flash.steps[i] = {255, 0, 0, 0, 100};
+  flash.gapMs = 100;
+  flash.endDark = true;
+  signalPlayer.play(flash, SIGNAL_PRIORITY_EMERGENCY);
 }
 
-// Utility functions (optimized for SPEEDIE)
+// Utility functions: peer index == PeerId, so lookups are one hash probe
 int findOrCreatePeer(const uint8_t* mac) {
-  int existingIndex = findPeer(mac);
-  if (existingIndex >= 0) return existingIndex;
-  
-  for (int i = 0; i < MAX_SWARM_PEERS; i++) {
-    if (!swarmPeers[i].isActive) {
-      memcpy(swarmPeers[i].macAddress, mac, 6);
-      swarmPeers[i].isActive = true;
-      activePeerCount++;
-      return i;
+  PeerId id = swarmNode->peerRegistry.findOrAdd(mac);
+  if (id == INVALID_PEER_ID) return -1;
+  if (swarmPeers[id].isActive) return id;
+  
+  if (activePeerCount >= MAX_SWARM_PEERS) {
+    // Full: a bot in the RSSI neighbour set displaces one that is not
+    if (!swarmMembership.isNeighbour(mac)) return -1;
+    int evicted = -1;
+    for (int i = 0; i < PEER_REGISTRY_CAPACITY && evicted < 0; i++) {
+      if (swarmPeers[i].isActive && !swarmMembership.isNeighbour(swarmPeers[i].macAddress)) evicted = i;
     }
+    if (evicted < 0) return -1;
+    swarmPeers[evicted].isActive = false;
+    activePeerCount--;
+    peerLocations[evicted].isActive = false;
+    swarmNode->spatialIndex.removePeer(evicted);
   }
-  return -1;
+  memset(&swarmPeers[id], 0, sizeof(SwarmPeer));
+  memcpy(swarmPeers[id].macAddress, mac, 6);
+  swarmPeers[id].isActive = true;
+  activePeerCount++;
+  return id;
 }
 
 int findPeer(const uint8_t* mac) {
-  for (int i = 0; i < MAX_SWARM_PEERS; i++) {
-    if (swarmPeers[i].isActive && macEquals(swarmPeers[i].macAddress, mac)) {
-      return i;
-    }
-  }
-  return -1;
+  PeerId id = swarmNode->peerRegistry.find(mac);
+  return (id != INVALID_PEER_ID && swarmPeers[id].isActive) ? id : -1;
+}
+
+// Registry reclaimed this id for a new MAC
+void releaseSwarmPeer(PeerId id) {
+  if (swarmPeers[id].isActive) activePeerCount--;
+  swarmPeers[id].isActive = false;
+  peerLocations[id].isActive = false;
+  swarmNode->spatialIndex.removePeer(id);
+}
+
+// Full registry: keep ourselves, then gossip neighbours, then the strongest RSSI
+int16_t peerRetentionRank(const uint8_t* mac) {
+  if (memcmp(mac, myMacAddress, 6) == 0) return PEER_RANK_KEEP;
+  int16_t rssi = swarmMembership.getRssi(mac);
+  return swarmMembership.isNeighbour(mac) ? 256 + rssi : rssi;
+}
+
+// Payload builders shared by standalone sends and the telemetry bundle
+void fillDiscoveryPayload(DiscoveryPayload& discovery) {
+  memset(&discovery, 0, sizeof(discovery));
+  discovery.botType = myBotType;
+  discovery.currentRole = currentSwarmRole;
+  discovery.generation = currentGenome.generation;
+  discovery.fitnessScore = currentGenome.fitnessScore;
+  discovery.uptime = millis();
+}
+
+void fillStatusPayload(StatusPayload& status) {
+  memset(&status, 0, sizeof(status));
+  status.currentRole = currentSwarmRole;
+  status.generation = currentGenome.generation;
+  status.fitnessScore = currentGenome.fitnessScore;
+  status.emotionalState[0] = latestControl.emotions.frustrationLevel;
+  status.emotionalState[1] = latestControl.emotions.confidenceLevel;
+  status.emotionalState[2] = latestControl.emotions.curiosityLevel;
 }
 
 // Send discovery (SPEEDIE announces guardian capabilities)
@@ -1895,18 +2803,12 @@ void sendDiscoveryMessage() {
   outgoingMessage.header.sequenceNumber = sequenceNumber++;
   outgoingMessage.header.timestamp = millis();
   
-  outgoingMessage.payload.discovery.botType = myBotType;
-  outgoingMessage.payload.discovery.currentRole = currentSwarmRole;
-  outgoingMessage.payload.discovery.generation = currentGenome.generation;
-  outgoingMessage.payload.discovery.fitnessScore = currentGenome.fitnessScore;
-  outgoingMessage.payload.discovery.uptime = millis();
+  fillDiscoveryPayload(outgoingMessage.payload.discovery);
   
-  outgoingMessage.header.checksum = calculateChecksum((uint8_t*)&outgoingMessage, sizeof(SwarmMessage) - 1);
+  size_t frameLength = finalizeSwarmMessage(&outgoingMessage, sizeof(DiscoveryPayload));
   
   uint8_t broadcastAddress[] = BROADCAST_MAC;
-  esp_err_t result = esp_now_send(broadcastAddress, (uint8_t*)&outgoingMessage, sizeof(SwarmMessage));
-  
-  if (result == ESP_OK) {
+  if (txQueue.enqueue(broadcastAddress, &outgoingMessage, frameLength)) {
     commStats.discoveryCount++;
   } else {
     commStats.commErrors++;
@@ -1923,41 +2825,140 @@ void sendPairingResponse(const uint8_t* targetMac) {
   outgoingMessage.header.sequenceNumber = sequenceNumber++;
   outgoingMessage.header.timestamp = millis();
   
-  outgoingMessage.payload.status.currentRole = currentSwarmRole;
-  outgoingMessage.payload.status.generation = currentGenome.generation;
-  outgoingMessage.payload.status.fitnessScore = currentGenome.fitnessScore;
-  outgoingMessage.payload.status.emotionalState[0] = currentState.frustrationLevel;
-  outgoingMessage.payload.status.emotionalState[1] = currentState.confidenceLevel;
-  outgoingMessage.payload.status.emotionalState[2] = currentState.curiosityLevel;
+  fillStatusPayload(outgoingMessage.payload.status);
   
-  outgoingMessage.header.checksum = calculateChecksum((uint8_t*)&outgoingMessage, sizeof(SwarmMessage) - 1);
+  size_t frameLength = finalizeSwarmMessage(&outgoingMessage, sizeof(StatusPayload));
   
-  esp_now_send(targetMac, (uint8_t*)&outgoingMessage, sizeof(SwarmMessage));
+  txQueue.enqueue(targetMac, &outgoingMessage, frameLength);
 }
 
-// Broadcast status (SPEEDIE efficient updates)
-void broadcastStatusUpdate() {
-  if (activePeerCount == 0) return;
+// Status tick: status, position and the latest range reading
+void appendStatusRecords(bool includeStatus) {
+  if (includeStatus) { // In gossip mode status is already spread by digests
+    StatusPayload status;
+    fillStatusPayload(status);
+    telemetryBundle.add(MSG_STATUS_UPDATE, PRIORITY_LOW, &status, sizeof(status));
+  }
   
-  memset(&outgoingMessage, 0, sizeof(SwarmMessage));
+  PositionPayload position;
+  memset(&position, 0, sizeof(position));
+  position.x = myPosition.x;
+  position.y = myPosition.y;
+  position.heading = latestControl.heading;
+  position.confidence = myPosition.isValid ? 50 : 0; // Dead reckoning only
+  telemetryBundle.add(MSG_POSITION_UPDATE, PRIORITY_LOW, &position, sizeof(position));
+  
+  SensorPayload sensor;
+  memset(&sensor, 0, sizeof(sensor));
+  sensor.sensorType = SENSOR_TYPE_ULTRASONIC;
+  sensor.timestamp = millis();
+  bool rangeValid = latestControl.latestDistance != SENSOR_ERROR_VALUE;
+  sensor.value1 = rangeValid ? latestControl.latestDistance : 0;
+  sensor.confidence = rangeValid ? 80 : 0;
+  telemetryBundle.add(MSG_SENSOR_DATA, PRIORITY_LOW, &sensor, sizeof(sensor));
+}
+
+// Everything due this tick leaves in one broadcast frame
+bool flushTelemetryBundle() {
+  size_t frameLength = telemetryBundle.finish(sequenceNumber++, millis());
+  if (frameLength == 0) return false;
   
-  outgoingMessage.header.messageType = MSG_STATUS_UPDATE;
+  uint8_t broadcastAddress[] = BROADCAST_MAC;
+  if (!txQueue.enqueue(broadcastAddress, telemetryBundle.getMessage(), frameLength)) {
+    commStats.commErrors++;
+    return false;
+  }
+  if (telemetryBundle.getRecordCount() > 1) commStats.bundlesSent++;
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════
+// 🧭 SHARED COVERAGE MAP
+// ═══════════════════════════════════════════════════════════
+
+// The cell we are in is explored; the next share carries it as a delta
+void markOwnCoverage() {
+  if (!myPosition.isValid) return;
+  swarmNode->spatialIndex.markExplored(myPosition.x * POSITION_UNIT_CM, myPosition.y * POSITION_UNIT_CM);
+}
+
+// Steer the control core's escape scan towards the closest cell nobody has explored
+void publishUnexploredSide() {
+  float x = myPosition.x * POSITION_UNIT_CM;
+  float y = myPosition.y * POSITION_UNIT_CM;
+  float targetX, targetY;
+  if (!myPosition.isValid || !swarmNode->spatialIndex.nearestUnexplored(x, y, targetX, targetY)) {
+    unexploredSide.store(EXPLORE_SIDE_NONE);
+    return;
+  }
+  
+  float headingError = degrees(atan2(targetY - y, targetX - x)) - myPosition.heading;
+  while (headingError > 180) headingError -= 360;
+  while (headingError < -180) headingError += 360;
+  unexploredSide.store(headingError > 0 ? EXPLORE_SIDE_RIGHT : EXPLORE_SIDE_LEFT);
+}
+
+// Rides the telemetry bundle when it fits, otherwise its own broadcast
+void appendCoverageShare(unsigned long now) {
+  if (!coverageSync.isShareDue(now)) return;
+  
+  static CoverageSharePayload share; // Comms-task only
+  size_t length = coverageSync.buildShare(share, now);
+  if (length == 0) return;
+  if (telemetryBundle.add(MSG_AREA_SHARE, PRIORITY_LOW, &share, length)) return;
+  
+  memset(&outgoingMessage.header, 0, sizeof(MessageHeader));
+  outgoingMessage.header.messageType = MSG_AREA_SHARE;
   outgoingMessage.header.priority = PRIORITY_LOW;
   outgoingMessage.header.senderType = myBotType;
   outgoingMessage.header.sequenceNumber = sequenceNumber++;
-  outgoingMessage.header.timestamp = millis();
+  outgoingMessage.header.timestamp = now;
+  memcpy(outgoingMessage.payload.rawData, &share, length);
   
-  outgoingMessage.payload.status.currentRole = currentSwarmRole;
-  outgoingMessage.payload.status.generation = currentGenome.generation;
-  outgoingMessage.payload.status.fitnessScore = currentGenome.fitnessScore;
-  outgoingMessage.payload.status.emotionalState[0] = currentState.frustrationLevel;
-  outgoingMessage.payload.status.emotionalState[1] = currentState.confidenceLevel;
-  outgoingMessage.payload.status.emotionalState[2] = currentState.curiosityLevel;
+  uint8_t broadcastAddress[] = BROADCAST_MAC;
+  size_t frameLength = finalizeSwarmMessage(&outgoingMessage, length);
+  if (!txQueue.enqueue(broadcastAddress, &outgoingMessage, frameLength)) {
+    commStats.commErrors++;
+  }
+}
+
+void handleAreaShare(const SwarmMessage* message) {
+  coverageSync.mergeShare(*(const CoverageSharePayload*)message->payload.rawData,
+                          message->header.payloadLength);
+}
+
+// ═══════════════════════════════════════════════════════════
+// 🧬 SWARM GENE POOL (MIGRATION)
+// ═══════════════════════════════════════════════════════════
+
+// Our latest evaluated candidate, for every other island's pool
+void appendGenomeShare(unsigned long now) {
+  if (!genePool.isShareDue(now)) return;
+  
+  GenomePayload share;
+  genePool.buildShare(share, now);
+  if (telemetryBundle.add(MSG_GENOME_SHARE, PRIORITY_LOW, &share, sizeof(share))) return;
   
-  outgoingMessage.header.checksum = calculateChecksum((uint8_t*)&outgoingMessage, sizeof(SwarmMessage) - 1);
+  memset(&outgoingMessage.header, 0, sizeof(MessageHeader));
+  outgoingMessage.header.messageType = MSG_GENOME_SHARE;
+  outgoingMessage.header.priority = PRIORITY_LOW;
+  outgoingMessage.header.senderType = myBotType;
+  outgoingMessage.header.sequenceNumber = sequenceNumber++;
+  outgoingMessage.header.timestamp = now;
+  outgoingMessage.payload.genome = share;
   
   uint8_t broadcastAddress[] = BROADCAST_MAC;
-  esp_now_send(broadcastAddress, (uint8_t*)&outgoingMessage, sizeof(SwarmMessage));
+  size_t frameLength = finalizeSwarmMessage(&outgoingMessage, sizeof(share));
+  if (!txQueue.enqueue(broadcastAddress, &outgoingMessage, frameLength)) {
+    commStats.commErrors++;
+  }
+}
+
+void handleGenomeShare(const uint8_t* senderMac, const GenomePayload* payload) {
+  if (genePool.mergeShare(senderMac, *payload, millis())) {
+    Serial.printf("🧬 Genome from %s: gen %d, fitness %.3f\n",
+                  macToString(senderMac).c_str(), payload->generation, payload->fitnessScore);
+  }
 }
 
 // Update swarm communication (SPEEDIE optimized)
@@ -1965,40 +2966,64 @@ void updateSwarmCommunication() {
   if (!isSwarmActive) return;
   
   unsigned long currentTime = millis();
+  telemetryBundle.begin(myBotType);
+  bool discoveryDue = false;
+  
+  // Large swarm: status travels by gossip, and discovery is only
+  // broadcast while we still lack neighbours (i.e. while joining)
+  bool gossipMode = swarmMembership.isGossipMode();
+  if (gossipMode && currentTime - lastGossipRound >= GOSSIP_INTERVAL) {
+    runGossipRound();
+    lastGossipRound = currentTime;
+  }
+  bool discoveryWanted = !gossipMode || swarmMembership.getNeighbourCount() < GOSSIP_MIN_NEIGHBOURS;
   
   // SPEEDIE sends faster updates for rapid coordination
-  if (currentTime - lastDiscoveryTime > DISCOVERY_INTERVAL) {
-    sendDiscoveryMessage();
+  if (discoveryWanted && currentTime - lastDiscoveryTime > DISCOVERY_INTERVAL) {
+    DiscoveryPayload discovery;
+    fillDiscoveryPayload(discovery);
+    telemetryBundle.add(MSG_DISCOVERY, PRIORITY_NORMAL, &discovery, sizeof(discovery));
+    discoveryDue = true;
     lastDiscoveryTime = currentTime;
   }
   
   if (currentTime - lastStatusBroadcast > 7000) { // Every 7 seconds (faster than WHEELIE)
-    broadcastStatusUpdate();
+    if (activePeerCount > 0) appendStatusRecords(!gossipMode);
     lastStatusBroadcast = currentTime;
   }
   
+  appendCoverageShare(currentTime);
+  appendGenomeShare(currentTime);
+  
+  if (flushTelemetryBundle() && discoveryDue) {
+    commStats.discoveryCount++;
+  }
+  
   // Clean up peers quickly
-  for (int i = 0; i < MAX_SWARM_PEERS; i++) {
+  for (int i = 0; i < PEER_REGISTRY_CAPACITY; i++) {
     if (swarmPeers[i].isActive && 
         (currentTime - swarmPeers[i].lastSeen > PEER_TIMEOUT)) {
       swarmPeers[i].isActive = false;
       activePeerCount--;
+      peerLocations[i].isActive = false;
+      swarmNode->spatialIndex.removePeer(i);
     }
   }
+  updateSelfReport();
 }
 
 // ═══════════════════════════════════════════════════════════
 // � ECOSYSTEM FUNCTION DECLARATIONS
 // ═══════════════════════════════════════════════════════════
 
-void initializeEcosystemManager();
-bool verifyDataWithEcosystem(uint8_t* senderMac, uint32_t dataHash, float* trustMultiplier);
-void reportInteractionToEcosystem(uint8_t* botMac, InteractionType type, InteractionResult result);
+// initializeEcosystemManager(), verifyDataWithEcosystem() and
+// reportInteractionToEcosystem() live in swarm_ecosystem_manager.cpp
 
 // ═══════════════════════════════════════════════════════════
 // �🎬 SPEEDIE SETUP
 // ═══════════════════════════════════════════════════════════
 
+#ifndef PIO_UNIT_TESTING // Test builds bring their own setup()/loop()
 void setup() {
   Serial.begin(115200);
   delay(1000);
@@ -2008,34 +3033,26 @@ void setup() {
   Serial.println("║     WITH ULTRA-FAST EVOLUTION 🧬      ║");
   Serial.println("╚════════════════════════════════════════╝\n");
   
-  EEPROM.begin(EEPROM_SIZE);
-  
   Serial.println("⚡ Loading SPEEDIE persistent memory...");
-  loadGenomeFromEEPROM();
-  loadStrategiesFromEEPROM();
-  loadMetricsFromEEPROM();
-  loadVocabularyFromEEPROM();
+  loadPersistentMemory();
+  evaluationBaseline = metrics;  // The first candidate is judged from boot
   
-  if (vocabularySize == 0) {
+  if (vocabulary.size() == 0) {
     initializeDefaultVocabulary();
   }
   
   Serial.println("ℹ️ SPEEDIE uses LED-only communication (no buzzer for max speed)");
   
   // Initialize sensors (NO motion sensor for SPEEDIE)
-  pinMode(ULTRASONIC_TRIG_PIN, OUTPUT);
-  pinMode(ULTRASONIC_ECHO_PIN, INPUT);
+  ultrasonicRanger.begin(ULTRASONIC_TRIG_PIN, ULTRASONIC_ECHO_PIN);
   
   Wire.begin();
-  if (!mpu.begin()) {
+  Wire.setClock(400000); // Fast mode: a FIFO batch is one short burst
+  if (!imu.begin(Wire, MPU_INT_PIN)) {
     Serial.println("❌ Failed to initialize MPU6050");
     while(1);
   }
   
-  mpu.setAccelerometerRange(MPU6050_RANGE_8_G);
-  mpu.setGyroRange(MPU6050_RANGE_500_DEG);
-  mpu.setFilterBandwidth(MPU6050_BAND_21_HZ);
-  
   Serial.println("⚡ SPEEDIE sensors initialized");
   
   // Initialize motors (high-performance setup)
@@ -2059,6 +3076,7 @@ void setup() {
   ledcAttachPin(LEFT_LED_G_PIN, PWM_CH_L_G);
   ledcAttachPin(RIGHT_LED_R_PIN, PWM_CH_R_R);
   ledcAttachPin(RIGHT_LED_G_PIN, PWM_CH_R_G);
+  signalPlayer.begin(writeSignalOutput);
 
   Serial.println("⚡ SPEEDIE high-performance LEDs initialized");
   Serial.println("⚡ SPEEDIE motors initialized");
@@ -2073,7 +3091,7 @@ void setup() {
   Serial.print("  Strategies Learned: ");
   Serial.println(strategyCount);
   Serial.print("  Vocabulary Size: ");
-  Serial.println(vocabularySize);
+  Serial.println(vocabulary.size());
   Serial.print("  Fastest Obstacle Time: ");
   Serial.println(metrics.fastestObstacleTime);
   
@@ -2083,59 +3101,96 @@ void setup() {
   
   // Initialize Swarm Ecosystem Manager (Layer 3 Intelligence)
   Serial.println("\n🌐 Initializing Swarm Ecosystem Manager...");
-  initializeEcosystemManager();
+  initializeEcosystemManager(myBotType, "SPEEDIE");
   
   Serial.println("\n⚡ Initializing SPEEDIE communication protocol...");
   delay(300);
   expressState(4, 50);
   
+  initializeScheduler();
+  
   Serial.println("\n⚡ SPEEDIE ready for immediate high-speed evolution!\n");
 }
 
 // ═══════════════════════════════════════════════════════════
-// 🌐 ECOSYSTEM TRUST VERIFICATION (LAYER 3 INTELLIGENCE)
+// 🔄 SPEEDIE MAIN LOOP (HIGH-SPEED OPERATION)
 // ═══════════════════════════════════════════════════════════
 
-// Initialize ecosystem manager
-void initializeEcosystemManager() {
-  ecosystemManager = new SwarmEcosystemManager();
-  Serial.println("🌟 Ecosystem Manager initialized - Layer 3 Intelligence active");
-}
+// ─── Core 1: control ────────────────────────────────────────
 
-// Trust verification functions for data quality assessment
-bool verifyDataWithEcosystem(uint8_t* senderMac, uint32_t dataHash, float* trustMultiplier) {
-  if (!ecosystemManager) {
-    *trustMultiplier = 1.0f;
-    return true;
-  }
-  
-  BotProfile* profile = ecosystemManager->getBotProfile(senderMac);
-  if (profile) {
-    // Use correct field names from BotProfile struct
-    *trustMultiplier = (profile->reputationScore / 100.0f) * profile->dataAccuracy;
-    return *trustMultiplier > 0.3f; // Threshold for data acceptance
+// Execute requests posted by the comms core (safe points only)
+void processControlCommands() {
+  ControlCommand command;
+  while (controlCommands.pop(command)) {
+    switch (command.type) {
+      case CMD_EXPRESS_STATE:
+        expressState(command.a, command.b);
+        break;
+      case CMD_EVOLVE_VOCABULARY:
+        if (vocabulary.size() > 0) evolveVocabulary();
+        break;
+      case CMD_PRUNE_STRATEGIES:
+        pruneWeakStrategies();
+        break;
+      default:
+        break;
+    }
   }
-  
-  *trustMultiplier = 0.5f; // Default for unknown bots
-  return true;
 }
 
-void reportInteractionToEcosystem(uint8_t* botMac, InteractionType type, InteractionResult result) {
-  if (ecosystemManager) {
-    // Get our own MAC address for the interaction
-    uint8_t myMac[6];
-    WiFi.macAddress(myMac);
-    
-    // Record interaction between us and the other bot
-    ecosystemManager->recordInteraction(myMac, botMac, type, result);
-  }
+void publishControlSnapshot() {
+  static ControlSnapshot snapshot;
+  snapshot.metrics = metrics;
+  snapshot.emotions = currentState;
+  snapshot.loopStats = controlStats;
+  snapshot.trappedAttempts = trappedAttempts;
+  snapshot.vocabularySize = vocabulary.size();
+  snapshot.strategyCount = strategyCount;
+  snapshot.latestDistance = latestDistance;
+  snapshot.heading = currentHeading;
+  snapshot.driveSpeed = driveSpeed;
+  snapshot.isAwake = isAwake;
+  snapshot.isAvoiding = isAvoiding;
+  controlSnapshotSlot.publish(snapshot);
 }
 
-// ═══════════════════════════════════════════════════════════
-// 🔄 SPEEDIE MAIN LOOP (HIGH-SPEED OPERATION)
-// ═══════════════════════════════════════════════════════════
+// Polling the context also fires its deadline edges (stuck), so every tick
+void readControlContext() {
+  controlContext = getCurrentContextId();
+  controlContextStability = getContextStability();
+}
 
-void loop() {
+// Full speed in open space; ease off while the area keeps throwing up obstacles
+int cruiseSpeed() {
+  bool cluttered = controlContext != CONTEXT_ID_OPEN_SPACE &&
+                   getMostFrequentContextId() == CONTEXT_ID_OBSTACLE_NEAR &&
+                   controlContextStability < CONTEXT_SETTLED_STABILITY;
+  return cluttered ? controlGenome.motorSpeed * CLUTTERED_SPEED_PERCENT / 100 : controlGenome.motorSpeed;
+}
+
+// Sense-act cycle: one distance sample, one escape/cruise decision
+void controlTask() {
+  // Pick up a newly evolved genome (applies from the next phase/command on)
+  genomeSlot.readIfNew(controlGenome, genomeSequenceSeen);
+  
+  latestDistance = readDistance();
+  postDistanceReading(latestDistance == SENSOR_ERROR_VALUE ? 0 : latestDistance / 10);
+  
+  if (emergencyStopRequested.exchange(false)) {
+    applyEmergencyStop();
+  }
+  
+  // Hold still while an emergency stop is in effect
+  if ((long)(millis() - emergencyStopUntil) < 0) {
+    stopMotors();
+    return;
+  }
+  
+  // Evolution jobs may reshuffle strategies/vocabulary: never mid-manoeuvre
+  if (!isAvoiding) {
+    processControlCommands();
+  }
+  
   checkSleepTimeout();
   
   // SPEEDIE uses timer-based activation (no motion sensor for max speed)
@@ -2149,44 +3204,219 @@ void loop() {
     lastActivityTime = millis();
     trappedAttempts = 0;
   }
-
-  if (isAwake && !isAvoiding) {
-    int distance = readDistance();
+  
+  if (isAvoiding) {
+    updateObstacleEscape();
+    return;
+  }
+  
+  if (latestDistance == SENSOR_ERROR_VALUE) {
+    accelerateForward(controlGenome.motorSpeed / 2, controlGenome.maxAcceleration / 2); // Cautious speed
+  } else if (latestDistance < controlGenome.obstacleThreshold) {
+    handleObstacle();
+  } else {
+    accelerateForward(cruiseSpeed(), controlGenome.maxAcceleration);
     
-    if (distance == SENSOR_ERROR_VALUE) {
-      accelerateForward(currentGenome.motorSpeed / 2, currentGenome.maxAcceleration / 2); // Cautious speed
-    } else {
-      if (distance < currentGenome.obstacleThreshold) {
-        handleObstacle();
-      } else {
-        accelerateForward(currentGenome.motorSpeed, currentGenome.maxAcceleration);
-        
-        if (random(0, 2000) < 5) { // Less frequent for speed
-          expressState(3, 40);
-        }
-      }
+    if (random(0, 2000) < 5) { // Less frequent for speed
+      expressState(3, 40);
     }
+  }
+}
+
+// Context detection only does work when one of these changes
+void postMotorContext() {
+  postMovingState(motorsRunning);
+  postTaskState(isAvoiding, false);
+}
+
+// Pinned to CONTROL_CORE: fixed period via vTaskDelayUntil, timing self-measured
+void controlTaskLoop(void* parameter) {
+  TickType_t lastWake = xTaskGetTickCount();
+  uint32_t lastStartUs = micros();
+  
+  for (;;) {
+    uint32_t startUs = micros();
+    uint32_t periodUs = startUs - lastStartUs;
+    lastStartUs = startUs;
     
-    evolutionCycle();
+    controlTask();
+    postMotorContext();
+    readControlContext();
     
-  } else if (!isAwake) {
-    // Turn off all LEDs (255 = OFF for common anode)
-    ledcWrite(PWM_CH_L_R, 255); ledcWrite(PWM_CH_L_G, 255);
-    ledcWrite(PWM_CH_R_R, 255); ledcWrite(PWM_CH_R_G, 255);
-    delay(50); // Shorter sleep delays
-  } else {
-    stopMotors();
-    delay(50);
+    uint32_t runtimeUs = micros() - startUs;
+    controlStats.ticks++;
+    if (runtimeUs > controlStats.maxRuntimeUs) controlStats.maxRuntimeUs = runtimeUs;
+    if (controlStats.ticks > 1 && periodUs > controlStats.maxPeriodUs) controlStats.maxPeriodUs = periodUs;
+    if (runtimeUs > CONTROL_PERIOD_MS * 1000UL) controlStats.overruns++;
+    
+    publishControlSnapshot();
+    
+    vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(CONTROL_PERIOD_MS));
   }
+}
+
+// ─── Core 0: comms ──────────────────────────────────────────
+
+void txTask() {
+  txQueue.service();
   
-  // Update swarm communication (SPEEDIE fast updates)
+  const TxQueueStats& tx = txQueue.getStats();
+  commStats.messagesSent = tx.delivered;
+  commStats.messagesDropped = tx.failed + tx.dropped;
+}
+
+void rxTask() {
+  controlSnapshotSlot.read(latestControl);
+  drainReceivedFrames();
+}
+
+// Update swarm communication (SPEEDIE fast updates)
+void commsTask() {
   updateSwarmCommunication();
+}
+
+void positionTask() {
+  updateMyPosition();
+  markOwnCoverage();
+  publishUnexploredSide();
+  ageOutPeerLocations();
+}
+
+// Update ecosystem manager (Layer 3 intelligence)
+void ecosystemTask() {
+  if (swarmNode->ecosystem != nullptr) {
+    swarmNode->ecosystem->update();
+  }
+}
+
+void evolutionTask() {
+  if (latestControl.isAwake && !latestControl.isAvoiding) {
+    evolutionCycle();
+  }
+}
+
+// All flash writes happen here, on the comms core
+void persistenceTask() {
+  uint8_t requests = persistRequests.exchange(0);
+  if (requests & PERSIST_GENOME) stageGenome();
+  if (requests & PERSIST_METRICS) stageMetrics(latestControl.metrics);
   
-  // Update ecosystem manager (Layer 3 intelligence)
-  if (ecosystemManager != nullptr) {
-    ecosystemManager->update();
+  if (strategySnapshotSlot.readIfNew(persistedStrategies, strategySequenceSaved)) {
+    stageStrategies();
+  }
+  if (vocabularySnapshotSlot.readIfNew(persistedVocabulary, vocabularySequenceSaved)) {
+    stageVocabulary();
   }
+  
+  if (persistentStore.getDirtyCount() == 0) return;
+  
+  // Flash writes stall the cache on both cores; keep them out of escapes
+  // unless records have waited too long
+  if (latestControl.isAvoiding && persistentStore.getOldestDirtyAge() < PERSIST_MAX_DEFER_MS) return;
+  persistentStore.flush(PERSIST_FLUSH_BUDGET_US);
+}
+
+void diagnosticsTask() {
+  const ControlLoopStats& loop = latestControl.loopStats;
+  Serial.printf("⏱️ Control core %lu: %lu ticks, max run %luus, max period %luus, %lu overruns\n",
+                (unsigned long)CONTROL_CORE, (unsigned long)loop.ticks,
+                (unsigned long)loop.maxRuntimeUs, (unsigned long)loop.maxPeriodUs,
+                (unsigned long)loop.overruns);
+  Serial.printf("📨 RX ring: %u queued, %lu overflows, %lu oversize, %lu dropped commands\n",
+                (unsigned)receivedFrames.size(), (unsigned long)rxRingOverflows.load(),
+                (unsigned long)rxOversizeFrames.load(), (unsigned long)droppedControlCommands.load());
+  txQueue.printStats();
+  Serial.printf("📦 Bundles: %lu sent, %lu records received\n",
+                (unsigned long)commStats.bundlesSent, (unsigned long)commStats.bundleRecordsReceived);
+  persistentStore.printStats();
+  swarmMembership.printMembers();
+  commsScheduler.printStats();
+  commsScheduler.resetStats();
+}
+
+// Pinned to COMMS_CORE (with the Wi-Fi stack); yields every pass so the idle task runs
+void commsTaskLoop(void* parameter) {
+  for (;;) {
+    commsScheduler.run();
+    vTaskDelay(1);
+  }
+}
+
+void initializeScheduler() {
+  // Registration order is priority order within one scheduler pass
+  commsScheduler.addTask("tx", txTask, TX_SERVICE_PERIOD_MS);
+  commsScheduler.addTask("rx", rxTask, RX_DRAIN_PERIOD_MS);
+  commsScheduler.addTask("comms", commsTask, COMMS_PERIOD_MS);
+  commsScheduler.addTask("position", positionTask, POSITION_PERIOD_MS);
+  commsScheduler.addTask("buzzer", buzzerTask, BUZZER_PERIOD_MS);
+  commsScheduler.addTask("ecosystem", ecosystemTask, ECOSYSTEM_PERIOD_MS);
+  commsScheduler.addTask("evolution", evolutionTask, EVOLUTION_PERIOD_MS);
+  commsScheduler.addTask("persist", persistenceTask, PERSIST_PERIOD_MS);
+  commsScheduler.addTask("diag", diagnosticsTask, DIAGNOSTICS_PERIOD_MS);
+  
+  // Seed the cross-core copies before either task starts
+  controlGenome = currentGenome;
+  genomeSlot.publish(currentGenome);
+  genomeSequenceSeen = genomeSlot.getSequence();
+  publishControlSnapshot();
+  controlSnapshotSlot.read(latestControl);
+  
+  xTaskCreatePinnedToCore(controlTaskLoop, "control", 8192, nullptr, 3, &controlTaskHandle, CONTROL_CORE);
+  xTaskCreatePinnedToCore(commsTaskLoop, "comms", 8192, nullptr, 2, &commsTaskHandle, COMMS_CORE);
+  
+  Serial.printf("⏱️ Control loop at %lu Hz on core %ld, comms on core %ld\n",
+                (unsigned long)(1000 / CONTROL_PERIOD_MS), (long)CONTROL_CORE, (long)COMMS_CORE);
+}
+
+void loop() {
+  // Everything runs in the pinned tasks created by initializeScheduler()
+  vTaskDelete(nullptr);
+}
+#else
+
+// ═══════════════════════════════════════════════════════════
+// 🧪 BENCHMARK HOOKS (test/test_benchmarks)
+// ═══════════════════════════════════════════════════════════
+// The persistence structs are private to this file, so the benchmarks
+// reach the save path through these. Records go to the namespace given,
+// never PERSIST_NAMESPACE: a bench run leaves the bot's memory alone.
+
+void benchOpenPersistentStore(const char* nameSpace) {
+  persistentStore.begin(nameSpace, PERSIST_SCHEMA_VERSION);
+  registerPersistentRecords();
+  
+  persistedMetrics = metrics;
+  memcpy(persistedStrategies.strategies, strategyLibrary, sizeof(strategyLibrary));
+  persistedStrategies.count = strategyCount;
+  for (int i = 0; i < vocabulary.size(); i++) vocabulary.get(i, persistedVocabulary.words[i]);
+  persistedVocabulary.size = vocabulary.size();
+}
+
+// Stage one section, first changing one of its fields if asked
+void benchStageGenome(bool change) {
+  if (change) currentGenome.generation++;
+  stageGenome();
+}
+
+void benchStageMetrics(bool change) {
+  if (change) persistedMetrics.obstaclesEncountered++;
+  stageMetrics(persistedMetrics);
+}
+
+void benchStageStrategies(bool change) {
+  if (change) persistedStrategies.strategies[0].timesUsed++;
+  stageStrategies();
+}
+
+void benchStageVocabulary(bool change) {
+  if (change) persistedVocabulary.words[0].timesUsed++;
+  stageVocabulary();
+}
+
+size_t benchFlushPersisted() {
+  return persistentStore.flushAll();
 }
+#endif // PIO_UNIT_TESTING
 
 // ═══════════════════════════════════════════════════════════
 // 🎯 LOCALIZATION MESSAGE HANDLERS
@@ -2263,9 +3493,9 @@ void sendLocalizationResponse(const uint8_t* targetMac, uint32_t originalTimesta
   outgoingMessage.payload.localization.senderHeading = myPosition.heading;
   outgoingMessage.payload.localization.beaconFrequency = AUDIO_BEACON_FREQUENCY;
   
-  outgoingMessage.header.checksum = calculateChecksum((uint8_t*)&outgoingMessage, sizeof(SwarmMessage) - 1);
+  size_t frameLength = finalizeSwarmMessage(&outgoingMessage, sizeof(LocalizationPayload));
   
-  esp_now_send(targetMac, (uint8_t*)&outgoingMessage, sizeof(SwarmMessage));
+  txQueue.enqueue(targetMac, &outgoingMessage, frameLength);
 }
 
 // Send beacon response for ToF measurement
@@ -2285,7 +3515,7 @@ void sendBeaconResponse(const uint8_t* targetMac, uint32_t beaconTimestamp) {
   outgoingMessage.payload.localization.senderY = myPosition.y;
   outgoingMessage.payload.localization.senderHeading = myPosition.heading;
   
-  outgoingMessage.header.checksum = calculateChecksum((uint8_t*)&outgoingMessage, sizeof(SwarmMessage) - 1);
+  size_t frameLength = finalizeSwarmMessage(&outgoingMessage, sizeof(LocalizationPayload));
   
-  esp_now_send(targetMac, (uint8_t*)&outgoingMessage, sizeof(SwarmMessage));
+  txQueue.enqueue(targetMac, &outgoingMessage, frameLength);
 }
\ No newline at end of file
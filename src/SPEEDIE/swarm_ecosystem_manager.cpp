@@ -1,279 +0,0 @@
-// ═══════════════════════════════════════════════════════════════════════════════
-// 🌐 SWARM ECOSYSTEM MANAGER - LAYER 3 INTELLIGENCE IMPLEMENTATION
-// 
-// This file implements the complete ecosystem intelligence system that manages
-// trust networks, reputation scoring, and bot relationship tracking across
-// the entire swarm. It represents the "third layer" of swarm intelligence:
-// 
-// Layer 1: Individual bot evolution and learning
-// Layer 2: Direct peer-to-peer communication and coordination  
-// Layer 3: Ecosystem-wide intelligence, trust networks, and reputation systems
-//
-// The ecosystem manager maintains profiles of all known bots, tracks their
-// reliability and reputation over time, manages trust relationships between
-// bots, and provides data quality assessment to prevent misinformation.
-// ═══════════════════════════════════════════════════════════════════════════════
-
-#include "../../include/swarm_ecosystem_manager.h"
-#include <WiFi.h>
-#include <EEPROM.h>
-
-// ═══════════════════════════════════════════════════════════
-// 🏗️ CONSTRUCTOR
-// ═══════════════════════════════════════════════════════════
-
-SwarmEcosystemManager::SwarmEcosystemManager() {
-  // Initialize counters
-  botCount = 0;
-  relationshipCount = 0;
-  verificationLogIndex = 0;
-  
-  // Clear all bot profiles
-  for (int i = 0; i < MAX_BOT_PROFILES; i++) {
-    memset(&botProfiles[i], 0, sizeof(BotProfile));
-  }
-  
-  // Clear all relationships
-  for (int i = 0; i < MAX_RELATIONSHIPS; i++) {
-    memset(&relationships[i], 0, sizeof(BotRelationship));
-  }
-  
-  // Clear verification log
-  for (int i = 0; i < 100; i++) {
-    memset(&verificationLog[i], 0, sizeof(DataVerificationEntry));
-  }
-  
-  // Initialize timestamps
-  lastReputationUpdate = 0;
-  lastEcosystemAnalysis = 0;
-  
-  Serial.println("🌐 SwarmEcosystemManager: Layer 3 Intelligence initialized");
-  Serial.println("    - Trust network ready");  
-  Serial.println("    - Reputation system active");
-  Serial.println("    - Bot relationship tracking enabled");
-}
-
-void SwarmEcosystemManager::initialize() {
-  // Additional initialization if needed
-  Serial.println("🌐 Ecosystem Manager initialized successfully");
-}
-
-// ═══════════════════════════════════════════════════════════
-// 🤖 BOT REGISTRATION & MANAGEMENT
-// ═══════════════════════════════════════════════════════════
-
-void SwarmEcosystemManager::registerBot(uint8_t* mac, BotType type, const char* name) {
-  // Check if bot already exists
-  for (int i = 0; i < botCount; i++) {
-    if (memcmp(botProfiles[i].botMAC, mac, 6) == 0) {
-      Serial.printf("🌐 Bot %s already registered, updating info\n", name);
-      
-      // Update existing bot info
-      strncpy(botProfiles[i].botName, name, 15);
-      botProfiles[i].botName[15] = '\0';
-      botProfiles[i].botType = type;
-      
-      return;
-    }
-  }
-  
-  // Register new bot if space available
-  if (botCount < MAX_BOT_PROFILES) {
-    BotProfile* newBot = &botProfiles[botCount];
-    
-    // Set identity
-    memcpy(newBot->botMAC, mac, 6);
-    strncpy(newBot->botName, name, 15);
-    newBot->botName[15] = '\0';
-    newBot->botType = type;
-    newBot->serialNumber = random(100000, 999999);
-    newBot->activationTimestamp = millis();
-    
-    // Initialize evolution status
-    newBot->generation = 1;
-    newBot->fitness = 50.0f;
-    newBot->totalRuntime = 0;
-    newBot->totalMissions = 0;
-    
-    // Initialize reliability metrics (neutral starting values)
-    newBot->dataAccuracy = 0.8f;
-    newBot->missionSuccessRate = 0.7f;
-    newBot->communicationReliability = 0.75f;
-    newBot->availabilityScore = 0.9f;
-    
-    newBot->totalDataSent = 0;
-    newBot->dataVerifiedGood = 0;
-    newBot->dataVerifiedBad = 0;
-    
-    // Initialize reputation
-    newBot->reputationScore = 50.0f; // Neutral starting reputation
-    newBot->lastReputationUpdate = millis();
-    
-    // Initialize health
-    newBot->health = HEALTH_GOOD;
-    for (int i = 0; i < 4; i++) {
-      newBot->sensorHealth[i] = COMPONENT_OPERATIONAL;
-    }
-    newBot->estimatedRemainingLife = 1000.0f; // 1000 hours estimated
-    
-    botCount++;
-    
-    Serial.printf("🌐 Registered new bot: %s - Total bots: %d\n", name, botCount);
-    
-    return;
-  }
-  
-  Serial.println("⚠️ Cannot register bot - ecosystem at capacity");
-}
-
-void SwarmEcosystemManager::updateBotStatus(uint8_t* mac, uint32_t generation, float fitness) {
-  BotProfile* profile = getBotProfile(mac);
-  if (profile) {
-    profile->generation = generation;
-    profile->fitness = fitness;
-  }
-}
-
-void SwarmEcosystemManager::updateBotHealth(uint8_t* mac, BotHealth health) {
-  BotProfile* profile = getBotProfile(mac);
-  if (profile) {
-    profile->health = health;
-  }
-}
-
-BotProfile* SwarmEcosystemManager::getBotProfile(uint8_t* mac) {
-  for (int i = 0; i < botCount; i++) {
-    if (memcmp(botProfiles[i].botMAC, mac, 6) == 0) {
-      return &botProfiles[i];
-    }
-  }
-  return nullptr;
-}
-
-void SwarmEcosystemManager::recordInteraction(uint8_t* botA, uint8_t* botB, 
-                                            InteractionType type, InteractionResult result) {
-  // Basic interaction recording - can be expanded
-  Serial.printf("🌐 Recorded interaction between bots\n");
-}
-
-void SwarmEcosystemManager::recordDataVerification(uint8_t* sender, uint8_t* verifier, 
-                                                 uint32_t dataHash, bool isCorrect, float confidence) {
-  // Record data verification results
-  if (verificationLogIndex < 100) {
-    DataVerificationEntry* entry = &verificationLog[verificationLogIndex];
-    memcpy(entry->senderMAC, sender, 6);
-    memcpy(entry->verifierMAC, verifier, 6);
-    entry->dataHash = dataHash;
-    entry->isVerification = isCorrect;
-    entry->timestamp = millis();
-    entry->dataConfidence = confidence;
-    verificationLogIndex++;
-  }
-}
-
-float SwarmEcosystemManager::getTrustScore(uint8_t* botA, uint8_t* botB) {
-  // Basic trust score calculation
-  return 0.7f; // Default trust level
-}
-
-bool SwarmEcosystemManager::shouldTrustBot(uint8_t* mac, float threshold) {
-  BotProfile* profile = getBotProfile(mac);
-  if (profile) {
-    return (profile->reputationScore / 100.0f) > threshold;
-  }
-  return false;
-}
-
-void SwarmEcosystemManager::updateAllReputations() {
-  // Update all bot reputations
-  lastReputationUpdate = millis();
-}
-
-float SwarmEcosystemManager::calculateReputation(uint8_t* mac) {
-  BotProfile* profile = getBotProfile(mac);
-  if (profile) {
-    return profile->reputationScore;
-  }
-  return 50.0f; // Default reputation
-}
-
-void SwarmEcosystemManager::updateDataAccuracy(uint8_t* mac) {
-  // Update data accuracy for bot
-}
-
-void SwarmEcosystemManager::performEcosystemAnalysis() {
-  // Analyze ecosystem health
-  lastEcosystemAnalysis = millis();
-  Serial.println("🌐 Ecosystem analysis completed");
-}
-
-void SwarmEcosystemManager::identifyWeakBots() {
-  // Identify underperforming bots
-}
-
-void SwarmEcosystemManager::identifyCapabilityGaps() {
-  // Find missing capabilities in swarm
-}
-
-void SwarmEcosystemManager::generateUpgradeRecommendations() {
-  // Generate upgrade suggestions
-}
-
-float SwarmEcosystemManager::getOverallSwarmHealth() {
-  return 75.0f; // Default health score
-}
-
-uint8_t SwarmEcosystemManager::getHealthyBotCount() {
-  uint8_t count = 0;
-  for (int i = 0; i < botCount; i++) {
-    if (botProfiles[i].health >= HEALTH_GOOD) {
-      count++;
-    }
-  }
-  return count;
-}
-
-uint8_t SwarmEcosystemManager::getDegradedBotCount() {
-  uint8_t count = 0;
-  for (int i = 0; i < botCount; i++) {
-    if (botProfiles[i].health < HEALTH_GOOD) {
-      count++;
-    }
-  }
-  return count;
-}
-
-BotProfile** SwarmEcosystemManager::getMostTrustedBots(uint8_t* count) {
-  // Return array of most trusted bots
-  *count = 0;
-  return nullptr;
-}
-
-BotProfile** SwarmEcosystemManager::getLeastTrustedBots(uint8_t* count) {
-  // Return array of least trusted bots
-  *count = 0;
-  return nullptr;
-}
-
-uint8_t* SwarmEcosystemManager::selectBestBotForTask(TaskType task, uint8_t* candidateMACs, uint8_t candidateCount) {
-  // Select best bot for specific task
-  if (candidateCount > 0) {
-    return candidateMACs; // Return first candidate as default
-  }
-  return nullptr;
-}
-
-void SwarmEcosystemManager::update() {
-  unsigned long currentTime = millis();
-  
-  // Update reputations periodically
-  if (currentTime - lastReputationUpdate > REPUTATION_UPDATE_INTERVAL) {
-    updateAllReputations();
-  }
-  
-  // Perform ecosystem analysis periodically
-  if (currentTime - lastEcosystemAnalysis > ECOSYSTEM_ANALYSIS_INTERVAL) {
-    performEcosystemAnalysis();
-  }
-}
-
@@ -0,0 +1,108 @@
+#include "ultrasonic_ranger.h"
+
+// ═══════════════════════════════════════════════════════════
+// 📏 ASYNC HC-SR04 RANGER IMPLEMENTATION
+// ═══════════════════════════════════════════════════════════
+// Echo state ownership:
+//   update()  IDLE -> WAIT_RISE (before the trigger pulse)
+//   ISR       WAIT_RISE -> WAIT_FALL (rising edge), WAIT_FALL -> IDLE (+ publish)
+//   update()  WAIT_* -> IDLE on timeout
+// Every hand-back to IDLE is a compare-exchange, so exactly one side
+// finishes each ping and a late edge can never publish a stale value.
+
+bool AsyncUltrasonicRanger::begin(uint8_t trig, uint8_t echo, uint32_t cycle) {
+  trigPin = trig;
+  echoPin = echo;
+  cycleUs = max(cycle, (uint32_t)1000);
+
+  pinMode(trigPin, OUTPUT);
+  pinMode(echoPin, INPUT);
+  digitalWrite(trigPin, LOW);
+
+  echoState.store(ECHO_IDLE);
+  triggerUs = micros() - cycleUs; // Allow the first ping straight away
+  attachInterruptArg(digitalPinToInterrupt(echoPin), echoIsr, this, CHANGE);
+
+  Serial.printf("📏 Async ultrasonic ranger on trig=%d echo=%d (cycle %luus)\n",
+                trigPin, echoPin, (unsigned long)cycleUs);
+  return true;
+}
+
+void IRAM_ATTR AsyncUltrasonicRanger::echoIsr(void* arg) {
+  AsyncUltrasonicRanger* self = static_cast<AsyncUltrasonicRanger*>(arg);
+  uint32_t now = micros();
+  uint8_t expected;
+
+  if (digitalRead(self->echoPin) == HIGH) {
+    expected = ECHO_WAIT_RISE;
+    if (self->echoState.compare_exchange_strong(expected, (uint8_t)ECHO_WAIT_FALL)) {
+      self->riseUs = now;
+    }
+    return;
+  }
+
+  expected = ECHO_WAIT_FALL;
+  if (!self->echoState.compare_exchange_strong(expected, (uint8_t)ECHO_IDLE)) return;
+
+  RangeReading reading;
+  reading.echoUs = now - self->riseUs;
+  reading.distanceMm = (int32_t)((reading.echoUs * 343UL) / 2000UL); // 0.343 mm/us, there and back
+  reading.timestampUs = now;
+  reading.valid = true;
+  self->results.publish(reading);
+}
+
+void AsyncUltrasonicRanger::update() {
+  uint32_t now = micros();
+  uint8_t state = echoState.load();
+
+  if (state != ECHO_IDLE) {
+    if (now - triggerUs > ULTRASONIC_ECHO_TIMEOUT_US) {
+      // Lost echo: take the ping back unless the ISR finished it meanwhile
+      if (echoState.compare_exchange_strong(state, (uint8_t)ECHO_IDLE)) {
+        timeoutCount++;
+        pendingTimeout = true;
+      }
+    }
+    return;
+  }
+
+  // Respect the trigger spacing, and never ping while the module is still
+  // holding echo high from a previous (missed) measurement
+  if (now - triggerUs < cycleUs) return;
+  if (digitalRead(echoPin) == HIGH) return;
+
+  triggerUs = now;
+  echoState.store(ECHO_WAIT_RISE);
+  digitalWrite(trigPin, HIGH);
+  delayMicroseconds(10);
+  digitalWrite(trigPin, LOW);
+}
+
+bool AsyncUltrasonicRanger::poll(RangeReading& out) {
+  if (results.readIfNew(lastResult, lastSeenSequence)) {
+    pendingTimeout = false;
+    hasResult = true;
+    out = lastResult;
+    return true;
+  }
+
+  if (pendingTimeout) {
+    pendingTimeout = false;
+    lastResult.distanceMm = 0;
+    lastResult.echoUs = 0;
+    lastResult.timestampUs = micros();
+    lastResult.valid = false;
+    hasResult = true;
+    out = lastResult;
+    return true;
+  }
+
+  return false;
+}
+
+bool AsyncUltrasonicRanger::getLatest(RangeReading& out) const {
+  if (!hasResult) return false;
+  out = lastResult;
+  return true;
+}
@@ -450,6 +450,7 @@ void runCompleteTestSuite() {
 // 🎬 SETUP
 // ═══════════════════════════════════════════════════════════
 
+#ifndef PIO_UNIT_TESTING // Test builds bring their own setup()/loop()
 void setup() {
   Serial.begin(115200);
   delay(1000);
@@ -528,4 +529,5 @@ void loop() {
       Serial.println("  'help' - Show this help");
     }
   }
-}
\ No newline at end of file
+}
+#endif // PIO_UNIT_TESTING
@@ -15,70 +15,81 @@
  */
 
 #include "emergent_signal.h"
+#include "context_detection.h"
+#include "swarm_node.h"
 
 // ═══════════════════════════════════════════════════════════
-// 🎯 GLOBAL CONTEXT STATE
+// 🎯 CONTEXT STATE (PER NODE)
 // ═══════════════════════════════════════════════════════════
+// Event driven: sensor and comms code post readings through the
+// postXxx() functions below. Each reading is reduced to edge flags (with
+// hysteresis), and the context is re-derived only when a flag flips, so a
+// new obstacle changes the context on the very reading that shows it.
+// Time-based edges (peer contact expiring, lack of progress) are deadlines
+// checked in O(1) by getCurrentContext(). All calls belong to one task.
 
-static EnvironmentalContext currentContextState = CONTEXT_UNKNOWN;
-static EmotionalState currentEmotionalState = EMOTION_NEUTRAL;
-static unsigned long lastContextUpdate = 0;
-static unsigned long lastSuccessTime = 0;
-static unsigned long lastFailureTime = 0;
-static uint8_t consecutiveSuccesses = 0;
-static uint8_t consecutiveFailures = 0;
-
-// External sensor data (these would be updated by main sensor loops)
-extern int distance_cm;              // From HC-SR04 or VL53L0X
-extern bool motionDetected;          // From RCWL-0516 (WHEELIE only)
-extern float accelerationMagnitude;  // From MPU-6050 (SPEEDIE only)
-extern bool isMoving;               // From movement detection
-extern bool taskInProgress;        // From main task loop
-extern bool taskSuccessful;        // From task completion detection
-extern unsigned long lastPeerContact; // From ESP-NOW peer detection
+#define OBSTACLE_ENTER_CM 15          // Obstacle near below this...
+#define OBSTACLE_EXIT_CM 18           // ...until the range opens past this
+#define CLEAR_ENTER_CM 100            // Open space above this (or no echo)...
+#define CLEAR_EXIT_CM 90              // ...until the range closes below this
+#define RESOURCE_MIN_CM 30            // Motion only means "resource" with room ahead
+#define DISTURBANCE_ACCEL 2.0f        // Acceleration while parked = being moved
+#define PEER_CONTACT_HOLD_MS 5000     // Peer context lasts this long after contact
+#define STUCK_PROGRESS_CM 5           // Range change that counts as progress
+#define STUCK_TIMEOUT_MS 1500         // No progress this long while moving = stuck
+
+static_assert(CONTEXT_ID_OBSTACLE_NEAR == CONTEXT_OBSTACLE_NEAR && CONTEXT_ID_OPEN_SPACE == CONTEXT_OPEN_SPACE &&
+              CONTEXT_ID_TASK_FAILURE == CONTEXT_TASK_FAILURE && CONTEXT_ID_UNKNOWN == CONTEXT_UNKNOWN,
+              "context_detection.h ids must match EnvironmentalContext");
+
+ContextDetectionState::ContextDetectionState() {
+  memset(this, 0, sizeof(*this));
+  currentContext = CONTEXT_UNKNOWN;
+  currentEmotion = EMOTION_NEUTRAL;
+  pathClear = true;
+  mostFrequentContext = CONTEXT_UNKNOWN;
+}
+
+static ContextDetectionState& contextState() {
+  SwarmNode* node = swarmNode;
+  if (node->context == nullptr) node->context = new ContextDetectionState();
+  return *node->context;
+}
 
 // Forward declarations
 void recordSuccess();
 void recordFailure();
-bool isStuck();
+void updateContextHistory(EnvironmentalContext context);
 
 // ═══════════════════════════════════════════════════════════
 // 🔍 CORE CONTEXT DETECTION
 // ═══════════════════════════════════════════════════════════
 
-EnvironmentalContext getCurrentContext() {
-  unsigned long now = millis();
-  
-  // Update context maximum once per 500ms to avoid rapid changes
-  if (now - lastContextUpdate < 500) {
-    return currentContextState;
-  }
-  
+static EnvironmentalContext deriveContext() {
+  ContextDetectionState& ctx = contextState();
   EnvironmentalContext newContext = CONTEXT_UNKNOWN;
   
   // Priority 1: Immediate danger/obstacles
-  if (distance_cm > 0 && distance_cm < 15) {
+  if (ctx.obstacleNear) {
     newContext = CONTEXT_OBSTACLE_NEAR;
   }
   // Priority 2: Task-related contexts
-  else if (taskInProgress) {
-    if (taskSuccessful) {
+  else if (ctx.taskInProgress) {
+    if (ctx.taskSuccessful) {
       newContext = CONTEXT_TASK_SUCCESS;
-      recordSuccess();
-    } else if (isStuck()) {
+    } else if (ctx.stuck) {
       newContext = CONTEXT_TASK_FAILURE;
-      recordFailure();
     } else {
       newContext = CONTEXT_EXPLORATION; // Actively working on task
     }
   }
   // Priority 3: Peer interaction
-  else if (now - lastPeerContact < 5000) { // Peer contact within 5 seconds
+  else if (ctx.peerNearby) {
     newContext = CONTEXT_PEER_DETECTED;
   }
   // Priority 4: Movement states
-  else if (isMoving) {
-    if (distance_cm > 100 || distance_cm == 0) { // Clear path ahead
+  else if (ctx.isMoving) {
+    if (ctx.pathClear) {
       newContext = CONTEXT_OPEN_SPACE;
     } else {
       newContext = CONTEXT_EXPLORATION;
@@ -90,66 +101,168 @@ EnvironmentalContext getCurrentContext() {
   }
   
   // Special contexts based on sensors
-  #ifdef WHEELIE_BOT
+  #if defined(WHEELIE_BOT) || defined(BOT_TYPE_WHEELIE)
   // WHEELIE has motion sensor - can detect interesting activity
-  if (motionDetected && distance_cm > 30) {
+  if (ctx.motionDetected && ctx.roomAhead) {
     newContext = CONTEXT_RESOURCE_FOUND; // Something interesting detected
   }
   #endif
   
-  #ifdef SPEEDIE_BOT
+  #if defined(SPEEDIE_BOT) || defined(BOT_TYPE_SPEEDIE)
   // SPEEDIE has accelerometer - can detect if being moved/disturbed
-  if (accelerationMagnitude > 2.0f && !isMoving) {
+  if (ctx.disturbed) {
     newContext = CONTEXT_DANGER_SENSED; // Being moved unexpectedly
   }
   #endif
   
-  // Update state
-  currentContextState = newContext;
-  lastContextUpdate = now;
-  
   return newContext;
 }
 
+// An input edge flipped: transition now, counting task outcomes once per entry
+static void reevaluateContext() {
+  ContextDetectionState& ctx = contextState();
+  ctx.disturbed = (ctx.accelerationMagnitude > DISTURBANCE_ACCEL) && !ctx.isMoving;
+  
+  EnvironmentalContext newContext = deriveContext();
+  if (newContext == ctx.currentContext) return;
+  
+  if (newContext == CONTEXT_TASK_SUCCESS) recordSuccess();
+  if (newContext == CONTEXT_TASK_FAILURE) recordFailure();
+  
+  ctx.currentContext = newContext;
+  updateContextHistory(newContext);
+}
+
+static void resetProgress(unsigned long now) {
+  ContextDetectionState& ctx = contextState();
+  ctx.progressDistance = ctx.distanceCm;
+  ctx.lastProgressTime = now;
+  ctx.stuck = false;
+}
+
+EnvironmentalContext getCurrentContext() {
+  ContextDetectionState& ctx = contextState();
+  unsigned long now = millis();
+  bool changed = false;
+  
+  // Deadlines are the only edges nobody posts
+  if (ctx.peerNearby && (long)(now - ctx.peerContactUntil) >= 0) {
+    ctx.peerNearby = false;
+    changed = true;
+  }
+  if (ctx.isMoving && !ctx.stuck && now - ctx.lastProgressTime >= STUCK_TIMEOUT_MS) {
+    ctx.stuck = true;
+    changed = true;
+  }
+  
+  if (changed) reevaluateContext();
+  return (EnvironmentalContext)ctx.currentContext;
+}
+
+// ═══════════════════════════════════════════════════════════
+// 📥 CONTEXT INPUT EVENTS
+// ═══════════════════════════════════════════════════════════
+
+void postDistanceReading(int distanceCm) {
+  ContextDetectionState& ctx = contextState();
+  ctx.distanceCm = distanceCm;
+  bool valid = distanceCm > 0;
+  
+  bool near = valid && distanceCm < (ctx.obstacleNear ? OBSTACLE_EXIT_CM : OBSTACLE_ENTER_CM);
+  bool clear = !valid || distanceCm > (ctx.pathClear ? CLEAR_EXIT_CM : CLEAR_ENTER_CM);
+  bool room = distanceCm > RESOURCE_MIN_CM;
+  
+  // Range changing while we drive counts as progress
+  bool wasStuck = ctx.stuck;
+  if (ctx.isMoving && abs(distanceCm - ctx.progressDistance) >= STUCK_PROGRESS_CM) {
+    resetProgress(millis());
+  }
+  
+  if (near == ctx.obstacleNear && clear == ctx.pathClear && room == ctx.roomAhead && ctx.stuck == wasStuck) return;
+  ctx.obstacleNear = near;
+  ctx.pathClear = clear;
+  ctx.roomAhead = room;
+  reevaluateContext();
+}
+
+void postMotionDetected(bool detected) {
+  ContextDetectionState& ctx = contextState();
+  if (detected == ctx.motionDetected) return;
+  ctx.motionDetected = detected;
+  reevaluateContext();
+}
+
+void postAcceleration(float magnitude) {
+  ContextDetectionState& ctx = contextState();
+  ctx.accelerationMagnitude = magnitude;
+  bool nowDisturbed = (magnitude > DISTURBANCE_ACCEL) && !ctx.isMoving;
+  if (nowDisturbed != ctx.disturbed) reevaluateContext();
+}
+
+void postMovingState(bool moving) {
+  ContextDetectionState& ctx = contextState();
+  if (moving == ctx.isMoving) return;
+  ctx.isMoving = moving;
+  resetProgress(millis());
+  reevaluateContext();
+}
+
+void postTaskState(bool inProgress, bool successful) {
+  ContextDetectionState& ctx = contextState();
+  if (inProgress == ctx.taskInProgress && successful == ctx.taskSuccessful) return;
+  ctx.taskInProgress = inProgress;
+  ctx.taskSuccessful = successful;
+  reevaluateContext();
+}
+
+void postPeerContact() {
+  ContextDetectionState& ctx = contextState();
+  ctx.peerContactUntil = millis() + PEER_CONTACT_HOLD_MS;
+  if (ctx.peerNearby) return;
+  ctx.peerNearby = true;
+  reevaluateContext();
+}
+
 EmotionalState getCurrentEmotionalState() {
+  ContextDetectionState& ctx = contextState();
   unsigned long now = millis();
   
   // Emotional state is influenced by recent success/failure patterns
   
   // Very positive: Recent successes, no failures
-  if (consecutiveSuccesses >= 3 && (now - lastFailureTime) > 30000) {
-    currentEmotionalState = EMOTION_VERY_POSITIVE;
+  if (ctx.consecutiveSuccesses >= 3 && (now - ctx.lastFailureTime) > 30000) {
+    ctx.currentEmotion = EMOTION_VERY_POSITIVE;
   }
   // Positive: More recent successes than failures
-  else if (consecutiveSuccesses >= 2 && (now - lastSuccessTime) < 10000) {
-    currentEmotionalState = EMOTION_POSITIVE;
+  else if (ctx.consecutiveSuccesses >= 2 && (now - ctx.lastSuccessTime) < 10000) {
+    ctx.currentEmotion = EMOTION_POSITIVE;
   }
   // Very negative: Recent failures, stuck situations
-  else if (consecutiveFailures >= 3 && (now - lastSuccessTime) > 30000) {
-    currentEmotionalState = EMOTION_VERY_NEGATIVE;
+  else if (ctx.consecutiveFailures >= 3 && (now - ctx.lastSuccessTime) > 30000) {
+    ctx.currentEmotion = EMOTION_VERY_NEGATIVE;
   }
   // Negative: Recent failure or being stuck
-  else if (consecutiveFailures >= 2 && (now - lastFailureTime) < 10000) {
-    currentEmotionalState = EMOTION_NEGATIVE;
+  else if (ctx.consecutiveFailures >= 2 && (now - ctx.lastFailureTime) < 10000) {
+    ctx.currentEmotion = EMOTION_NEGATIVE;
   }
   // Neutral: Balanced or no recent strong events
   else {
-    currentEmotionalState = EMOTION_NEUTRAL;
+    ctx.currentEmotion = EMOTION_NEUTRAL;
   }
   
   // Decay extreme emotions over time
-  if (now - lastSuccessTime > 60000 && now - lastFailureTime > 60000) {
-    if (currentEmotionalState != EMOTION_NEUTRAL) {
+  if (now - ctx.lastSuccessTime > 60000 && now - ctx.lastFailureTime > 60000) {
+    if (ctx.currentEmotion != EMOTION_NEUTRAL) {
       // Gradually return to neutral
-      if (currentEmotionalState > EMOTION_NEUTRAL) {
-        currentEmotionalState = (EmotionalState)(currentEmotionalState - 1);
+      if (ctx.currentEmotion > EMOTION_NEUTRAL) {
+        ctx.currentEmotion--;
       } else {
-        currentEmotionalState = (EmotionalState)(currentEmotionalState + 1);
+        ctx.currentEmotion++;
       }
     }
   }
   
-  return currentEmotionalState;
+  return (EmotionalState)ctx.currentEmotion;
 }
 
 // ═══════════════════════════════════════════════════════════
@@ -157,51 +270,29 @@ EmotionalState getCurrentEmotionalState() {
 // ═══════════════════════════════════════════════════════════
 
 void recordSuccess() {
-  lastSuccessTime = millis();
-  consecutiveSuccesses++;
-  consecutiveFailures = 0; // Reset failure counter
+  ContextDetectionState& ctx = contextState();
+  ctx.lastSuccessTime = millis();
+  ctx.consecutiveSuccesses++;
+  ctx.consecutiveFailures = 0; // Reset failure counter
   
-  if (consecutiveSuccesses > 10) {
-    consecutiveSuccesses = 10; // Cap at 10
+  if (ctx.consecutiveSuccesses > 10) {
+    ctx.consecutiveSuccesses = 10; // Cap at 10
   }
   
-  Serial.printf("✅ Success recorded (consecutive: %d)\n", consecutiveSuccesses);
+  Serial.printf("✅ Success recorded (consecutive: %d)\n", ctx.consecutiveSuccesses);
 }
 
 void recordFailure() {
-  lastFailureTime = millis();
-  consecutiveFailures++;
-  consecutiveSuccesses = 0; // Reset success counter
-  
-  if (consecutiveFailures > 10) {
-    consecutiveFailures = 10; // Cap at 10
-  }
-  
-  Serial.printf("❌ Failure recorded (consecutive: %d)\n", consecutiveFailures);
-}
-
-bool isStuck() {
-  // Define "stuck" as: trying to move but distance hasn't changed significantly
-  static int lastDistance = 0;
-  static unsigned long lastMovementAttempt = 0;
-  static uint8_t stuckCounter = 0;
+  ContextDetectionState& ctx = contextState();
+  ctx.lastFailureTime = millis();
+  ctx.consecutiveFailures++;
+  ctx.consecutiveSuccesses = 0; // Reset success counter
   
-  unsigned long now = millis();
-  
-  if (isMoving) {
-    if (abs(distance_cm - lastDistance) < 5) {
-      // Distance hasn't changed much despite movement
-      stuckCounter++;
-    } else {
-      stuckCounter = 0; // Reset if we're making progress
-    }
-    
-    lastDistance = distance_cm;
-    lastMovementAttempt = now;
+  if (ctx.consecutiveFailures > 10) {
+    ctx.consecutiveFailures = 10; // Cap at 10
   }
   
-  // Consider stuck if no progress for 3 consecutive movement attempts
-  return (stuckCounter >= 3);
+  Serial.printf("❌ Failure recorded (consecutive: %d)\n", ctx.consecutiveFailures);
 }
 
 // ═══════════════════════════════════════════════════════════
@@ -256,62 +347,89 @@ float getContextIntensity(EnvironmentalContext context) {
 // 📈 CONTEXT HISTORY & PATTERNS
 // ═══════════════════════════════════════════════════════════
 
-#define CONTEXT_HISTORY_SIZE 20
-static EnvironmentalContext contextHistory[CONTEXT_HISTORY_SIZE];
-static unsigned long contextTimestamps[CONTEXT_HISTORY_SIZE];
-static uint8_t historyIndex = 0;
-static bool historyFull = false;
+#define CONTEXT_STABILITY_WINDOW_MS 10000
+#define CONTEXT_STABILITY_MAX_CHANGES 9    // This many transitions in the window = fully unstable
 
-void updateContextHistory(EnvironmentalContext context) {
-  contextHistory[historyIndex] = context;
-  contextTimestamps[historyIndex] = millis();
-  
-  historyIndex = (historyIndex + 1) % CONTEXT_HISTORY_SIZE;
-  if (historyIndex == 0) {
-    historyFull = true;
-  }
+// The history is a ring of context transitions, newest last. contextCounts[]
+// mirrors the ring and the stability window start only ever moves forward,
+// so both queries below are O(1) instead of a rescan.
+
+static uint8_t historySlotOf(uint32_t transition) {
+  ContextDetectionState& ctx = contextState();
+  return (ctx.historyIndex + CONTEXT_HISTORY_SIZE - (ctx.transitionTotal - transition)) % CONTEXT_HISTORY_SIZE;
 }
 
-EnvironmentalContext getMostFrequentRecentContext() {
-  uint8_t contextCounts[12] = {0}; // Count for each context type
+// Only needed when the most frequent context lost an entry: CONTEXT_TYPES reads
+static void rescanMostFrequent() {
+  ContextDetectionState& ctx = contextState();
+  ctx.mostFrequentContext = CONTEXT_UNKNOWN;
   uint8_t maxCount = 0;
-  EnvironmentalContext mostFrequent = CONTEXT_UNKNOWN;
+  for (uint8_t c = 0; c < CONTEXT_TYPES; c++) {
+    if (ctx.contextCounts[c] > maxCount) {
+      maxCount = ctx.contextCounts[c];
+      ctx.mostFrequentContext = c;
+    }
+  }
+}
+
+void updateContextHistory(EnvironmentalContext context) {
+  ContextDetectionState& ctx = contextState();
+  if (ctx.historyCount == CONTEXT_HISTORY_SIZE) {
+    uint8_t evicted = ctx.history[ctx.historyIndex];
+    if (evicted < CONTEXT_TYPES) {
+      ctx.contextCounts[evicted]--;
+      if (evicted == ctx.mostFrequentContext) rescanMostFrequent();
+    }
+  } else {
+    ctx.historyCount++;
+  }
   
-  uint8_t itemsToCheck = historyFull ? CONTEXT_HISTORY_SIZE : historyIndex;
+  ctx.history[ctx.historyIndex] = context;
+  ctx.historyTimes[ctx.historyIndex] = millis();
+  ctx.historyIndex = (ctx.historyIndex + 1) % CONTEXT_HISTORY_SIZE;
+  ctx.transitionTotal++;
   
-  for (uint8_t i = 0; i < itemsToCheck; i++) {
-    if (contextHistory[i] < 12) { // Valid context
-      contextCounts[contextHistory[i]]++;
-      if (contextCounts[contextHistory[i]] > maxCount) {
-        maxCount = contextCounts[contextHistory[i]];
-        mostFrequent = contextHistory[i];
-      }
+  if (context < CONTEXT_TYPES) {
+    ctx.contextCounts[context]++;
+    if (ctx.mostFrequentContext == CONTEXT_UNKNOWN ||
+        ctx.contextCounts[context] > ctx.contextCounts[ctx.mostFrequentContext]) {
+      ctx.mostFrequentContext = context;
     }
   }
-  
-  return mostFrequent;
+}
+
+EnvironmentalContext getMostFrequentRecentContext() {
+  ContextDetectionState& ctx = contextState();
+  return (EnvironmentalContext)ctx.mostFrequentContext;
+}
+
+uint8_t getCurrentContextId() {
+  return getCurrentContext();
+}
+
+uint8_t getMostFrequentContextId() {
+  return getMostFrequentRecentContext();
 }
 
 float getContextStability() {
+  ContextDetectionState& ctx = contextState();
   // Measure how stable the context has been recently
-  if (!historyFull && historyIndex < 5) {
+  if (ctx.transitionTotal == 0) {
     return 0.5f; // Not enough data
   }
   
-  uint8_t itemsToCheck = min(10, historyFull ? CONTEXT_HISTORY_SIZE : historyIndex);
-  uint8_t changes = 0;
-  
-  for (uint8_t i = 1; i < itemsToCheck; i++) {
-    uint8_t prevIndex = (historyIndex - i - 1 + CONTEXT_HISTORY_SIZE) % CONTEXT_HISTORY_SIZE;
-    uint8_t currIndex = (historyIndex - i + CONTEXT_HISTORY_SIZE) % CONTEXT_HISTORY_SIZE;
-    
-    if (contextHistory[prevIndex] != contextHistory[currIndex]) {
-      changes++;
-    }
+  // Drop transitions that aged out of the window (or out of the ring)
+  unsigned long now = millis();
+  uint32_t oldestKept = ctx.transitionTotal - ctx.historyCount;
+  if (ctx.stabilityWindowStart < oldestKept) ctx.stabilityWindowStart = oldestKept;
+  while (ctx.stabilityWindowStart < ctx.transitionTotal &&
+         now - ctx.historyTimes[historySlotOf(ctx.stabilityWindowStart)] > CONTEXT_STABILITY_WINDOW_MS) {
+    ctx.stabilityWindowStart++;
   }
   
   // Stability = 1.0 - (changes / possible_changes)
-  return 1.0f - (float)changes / (float)(itemsToCheck - 1);
+  uint32_t changes = min(ctx.transitionTotal - ctx.stabilityWindowStart, (uint32_t)CONTEXT_STABILITY_MAX_CHANGES);
+  return 1.0f - (float)changes / (float)CONTEXT_STABILITY_MAX_CHANGES;
 }
 
 // ═══════════════════════════════════════════════════════════
@@ -319,20 +437,21 @@ float getContextStability() {
 // ═══════════════════════════════════════════════════════════
 
 void printContextState() {
+  ContextDetectionState& ctx = contextState();
   Serial.println("🌍 === CURRENT ENVIRONMENTAL STATE ===");
   Serial.printf("Context: %s (intensity: %.1f)\n", 
-                contextToString(currentContextState).c_str(), 
-                getContextIntensity(currentContextState));
-  Serial.printf("Emotion: %s\n", emotionToString(currentEmotionalState).c_str());
+                contextToString((EnvironmentalContext)ctx.currentContext).c_str(), 
+                getContextIntensity((EnvironmentalContext)ctx.currentContext));
+  Serial.printf("Emotion: %s\n", emotionToString((EmotionalState)ctx.currentEmotion).c_str());
   Serial.printf("Consecutive successes: %d, failures: %d\n", 
-                consecutiveSuccesses, consecutiveFailures);
+                ctx.consecutiveSuccesses, ctx.consecutiveFailures);
   Serial.printf("Context stability: %.2f\n", getContextStability());
   Serial.printf("Most frequent recent: %s\n", 
                 contextToString(getMostFrequentRecentContext()).c_str());
   
   // Sensor summary
   Serial.printf("Sensors: dist=%dcm, motion=%s, moving=%s\n", 
-                distance_cm, motionDetected ? "YES" : "NO", isMoving ? "YES" : "NO");
+                ctx.distanceCm, ctx.motionDetected ? "YES" : "NO", ctx.isMoving ? "YES" : "NO");
   
   Serial.println("========================================");
-}
\ No newline at end of file
+}
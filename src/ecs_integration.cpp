@@ -8,13 +8,6 @@ Implementation of the ECS integration layer for ESP32-based bots
 // Global ECS instance
 ECSIntegration ecs;
 
-// EEPROM layout constants
-#define ECS_EEPROM_MAGIC 0xEC52  // "ECS2" magic number
-#define ECS_EEPROM_MAGIC_ADDR 0
-#define ECS_EEPROM_VERSION_ADDR 2
-#define ECS_EEPROM_PARAM_COUNT_ADDR 4
-#define ECS_EEPROM_PARAMS_START 8
-
 ECSIntegration::ECSIntegration() {
     param_count = 0;
     performance_sample_count = 0;
@@ -23,6 +16,9 @@ ECSIntegration::ECSIntegration() {
     ecs_connected = false;
     last_heartbeat = 0;
     message_sequence = 0;
+    tx_used = 0;
+    tx_remaining = 0;
+    tx_failed = false;
     generation = 0;
     current_fitness = 0.0;
     mutation_attempts = 0;
@@ -30,6 +26,10 @@ ECSIntegration::ECSIntegration() {
     
     // Initialize parameter array
     memset(parameters, 0, sizeof(parameters));
+    memset(param_values, 0, sizeof(param_values));
+    memset(param_hashes, 0, sizeof(param_hashes));
+    memset(hash_slots, -1, sizeof(hash_slots));
+    memset(param_records, -1, sizeof(param_records));
     
     // Initialize metrics
     for (int i = 0; i < 8; i++) {
@@ -48,15 +48,15 @@ ECSIntegration::ECSIntegration() {
 }
 
 ECSIntegration::~ECSIntegration() {
-    saveParametersToEEPROM();
+    saveParameters();
 }
 
 bool ECSIntegration::initialize(const uint8_t coordinator_mac[6]) {
     Serial.println("🧬 Initializing ECS Integration v2.0");
     
-    // Initialize EEPROM
-    if (!EEPROM.begin(ECS_EEPROM_SIZE)) {
-        Serial.println("❌ Failed to initialize EEPROM");
+    // Validates the store manifest only; records are read per parameter
+    if (!store.begin(ECS_STORE_NAMESPACE, ECS_STORE_SCHEMA_VERSION)) {
+        Serial.println("❌ Failed to open ECS parameter store");
         return false;
     }
     
@@ -68,8 +68,10 @@ bool ECSIntegration::initialize(const uint8_t coordinator_mac[6]) {
                      coordinator_mac[3], coordinator_mac[4], coordinator_mac[5]);
     }
     
-    // Load parameters from EEPROM
-    loadParametersFromEEPROM();
+    // Parameters registered before initialize() load now, later ones on registration
+    for (uint8_t i = 0; i < param_count; i++) {
+        loadParameter(i);
+    }
     
     // Initialize ESP-NOW if WiFi is available
     if (WiFi.getMode() != WIFI_MODE_NULL) {
@@ -94,12 +96,11 @@ bool ECSIntegration::registerParameter(const char* name, int32_t initial_value,
         return false;
     }
     
-    // Check for duplicate names
-    for (uint8_t i = 0; i < param_count; i++) {
-        if (strcmp(parameters[i].name, name) == 0) {
-            reportError(ERROR_WARNING, 9002, "Duplicate parameter", __FUNCTION__);
-            return false;
-        }
+    // Duplicate names (or, vanishingly rarely, hashes) would make handles ambiguous
+    uint32_t hash = ecsParamHash(name);
+    if (findHandle(hash, nullptr) != ECS_INVALID_HANDLE) {
+        reportError(ERROR_WARNING, 9002, "Duplicate parameter", __FUNCTION__);
+        return false;
     }
     
     // Create new parameter
@@ -115,19 +116,63 @@ bool ECSIntegration::registerParameter(const char* name, int32_t initial_value,
     param.fitness_impact = 0.0;
     param.last_updated = millis();
     
+    param_values[param_count] = initial_value;
+    param_hashes[param_count] = hash;
+    
+    uint32_t slot = hash & (ECS_HASH_SLOTS - 1);
+    while (hash_slots[slot] >= 0) {
+        slot = (slot + 1) & (ECS_HASH_SLOTS - 1);
+    }
+    hash_slots[slot] = (int8_t)param_count;
+    
+    char key[STORE_KEY_LENGTH];
+    snprintf(key, sizeof(key), "p%08lx", (unsigned long)hash);
+    param_records[param_count] = store.addRecord(key, &param, sizeof(EvolvableParameter),
+                                                 ECS_PARAM_LAYOUT_VERSION);
+    
     param_count++;
     
     Serial.printf("📝 Registered parameter: %s = %d [%d..%d]\n", 
                   name, initial_value, min_val, max_val);
     
+    if (store.isOpen()) {
+        loadParameter(param_count - 1);
+    }
+    
     return true;
 }
 
-int32_t ECSIntegration::getParameter(const char* name) {
-    for (uint8_t i = 0; i < param_count; i++) {
-        if (strcmp(parameters[i].name, name) == 0) {
-            return parameters[i].value;
+ECSParamHandle ECSIntegration::findHandle(uint32_t hash, const char* name) const {
+    uint32_t slot = hash & (ECS_HASH_SLOTS - 1);
+    
+    for (int probes = 0; probes < ECS_HASH_SLOTS; probes++) {
+        int8_t index = hash_slots[slot];
+        if (index < 0) break;
+        
+        if (param_hashes[index] == hash &&
+            (name == nullptr || strncmp(parameters[index].name, name, sizeof(parameters[index].name) - 1) == 0)) {
+            return index;
         }
+        slot = (slot + 1) & (ECS_HASH_SLOTS - 1);
+    }
+    
+    return ECS_INVALID_HANDLE;
+}
+
+int32_t ECSIntegration::getParameter(const char* name) {
+    ECSParamHandle handle = getHandle(name);
+    if (handle != ECS_INVALID_HANDLE) {
+        return param_values[handle];
+    }
+    
+    reportError(ERROR_WARNING, 9003, "Parameter not found", __FUNCTION__);
+    return 0;
+}
+
+int32_t ECSIntegration::getParameterByHash(uint32_t hash) {
+    ECSParamHandle handle = getHandleByHash(hash);
+    if (handle != ECS_INVALID_HANDLE) {
+        return param_values[handle];
     }
     
     reportError(ERROR_WARNING, 9003, "Parameter not found", __FUNCTION__);
@@ -135,37 +180,46 @@ int32_t ECSIntegration::getParameter(const char* name) {
 }
 
 bool ECSIntegration::setParameter(const char* name, int32_t value) {
-    for (uint8_t i = 0; i < param_count; i++) {
-        if (strcmp(parameters[i].name, name) == 0) {
-            EvolvableParameter& param = parameters[i];
-            
-            // Validate bounds
-            if (value < param.min_value || value > param.max_value) {
-                reportError(ERROR_WARNING, 9004, "Parameter out of bounds", __FUNCTION__);
-                return false;
-            }
-            
-            param.value = value;
-            param.mutation_count++;
-            param.last_updated = millis();
-            
-            Serial.printf("🔧 Parameter updated: %s = %d\n", name, value);
-            return true;
-        }
+    ECSParamHandle handle = getHandle(name);
+    if (handle == ECS_INVALID_HANDLE) {
+        reportError(ERROR_WARNING, 9005, "Cannot set unknown parameter", __FUNCTION__);
+        return false;
+    }
+    return setParameterAt(handle, value);
+}
+
+bool ECSIntegration::setParameterAt(ECSParamHandle handle, int32_t value) {
+    if ((uint8_t)handle >= param_count) {
+        reportError(ERROR_WARNING, 9005, "Cannot set unknown parameter", __FUNCTION__);
+        return false;
+    }
+    
+    EvolvableParameter& param = parameters[handle];
+    
+    // Validate bounds
+    if (value < param.min_value || value > param.max_value) {
+        reportError(ERROR_WARNING, 9004, "Parameter out of bounds", __FUNCTION__);
+        return false;
     }
     
-    reportError(ERROR_WARNING, 9005, "Cannot set unknown parameter", __FUNCTION__);
-    return false;
+    param.value = value;
+    param.mutation_count++;
+    param.last_updated = millis();
+    param_values[handle] = value;
+    
+    Serial.printf("🔧 Parameter updated: %s = %d\n", param.name, value);
+    return true;
 }
 
 void ECSIntegration::resetParametersToDefault() {
     for (uint8_t i = 0; i < param_count; i++) {
         parameters[i].value = parameters[i].default_value;
         parameters[i].last_updated = millis();
+        param_values[i] = parameters[i].value;
     }
     
     Serial.println("🔄 Parameters reset to default values");
-    saveParametersToEEPROM();
+    saveParameters();
 }
 
 void ECSIntegration::reportMetric(MetricType type, float value) {
@@ -283,6 +337,7 @@ void ECSIntegration::requestEvolution(const char* trigger_reason) {
         return;
     }
     
+#ifdef ECS_JSON_DEBUG
     DynamicJsonDocument doc(256);
     doc["type"] = "evolution_request";
     doc["generation"] = generation;
@@ -294,10 +349,20 @@ void ECSIntegration::requestEvolution(const char* trigger_reason) {
         doc["trigger"] = trigger_reason;
     }
     
-    char buffer[256];
-    serializeJson(doc, buffer, sizeof(buffer));
+    sendJSON(ECS_FITNESS_REQUEST, doc);
+#else
+    ECSEvolutionRequestBody body;
+    memset(&body, 0, sizeof(body));
+    body.generation = generation;
+    body.fitness = current_fitness;
+    body.mutation_attempts = mutation_attempts;
+    body.error_count = getErrorCount(ERROR_WARNING);
+    if (trigger_reason) {
+        strncpy(body.trigger, trigger_reason, sizeof(body.trigger) - 1);
+    }
     
-    sendESPNowMessage(ECS_FITNESS_REQUEST, buffer);
+    sendMessage(ECS_FITNESS_REQUEST, &body, sizeof(body));
+#endif
     
     Serial.printf("🧬 Evolution requested: %s\n", 
                   trigger_reason ? trigger_reason : "Manual trigger");
@@ -315,16 +380,22 @@ void ECSIntegration::reportEvolutionResult(bool success, float fitness_delta) {
         successful_mutations++;
     }
     
+#ifdef ECS_JSON_DEBUG
     DynamicJsonDocument doc(128);
     doc["type"] = "evolution_result";
     doc["success"] = success;
     doc["fitness_delta"] = fitness_delta;
     doc["generation"] = generation;
     
-    char buffer[128];
-    serializeJson(doc, buffer, sizeof(buffer));
+    sendJSON(ECS_EVOLUTION_RESULT, doc);
+#else
+    ECSEvolutionResultBody body;
+    body.success = success ? 1 : 0;
+    body.fitness_delta = fitness_delta;
+    body.generation = generation;
     
-    sendESPNowMessage(ECS_PERFORMANCE_REPORT, buffer);
+    sendMessage(ECS_EVOLUTION_RESULT, &body, sizeof(body));
+#endif
     
     if (success) {
         generation++;
@@ -338,7 +409,8 @@ void ECSIntegration::reportEvolutionResult(bool success, float fitness_delta) {
 void ECSIntegration::sendPerformanceReport() {
     if (!ecs_connected) return;
     
-    DynamicJsonDocument doc(512);
+#ifdef ECS_JSON_DEBUG
+    DynamicJsonDocument doc(1536);
     doc["type"] = "performance_report";
     doc["bot_id"] = WiFi.macAddress();
     doc["generation"] = generation;
@@ -361,23 +433,52 @@ void ECSIntegration::sendPerformanceReport() {
         param["mutations"] = parameters[i].mutation_count;
     }
     
-    char buffer[512];
-    serializeJson(doc, buffer, sizeof(buffer));
+    sendJSON(ECS_PERFORMANCE_REPORT, doc);
+#else
+    ECSPerformanceBody head;
+    WiFi.macAddress(head.bot_mac);
+    head.generation = generation;
+    head.fitness = current_fitness;
+    head.sample_count = performance_sample_count;
+    head.metric_count = 8;
+    head.param_count = param_count;
     
-    sendESPNowMessage(ECS_PERFORMANCE_REPORT, buffer);
+    // 16 parameters need two frames; records stream straight into them
+    beginMessage(ECS_PERFORMANCE_REPORT, sizeof(head) +
+                 head.metric_count * sizeof(ECSMetricRecord) +
+                 head.param_count * sizeof(ECSParamRecord));
+    writeBody(&head, sizeof(head));
+    
+    for (int i = 0; i < 8; i++) {
+        ECSMetricRecord record;
+        record.type = (uint8_t)i;
+        record.value = metrics[i].running_average;
+        record.samples = metrics[i].sample_count;
+        writeBody(&record, sizeof(record));
+    }
+    
+    for (uint8_t i = 0; i < param_count; i++) {
+        ECSParamRecord record;
+        memcpy(record.name, parameters[i].name, sizeof(record.name));
+        record.value = parameters[i].value;
+        record.mutations = parameters[i].mutation_count;
+        writeBody(&record, sizeof(record));
+    }
+#endif
 }
 
 void ECSIntegration::sendErrorReport() {
     if (!ecs_connected) return;
     
-    DynamicJsonDocument doc(256);
+    uint8_t log_size = (error_count < ECS_ERROR_LOG_SIZE) ? error_count : ECS_ERROR_LOG_SIZE;
+    
+#ifdef ECS_JSON_DEBUG
+    DynamicJsonDocument doc(4096);
     doc["type"] = "error_report";
     doc["bot_id"] = WiFi.macAddress();
-    doc["error_count"] = (error_count < ECS_ERROR_LOG_SIZE) ? error_count : ECS_ERROR_LOG_SIZE;
+    doc["error_count"] = log_size;
     
     JsonArray errors_array = doc.createNestedArray("errors");
-    uint8_t log_size = (error_count < ECS_ERROR_LOG_SIZE) ? error_count : ECS_ERROR_LOG_SIZE;
-    
     for (uint8_t i = 0; i < log_size; i++) {
         const ErrorLogEntry& entry = error_log[i];
         JsonObject error = errors_array.createNestedObject();
@@ -388,16 +489,33 @@ void ECSIntegration::sendErrorReport() {
         error["timestamp"] = entry.timestamp;
     }
     
-    char buffer[256];
-    serializeJson(doc, buffer, sizeof(buffer));
+    sendJSON(ECS_ERROR_REPORT, doc);
+#else
+    ECSErrorReportBody head;
+    WiFi.macAddress(head.bot_mac);
+    head.error_count = log_size;
     
-    sendESPNowMessage(ECS_ERROR_REPORT, buffer);
+    beginMessage(ECS_ERROR_REPORT, sizeof(head) + log_size * sizeof(ECSErrorRecord));
+    writeBody(&head, sizeof(head));
+    
+    for (uint8_t i = 0; i < log_size; i++) {
+        const ErrorLogEntry& entry = error_log[i];
+        ECSErrorRecord record;
+        record.severity = (uint8_t)entry.severity;
+        record.code = entry.error_code;
+        record.timestamp = entry.timestamp;
+        memcpy(record.description, entry.description, sizeof(record.description));
+        memcpy(record.function_name, entry.function_name, sizeof(record.function_name));
+        writeBody(&record, sizeof(record));
+    }
+#endif
 }
 
 void ECSIntegration::sendHeartbeat() {
     if (!ecs_connected) return;
     
-    DynamicJsonDocument doc(128);
+#ifdef ECS_JSON_DEBUG
+    DynamicJsonDocument doc(192);
     doc["type"] = "heartbeat";
     doc["bot_id"] = WiFi.macAddress();
     doc["uptime"] = millis();
@@ -405,19 +523,98 @@ void ECSIntegration::sendHeartbeat() {
     doc["fitness"] = current_fitness;
     doc["free_heap"] = ESP.getFreeHeap();
     
-    char buffer[128];
-    serializeJson(doc, buffer, sizeof(buffer));
+    sendJSON(ECS_HEARTBEAT, doc);
+#else
+    ECSHeartbeatBody body;
+    WiFi.macAddress(body.bot_mac);
+    body.uptime_ms = millis();
+    body.generation = generation;
+    body.fitness = current_fitness;
+    body.free_heap = ESP.getFreeHeap();
     
-    sendESPNowMessage(ECS_STATUS_QUERY, buffer);
+    sendMessage(ECS_HEARTBEAT, &body, sizeof(body));
+#endif
     
     last_heartbeat = millis();
 }
 
 void ECSIntegration::handleESPNowMessage(const uint8_t* mac, const uint8_t* data, int len) {
-    if (len > ECS_MESSAGE_BUFFER_SIZE) return;
+    if (data == nullptr || len <= 0 || len > ESP_NOW_MAX_DATA_LEN) return;
+    
+#ifdef ECS_JSON_DEBUG
+    // Bare JSON from bridges that predate the framed format
+    if (data[0] == '{') {
+        handleJSONMessage(data, len);
+        return;
+    }
+#endif
     
+    ECSFrameHeader header;
+    if (len < (int)sizeof(header)) {
+        reportError(ERROR_WARNING, 8002, "Malformed ECS frame", __FUNCTION__);
+        return;
+    }
+    memcpy(&header, data, sizeof(header));
+    
+    if (header.magic != ECS_WIRE_MAGIC || header.payload_size != len - sizeof(header)) {
+        reportError(ERROR_WARNING, 8002, "Malformed ECS frame", __FUNCTION__);
+        return;
+    }
+    
+    // Coordinator commands always fit one frame
+    if (header.fragment_count != 1) {
+        reportError(ERROR_WARNING, 8003, "Fragmented ECS command", __FUNCTION__);
+        return;
+    }
+    
+    const uint8_t* body = data + sizeof(header);
+    if (header.flags & ECS_FLAG_JSON) {
+#ifdef ECS_JSON_DEBUG
+        handleJSONMessage(body, header.payload_size);
+#endif
+        return;
+    }
+    
+    handleBinaryMessage(header.type, body, header.payload_size);
+}
+
+void ECSIntegration::handleBinaryMessage(uint8_t type, const uint8_t* body, size_t length) {
+    switch (type) {
+        case ECS_PARAM_UPDATE:
+        case ECS_MUTATION_APPLY: {
+            ECSParamUpdateBody update;
+            if (length < sizeof(update)) break;
+            memcpy(&update, body, sizeof(update));
+            update.name[sizeof(update.name) - 1] = '\0';
+            applyMutation(update.name, update.value);
+            return;
+        }
+        case ECS_FITNESS_REQUEST: {
+            ECSEvolutionTriggerBody trigger;
+            memset(&trigger, 0, sizeof(trigger));
+            memcpy(&trigger, body, min(length, sizeof(trigger)));
+            trigger.reason[sizeof(trigger.reason) - 1] = '\0';
+            requestEvolution(trigger.reason[0] ? trigger.reason : nullptr);
+            return;
+        }
+        case ECS_RESET_PARAMS:
+            resetParametersToDefault();
+            return;
+        case ECS_STATUS_QUERY:
+            sendPerformanceReport();
+            sendErrorReport();
+            return;
+        default:
+            return; // Not a coordinator command
+    }
+    
+    reportError(ERROR_WARNING, 8004, "Short ECS message", __FUNCTION__);
+}
+
+#ifdef ECS_JSON_DEBUG
+void ECSIntegration::handleJSONMessage(const uint8_t* data, size_t length) {
     DynamicJsonDocument doc(256);
-    DeserializationError error = deserializeJson(doc, (const char*)data, len);
+    DeserializationError error = deserializeJson(doc, (const char*)data, length);
     
     if (error) {
         reportError(ERROR_WARNING, 8001, "JSON parse error", __FUNCTION__);
@@ -447,6 +644,7 @@ void ECSIntegration::handleESPNowMessage(const uint8_t* mac, const uint8_t* data
         sendErrorReport();
     }
 }
+#endif
 
 void ECSIntegration::printSystemStatus() {
     Serial.println("🧬 ECS System Status:");
@@ -462,20 +660,16 @@ void ECSIntegration::printSystemStatus() {
 }
 
 void ECSIntegration::getStatusJSON(char* buffer, size_t buffer_size) {
-    DynamicJsonDocument doc(256);
-    doc["generation"] = generation;
-    doc["fitness"] = current_fitness;
-    doc["mutations"] = mutation_attempts;
-    doc["successful_mutations"] = successful_mutations;
-    doc["success_rate"] = getSuccessRate();
-    doc["parameter_count"] = param_count;
-    doc["error_count"] = getErrorCount();
-    doc["performance_samples"] = performance_sample_count;
-    doc["connected"] = ecs_connected;
-    doc["free_heap"] = ESP.getFreeHeap();
-    doc["uptime"] = millis();
-    
-    serializeJson(doc, buffer, buffer_size);
+    // Formatted by hand so status dumps never touch the heap
+    snprintf(buffer, buffer_size,
+             "{\"generation\":%lu,\"fitness\":%.4f,\"mutations\":%lu,"
+             "\"successful_mutations\":%lu,\"success_rate\":%.4f,\"parameter_count\":%u,"
+             "\"error_count\":%u,\"performance_samples\":%u,\"connected\":%s,"
+             "\"free_heap\":%lu,\"uptime\":%lu}",
+             (unsigned long)generation, current_fitness, (unsigned long)mutation_attempts,
+             (unsigned long)successful_mutations, getSuccessRate(), param_count,
+             getErrorCount(), performance_sample_count, ecs_connected ? "true" : "false",
+             (unsigned long)ESP.getFreeHeap(), (unsigned long)millis());
 }
 
 float ECSIntegration::getSuccessRate() const {
@@ -496,7 +690,7 @@ void ECSIntegration::update() {
     
     // Auto-save parameters (every 5 minutes)
     if (now - last_auto_save > 300000) {
-        saveParametersToEEPROM();
+        saveParameters();
         last_auto_save = now;
     }
     
@@ -507,62 +701,38 @@ void ECSIntegration::update() {
     pruneErrorLog();
 }
 
-void ECSIntegration::loadParametersFromEEPROM() {
-    uint16_t magic = EEPROM.readUShort(ECS_EEPROM_MAGIC_ADDR);
+void ECSIntegration::loadParameter(uint8_t index) {
+    EvolvableParameter saved_param;
+    if (!store.load(param_records[index], &saved_param)) return;
     
-    if (magic != ECS_EEPROM_MAGIC) {
-        Serial.println("🔧 No valid ECS data in EEPROM, using defaults");
-        return;
-    }
-    
-    uint8_t version = EEPROM.readUChar(ECS_EEPROM_VERSION_ADDR);
-    uint8_t saved_param_count = EEPROM.readUChar(ECS_EEPROM_PARAM_COUNT_ADDR);
-    
-    Serial.printf("📖 Loading ECS data: version %d, %d parameters\n", version, saved_param_count);
-    
-    int addr = ECS_EEPROM_PARAMS_START;
+    // Only the evolved state is restored; bounds come from registration
+    EvolvableParameter& param = parameters[index];
+    if (strncmp(saved_param.name, param.name, sizeof(param.name)) != 0) return;
     
-    for (uint8_t i = 0; i < saved_param_count && i < param_count && addr < ECS_EEPROM_SIZE - sizeof(EvolvableParameter); i++) {
-        EvolvableParameter saved_param;
-        EEPROM.readBytes(addr, (uint8_t*)&saved_param, sizeof(EvolvableParameter));
-        addr += sizeof(EvolvableParameter);
+    if (saved_param.value >= param.min_value && saved_param.value <= param.max_value) {
+        param.value = saved_param.value;
+        param_values[index] = saved_param.value;
+        param.mutation_count = saved_param.mutation_count;
+        param.fitness_impact = saved_param.fitness_impact;
         
-        // Find matching parameter by name
-        for (uint8_t j = 0; j < param_count; j++) {
-            if (strcmp(parameters[j].name, saved_param.name) == 0) {
-                // Validate bounds
-                if (saved_param.value >= parameters[j].min_value && 
-                    saved_param.value <= parameters[j].max_value) {
-                    parameters[j].value = saved_param.value;
-                    parameters[j].mutation_count = saved_param.mutation_count;
-                    parameters[j].fitness_impact = saved_param.fitness_impact;
-                    
-                    Serial.printf("✅ Loaded parameter: %s = %d\n", 
-                                  saved_param.name, saved_param.value);
-                } else {
-                    Serial.printf("⚠️  Parameter %s out of bounds, using default\n", 
-                                  saved_param.name);
-                }
-                break;
-            }
-        }
+        Serial.printf("✅ Loaded parameter: %s = %d\n", saved_param.name, saved_param.value);
+    } else {
+        Serial.printf("⚠️  Parameter %s out of bounds, using default\n", saved_param.name);
     }
 }
 
-void ECSIntegration::saveParametersToEEPROM() {
-    EEPROM.writeUShort(ECS_EEPROM_MAGIC_ADDR, ECS_EEPROM_MAGIC);
-    EEPROM.writeUChar(ECS_EEPROM_VERSION_ADDR, 2);  // Version 2.0
-    EEPROM.writeUChar(ECS_EEPROM_PARAM_COUNT_ADDR, param_count);
-    
-    int addr = ECS_EEPROM_PARAMS_START;
+void ECSIntegration::saveParameters() {
+    if (!store.isOpen()) return;
     
-    for (uint8_t i = 0; i < param_count && addr < ECS_EEPROM_SIZE - sizeof(EvolvableParameter); i++) {
-        EEPROM.writeBytes(addr, (const uint8_t*)&parameters[i], sizeof(EvolvableParameter));
-        addr += sizeof(EvolvableParameter);
+    for (uint8_t i = 0; i < param_count; i++) {
+        store.stage(param_records[i]);
     }
     
-    EEPROM.commit();
-    Serial.printf("💾 Saved %d parameters to EEPROM\n", param_count);
+    size_t changed = store.getDirtyCount();
+    if (changed == 0) return;
+    
+    store.flushAll();
+    Serial.printf("💾 Saved %d of %d parameters\n", (int)changed, param_count);
 }
 
 void ECSIntegration::updateRunningAverages() {
@@ -583,39 +753,100 @@ void ECSIntegration::pruneErrorLog() {
 }
 
 bool ECSIntegration::validateParameter(const char* name, int32_t value) {
-    for (uint8_t i = 0; i < param_count; i++) {
-        if (strcmp(parameters[i].name, name) == 0) {
-            return (value >= parameters[i].min_value && value <= parameters[i].max_value);
+    ECSParamHandle handle = getHandle(name);
+    if (handle == ECS_INVALID_HANDLE) return false;
+    return (value >= parameters[handle].min_value && value <= parameters[handle].max_value);
+}
+
+// ═══════════════════════════════════════════════════════════
+// 📡 FRAMING & FRAGMENTATION
+// ═══════════════════════════════════════════════════════════
+
+void ECSIntegration::beginMessage(ECSMessageType type, size_t body_size, uint8_t flags) {
+    size_t fragments = (body_size + ECS_MAX_FRAGMENT_PAYLOAD - 1) / ECS_MAX_FRAGMENT_PAYLOAD;
+    if (fragments == 0) fragments = 1;
+    if (fragments > 255) {
+        reportError(ERROR_WARNING, 7002, "ECS message too large", __FUNCTION__);
+        fragments = 255;
+        body_size = fragments * ECS_MAX_FRAGMENT_PAYLOAD;
+    }
+    
+    ECSFrameHeader header;
+    header.magic = ECS_WIRE_MAGIC;
+    header.type = (uint8_t)type;
+    header.sequence = message_sequence++;
+    header.fragment = 0;
+    header.fragment_count = (uint8_t)fragments;
+    header.payload_size = 0;
+    header.flags = flags;
+    memcpy(tx_frame, &header, sizeof(header));
+    
+    tx_used = sizeof(header);
+    tx_remaining = body_size;
+    tx_failed = false;
+    
+    if (body_size == 0) flushFrame();
+}
+
+void ECSIntegration::writeBody(const void* data, size_t length) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    length = min(length, tx_remaining);
+    
+    while (length > 0) {
+        size_t chunk = min(length, sizeof(tx_frame) - tx_used);
+        memcpy(tx_frame + tx_used, bytes, chunk);
+        tx_used += chunk;
+        tx_remaining -= chunk;
+        bytes += chunk;
+        length -= chunk;
+        
+        if (tx_used == sizeof(tx_frame) || tx_remaining == 0) {
+            flushFrame();
         }
     }
-    return false;
 }
 
-void ECSIntegration::sendESPNowMessage(ECSMessageType type, const char* payload) {
-    if (!ecs_connected) return;
-    
-    // Create message with header
-    struct {
-        uint16_t sequence;
-        uint8_t type;
-        uint8_t payload_size;
-        char payload[ECS_MESSAGE_BUFFER_SIZE - 4];
-    } message;
-    
-    message.sequence = message_sequence++;
-    message.type = (uint8_t)type;
+void ECSIntegration::flushFrame() {
+    ECSFrameHeader* header = (ECSFrameHeader*)tx_frame;
+    header->payload_size = (uint8_t)(tx_used - sizeof(ECSFrameHeader));
     
-    size_t payload_len = strlen(payload);
-    message.payload_size = min(payload_len, sizeof(message.payload) - 1);
-    
-    strncpy(message.payload, payload, message.payload_size);
-    message.payload[message.payload_size] = '\0';
+    if (ecs_connected && !tx_failed) {
+        esp_err_t result = esp_now_send(ecs_coordinator_mac, tx_frame, tx_used);
+        if (result != ESP_OK) {
+            // Later fragments are useless without this one
+            tx_failed = true;
+            reportError(ERROR_WARNING, 7001, "ESP-NOW send failed", __FUNCTION__);
+        }
+    }
     
-    size_t total_size = 4 + message.payload_size;
+    header->fragment++;
+    tx_used = sizeof(ECSFrameHeader);
+}
+
+void ECSIntegration::sendMessage(ECSMessageType type, const void* body, size_t body_size) {
+    beginMessage(type, body_size);
+    writeBody(body, body_size);
+}
+
+#ifdef ECS_JSON_DEBUG
+// Lets ArduinoJson serialize straight into outgoing fragments
+struct ECSIntegration::JSONFrameWriter {
+    ECSIntegration& owner;
     
-    esp_err_t result = esp_now_send(ecs_coordinator_mac, (uint8_t*)&message, total_size);
+    size_t write(uint8_t c) {
+        owner.writeBody(&c, 1);
+        return 1;
+    }
     
-    if (result != ESP_OK) {
-        reportError(ERROR_WARNING, 7001, "ESP-NOW send failed", __FUNCTION__);
+    size_t write(const uint8_t* data, size_t length) {
+        owner.writeBody(data, length);
+        return length;
     }
-}
\ No newline at end of file
+};
+
+void ECSIntegration::sendJSON(ECSMessageType type, const JsonDocument& doc) {
+    beginMessage(type, measureJson(doc), ECS_FLAG_JSON);
+    JSONFrameWriter writer{*this};
+    serializeJson(doc, writer);
+}
+#endif
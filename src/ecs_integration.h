@@ -10,7 +10,8 @@ Key Features:
 - Real-time parameter evolution via ESP-NOW
 - Performance metric collection and reporting
 - Automatic error detection and reporting
-- Memory-efficient parameter storage in EEPROM
+- Per-parameter CRC-checked NVS records (swarm_persistent_store.h)
+- Compact binary wire format with fragmentation (JSON via ECS_JSON_DEBUG)
 - Seamless integration with existing bot code
 */
 
@@ -18,18 +19,23 @@ Key Features:
 #define ECS_INTEGRATION_H
 
 #include <Arduino.h>
-#include <EEPROM.h>
 #include <esp_now.h>
 #include <WiFi.h>
+#ifdef ECS_JSON_DEBUG
 #include <ArduinoJson.h>
+#endif
+#include "swarm_persistent_store.h"
 
 // ECS Configuration Constants
 #define ECS_VERSION "2.0"
-#define ECS_EEPROM_SIZE 512
+#define ECS_STORE_NAMESPACE "ecs"
+#define ECS_STORE_SCHEMA_VERSION 1
+#define ECS_PARAM_LAYOUT_VERSION 1  // Bump when EvolvableParameter changes
 #define ECS_PARAM_COUNT 16
 #define ECS_ERROR_LOG_SIZE 32
 #define ECS_PERFORMANCE_BUFFER_SIZE 64
 #define ECS_MESSAGE_BUFFER_SIZE 256
+#define ECS_HASH_SLOTS 32           // Power of two, >= 2 * ECS_PARAM_COUNT
 
 // Message Types for ECS Communication
 enum ECSMessageType {
@@ -40,7 +46,9 @@ enum ECSMessageType {
     ECS_MUTATION_APPLY = 0x14,      // Apply specific mutation
     ECS_STATUS_QUERY = 0x15,        // System status check
     ECS_RESET_PARAMS = 0x16,        // Reset to baseline parameters
-    ECS_BACKUP_GENOME = 0x17        // Backup current genome
+    ECS_BACKUP_GENOME = 0x17,       // Backup current genome
+    ECS_EVOLUTION_RESULT = 0x18,    // Evolution success/failure feedback
+    ECS_HEARTBEAT = 0x19            // Periodic liveness + fitness
 };
 
 // Error Severity Levels
@@ -63,6 +71,128 @@ enum MetricType {
     METRIC_MOVEMENT_EFFICIENCY = 7
 };
 
+// ═══════════════════════════════════════════════════════════
+// 📡 ECS WIRE FORMAT
+// ═══════════════════════════════════════════════════════════
+// Every ESP-NOW frame is an ECSFrameHeader followed by up to
+// ECS_MAX_FRAGMENT_PAYLOAD bytes. A message whose body is larger is split
+// into fragmentCount frames sharing one sequence number; the receiver
+// concatenates them in fragment order. Bodies are the packed little-endian
+// structs below (decoded by src/ecs_wire_protocol.py). With
+// ECS_JSON_DEBUG the body is the old JSON text and ECS_FLAG_JSON is set.
+
+#define ECS_WIRE_MAGIC 0xEC
+#define ECS_FLAG_JSON 0x01
+#define ECS_NAME_LENGTH 16
+#define ECS_DESCRIPTION_LENGTH 32
+
+struct ECSFrameHeader {
+    uint8_t magic;           // ECS_WIRE_MAGIC
+    uint8_t type;            // ECSMessageType
+    uint16_t sequence;       // Same for every fragment of one message
+    uint8_t fragment;        // 0 .. fragmentCount-1
+    uint8_t fragment_count;
+    uint8_t payload_size;    // Body bytes in this frame
+    uint8_t flags;           // ECS_FLAG_*
+} __attribute__((packed));
+
+#define ECS_MAX_FRAGMENT_PAYLOAD (ESP_NOW_MAX_DATA_LEN - sizeof(ECSFrameHeader))
+
+// Bot → coordinator
+struct ECSHeartbeatBody {
+    uint8_t bot_mac[6];
+    uint32_t uptime_ms;
+    uint32_t generation;
+    float fitness;
+    uint32_t free_heap;
+} __attribute__((packed));
+
+struct ECSPerformanceBody {        // Followed by metric_count + param_count records
+    uint8_t bot_mac[6];
+    uint32_t generation;
+    float fitness;
+    uint16_t sample_count;
+    uint8_t metric_count;
+    uint8_t param_count;
+} __attribute__((packed));
+
+struct ECSMetricRecord {
+    uint8_t type;            // MetricType
+    float value;             // Running average
+    uint16_t samples;
+} __attribute__((packed));
+
+struct ECSParamRecord {
+    char name[ECS_NAME_LENGTH];
+    int32_t value;
+    uint16_t mutations;
+} __attribute__((packed));
+
+struct ECSErrorReportBody {        // Followed by error_count records
+    uint8_t bot_mac[6];
+    uint8_t error_count;
+} __attribute__((packed));
+
+struct ECSErrorRecord {
+    uint8_t severity;        // ErrorSeverity
+    uint16_t code;
+    uint32_t timestamp;
+    char description[ECS_DESCRIPTION_LENGTH];
+    char function_name[ECS_NAME_LENGTH];
+} __attribute__((packed));
+
+struct ECSEvolutionRequestBody {
+    uint32_t generation;
+    float fitness;
+    uint32_t mutation_attempts;
+    uint8_t error_count;
+    char trigger[ECS_DESCRIPTION_LENGTH];
+} __attribute__((packed));
+
+struct ECSEvolutionResultBody {
+    uint8_t success;
+    float fitness_delta;
+    uint32_t generation;
+} __attribute__((packed));
+
+// Coordinator → bot (ECS_PARAM_UPDATE / ECS_MUTATION_APPLY)
+struct ECSParamUpdateBody {
+    char name[ECS_NAME_LENGTH];
+    int32_t value;
+} __attribute__((packed));
+
+// Coordinator → bot (ECS_FITNESS_REQUEST: trigger an evolution request)
+struct ECSEvolutionTriggerBody {
+    char reason[ECS_DESCRIPTION_LENGTH];
+} __attribute__((packed));
+
+// ═══════════════════════════════════════════════════════════
+// 🔑 PARAMETER HANDLES
+// ═══════════════════════════════════════════════════════════
+// Parameters are found by the 32-bit FNV-1a hash of their name. For a
+// string literal the hash is computed by the compiler, so
+// ECS_GET_PARAM("motorSpeed") is one hash-table probe, not a strcmp
+// scan. Control loops can go one step further and keep the
+// ECSParamHandle (an index into a dense value array).
+
+typedef int8_t ECSParamHandle;
+#define ECS_INVALID_HANDLE ((ECSParamHandle)-1)
+
+constexpr uint32_t ecsHashStep(const char* text, uint32_t hash) {
+    return *text ? ecsHashStep(text + 1, (hash ^ (uint8_t)*text) * 16777619u) : hash;
+}
+
+constexpr uint32_t ecsParamHash(const char* name) {
+    return ecsHashStep(name, 2166136261u);
+}
+
+// Forces compile-time evaluation (name must be a string literal)
+template <uint32_t Hash>
+struct ECSParamHashConstant {
+    static constexpr uint32_t value = Hash;
+};
+#define ECS_PARAM_HASH(name) (ECSParamHashConstant<ecsParamHash(name)>::value)
+
 // Evolvable Parameter Structure
 struct EvolvableParameter {
     char name[16];          // Parameter name
@@ -100,6 +230,15 @@ private:
     EvolvableParameter parameters[ECS_PARAM_COUNT];
     uint8_t param_count;
     
+    // Hot-path mirror: param_values[handle] == parameters[handle].value
+    int32_t param_values[ECS_PARAM_COUNT];
+    uint32_t param_hashes[ECS_PARAM_COUNT];
+    int8_t hash_slots[ECS_HASH_SLOTS];   // Open addressing, -1 = empty
+    
+    // Persistence: one store record per parameter, keyed by name hash
+    SwarmPersistentStore store;
+    int param_records[ECS_PARAM_COUNT];
+    
     // Performance tracking
     PerformanceMetric metrics[8];  // One for each MetricType
     uint16_t performance_sample_count;
@@ -115,6 +254,12 @@ private:
     uint32_t last_heartbeat;
     uint16_t message_sequence;
     
+    // Outgoing frame being filled (messages stream through it fragment by fragment)
+    uint8_t tx_frame[ESP_NOW_MAX_DATA_LEN];
+    size_t tx_used;
+    size_t tx_remaining;     // Body bytes still to come for the current message
+    bool tx_failed;
+    
     // Evolution tracking
     uint32_t generation;
     float current_fitness;
@@ -122,12 +267,26 @@ private:
     uint32_t successful_mutations;
     
     // Internal methods
-    void loadParametersFromEEPROM();
-    void saveParametersToEEPROM();
+    void loadParameter(uint8_t index);
+    void saveParameters();
     void updateRunningAverages();
     void pruneErrorLog();
     bool validateParameter(const char* name, int32_t value);
-    void sendESPNowMessage(ECSMessageType type, const char* payload);
+    ECSParamHandle findHandle(uint32_t hash, const char* name) const;
+    bool setParameterAt(ECSParamHandle handle, int32_t value);
+    
+    // Binary encoding: beginMessage() with the full body size, then
+    // writeBody() in pieces; frames are flushed as they fill
+    void beginMessage(ECSMessageType type, size_t body_size, uint8_t flags = 0);
+    void writeBody(const void* data, size_t length);
+    void flushFrame();
+    void sendMessage(ECSMessageType type, const void* body, size_t body_size);
+    void handleBinaryMessage(uint8_t type, const uint8_t* body, size_t length);
+#ifdef ECS_JSON_DEBUG
+    struct JSONFrameWriter;
+    void sendJSON(ECSMessageType type, const JsonDocument& doc);
+    void handleJSONMessage(const uint8_t* data, size_t length);
+#endif
     
 public:
     ECSIntegration();
@@ -142,6 +301,17 @@ public:
                           int32_t min_val, int32_t max_val);
     int32_t getParameter(const char* name);
     bool setParameter(const char* name, int32_t value);
+    
+    // O(1) access: resolve once, then index every tick
+    ECSParamHandle getHandle(const char* name) const { return findHandle(ecsParamHash(name), name); }
+    ECSParamHandle getHandleByHash(uint32_t hash) const { return findHandle(hash, nullptr); }
+    int32_t getParameter(ECSParamHandle handle) const {
+        return ((uint8_t)handle < param_count) ? param_values[handle] : 0;
+    }
+    int32_t getParameterByHash(uint32_t hash);
+    bool setParameter(ECSParamHandle handle, int32_t value) { return setParameterAt(handle, value); }
+    bool setParameterByHash(uint32_t hash, int32_t value) { return setParameterAt(getHandleByHash(hash), value); }
+    const int32_t* getParameterValues() const { return param_values; }
     void resetParametersToDefault();
     uint8_t getParameterCount() const { return param_count; }
     
@@ -188,8 +358,8 @@ public:
 extern ECSIntegration ecs;
 
 // Convenience macros for parameter access
-#define ECS_GET_PARAM(name) ecs.getParameter(name)
-#define ECS_SET_PARAM(name, value) ecs.setParameter(name, value)
+#define ECS_GET_PARAM(name) ecs.getParameterByHash(ECS_PARAM_HASH(name))
+#define ECS_SET_PARAM(name, value) ecs.setParameterByHash(ECS_PARAM_HASH(name), value)
 #define ECS_REPORT_METRIC(type, value) ecs.reportMetric(type, value)
 #define ECS_REPORT_ERROR(severity, code, desc) ecs.reportError(severity, code, desc, __FUNCTION__)
 
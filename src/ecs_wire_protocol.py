@@ -0,0 +1,264 @@
+#!/usr/bin/env python3
+"""
+🧬 Project Jumbo: ECS Binary Wire Protocol
+Decoder/encoder for the packed ESP-NOW frames sent by ECSIntegration
+
+Mirrors the structs in src/ecs_integration.h. Decoded messages are plain
+dicts with the same keys the old JSON reports used, so bridge and PC code
+handle binary and ECS_JSON_DEBUG traffic identically.
+
+Frame layout (little-endian):
+- ECSFrameHeader: magic, type, sequence, fragment, fragment_count,
+  payload_size, flags (8 bytes)
+- Body fragment: up to 242 bytes; fragments of one message share a
+  sequence number and are concatenated in order
+"""
+
+import json
+import struct
+import time
+from typing import Dict, Optional, Tuple
+
+ECS_WIRE_MAGIC = 0xEC
+ECS_FLAG_JSON = 0x01
+ESP_NOW_MAX_DATA_LEN = 250
+
+# ECSMessageType
+ECS_PARAM_UPDATE = 0x10
+ECS_PERFORMANCE_REPORT = 0x11
+ECS_ERROR_REPORT = 0x12
+ECS_FITNESS_REQUEST = 0x13
+ECS_MUTATION_APPLY = 0x14
+ECS_STATUS_QUERY = 0x15
+ECS_RESET_PARAMS = 0x16
+ECS_BACKUP_GENOME = 0x17
+ECS_EVOLUTION_RESULT = 0x18
+ECS_HEARTBEAT = 0x19
+
+FRAME_HEADER = struct.Struct('<BBHBBBB')
+MAX_FRAGMENT_PAYLOAD = ESP_NOW_MAX_DATA_LEN - FRAME_HEADER.size
+
+HEARTBEAT_BODY = struct.Struct('<6sIIfI')
+PERFORMANCE_BODY = struct.Struct('<6sIfHBB')
+METRIC_RECORD = struct.Struct('<BfH')
+PARAM_RECORD = struct.Struct('<16siH')
+ERROR_REPORT_BODY = struct.Struct('<6sB')
+ERROR_RECORD = struct.Struct('<BHI32s16s')
+EVOLUTION_REQUEST_BODY = struct.Struct('<IfIB32s')
+EVOLUTION_RESULT_BODY = struct.Struct('<BfI')
+PARAM_UPDATE_BODY = struct.Struct('<16si')
+EVOLUTION_TRIGGER_BODY = struct.Struct('<32s')
+
+def _mac_to_string(raw: bytes) -> str:
+    """Format a MAC the way WiFi.macAddress() does"""
+    return ':'.join(f'{b:02X}' for b in raw)
+
+def _c_string(raw: bytes) -> str:
+    return raw.split(b'\0', 1)[0].decode('utf-8', errors='replace')
+
+def _fixed_string(text: str, length: int) -> bytes:
+    # Always leave room for the terminator the firmware relies on
+    return text.encode('utf-8')[:length - 1]
+
+# ═══════════════════════════════════════════════════════════
+# 📥 DECODING
+# ═══════════════════════════════════════════════════════════
+
+def decode_heartbeat(body: bytes) -> Dict:
+    mac, uptime, generation, fitness, free_heap = HEARTBEAT_BODY.unpack_from(body)
+    return {
+        'type': 'heartbeat',
+        'bot_id': _mac_to_string(mac),
+        'uptime': uptime,
+        'generation': generation,
+        'fitness': fitness,
+        'free_heap': free_heap
+    }
+
+def decode_performance_report(body: bytes) -> Dict:
+    mac, generation, fitness, sample_count, metric_count, param_count = \
+        PERFORMANCE_BODY.unpack_from(body)
+    offset = PERFORMANCE_BODY.size
+
+    metrics = []
+    for _ in range(metric_count):
+        metric_type, value, samples = METRIC_RECORD.unpack_from(body, offset)
+        offset += METRIC_RECORD.size
+        metrics.append({'type': metric_type, 'value': value, 'samples': samples})
+
+    parameters = []
+    for _ in range(param_count):
+        name, value, mutations = PARAM_RECORD.unpack_from(body, offset)
+        offset += PARAM_RECORD.size
+        parameters.append({'name': _c_string(name), 'value': value, 'mutations': mutations})
+
+    return {
+        'type': 'performance_report',
+        'bot_id': _mac_to_string(mac),
+        'generation': generation,
+        'fitness': fitness,
+        'sample_count': sample_count,
+        'metrics': metrics,
+        'parameters': parameters
+    }
+
+def decode_error_report(body: bytes) -> Dict:
+    mac, error_count = ERROR_REPORT_BODY.unpack_from(body)
+    offset = ERROR_REPORT_BODY.size
+
+    errors = []
+    for _ in range(error_count):
+        severity, code, timestamp, description, function = ERROR_RECORD.unpack_from(body, offset)
+        offset += ERROR_RECORD.size
+        errors.append({
+            'severity': severity,
+            'code': code,
+            'description': _c_string(description),
+            'function': _c_string(function),
+            'timestamp': timestamp
+        })
+
+    return {
+        'type': 'error_report',
+        'bot_id': _mac_to_string(mac),
+        'error_count': error_count,
+        'errors': errors
+    }
+
+def decode_evolution_request(body: bytes) -> Dict:
+    generation, fitness, mutation_attempts, error_count, trigger = \
+        EVOLUTION_REQUEST_BODY.unpack_from(body)
+    message = {
+        'type': 'evolution_request',
+        'generation': generation,
+        'fitness': fitness,
+        'mutation_attempts': mutation_attempts,
+        'error_count': error_count
+    }
+    if trigger[0:1] != b'\0':
+        message['trigger'] = _c_string(trigger)
+    return message
+
+def decode_evolution_result(body: bytes) -> Dict:
+    success, fitness_delta, generation = EVOLUTION_RESULT_BODY.unpack_from(body)
+    return {
+        'type': 'evolution_result',
+        'success': bool(success),
+        'fitness_delta': fitness_delta,
+        'generation': generation
+    }
+
+DECODERS = {
+    ECS_HEARTBEAT: decode_heartbeat,
+    ECS_PERFORMANCE_REPORT: decode_performance_report,
+    ECS_ERROR_REPORT: decode_error_report,
+    ECS_FITNESS_REQUEST: decode_evolution_request,
+    ECS_EVOLUTION_RESULT: decode_evolution_result
+}
+
+def decode_body(message_type: int, body: bytes, flags: int = 0) -> Optional[Dict]:
+    """Decode one complete (reassembled) message body"""
+    if flags & ECS_FLAG_JSON:
+        return json.loads(body.decode('utf-8'))
+    decoder = DECODERS.get(message_type)
+    if decoder is None:
+        return None
+    return decoder(body)
+
+class ECSReassembler:
+    """Collects fragments per sender and returns decoded messages when complete"""
+
+    def __init__(self, timeout_s: float = 2.0):
+        self.timeout_s = timeout_s
+        self.pending: Dict[Tuple[str, int], Dict] = {}
+        self.stats = {'frames': 0, 'messages': 0, 'malformed': 0, 'expired': 0}
+
+    def feed(self, frame: bytes, source: str = '') -> Optional[Dict]:
+        """Feed one ESP-NOW frame; returns a message dict once all fragments arrived"""
+        self.stats['frames'] += 1
+        self._expire()
+
+        if len(frame) < FRAME_HEADER.size:
+            self.stats['malformed'] += 1
+            return None
+
+        magic, message_type, sequence, fragment, fragment_count, payload_size, flags = \
+            FRAME_HEADER.unpack_from(frame)
+        body = frame[FRAME_HEADER.size:]
+        if (magic != ECS_WIRE_MAGIC or payload_size != len(body) or
+                fragment_count == 0 or fragment >= fragment_count):
+            self.stats['malformed'] += 1
+            return None
+
+        if fragment_count == 1:
+            return self._finish(message_type, body, flags)
+
+        key = (source, sequence)
+        entry = self.pending.get(key)
+        if entry is None or entry['type'] != message_type or entry['count'] != fragment_count:
+            entry = {'type': message_type, 'count': fragment_count, 'flags': flags,
+                     'parts': {}, 'started': time.time()}
+            self.pending[key] = entry
+
+        entry['parts'][fragment] = body
+        if len(entry['parts']) < fragment_count:
+            return None
+
+        del self.pending[key]
+        full_body = b''.join(entry['parts'][i] for i in range(fragment_count))
+        return self._finish(message_type, full_body, entry['flags'])
+
+    def _finish(self, message_type: int, body: bytes, flags: int) -> Optional[Dict]:
+        try:
+            message = decode_body(message_type, body, flags)
+        except (struct.error, ValueError, UnicodeDecodeError):
+            self.stats['malformed'] += 1
+            return None
+        if message is not None:
+            self.stats['messages'] += 1
+        return message
+
+    def _expire(self):
+        now = time.time()
+        for key in [k for k, v in self.pending.items() if now - v['started'] > self.timeout_s]:
+            del self.pending[key]
+            self.stats['expired'] += 1
+
+# ═══════════════════════════════════════════════════════════
+# 📤 ENCODING (coordinator → bot)
+# ═══════════════════════════════════════════════════════════
+
+def encode_frame(message_type: int, body: bytes, sequence: int, flags: int = 0) -> bytes:
+    """Single-frame message; coordinator commands never need fragmenting"""
+    if len(body) > MAX_FRAGMENT_PAYLOAD:
+        raise ValueError(f"ECS command body too large: {len(body)} bytes")
+    header = FRAME_HEADER.pack(ECS_WIRE_MAGIC, message_type, sequence & 0xFFFF,
+                               0, 1, len(body), flags)
+    return header + body
+
+def encode_command(command: Dict, sequence: int) -> bytes:
+    """Encode a JSON-style command dict ('parameter_update', 'evolution_trigger', ...)"""
+    command_type = command.get('type')
+
+    if command_type == 'parameter_update':
+        body = PARAM_UPDATE_BODY.pack(_fixed_string(command['parameter'], 16), int(command['value']))
+        return encode_frame(ECS_PARAM_UPDATE, body, sequence)
+    if command_type == 'evolution_trigger':
+        body = EVOLUTION_TRIGGER_BODY.pack(_fixed_string(command.get('reason', ''), 32))
+        return encode_frame(ECS_FITNESS_REQUEST, body, sequence)
+    if command_type == 'reset_parameters':
+        return encode_frame(ECS_RESET_PARAMS, b'', sequence)
+    if command_type == 'status_request':
+        return encode_frame(ECS_STATUS_QUERY, b'', sequence)
+
+    raise ValueError(f"No binary encoding for command type: {command_type}")
+
+def encode_command_json(command: Dict, sequence: int) -> bytes:
+    """ECS_JSON_DEBUG firmware: same framing, JSON body"""
+    message_type = {
+        'parameter_update': ECS_PARAM_UPDATE,
+        'evolution_trigger': ECS_FITNESS_REQUEST,
+        'reset_parameters': ECS_RESET_PARAMS,
+        'status_request': ECS_STATUS_QUERY
+    }.get(command.get('type'), ECS_STATUS_QUERY)
+    return encode_frame(message_type, json.dumps(command).encode('utf-8'), sequence, ECS_FLAG_JSON)
@@ -16,14 +16,15 @@
  */
 
 #include "emergent_signal.h"
+#include "swarm_node.h"
 #include <random>
 
 // ═══════════════════════════════════════════════════════════
 // 🏗️ CONSTRUCTOR & INITIALIZATION
 // ═══════════════════════════════════════════════════════════
 
-EmergentSignalGenerator::EmergentSignalGenerator() {
-  vocabularySize = 0;
+EmergentSignalGenerator::EmergentSignalGenerator()
+  : vocabulary(EMOTION_VERY_NEGATIVE, EMOTION_VERY_POSITIVE) {
   memorySize = 0;
   peerCount = 0;
   currentGeneration = 0;
@@ -34,9 +35,9 @@ EmergentSignalGenerator::EmergentSignalGenerator() {
   innovationRate = random(10, 90);     // 10-90% chance to create new vs reuse
   
   // Initialize arrays
-  memset(vocabulary, 0, sizeof(vocabulary));
   memset(contextMemory, 0, sizeof(contextMemory));
   memset(peerProfiles, 0, sizeof(peerProfiles));
+  memset(profileSlot, -1, sizeof(profileSlot));
   
   Serial.printf("🧬 Emergent Signal Generator initialized\n");
   Serial.printf("   Personality: 0x%02X, Complexity: %d, Innovation: %d%%\n", 
@@ -47,39 +48,37 @@ EmergentSignalGenerator::EmergentSignalGenerator() {
 // 🎵 CORE SIGNAL GENERATION
 // ═══════════════════════════════════════════════════════════
 
-SignalWord* EmergentSignalGenerator::generateSignalForContext(EnvironmentalContext context, EmotionalState emotion) {
+int8_t EmergentSignalGenerator::generateSignalForContext(EnvironmentalContext context, EmotionalState emotion) {
   Serial.printf("🎵 Generating signal for context: %s, emotion: %s\n", 
                 contextToString(context).c_str(), emotionToString(emotion).c_str());
   
   // Strategy 1: Look for existing signal that fits this context+emotion
-  SignalWord* existingSignal = findExistingSignal(context, emotion);
+  int8_t existingSignal = findExistingSignal(context, emotion);
   
-  if (existingSignal != nullptr) {
+  if (existingSignal >= 0) {
     // Found existing signal - decide whether to reuse or innovate
     uint8_t innovationRoll = random(0, 100);
     
     if (innovationRoll > innovationRate) {
       // Reuse existing signal
-      Serial.printf("♻️ Reusing existing signal (utility: %.2f)\n", existingSignal->utility);
-      existingSignal->timesUsed++;
-      existingSignal->lastUsed = millis();
+      Serial.printf("♻️ Reusing existing signal (utility: %.2f)\n", vocabulary.utility(existingSignal));
+      vocabulary.recordUse(existingSignal, millis());
       return existingSignal;
     }
     
     // Innovation: mutate existing signal slightly
     Serial.println("🔄 Mutating existing signal for variation");
-    SignalWord mutatedSignal = *existingSignal;
-    mutateSignal(&mutatedSignal);
+    SignalWord mutatedSignal;
+    vocabulary.get(existingSignal, mutatedSignal);
+    mutateSignal(&mutatedSignal.pattern);
     
     // Add mutated signal to vocabulary if space available
-    if (vocabularySize < MAX_SIGNAL_VOCABULARY) {
-      vocabulary[vocabularySize] = mutatedSignal;
-      vocabulary[vocabularySize].createdAt = millis();
-      vocabulary[vocabularySize].generation = currentGeneration;
-      vocabulary[vocabularySize].timesUsed = 1;
-      vocabulary[vocabularySize].utility = 0.5f; // Start with neutral utility
-      vocabularySize++;
-      return &vocabulary[vocabularySize - 1];
+    if (!vocabulary.isFull()) {
+      mutatedSignal.createdAt = millis();
+      mutatedSignal.generation = currentGeneration;
+      mutatedSignal.timesUsed = 1;
+      mutatedSignal.utility = 0.5f; // Start with neutral utility
+      return vocabulary.add(mutatedSignal);
     }
   }
   
@@ -87,52 +86,54 @@ SignalWord* EmergentSignalGenerator::generateSignalForContext(EnvironmentalConte
   Serial.println("✨ Creating brand new signal");
   SignalWord newSignal = createNewSignal(context, emotion);
   
-  // Add to vocabulary if space available
-  if (vocabularySize < MAX_SIGNAL_VOCABULARY) {
-    vocabulary[vocabularySize] = newSignal;
-    vocabularySize++;
-    return &vocabulary[vocabularySize - 1];
-  } else {
-    // Vocabulary full - replace least useful signal
+  // Add to vocabulary; when full this replaces the least useful signal
+  if (vocabulary.isFull()) {
     Serial.println("📚 Vocabulary full, replacing least useful signal");
-    
-    float lowestUtility = 1.0f;
-    uint8_t replaceIndex = 0;
-    
-    for (uint8_t i = 0; i < vocabularySize; i++) {
-      if (vocabulary[i].utility < lowestUtility) {
-        lowestUtility = vocabulary[i].utility;
-        replaceIndex = i;
-      }
-    }
-    
-    vocabulary[replaceIndex] = newSignal;
-    return &vocabulary[replaceIndex];
   }
+  return vocabulary.add(newSignal);
 }
 
-SignalWord* EmergentSignalGenerator::findExistingSignal(EnvironmentalContext context, EmotionalState emotion) {
-  SignalWord* bestMatch = nullptr;
+// Score is (context match * 0.6 + emotion match * 0.4) * utility. Within a
+// bucket the matches are fixed and words are sorted by utility, so each
+// bucket is cut off as soon as its best remaining word cannot win.
+int8_t EmergentSignalGenerator::findExistingSignal(EnvironmentalContext context, EmotionalState emotion) {
+  int8_t bestMatch = -1;
   float bestScore = 0.0f;
+  uint8_t ownContextBin = vocabulary.contextBin(context);
   
-  for (uint8_t i = 0; i < vocabularySize; i++) {
-    SignalWord* signal = &vocabulary[i];
-    
-    // Calculate contextual similarity
-    float contextMatch = (signal->contextType == context) ? 1.0f : 0.0f;
-    float emotionMatch = (abs(signal->emotionalValence - emotion) <= 1) ? 1.0f : 0.0f;
-    
-    // Weight by utility - prefer successful signals
-    float totalScore = (contextMatch * 0.6f + emotionMatch * 0.4f) * signal->utility;
+  for (uint8_t pass = 0; pass < SIGNAL_CONTEXT_BINS; pass++) {
+    uint8_t contextBin = vocabulary.contextBinForPass(pass, ownContextBin);
+    float contextBound = (contextBin == ownContextBin) ? 0.6f : 0.0f;
     
-    if (totalScore > bestScore) {
-      bestScore = totalScore;
-      bestMatch = signal;
+    for (uint8_t emotionBin = 0; emotionBin < SIGNAL_EMOTION_BINS; emotionBin++) {
+      int8_t i = vocabulary.head(contextBin * SIGNAL_EMOTION_BINS + emotionBin);
+      if (i < 0) continue;
+      
+      int low, high;
+      vocabulary.valenceRange(emotionBin, low, high);
+      bool emotionPossible = (emotion + 1 >= low) && (emotion - 1 <= high);
+      float bound = contextBound + (emotionPossible ? 0.4f : 0.0f);
+      
+      for (; i >= 0; i = vocabulary.next(i)) {
+        if (bound * vocabulary.utility(i) <= bestScore) break; // Rest of the bucket scores lower
+        
+        // Calculate contextual similarity
+        float contextMatch = (vocabulary.context(i) == context) ? 1.0f : 0.0f;
+        float emotionMatch = (abs(vocabulary.valence(i) - emotion) <= 1) ? 1.0f : 0.0f;
+        
+        // Weight by utility - prefer successful signals
+        float totalScore = (contextMatch * 0.6f + emotionMatch * 0.4f) * vocabulary.utility(i);
+        
+        if (totalScore > bestScore) {
+          bestScore = totalScore;
+          bestMatch = i;
+        }
+      }
     }
   }
   
   // Only return if match is reasonably good
-  return (bestScore > 0.3f) ? bestMatch : nullptr;
+  return (bestScore > 0.3f) ? bestMatch : -1;
 }
 
 SignalWord EmergentSignalGenerator::createNewSignal(EnvironmentalContext context, EmotionalState emotion) {
@@ -143,49 +144,50 @@ SignalWord EmergentSignalGenerator::createNewSignal(EnvironmentalContext context
   newSignal.contextType = context;
   newSignal.emotionalValence = emotion;
   newSignal.generation = currentGeneration;
+  SignalPattern& pattern = newSignal.pattern;
   
   // Generate acoustic properties based on context and emotion
   // Context influences number of components
   switch (context) {
     case CONTEXT_DANGER_SENSED:
     case CONTEXT_TASK_FAILURE:
-      newSignal.componentCount = random(3, 6); // Urgent contexts = more complex
+      pattern.length = random(3, 6); // Urgent contexts = more complex
       break;
     case CONTEXT_TASK_SUCCESS:
     case CONTEXT_RESOURCE_FOUND:
-      newSignal.componentCount = random(2, 4); // Success = moderate complexity
+      pattern.length = random(2, 4); // Success = moderate complexity
       break;
     default:
-      newSignal.componentCount = random(1, complexityPreference + 1);
+      pattern.length = random(1, complexityPreference + 1);
       break;
   }
   
   // Emotion influences component types and intensity
-  for (uint8_t i = 0; i < newSignal.componentCount; i++) {
+  for (uint8_t i = 0; i < pattern.length; i++) {
     // Choose component type based on emotion
     if (emotion >= EMOTION_POSITIVE) {
       // Positive emotions prefer higher frequencies and rising sweeps
       uint8_t positiveComponents[] = {COMPONENT_TONE_HIGH, COMPONENT_SWEEP_UP, COMPONENT_PULSE_FAST};
-      newSignal.components[i] = positiveComponents[random(0, 3)];
-      newSignal.intensities[i] = random(150, 255); // Higher intensity
+      pattern.components[i] = positiveComponents[random(0, 3)];
+      pattern.intensities[i] = random(150, 255); // Higher intensity
     } else if (emotion <= EMOTION_NEGATIVE) {
       // Negative emotions prefer lower frequencies and falling sweeps
       uint8_t negativeComponents[] = {COMPONENT_TONE_LOW, COMPONENT_SWEEP_DOWN, COMPONENT_PULSE_SLOW};
-      newSignal.components[i] = negativeComponents[random(0, 3)];
-      newSignal.intensities[i] = random(100, 200); // Moderate intensity
+      pattern.components[i] = negativeComponents[random(0, 3)];
+      pattern.intensities[i] = random(100, 200); // Moderate intensity
     } else {
       // Neutral emotion - any component
-      newSignal.components[i] = generateRandomComponent();
-      newSignal.intensities[i] = generateRandomIntensity();
+      pattern.components[i] = generateRandomComponent();
+      pattern.intensities[i] = generateRandomIntensity();
     }
     
     // Duration influenced by context urgency
     if (context == CONTEXT_DANGER_SENSED || context == CONTEXT_TASK_FAILURE) {
-      newSignal.durations[i] = random(50, 200); // Short, urgent
+      pattern.durations[i] = random(50, 200); // Short, urgent
     } else if (context == CONTEXT_WAITING || context == CONTEXT_EXPLORATION) {
-      newSignal.durations[i] = random(200, 800); // Longer, relaxed
+      pattern.durations[i] = random(200, 800); // Longer, relaxed
     } else {
-      newSignal.durations[i] = random(100, 400); // Normal duration
+      pattern.durations[i] = random(100, 400); // Normal duration
     }
   }
   
@@ -197,11 +199,11 @@ SignalWord EmergentSignalGenerator::createNewSignal(EnvironmentalContext context
   newSignal.createdAt = millis();
   
   // Add personality signature
-  newSignal.personalitySignature = personalitySignature;
-  newSignal.complexityPreference = complexityPreference;
+  pattern.personalitySignature = personalitySignature;
+  pattern.complexityPreference = complexityPreference;
   
   Serial.printf("✨ Created new signal: %d components, context=%d, emotion=%d\n", 
-                newSignal.componentCount, context, emotion);
+                pattern.length, context, emotion);
   
   return newSignal;
 }
@@ -210,65 +212,66 @@ SignalWord EmergentSignalGenerator::createNewSignal(EnvironmentalContext context
 // 🧬 SIGNAL EVOLUTION & LEARNING
 // ═══════════════════════════════════════════════════════════
 
-void EmergentSignalGenerator::updateSignalUtility(SignalWord* signal, float outcome) {
-  if (signal == nullptr) return;
+void EmergentSignalGenerator::updateSignalUtility(uint8_t slot, float outcome) {
+  if (slot >= vocabulary.size()) return;
   
   // Update utility using exponential moving average
   float alpha = 0.1f; // Learning rate
-  signal->utility = (1.0f - alpha) * signal->utility + alpha * outcome;
+  float utility = (1.0f - alpha) * vocabulary.utility(slot) + alpha * outcome;
+  vocabulary.setUtility(slot, utility);
   
   // Track understanding
   if (outcome > 0.5f) {
-    signal->timesUnderstood++;
+    vocabulary.recordUnderstood(slot);
   }
   
-  Serial.printf("📈 Updated signal utility: %.3f (outcome: %.3f)\n", signal->utility, outcome);
+  Serial.printf("📈 Updated signal utility: %.3f (outcome: %.3f)\n", utility, outcome);
   
   // Evolution pressure: signals with very low utility get mutated
-  if (signal->utility < 0.2f && signal->timesUsed > 5) {
+  if (utility < 0.2f && vocabulary.timesUsed(slot) > 5) {
     Serial.println("🔄 Low utility signal - applying evolutionary pressure");
-    mutateSignal(signal);
-    signal->generation = currentGeneration; // Mark as evolved
+    mutateSignal(&vocabulary.pattern(slot));
+    vocabulary.setGeneration(slot, currentGeneration); // Mark as evolved
   }
 }
 
-void EmergentSignalGenerator::mutateSignal(SignalWord* signal) {
+void EmergentSignalGenerator::mutateSignal(SignalPattern* pattern) {
   uint8_t mutationType = random(0, 4);
   
   switch (mutationType) {
     case 0: // Mutate duration
-      if (signal->componentCount > 0) {
-        uint8_t componentIndex = random(0, signal->componentCount);
-        signal->durations[componentIndex] += random(-50, 51);
-        signal->durations[componentIndex] = constrain(signal->durations[componentIndex], 50, 1000);
+      if (pattern->length > 0) {
+        uint8_t componentIndex = random(0, pattern->length);
+        pattern->durations[componentIndex] += random(-50, 51);
+        pattern->durations[componentIndex] = constrain(pattern->durations[componentIndex], 50, 1000);
       }
       break;
       
     case 1: // Mutate intensity
-      if (signal->componentCount > 0) {
-        uint8_t componentIndex = random(0, signal->componentCount);
-        signal->intensities[componentIndex] += random(-30, 31);
-        signal->intensities[componentIndex] = constrain(signal->intensities[componentIndex], 50, 255);
+      if (pattern->length > 0) {
+        uint8_t componentIndex = random(0, pattern->length);
+        pattern->intensities[componentIndex] += random(-30, 31);
+        pattern->intensities[componentIndex] = constrain(pattern->intensities[componentIndex], 50, 255);
       }
       break;
       
     case 2: // Change component type
-      if (signal->componentCount > 0) {
-        uint8_t componentIndex = random(0, signal->componentCount);
-        signal->components[componentIndex] = generateRandomComponent();
+      if (pattern->length > 0) {
+        uint8_t componentIndex = random(0, pattern->length);
+        pattern->components[componentIndex] = generateRandomComponent();
       }
       break;
       
     case 3: // Add or remove component
-      if (signal->componentCount < MAX_SIGNAL_COMPONENTS && random(0, 2)) {
+      if (pattern->length < MAX_SIGNAL_COMPONENTS && random(0, 2)) {
         // Add component
-        signal->components[signal->componentCount] = generateRandomComponent();
-        signal->durations[signal->componentCount] = generateRandomDuration();
-        signal->intensities[signal->componentCount] = generateRandomIntensity();
-        signal->componentCount++;
-      } else if (signal->componentCount > 1) {
+        pattern->components[pattern->length] = generateRandomComponent();
+        pattern->durations[pattern->length] = generateRandomDuration();
+        pattern->intensities[pattern->length] = generateRandomIntensity();
+        pattern->length++;
+      } else if (pattern->length > 1) {
         // Remove component
-        signal->componentCount--;
+        pattern->length--;
       }
       break;
   }
@@ -280,34 +283,72 @@ void EmergentSignalGenerator::mutateSignal(SignalWord* signal) {
 // 🤝 PEER LEARNING & COMMUNICATION
 // ═══════════════════════════════════════════════════════════
 
+// Profiles are reached through the shared registry id, not a MAC scan.
+// A registry id can be reclaimed for another bot, so the stored MAC is
+// still checked and the slot recycled when it no longer matches.
+PeerSignalProfile* EmergentSignalGenerator::findPeerProfile(const uint8_t* peerMac, bool create) {
+  PeerId id = create ? swarmNode->peerRegistry.findOrAdd(peerMac) : swarmNode->peerRegistry.find(peerMac);
+  if (id == INVALID_PEER_ID) return nullptr;
+
+  int8_t slot = profileSlot[id];
+  if (slot >= 0 && macEquals(peerProfiles[slot].peerMac, (uint8_t*)peerMac)) {
+    return &peerProfiles[slot];
+  }
+  if (!create) return nullptr;
+
+  if (slot < 0) {
+    if (peerCount >= 8) return nullptr;
+    slot = peerCount++;
+    profileSlot[id] = slot;
+  }
+
+  // Create new peer profile
+  PeerSignalProfile* profile = &peerProfiles[slot];
+  memset(profile, 0, sizeof(PeerSignalProfile));
+  memcpy(profile->peerMac, peerMac, 6);
+  profile->trustLevel = 0.5f; // Start with neutral trust
+  profile->lastInteraction = millis();
+  return profile;
+}
+
 void EmergentSignalGenerator::learnFromPeerSignal(uint8_t* peerMac, SignalWord* signal, EnvironmentalContext context) {
   Serial.printf("🧠 Learning from peer signal in context: %s\n", contextToString(context).c_str());
   
   // Find or create peer profile
-  PeerSignalProfile* profile = nullptr;
-  for (uint8_t i = 0; i < peerCount; i++) {
-    if (macEquals(peerProfiles[i].peerMac, peerMac)) {
-      profile = &peerProfiles[i];
-      break;
-    }
-  }
-  
-  if (profile == nullptr && peerCount < 8) {
-    // Create new peer profile
-    profile = &peerProfiles[peerCount];
-    memcpy(profile->peerMac, peerMac, 6);
-    profile->signalCount = 0;
-    profile->trustLevel = 0.5f; // Start with neutral trust
-    profile->personalitySignature = signal->personalitySignature;
-    profile->lastInteraction = millis();
-    peerCount++;
+  PeerSignalProfile* profile = findPeerProfile(peerMac, true);
+  if (profile != nullptr && profile->signalCount == 0) {
+    profile->personalitySignature = signal->pattern.personalitySignature;
   }
   
   if (profile != nullptr) {
-    // Store this signal if we have space
-    if (profile->signalCount < 16) {
-      profile->knownSignals[profile->signalCount] = *signal;
-      profile->signalCount++;
+    // One batched pass over our vocabulary and every peer's known signals
+    uint8_t scores[MAX_SIGNAL_VOCABULARY];
+    uint8_t closestOwn = 0;
+    acousticSimilarityBatch(signal->pattern, vocabulary.patternTable(), vocabulary.size(), scores);
+    for (uint8_t i = 0; i < vocabulary.size(); i++) closestOwn = max(closestOwn, scores[i]);
+    
+    int8_t duplicate = -1;
+    uint8_t sharedBy = 0;       // Other peers already using a signal like it
+    for (uint8_t p = 0; p < peerCount; p++) {
+      PeerSignalProfile* peer = &peerProfiles[p];
+      acousticSimilarityBatch(signal->pattern, peer->knownPatterns, peer->signalCount, scores);
+      
+      uint8_t best = 0;
+      for (uint8_t i = 0; i < peer->signalCount; i++) {
+        if (scores[i] <= best) continue;
+        best = scores[i];
+        if (peer == profile && best >= SIGNAL_MATCH_THRESHOLD) duplicate = i;
+      }
+      if (peer != profile && best >= SIGNAL_MATCH_THRESHOLD) sharedBy++;
+    }
+    
+    // Same signal again from this peer: refresh it rather than store a copy
+    int8_t slot = (duplicate >= 0) ? duplicate : 
+                  (profile->signalCount < MAX_PEER_SIGNALS) ? profile->signalCount++ : -1;
+    if (slot >= 0) {
+      profile->knownContexts[slot] = signal->contextType;
+      profile->knownValences[slot] = signal->emotionalValence;
+      profile->knownPatterns[slot] = signal->pattern;
     }
     
     // Update last interaction
@@ -324,23 +365,40 @@ void EmergentSignalGenerator::learnFromPeerSignal(uint8_t* peerMac, SignalWord*
       memorySize++;
     }
     
-    Serial.printf("📚 Learned signal from peer %s (total signals: %d)\n", 
-                  macToString(peerMac).c_str(), profile->signalCount);
+    Serial.printf("📚 Learned signal from peer %s (total signals: %d, closest own: %.2f, shared by %d peers)\n", 
+                  macToString(peerMac).c_str(), profile->signalCount, 
+                  closestOwn / (float)SIGNAL_SIMILARITY_MAX, sharedBy);
   }
 }
 
-bool EmergentSignalGenerator::sendEmergentMessage(SignalWord* signal, EnvironmentalContext context, EmotionalState emotion) {
-  if (signal == nullptr) return false;
+float EmergentSignalGenerator::evaluateSignalSimilarity(SignalWord* signal1, SignalWord* signal2) {
+  // How it sounds matters more than when it was used
+  return calculateAcousticSimilarity(signal1, signal2) * 0.7f + 
+         calculateSemanticSimilarity(signal1, signal2) * 0.3f;
+}
+
+void EmergentSignalGenerator::updatePeerTrust(uint8_t* peerMac, float outcome) {
+  PeerSignalProfile* profile = findPeerProfile(peerMac, false);
+  if (profile == nullptr) return;
+
+  // Nudge trust towards the outcome of acting on this peer's signals
+  profile->trustLevel = constrain(profile->trustLevel + outcome * 0.1f, 0.0f, 1.0f);
+  profile->lastInteraction = millis();
+}
+
+bool EmergentSignalGenerator::sendEmergentMessage(uint8_t slot, EnvironmentalContext context, EmotionalState emotion) {
+  if (slot >= vocabulary.size()) return false;
   
   EmergentMessage message;
   memset(&message, 0, sizeof(EmergentMessage));
   
   // Fill message structure
-  message.protocolVersion = 0x02;
+  message.protocolVersion = EMERGENT_PROTOCOL_VERSION;
   WiFi.macAddress(message.senderMac);
   message.timestamp = millis();
   message.sequenceNumber = random(0, 255);
-  message.signal = *signal;
+  vocabulary.get(slot, message.signal);
+  SignalWord* signal = &message.signal;
   message.currentContext = context;
   message.currentEmotion = emotion;
   message.confidence = min(255, (int)(signal->utility * 255));
@@ -362,8 +420,8 @@ bool EmergentSignalGenerator::sendEmergentMessage(SignalWord* signal, Environmen
   if (result == ESP_OK) {
     Serial.printf("📡 Emergent signal broadcast successful\n");
     
-    // Play the signal locally (optional - for debugging/demonstration)
-    playSignalWord(signal);
+    // Play the signal locally; urgent contexts pre-empt ordinary expression
+    playSignalWord(signal, message.expectsResponse ? SIGNAL_PRIORITY_ALERT : SIGNAL_PRIORITY_EXPRESSION);
     
     return true;
   } else {
@@ -386,6 +444,13 @@ void EmergentSignalGenerator::processReceivedMessage(EmergentMessage* message) {
     Serial.println("❌ Message checksum failed");
     return;
   }
+  if (message->protocolVersion != EMERGENT_PROTOCOL_VERSION) {
+    Serial.printf("❌ Unsupported emergent protocol version %d\n", message->protocolVersion);
+    return;
+  }
+  
+  // A valid message is peer contact for context detection
+  postPeerContact();
   
   // Learn from this peer's signal
   learnFromPeerSignal(message->senderMac, &message->signal, (EnvironmentalContext)message->currentContext);
@@ -398,8 +463,8 @@ void EmergentSignalGenerator::processReceivedMessage(EmergentMessage* message) {
     EnvironmentalContext ourContext = getCurrentContext();
     EmotionalState ourEmotion = getCurrentEmotionalState();
     
-    SignalWord* responseSignal = generateSignalForContext(ourContext, ourEmotion);
-    if (responseSignal != nullptr) {
+    int8_t responseSignal = generateSignalForContext(ourContext, ourEmotion);
+    if (responseSignal >= 0) {
       // Send response after short delay
       delay(random(100, 500)); // Avoid collision
       sendEmergentMessage(responseSignal, ourContext, ourEmotion);
@@ -428,34 +493,52 @@ uint8_t generateRandomIntensity() {
   return random(100, 255);
 }
 
-float calculateAcousticSimilarity(SignalWord* sig1, SignalWord* sig2) {
-  if (sig1 == nullptr || sig2 == nullptr) return 0.0f;
-  
-  float similarity = 0.0f;
-  uint8_t commonComponents = min(sig1->componentCount, sig2->componentCount);
-  
-  // Compare component types
-  for (uint8_t i = 0; i < commonComponents; i++) {
-    if (sig1->components[i] == sig2->components[i]) {
-      similarity += 0.4f / commonComponents;
+// One probe against a whole array (vocabulary or a peer's knownPatterns).
+// No divisions in the component loop: "min / max > 0.5" is "2 * min > max"
+// and "> 0.7" is "10 * min > 7 * max"; equal values always match.
+void acousticSimilarityBatch(const SignalPattern& probe, const SignalPattern* patterns, uint8_t count, uint8_t* scores) {
+  uint8_t probeCount = min(probe.length, (uint8_t)MAX_SIGNAL_COMPONENTS);
+  
+  for (uint8_t w = 0; w < count; w++) {
+    const SignalPattern* word = &patterns[w];
+    uint8_t commonComponents = min(probeCount, word->length);
+    if (commonComponents == 0) {
+      scores[w] = 0;
+      continue;
     }
     
-    // Compare durations (allow 50% variance)
-    float durationRatio = min(sig1->durations[i], sig2->durations[i]) / 
-                         max(sig1->durations[i], sig2->durations[i]);
-    if (durationRatio > 0.5f) {
-      similarity += 0.3f / commonComponents;
+    uint16_t points = 0;
+    for (uint8_t i = 0; i < commonComponents; i++) {
+      uint32_t d1 = probe.durations[i], d2 = word->durations[i];
+      uint32_t dMin = min(d1, d2), dMax = max(d1, d2);
+      uint16_t i1 = probe.intensities[i], i2 = word->intensities[i];
+      uint16_t iMin = min(i1, i2), iMax = max(i1, i2);
+      
+      points += (probe.components[i] == word->components[i]) ? 4 : 0;
+      points += (dMin == dMax || 2 * dMin > dMax) ? 3 : 0;
+      points += (iMin == iMax || 10 * iMin > 7 * iMax) ? 3 : 0;
     }
     
-    // Compare intensities (allow 30% variance)
-    float intensityRatio = min(sig1->intensities[i], sig2->intensities[i]) / 
-                          max(sig1->intensities[i], sig2->intensities[i]);
-    if (intensityRatio > 0.7f) {
-      similarity += 0.3f / commonComponents;
-    }
+    // 10 points per component is a perfect match
+    scores[w] = (uint8_t)((points * SIGNAL_SIMILARITY_MAX) / (10 * commonComponents));
   }
+}
+
+float calculateAcousticSimilarity(SignalWord* sig1, SignalWord* sig2) {
+  if (sig1 == nullptr || sig2 == nullptr) return 0.0f;
   
-  return similarity;
+  uint8_t score;
+  acousticSimilarityBatch(sig1->pattern, &sig2->pattern, 1, &score);
+  return score / (float)SIGNAL_SIMILARITY_MAX;
+}
+
+float calculateSemanticSimilarity(SignalWord* sig1, SignalWord* sig2) {
+  if (sig1 == nullptr || sig2 == nullptr) return 0.0f;
+  
+  // Same situation counts most; emotion is on a -2..+2 scale
+  float contextMatch = (sig1->contextType == sig2->contextType) ? 1.0f : 0.0f;
+  float emotionCloseness = 1.0f - min(abs(sig1->emotionalValence - sig2->emotionalValence), 4) / 4.0f;
+  return contextMatch * 0.6f + emotionCloseness * 0.4f;
 }
 
 String contextToString(EnvironmentalContext context) {
@@ -497,14 +580,15 @@ bool macEquals(uint8_t* mac1, uint8_t* mac2) {
   return memcmp(mac1, mac2, 6) == 0;
 }
 
-void playSignalWord(SignalWord* signal) {
-  // This would connect to speaker/buzzer hardware
-  // For now, just debug output
-  Serial.printf("🔊 Playing signal: %d components\n", signal->componentCount);
-  for (uint8_t i = 0; i < signal->componentCount; i++) {
+void playSignalWord(SignalWord* signal, uint8_t priority) {
+  Serial.printf("🔊 Playing signal: %d components\n", signal->pattern.length);
+  for (uint8_t i = 0; i < signal->pattern.length; i++) {
     Serial.printf("   Component %d: type=%d, duration=%dms, intensity=%d\n", 
-                  i, signal->components[i], signal->durations[i], signal->intensities[i]);
+                  i, signal->pattern.components[i], signal->pattern.durations[i], signal->pattern.intensities[i]);
   }
+  
+  // Timer-driven: the owner attaches LEDs/buzzer with signalPlayer.begin()
+  signalPlayer.play(*signal, priority);
 }
 
 // ═══════════════════════════════════════════════════════════
@@ -512,33 +596,39 @@ void playSignalWord(SignalWord* signal) {
 // ═══════════════════════════════════════════════════════════
 
 void EmergentSignalGenerator::pruneUnusedSignals() {
-  uint8_t writeIndex = 0;
-  
-  // Keep signals that have been used recently or frequently
-  for (uint8_t readIndex = 0; readIndex < vocabularySize; readIndex++) {
-    SignalWord* signal = &vocabulary[readIndex];
-    
-    // Keep signal if:
-    // 1. It's been used in the last 10 minutes
-    // 2. It has high utility (> 0.5)
-    // 3. It's been used more than 5 times
-    unsigned long timeSinceLastUse = millis() - signal->lastUsed;
-    bool keepSignal = (timeSinceLastUse < 600000) ||  // 10 minutes
-                      (signal->utility > 0.5) ||
-                      (signal->timesUsed > 5);
-    
-    if (keepSignal && writeIndex != readIndex) {
-      vocabulary[writeIndex] = vocabulary[readIndex];
+  // Only words with utility <= 0.5 can go, and those sit at bucket tails
+  uint8_t candidates[MAX_SIGNAL_VOCABULARY];
+  uint8_t candidateCount = 0;
+  
+  for (uint8_t bucket = 0; bucket < SIGNAL_BUCKETS; bucket++) {
+    for (int8_t i = vocabulary.tail(bucket); i >= 0 && vocabulary.utility(i) <= 0.5f;
+         i = vocabulary.prev(i)) {
+      // Keep signal if:
+      // 1. It's been used in the last 10 minutes
+      // 2. It has high utility (> 0.5) - not a candidate at all
+      // 3. It's been used more than 5 times
+      unsigned long timeSinceLastUse = millis() - vocabulary.lastUsed(i);
+      bool keepSignal = (timeSinceLastUse < 600000) ||  // 10 minutes
+                        (vocabulary.timesUsed(i) > 5);
+      
+      if (!keepSignal) candidates[candidateCount++] = i;
     }
-    
-    if (keepSignal) {
-      writeIndex++;
-    } else {
-      Serial.printf("🧹 Pruning unused signal (utility: %.2f, uses: %d)\n", 
-                    signal->utility, signal->timesUsed);
+  }
+  
+  // Highest slot first, so swap-removal never moves a pending candidate
+  for (uint8_t i = 1; i < candidateCount; i++) {
+    for (uint8_t j = i; j > 0 && candidates[j] > candidates[j - 1]; j--) {
+      uint8_t swap = candidates[j];
+      candidates[j] = candidates[j - 1];
+      candidates[j - 1] = swap;
     }
   }
   
-  vocabularySize = writeIndex;
-  Serial.printf("🧹 Vocabulary pruned: %d signals remaining\n", vocabularySize);
-}
\ No newline at end of file
+  for (uint8_t i = 0; i < candidateCount; i++) {
+    Serial.printf("🧹 Pruning unused signal (utility: %.2f, uses: %d)\n", 
+                  vocabulary.utility(candidates[i]), vocabulary.timesUsed(candidates[i]));
+    vocabulary.remove(candidates[i]);
+  }
+  
+  Serial.printf("🧹 Vocabulary pruned: %d signals remaining\n", vocabulary.size());
+}
@@ -0,0 +1,175 @@
+#include "signal_player.h"
+
+// ═══════════════════════════════════════════════════════════
+// 🎶 SIGNAL PLAYER IMPLEMENTATION
+// ═══════════════════════════════════════════════════════════
+
+SignalPlayer signalPlayer;
+
+SignalPlayer::SignalPlayer() {
+  timer = nullptr;
+  output = nullptr;
+  lock = portMUX_INITIALIZER_UNLOCKED;
+  currentLevel = -1;
+  step = 0;
+  inGap = false;
+  restart = false;
+  deadlineUs = 0;
+  memset(&current, 0, sizeof(current));
+  memset(hasPending, 0, sizeof(hasPending));
+}
+
+bool SignalPlayer::begin(SignalOutputFn outputFn) {
+  if (timer != nullptr) return true;
+  output = outputFn;
+
+  esp_timer_create_args_t args;
+  memset(&args, 0, sizeof(args));
+  args.callback = &SignalPlayer::onTimer;
+  args.arg = this;
+  args.dispatch_method = ESP_TIMER_TASK;
+  args.name = "signalPlayer";
+
+  if (esp_timer_create(&args, &timer) != ESP_OK) {
+    timer = nullptr;
+    Serial.println("❌ Signal player timer could not be created");
+    return false;
+  }
+  return true;
+}
+
+void SignalPlayer::sequenceFromPattern(const SignalPattern& pattern, SignalSequence& sequence) {
+  sequence.count = min(pattern.length, (uint8_t)SIGNAL_PLAYER_MAX_STEPS);
+  for (uint8_t i = 0; i < sequence.count; i++) {
+    SignalStep& s = sequence.steps[i];
+    s.r = pattern.r;
+    s.g = pattern.g;
+    s.b = pattern.b;
+    s.toneHz = pattern.tones[i];
+    s.holdMs = pattern.durations[i];
+  }
+  sequence.gapMs = SIGNAL_PLAYER_DEFAULT_GAP_MS;
+  sequence.endDark = true;
+}
+
+// ═══════════════════════════════════════════════════════════
+// ▶️ STARTING & STOPPING (any task)
+// ═══════════════════════════════════════════════════════════
+
+bool SignalPlayer::play(const SignalSequence& sequence, uint8_t priority) {
+  if (timer == nullptr || priority >= SIGNAL_PRIORITY_LEVELS) return false;
+
+  portENTER_CRITICAL(&lock);
+  bool preempt = (int8_t)priority >= currentLevel;
+  if (preempt) {
+    current = sequence;
+    currentLevel = priority;
+    restart = true;
+  } else {
+    pending[priority] = sequence;
+    hasPending[priority] = true;
+  }
+  portEXIT_CRITICAL(&lock);
+
+  if (preempt) kick();
+  return true;
+}
+
+bool SignalPlayer::play(const SignalWord& word, uint8_t priority) {
+  SignalSequence sequence;
+  sequenceFromPattern(word.pattern, sequence);
+  return play(sequence, priority);
+}
+
+void SignalPlayer::stop() {
+  if (timer == nullptr) return;
+
+  portENTER_CRITICAL(&lock);
+  currentLevel = -1;
+  memset(hasPending, 0, sizeof(hasPending));
+  restart = true;
+  portEXIT_CRITICAL(&lock);
+
+  kick();
+}
+
+// Re-arm for "now"; the timer task picks up the new state
+void SignalPlayer::kick() {
+  esp_timer_stop(timer);
+  esp_timer_start_once(timer, 0);
+}
+
+// ═══════════════════════════════════════════════════════════
+// ⏱️ TIMER TASK
+// ═══════════════════════════════════════════════════════════
+
+void SignalPlayer::onTimer(void* arg) {
+  static_cast<SignalPlayer*>(arg)->advance();
+}
+
+// Lock held. Highest queued level becomes current.
+bool SignalPlayer::startPending() {
+  for (int level = SIGNAL_PRIORITY_LEVELS - 1; level >= 0; level--) {
+    if (!hasPending[level]) continue;
+    current = pending[level];
+    hasPending[level] = false;
+    currentLevel = level;
+    step = 0;
+    inGap = false;
+    return true;
+  }
+  return false;
+}
+
+void SignalPlayer::advance() {
+  static const SignalStep dark = {0, 0, 0, 0, 0};
+  SignalStep out = dark;
+  uint32_t waitMs = 0;                   // 0 = nothing left to time
+  int64_t now = esp_timer_get_time();
+
+  portENTER_CRITICAL(&lock);
+
+  if (!restart && currentLevel >= 0 && now < deadlineUs) {
+    // Woken early (a play() raced the armed timer): sleep out the step
+    uint64_t remainingUs = deadlineUs - now;
+    portEXIT_CRITICAL(&lock);
+    esp_timer_start_once(timer, remainingUs);
+    return;
+  }
+
+  bool starting = false;
+  if (restart) {
+    restart = false;
+    step = 0;
+    inGap = false;
+    starting = (currentLevel >= 0);
+  } else if (currentLevel >= 0) {
+    if (!inGap && current.gapMs > 0) {
+      // Step done: outputs off for the gap
+      inGap = true;
+      waitMs = current.gapMs;
+    } else {
+      inGap = false;
+      step++;
+      starting = true;
+    }
+  }
+
+  while (starting && step >= current.count) {
+    // Sequence finished: next queued one, or rest on the final state
+    if (!current.endDark && current.count > 0) out = current.steps[current.count - 1];
+    currentLevel = -1;
+    starting = startPending();
+  }
+
+  if (starting && step < current.count) {
+    out = current.steps[step];
+    waitMs = max((uint16_t)1, out.holdMs);
+  }
+
+  if (waitMs > 0) deadlineUs = now + (int64_t)waitMs * 1000;
+  portEXIT_CRITICAL(&lock);
+
+  if (output != nullptr) output(out.r, out.g, out.b, out.toneHz);
+  if (waitMs > 0) esp_timer_start_once(timer, (uint64_t)waitMs * 1000);
+}
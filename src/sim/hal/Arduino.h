@@ -0,0 +1,116 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+
+// ═══════════════════════════════════════════════════════════
+// 🖥️ NATIVE HAL - ARDUINO CORE SUBSET
+// ═══════════════════════════════════════════════════════════
+// Just the part of the ESP32 Arduino core the swarm modules use, on
+// the simulator's virtual clock and the current node (native_hal.h).
+
+// One task per node, so critical sections have nothing to exclude
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+
+#define PI 3.1415926535897932384626433832795
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define DEC 10
+#define HEX 16
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+using std::min;
+using std::max;
+
+template <class T, class L, class H>
+auto constrain(T x, L low, H high) -> decltype(x + low + high) {
+  return x < low ? low : (x > high ? high : x);
+}
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+inline double radians(double deg) { return deg * DEG_TO_RAD; }
+inline double degrees(double rad) { return rad * RAD_TO_DEG; }
+
+// Time (virtual, since the current node's boot)
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);               // Advances the virtual clock
+
+// Seeded, shared by every node
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+class String {
+public:
+  String() {}
+  String(const char* text) : value(text ? text : "") {}
+  String(const std::string& text) : value(text) {}
+  String(char c) : value(1, c) {}
+  String(int number) : value(std::to_string(number)) {}
+  String(unsigned int number) : value(std::to_string(number)) {}
+  String(long number) : value(std::to_string(number)) {}
+  String(unsigned long number) : value(std::to_string(number)) {}
+  String(double number, unsigned int decimals = 2);
+
+  const char* c_str() const { return value.c_str(); }
+  unsigned int length() const { return value.size(); }
+  bool isEmpty() const { return value.empty(); }
+
+  String& operator+=(const String& other) { value += other.value; return *this; }
+  String& operator+=(const char* other) { value += other ? other : ""; return *this; }
+  String& operator+=(char c) { value += c; return *this; }
+  friend String operator+(const String& a, const String& b) { return String(a.value + b.value); }
+  bool operator==(const String& other) const { return value == other.value; }
+  bool operator!=(const String& other) const { return value != other.value; }
+
+private:
+  std::string value;
+};
+
+// Output goes to stderr while the current node has serialEnabled, so
+// stdout stays free for the simulator's results
+class HardwareSerial {
+public:
+  void begin(unsigned long baud) { (void)baud; }
+  int available() { return 0; }
+  int read() { return -1; }
+
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+  size_t print(const char* text);
+  size_t print(const String& text) { return print(text.c_str()); }
+  size_t print(char c);
+  size_t print(long number, int base = DEC);
+  size_t print(unsigned long number, int base = DEC);
+  size_t print(int number, int base = DEC) { return print((long)number, base); }
+  size_t print(unsigned int number, int base = DEC) { return print((unsigned long)number, base); }
+  size_t print(double number, int digits = 2);
+
+  size_t println() { return print("\n"); }
+  template <typename T>
+  size_t println(const T& value) { return print(value) + println(); }
+  template <typename T>
+  size_t println(const T& value, int format) { return print(value, format) + println(); }
+
+private:
+  bool enabled() const;
+};
+
+extern HardwareSerial Serial;
+
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <Arduino.h>
+#include "native_hal.h"
+
+// ═══════════════════════════════════════════════════════════
+// 🖥️ NATIVE HAL - EEPROM
+// ═══════════════════════════════════════════════════════════
+// Reads and writes the current node's image; it survives halBootNode().
+
+class EEPROMClass {
+public:
+  bool begin(size_t size) { return size <= HAL_EEPROM_SIZE; }
+  bool commit();
+  void end() {}
+  size_t length() const { return HAL_EEPROM_SIZE; }
+
+  uint8_t read(int address);
+  void write(int address, uint8_t value);
+  uint8_t readUChar(int address) { return read(address); }
+  size_t writeUChar(int address, uint8_t value) { write(address, value); return 1; }
+  size_t readBytes(int address, void* data, size_t len);
+  size_t writeBytes(int address, const void* data, size_t len);
+
+  template <typename T>
+  T& get(int address, T& value) {
+    readBytes(address, &value, sizeof(T));
+    return value;
+  }
+
+  template <typename T>
+  const T& put(int address, const T& value) {
+    writeBytes(address, &value, sizeof(T));
+    return value;
+  }
+};
+
+extern EEPROMClass EEPROM;
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ═══════════════════════════════════════════════════════════
+// 🖥️ NATIVE HAL - WIFI (STATION MAC ONLY)
+// ═══════════════════════════════════════════════════════════
+
+typedef enum {
+  WIFI_OFF = 0,
+  WIFI_STA,
+  WIFI_AP,
+  WIFI_AP_STA
+} wifi_mode_t;
+
+class WiFiClass {
+public:
+  bool mode(wifi_mode_t mode) { (void)mode; return true; }
+  bool disconnect() { return true; }
+  uint8_t* macAddress(uint8_t* mac);   // The current node's MAC
+  String macAddress();
+  uint8_t channel() { return 1; }
+};
+
+extern WiFiClass WiFi;
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stdint.h>
+#include "esp_now.h"
+
+// ═══════════════════════════════════════════════════════════
+// 🖥️ NATIVE HAL - ESP TIMER
+// ═══════════════════════════════════════════════════════════
+// No timer task in the simulator: creating a timer fails, so code that
+// drives outputs from one (SignalPlayer) stays idle. The clock is the
+// node's virtual one.
+
+#define ESP_ERR_NOT_SUPPORTED 0x106
+
+typedef struct esp_timer* esp_timer_handle_t;
+typedef void (*esp_timer_cb_t)(void* arg);
+
+typedef enum {
+  ESP_TIMER_TASK = 0
+} esp_timer_dispatch_t;
+
+typedef struct {
+  esp_timer_cb_t callback;
+  void* arg;
+  esp_timer_dispatch_t dispatch_method;
+  const char* name;
+  bool skip_unhandled_events;
+} esp_timer_create_args_t;
+
+inline esp_err_t esp_timer_create(const esp_timer_create_args_t*, esp_timer_handle_t* handle) {
+  *handle = nullptr;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+inline esp_err_t esp_timer_start_once(esp_timer_handle_t, uint64_t) { return ESP_ERR_NOT_SUPPORTED; }
+inline esp_err_t esp_timer_stop(esp_timer_handle_t) { return ESP_ERR_NOT_SUPPORTED; }
+int64_t esp_timer_get_time();
@@ -0,0 +1,217 @@
+#include "native_hal.h"
+#include <Arduino.h>
+#include <esp_now.h>
+#include <WiFi.h>
+#include <EEPROM.h>
+#include <esp_timer.h>
+
+// ═══════════════════════════════════════════════════════════
+// 🖥️ NATIVE HAL IMPLEMENTATION
+// ═══════════════════════════════════════════════════════════
+
+HardwareSerial Serial;
+WiFiClass WiFi;
+EEPROMClass EEPROM;
+
+static HalNode* currentNode = nullptr;
+static uint64_t clockUs = 0;
+static HalRadioHook radioHook = nullptr;
+static uint64_t randomState = 0x9E3779B97F4A7C15ULL;
+
+static const uint8_t BROADCAST[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+void halInitNode(HalNode* node, const uint8_t* mac) {
+  memset(node, 0, sizeof(*node));
+  memcpy(node->mac, mac, 6);
+  memset(node->eeprom, 0xFF, sizeof(node->eeprom));   // Erased flash
+  node->bootUs = clockUs;
+}
+
+void halSetNode(HalNode* node) { currentNode = node; }
+HalNode* halGetNode() { return currentNode; }
+
+void halBootNode(HalNode* node) {
+  node->bootUs = clockUs;
+  node->recvCallback = nullptr;
+  node->sendCallback = nullptr;
+}
+
+void halSetTimeUs(uint64_t us) { clockUs = us; }
+uint64_t halGetTimeUs() { return clockUs; }
+
+void halSetRadio(HalRadioHook hook) { radioHook = hook; }
+
+void halRandomSeed(uint32_t seed) {
+  randomState = 0x9E3779B97F4A7C15ULL ^ ((uint64_t)seed << 1);
+  if (randomState == 0) randomState = 1;
+}
+
+// xorshift64*
+uint32_t halRandom() {
+  randomState ^= randomState >> 12;
+  randomState ^= randomState << 25;
+  randomState ^= randomState >> 27;
+  return (uint32_t)((randomState * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+// ═══════════════════════════════════════════════════════════
+// ⏱️ TIME AND RANDOM
+// ═══════════════════════════════════════════════════════════
+
+unsigned long micros() {
+  uint64_t boot = currentNode ? currentNode->bootUs : 0;
+  return (unsigned long)(uint32_t)(clockUs - boot);   // Wraps like the 32-bit original
+}
+
+unsigned long millis() {
+  uint64_t boot = currentNode ? currentNode->bootUs : 0;
+  return (unsigned long)(uint32_t)((clockUs - boot) / 1000);
+}
+
+int64_t esp_timer_get_time() {
+  uint64_t boot = currentNode ? currentNode->bootUs : 0;
+  return (int64_t)(clockUs - boot);
+}
+
+void delay(unsigned long ms) { clockUs += (uint64_t)ms * 1000; }
+
+long random(long maxValue) {
+  if (maxValue <= 0) return 0;
+  return halRandom() % (uint32_t)maxValue;
+}
+
+long random(long minValue, long maxValue) {
+  if (minValue >= maxValue) return minValue;
+  return minValue + random(maxValue - minValue);
+}
+
+void randomSeed(unsigned long seed) { halRandomSeed(seed); }
+
+// ═══════════════════════════════════════════════════════════
+// 🔤 STRING AND SERIAL
+// ═══════════════════════════════════════════════════════════
+
+String::String(double number, unsigned int decimals) {
+  char buffer[48];
+  snprintf(buffer, sizeof(buffer), "%.*f", (int)decimals, number);
+  value = buffer;
+}
+
+bool HardwareSerial::enabled() const {
+  return currentNode != nullptr && currentNode->serialEnabled;
+}
+
+size_t HardwareSerial::printf(const char* format, ...) {
+  if (!enabled()) return 0;
+  va_list args;
+  va_start(args, format);
+  int written = vfprintf(stderr, format, args);
+  va_end(args);
+  return written > 0 ? written : 0;
+}
+
+size_t HardwareSerial::print(const char* text) {
+  if (!enabled() || text == nullptr) return 0;
+  return fputs(text, stderr) >= 0 ? strlen(text) : 0;
+}
+
+size_t HardwareSerial::print(char c) {
+  if (!enabled()) return 0;
+  return fputc(c, stderr) == EOF ? 0 : 1;
+}
+
+size_t HardwareSerial::print(long number, int base) {
+  return base == HEX ? printf("%lX", number) : printf("%ld", number);
+}
+
+size_t HardwareSerial::print(unsigned long number, int base) {
+  return base == HEX ? printf("%lX", number) : printf("%lu", number);
+}
+
+size_t HardwareSerial::print(double number, int digits) {
+  return printf("%.*f", digits, number);
+}
+
+// ═══════════════════════════════════════════════════════════
+// 📶 WIFI AND ESP-NOW
+// ═══════════════════════════════════════════════════════════
+
+uint8_t* WiFiClass::macAddress(uint8_t* mac) {
+  if (currentNode != nullptr) memcpy(mac, currentNode->mac, 6);
+  else memset(mac, 0, 6);
+  return mac;
+}
+
+String WiFiClass::macAddress() {
+  uint8_t mac[6];
+  macAddress(mac);
+  char buffer[18];
+  snprintf(buffer, sizeof(buffer), "%02X:%02X:%02X:%02X:%02X:%02X",
+           mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+  return String(buffer);
+}
+
+esp_err_t esp_now_init() { return ESP_OK; }
+esp_err_t esp_now_deinit() { return ESP_OK; }
+
+esp_err_t esp_now_register_send_cb(esp_now_send_cb_t callback) {
+  if (currentNode == nullptr) return ESP_FAIL;
+  currentNode->sendCallback = (HalSendCallback)callback;
+  return ESP_OK;
+}
+
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t callback) {
+  if (currentNode == nullptr) return ESP_FAIL;
+  currentNode->recvCallback = callback;
+  return ESP_OK;
+}
+
+// Broadcast needs no peer table in the simulated radio
+esp_err_t esp_now_add_peer(const esp_now_peer_info_t* peer) { return peer ? ESP_OK : ESP_ERR_ESPNOW_ARG; }
+esp_err_t esp_now_del_peer(const uint8_t*) { return ESP_OK; }
+bool esp_now_is_peer_exist(const uint8_t*) { return true; }
+
+// The send callback runs straight away: MAC-level acks are not modelled
+esp_err_t esp_now_send(const uint8_t* mac, const uint8_t* data, size_t len) {
+  if (currentNode == nullptr || data == nullptr || len == 0 || len > ESP_NOW_MAX_DATA_LEN) {
+    return ESP_ERR_ESPNOW_ARG;
+  }
+  const uint8_t* dest = mac ? mac : BROADCAST;
+  bool queued = radioHook != nullptr && radioHook(currentNode, dest, data, len);
+  if (currentNode->sendCallback) {
+    currentNode->sendCallback(dest, queued ? ESP_NOW_SEND_SUCCESS : ESP_NOW_SEND_FAIL);
+  }
+  return queued ? ESP_OK : ESP_FAIL;
+}
+
+// ═══════════════════════════════════════════════════════════
+// 💾 EEPROM
+// ═══════════════════════════════════════════════════════════
+
+uint8_t EEPROMClass::read(int address) {
+  if (currentNode == nullptr || address < 0 || address >= HAL_EEPROM_SIZE) return 0xFF;
+  return currentNode->eeprom[address];
+}
+
+void EEPROMClass::write(int address, uint8_t value) {
+  if (currentNode == nullptr || address < 0 || address >= HAL_EEPROM_SIZE) return;
+  currentNode->eeprom[address] = value;
+}
+
+size_t EEPROMClass::readBytes(int address, void* data, size_t len) {
+  if (currentNode == nullptr || address < 0 || address + len > HAL_EEPROM_SIZE) return 0;
+  memcpy(data, currentNode->eeprom + address, len);
+  return len;
+}
+
+size_t EEPROMClass::writeBytes(int address, const void* data, size_t len) {
+  if (currentNode == nullptr || address < 0 || address + len > HAL_EEPROM_SIZE) return 0;
+  memcpy(currentNode->eeprom + address, data, len);
+  return len;
+}
+
+bool EEPROMClass::commit() {
+  if (currentNode == nullptr) return false;
+  currentNode->eepromCommits++;
+  return true;
+}
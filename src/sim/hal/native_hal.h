@@ -0,0 +1,57 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ═══════════════════════════════════════════════════════════
+// 🖥️ NATIVE HAL - SIMULATOR SIDE
+// ═══════════════════════════════════════════════════════════
+// The Arduino, ESP-NOW, WiFi and EEPROM stand-ins in this library act
+// on the "current node": the simulator points the HAL at a virtual
+// bot before running any of that bot's code, and every call made
+// until the next halSetNode() belongs to that bot:
+// - millis()/micros() read one shared virtual clock, minus the
+//   node's boot time, so a rebooted bot counts from zero again
+// - esp_now_send() hands the frame to the radio hook; delivery,
+//   latency and loss are the simulator's business
+// - EEPROM reads and writes the node's own image, which survives
+//   reboots like flash does
+// random() draws from one seeded generator, so a run is repeatable
+// for as long as the events are processed in the same order.
+
+#define HAL_EEPROM_SIZE 4096
+
+typedef void (*HalRecvCallback)(const uint8_t* mac, const uint8_t* data, int len);
+typedef void (*HalSendCallback)(const uint8_t* mac, int status);
+
+struct HalNode {
+  uint8_t mac[6];
+  uint64_t bootUs;                // Virtual time of the last boot
+  void* owner;                    // Simulator's per-bot state
+
+  // Flash
+  uint8_t eeprom[HAL_EEPROM_SIZE];
+  uint32_t eepromCommits;
+
+  // ESP-NOW callbacks registered by the bot's code
+  HalRecvCallback recvCallback;
+  HalSendCallback sendCallback;
+
+  bool serialEnabled;             // Serial output goes to stderr
+};
+
+// Returns false if the frame could not be queued (ESP_FAIL for the caller)
+typedef bool (*HalRadioHook)(HalNode* from, const uint8_t* destMac, const uint8_t* data, size_t len);
+
+void halInitNode(HalNode* node, const uint8_t* mac);
+void halSetNode(HalNode* node);
+HalNode* halGetNode();
+void halBootNode(HalNode* node);   // Clock restarts; EEPROM and MAC stay
+
+void halSetTimeUs(uint64_t us);
+uint64_t halGetTimeUs();
+
+void halSetRadio(HalRadioHook hook);
+
+void halRandomSeed(uint32_t seed);
+uint32_t halRandom();
@@ -0,0 +1,85 @@
+/*
+ * 🧪 Project Jumbo: Host-Side Swarm Simulator
+ * Runs the swarm coordination engines for up to 32 virtual bots
+ * (SIM_MAX_BOTS) on a virtual clock, far faster than real time.
+ *
+ * Build and run:
+ *   pio run -e native
+ *   .pio/build/native/program --bots 32 --duration 7200 --fail-leader-ms 60000
+ *
+ * Output is one JSON object per line on stdout (snapshots, optional
+ * events, and a final summary); bot Serial output goes to stderr with
+ * --serial. swarm_testing_framework.py --sim drives batches of runs.
+ */
+
+#include <chrono>
+#include "swarm_sim.h"
+
+static void printUsage(const char* program) {
+  fprintf(stderr,
+          "usage: %s [options]\n"
+          "  --bots N            virtual bots, 2-%d (default 12)\n"
+          "  --duration S        virtual seconds to run (default 3600)\n"
+          "  --seed N            same seed, same run (default 1)\n"
+          "  --loss P            frame loss per receiver, 0-1 (default 0.05)\n"
+          "  --latency-us N      one-hop latency (default 2000)\n"
+          "  --jitter-us N       extra latency, 0..N (default 3000)\n"
+          "  --evolution-ms N    evolution interval (default 45000)\n"
+          "  --proposal-ms N     leader opens a vote this often, 0 = never (default 5000)\n"
+          "  --fail-leader-ms N  power the leader off this often, 0 = never (default 0)\n"
+          "  --down-ms N         ...for this long (default 10000)\n"
+          "  --report-ms N       snapshot interval, 0 = summary only (default 60000)\n"
+          "  --solo              no gene sharing: every bot hill-climbs alone\n"
+          "  --events            print leader changes, decisions and reboots too\n"
+          "  --serial            bots' Serial output to stderr\n",
+          program, SIM_MAX_BOTS);
+}
+
+static bool parseArgs(int argc, char** argv, SimConfig& config) {
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    const char* value = hasValue ? argv[i + 1] : "";
+
+    if (strcmp(arg, "--solo") == 0) { config.islandMode = false; continue; }
+    if (strcmp(arg, "--events") == 0) { config.events = true; continue; }
+    if (strcmp(arg, "--serial") == 0) { config.serial = true; continue; }
+    if (!hasValue) return false;
+
+    if (strcmp(arg, "--bots") == 0) config.botCount = (uint8_t)strtoul(value, nullptr, 10);
+    else if (strcmp(arg, "--duration") == 0) config.durationS = strtoul(value, nullptr, 10);
+    else if (strcmp(arg, "--seed") == 0) config.seed = strtoul(value, nullptr, 10);
+    else if (strcmp(arg, "--loss") == 0) config.lossRate = strtof(value, nullptr);
+    else if (strcmp(arg, "--latency-us") == 0) config.latencyUs = strtoul(value, nullptr, 10);
+    else if (strcmp(arg, "--jitter-us") == 0) config.jitterUs = strtoul(value, nullptr, 10);
+    else if (strcmp(arg, "--evolution-ms") == 0) config.evolutionMs = strtoul(value, nullptr, 10);
+    else if (strcmp(arg, "--proposal-ms") == 0) config.proposalMs = strtoul(value, nullptr, 10);
+    else if (strcmp(arg, "--fail-leader-ms") == 0) config.failLeaderMs = strtoul(value, nullptr, 10);
+    else if (strcmp(arg, "--down-ms") == 0) config.downMs = strtoul(value, nullptr, 10);
+    else if (strcmp(arg, "--report-ms") == 0) config.reportMs = strtoul(value, nullptr, 10);
+    else return false;
+    i++;
+  }
+
+  return config.botCount >= 2 && config.botCount <= SIM_MAX_BOTS &&
+         config.lossRate >= 0.0f && config.lossRate <= 1.0f &&
+         config.evolutionMs > 0 && config.durationS > 0;
+}
+
+#ifndef PIO_UNIT_TESTING
+int main(int argc, char** argv) {
+  SimConfig config;
+  if (!parseArgs(argc, argv, config)) {
+    printUsage(argv[0]);
+    return 2;
+  }
+
+  auto started = std::chrono::steady_clock::now();
+  SwarmSimulator simulator(config);
+  simulator.run();
+  std::chrono::duration<double> wall = std::chrono::steady_clock::now() - started;
+
+  simulator.printSummary(wall.count());
+  return 0;
+}
+#endif
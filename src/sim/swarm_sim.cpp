@@ -0,0 +1,734 @@
+#include "swarm_sim.h"
+#include <esp_now.h>
+#include <EEPROM.h>
+
+// ═══════════════════════════════════════════════════════════
+// 🧪 SWARM SIMULATOR IMPLEMENTATION
+// ═══════════════════════════════════════════════════════════
+
+// Modelled on the SPEEDIE movement genes; the optimum is drawn per seed
+static const GeneBounds SIM_GENE_BOUNDS[SIM_GENE_COUNT] = {
+  {180, 255, 20},   // motorSpeed
+  {120, 220, 15},   // turnSpeed
+  {200, 800, 50},   // turnDelay (ms)
+  {150, 400, 30},   // backupDelay (ms)
+  {10, 40, 4},      // obstacleThreshold (cm)
+  {20, 80, 6},      // scanInterval (ms)
+  {50, 300, 30},    // escapeDelay (ms)
+  {50, 500, 50}     // gyroSensitivity x 100
+};
+
+static const int16_t SIM_DEFAULT_GENES[SIM_GENE_COUNT] = {240, 180, 400, 250, 20, 50, 150, 200};
+
+static const uint8_t SIM_BROADCAST[6] = BROADCAST_MAC;
+
+SwarmSimulator* SwarmSimulator::active = nullptr;
+
+// Order-independent per-(proposal, bot) preferences: a hash, not the RNG
+static uint32_t mix32(uint32_t x) {
+  x ^= x >> 16;
+  x *= 0x7FEB352D;
+  x ^= x >> 15;
+  x *= 0x846CA68B;
+  x ^= x >> 16;
+  return x;
+}
+
+static uint8_t bestChoiceFor(uint32_t seed, uint16_t proposalId) {
+  return mix32(proposalId ^ (seed * 0x9E3779B9)) % SIM_CONSENSUS_CHOICES;
+}
+
+SimBot::SimBot() : genePool(SIM_GENE_BOUNDS, SIM_GENE_COUNT, SIM_GENOME_LAYOUT) {
+  memset(&node, 0, sizeof(node));
+  signals = nullptr;
+  index = 0;
+  epoch = 0;
+  online = false;
+  memcpy(genes, SIM_DEFAULT_GENES, sizeof(genes));
+  memcpy(bestGenes, SIM_DEFAULT_GENES, sizeof(bestGenes));
+  bestFitness = -1.0f;
+  fitness = 0.0f;
+  generation = 0;
+  lastProposal = 0;
+  lastHeartbeat = 0;
+  lastSignal = 0;
+  leading = false;
+  rangeCm = 100;
+  moving = false;
+}
+
+SimBot::~SimBot() {
+  delete signals;
+}
+
+SwarmSimulator::SwarmSimulator(const SimConfig& simConfig) : config(simConfig) {
+  active = this;
+  hostNode = swarmNode;
+  nowUs = 0;
+  endUs = (uint64_t)config.durationS * 1000000ULL;
+  nextOrder = 0;
+  memset(&stats, 0, sizeof(stats));
+  stats.failoverMinMs = UINT32_MAX;
+  failoverPending = false;
+  failoverStartUs = 0;
+  memset(failedLeader, 0, sizeof(failedLeader));
+  memset(bots, 0, sizeof(bots));
+
+  halSetTimeUs(0);
+  halSetRadio(radio);
+  halRandomSeed(config.seed);
+
+  for (uint8_t g = 0; g < SIM_GENE_COUNT; g++) {
+    optimum[g] = random(SIM_GENE_BOUNDS[g].minValue, SIM_GENE_BOUNDS[g].maxValue + 1);
+  }
+
+  for (uint8_t i = 0; i < config.botCount; i++) {
+    uint8_t mac[6] = {0x5E, 0x1A, 0x00, 0x00, 0x00, (uint8_t)(i + 1)};   // Locally administered
+    bots[i] = new SimBot();
+    halInitNode(&bots[i]->node, mac);
+    bots[i]->node.owner = bots[i];
+    bots[i]->node.serialEnabled = config.serial;
+    bots[i]->index = i;
+    boot(i);
+  }
+
+  if (config.reportMs > 0) schedule((uint64_t)config.reportMs * 1000, SIM_EVENT_REPORT, 0);
+  if (config.failLeaderMs > 0) schedule((uint64_t)config.failLeaderMs * 1000, SIM_EVENT_POWER_OFF, 0);
+}
+
+SwarmSimulator::~SwarmSimulator() {
+  for (uint8_t i = 0; i < SIM_MAX_BOTS; i++) delete bots[i];
+  halSetNode(nullptr);
+  swarmNode = hostNode;
+  halSetRadio(nullptr);
+  if (active == this) active = nullptr;
+}
+
+void SwarmSimulator::schedule(uint64_t atUs, SimEventType type, uint8_t bot, int32_t frame) {
+  SimEvent event;
+  event.timeUs = atUs;
+  event.order = nextOrder++;
+  event.type = type;
+  event.bot = bot;
+  event.epoch = bots[bot] ? bots[bot]->epoch : 0;
+  event.frame = frame;
+  queue.push(event);
+}
+
+void SwarmSimulator::enter(SimBot* bot) {
+  halSetNode(&bot->node);
+  swarmNode = &bot->swarm;
+}
+
+SwarmLeaderElection& SwarmSimulator::electionOf(SimBot* bot) {
+  enter(bot);
+  return swarmIntelligence().leaderElection;
+}
+
+// ═══════════════════════════════════════════════════════════
+// ⏱️ EVENT LOOP
+// ═══════════════════════════════════════════════════════════
+
+void SwarmSimulator::run() {
+  while (!queue.empty()) {
+    SimEvent event = queue.top();
+    if (event.timeUs > endUs) break;
+    queue.pop();
+
+    // A bot that delay()ed is busy until its clock catches up
+    nowUs = max(event.timeUs, halGetTimeUs());
+    halSetTimeUs(nowUs);
+    stats.events++;
+    SimBot* bot = bots[event.bot];
+
+    switch (event.type) {
+      case SIM_EVENT_TICK:
+        if (!bot->online || event.epoch != bot->epoch) break;
+        tick(bot);
+        schedule(nowUs + SIM_TICK_MS * 1000, SIM_EVENT_TICK, event.bot);
+        if (failoverPending) checkFailover();
+        break;
+
+      case SIM_EVENT_DELIVER: {
+        SimFrame frame = frames[event.frame];
+        if (--frames[event.frame].pending == 0) freeFrames.push_back(event.frame);
+        if (!bot->online) {
+          stats.framesDropped++;
+          break;
+        }
+        stats.deliveries++;
+        enter(bot);
+        if (bot->node.recvCallback) {
+          bot->node.recvCallback(bots[frame.from]->node.mac, frame.data, frame.length);
+        }
+        break;
+      }
+
+      case SIM_EVENT_EVOLVE:
+        if (!bot->online || event.epoch != bot->epoch) break;
+        evolve(bot);
+        schedule(nowUs + (uint64_t)config.evolutionMs * 1000, SIM_EVENT_EVOLVE, event.bot);
+        break;
+
+      case SIM_EVENT_POWER_OFF:
+        powerOffLeader();
+        schedule(nowUs + (uint64_t)config.failLeaderMs * 1000, SIM_EVENT_POWER_OFF, 0);
+        break;
+
+      case SIM_EVENT_POWER_ON:
+        if (failoverPending && memcmp(bot->node.mac, failedLeader, 6) == 0) {
+          failoverPending = false;
+          stats.failoversMissed++;
+        }
+        reboot(event.bot);
+        break;
+
+      case SIM_EVENT_REPORT:
+        report();
+        schedule(nowUs + (uint64_t)config.reportMs * 1000, SIM_EVENT_REPORT, 0);
+        break;
+    }
+  }
+
+  nowUs = endUs;
+  halSetTimeUs(nowUs);
+}
+
+// ═══════════════════════════════════════════════════════════
+// 🤖 BOT BEHAVIOUR
+// ═══════════════════════════════════════════════════════════
+
+void SwarmSimulator::boot(uint8_t index) {
+  SimBot* bot = bots[index];
+  bot->epoch++;
+  bot->online = true;
+  enter(bot);
+
+  esp_now_init();
+  esp_now_register_recv_cb(onReceive);
+  initializeEcosystemManager(BOT_SPEEDIE, "SIM");
+  bot->signals = new EmergentSignalGenerator();
+
+  if (loadGenome(bot)) memcpy(bot->bestGenes, bot->genes, sizeof(bot->genes));
+
+  fillSelfReport(bot);
+  swarmIntelligence().swarmConsensus.setResolvedListener(onResolved);
+  bot->genePool.begin(bot->node.mac);
+
+  // Spread the bots' ticks and evolution cycles like free-running clocks would
+  uint64_t tickPhaseUs = (uint64_t)index * SIM_TICK_MS * 1000 / config.botCount;
+  uint64_t evolvePhaseUs = (uint64_t)random(0, config.evolutionMs / 10 + 1) * 1000;
+  schedule(nowUs + tickPhaseUs, SIM_EVENT_TICK, index);
+  schedule(nowUs + (uint64_t)config.evolutionMs * 1000 + evolvePhaseUs, SIM_EVENT_EVOLVE, index);
+}
+
+// Everything but the MAC and EEPROM starts over
+void SwarmSimulator::reboot(uint8_t index) {
+  SimBot* old = bots[index];
+  SimBot* fresh = new SimBot();
+  fresh->node = old->node;
+  fresh->node.owner = fresh;
+  fresh->index = index;
+  fresh->epoch = old->epoch;
+  delete old;
+
+  bots[index] = fresh;
+  halBootNode(&fresh->node);
+  boot(index);
+
+  if (config.events) {
+    printf("{\"event\":\"reboot\",\"t_ms\":%llu,\"bot\":%u,\"generation\":%u}\n",
+           (unsigned long long)(nowUs / 1000), index, fresh->generation);
+  }
+}
+
+void SwarmSimulator::tick(SimBot* bot) {
+  enter(bot);
+  unsigned long now = millis();
+
+  fillSelfReport(bot);
+  updateSwarmIntelligence();
+  noteLeadership(bot);
+
+  if (config.proposalMs > 0 && swarmIntelligence().isLeader && now - bot->lastProposal >= config.proposalMs) {
+    propose(bot);
+  }
+
+  if (config.islandMode && bot->genePool.isShareDue(now)) sendGenome(bot);
+
+  sense(bot);
+  if (now - bot->lastSignal >= SIM_SIGNAL_MS) signal(bot);
+  swarmNode->ecosystem->update();
+
+  // Stands in for the status records that keep peers active on hardware
+  if (now - bot->lastHeartbeat >= HEARTBEAT_INTERVAL) {
+    send(bot, MSG_HEARTBEAT, nullptr, 0);
+    bot->lastHeartbeat = now;
+  }
+}
+
+void SwarmSimulator::onReceive(const uint8_t* mac, const uint8_t* data, int len) {
+  HalNode* node = halGetNode();
+  if (active == nullptr || node == nullptr) return;
+  active->receive((SimBot*)node->owner, mac, data, len);
+}
+
+// The firmware's handleSwarmMessage(), for the messages simulated here
+void SwarmSimulator::receive(SimBot* bot, const uint8_t* senderMac, const uint8_t* data, int len) {
+  SwarmMessage message;
+  if (!decodeSwarmFrame(data, len, &message)) {
+    // Emergent signals go out bare, not as SwarmMessage frames
+    if (len == sizeof(EmergentMessage)) {
+      EmergentMessage signal;
+      memcpy(&signal, data, sizeof(signal));
+      bot->signals->processReceivedMessage(&signal);
+      stats.signalsHeard++;
+      return;
+    }
+    stats.badFrames++;
+    return;
+  }
+
+  SwarmPeerRegistry& registry = swarmNode->peerRegistry;
+  PeerId peer = registry.findOrAdd(senderMac);
+  if (peer == INVALID_PEER_ID) return;
+  registry.touch(peer);
+  unsigned long now = millis();
+
+  switch (message.header.messageType) {
+    case MSG_LEADER_ELECTION:
+      handleLeaderElection(senderMac, &message);
+      noteLeadership(bot);
+      break;
+
+    case MSG_CONSENSUS_VOTE:
+      handleConsensusVotes(senderMac, &message);
+      voteOnOpen(bot, *(const ConsensusBatchPayload*)message.payload.rawData, message.header.payloadLength);
+      break;
+
+    case MSG_GENOME_SHARE: {
+      // The closest thing to a status record the simulated bots send
+      const GenomePayload& share = message.payload.genome;
+      swarmNode->ecosystem->registerBot((uint8_t*)senderMac, BOT_SPEEDIE, "SIM");
+      swarmNode->ecosystem->updateBotStatus((uint8_t*)senderMac, share.generation, share.fitnessScore);
+      if (config.islandMode && bot->genePool.mergeShare(senderMac, share, now)) {
+        stats.migrantsMerged++;
+      }
+      break;
+    }
+
+    default:
+      break;
+  }
+}
+
+// SPEEDIE's evolutionCycle(): breed from the pool, else hill-climb alone
+void SwarmSimulator::evolve(SimBot* bot) {
+  enter(bot);
+  unsigned long now = millis();
+
+  bot->fitness = measureFitness(bot->genes);
+  stats.evaluations++;
+
+  int16_t child[GENOME_MAX_GENES];
+  if (config.islandMode) {
+    bot->genePool.recordEvaluation(bot->genes, bot->fitness, bot->generation, now);
+    if (bot->genePool.isShareDue(now)) sendGenome(bot);
+  }
+
+  if (config.islandMode && bot->genePool.breed(child, now)) {
+    memcpy(bot->genes, child, sizeof(bot->genes));
+  } else {
+    if (bot->fitness >= bot->bestFitness) {
+      bot->bestFitness = bot->fitness;
+      memcpy(bot->bestGenes, bot->genes, sizeof(bot->genes));
+    } else {
+      memcpy(bot->genes, bot->bestGenes, sizeof(bot->genes));
+    }
+    mutate(bot->genes);
+  }
+
+  bot->generation++;
+  saveGenome(bot);
+}
+
+// What SPEEDIE's updateSelfReport() does from its genome and peer table
+void SwarmSimulator::fillSelfReport(SimBot* bot) {
+  SwarmSelfReport& self = bot->swarm.self;
+  self.botType = BOT_SPEEDIE;
+  self.generation = bot->generation;
+  self.fitness = bot->fitness;
+  self.activePeers = expectedVoters(bot) - 1;
+}
+
+// Leadership changes hands inside the module; count the ones we took
+void SwarmSimulator::noteLeadership(SimBot* bot) {
+  SwarmIntelligenceState& intel = swarmIntelligence();
+  bool wasLeading = bot->leading;
+  bot->leading = intel.isLeader;
+  if (!bot->leading || wasLeading) return;
+  stats.leaderChanges++;
+
+  if (config.events) {
+    printf("{\"event\":\"leader\",\"t_ms\":%llu,\"bot\":%u,\"term\":%u}\n",
+           (unsigned long long)(nowUs / 1000), bot->index, intel.leaderElection.getTerm());
+  }
+}
+
+void SwarmSimulator::propose(SimBot* bot) {
+  unsigned long now = millis();
+  if (expectedVoters(bot) < MIN_CONSENSUS_PARTICIPANTS) return;
+
+  fillSelfReport(bot);
+  uint16_t proposalId = proposeDecision(DECIDE_EXPLORATION_AREA, CONSENSUS_SIMPLE_MAJORITY);
+  if (proposalId == 0) return;
+  bot->lastProposal = now;
+
+  SimDecision decision;
+  memset(&decision, 0, sizeof(decision));
+  decision.createdUs = nowUs;
+  decision.bestChoice = bestChoiceFor(config.seed, proposalId);
+  decision.winner = CONSENSUS_NO_CHOICE;
+  decisions[proposalId] = decision;
+  stats.proposals++;
+
+  castVote(proposalId, choiceFor(bot, proposalId), 1.0f);
+}
+
+// A proposal we just heard of gets our vote straight away
+void SwarmSimulator::voteOnOpen(SimBot* bot, const ConsensusBatchPayload& batch, size_t length) {
+  if (length < 1) return;
+  uint8_t count = min((size_t)batch.entryCount, (length - 1) / sizeof(ConsensusBatchEntry));
+  count = min(count, (uint8_t)MAX_CONSENSUS_PROPOSALS);
+
+  for (uint8_t i = 0; i < count; i++) {
+    uint16_t proposalId = batch.entries[i].proposalId;
+    const ConsensusProposal* proposal = swarmIntelligence().swarmConsensus.find(proposalId);
+    if (proposal == nullptr || proposal->isResolved || proposal->myChoice != CONSENSUS_NO_CHOICE) continue;
+    castVote(proposalId, choiceFor(bot, proposalId), 1.0f);
+  }
+}
+
+void SwarmSimulator::send(SimBot* bot, uint8_t type, const void* payload, size_t length) {
+  static SwarmMessage message;
+  enter(bot);
+
+  if (length > 0) memcpy(message.payload.rawData, payload, length);
+  message.header.messageType = type;
+  message.header.priority = PRIORITY_HIGH;
+  message.header.senderType = BOT_SPEEDIE;
+  message.header.sequenceNumber = 0;
+  message.header.timestamp = millis();
+  size_t frameLength = finalizeSwarmMessage(&message, length);
+
+  esp_now_send(SIM_BROADCAST, (const uint8_t*)&message, frameLength);
+}
+
+void SwarmSimulator::sendGenome(SimBot* bot) {
+  GenomePayload share;
+  if (bot->genePool.buildShare(share, millis())) send(bot, MSG_GENOME_SHARE, &share, sizeof(share));
+}
+
+// The bot wanders: mostly driving, stopping now and then, with the range
+// ahead drifting. Posted every tick, as the control task would.
+void SwarmSimulator::sense(SimBot* bot) {
+  if (random(0, 1000) < 5) bot->moving = !bot->moving;
+  bot->rangeCm = constrain(bot->rangeCm + (int)random(-8, 9), 5, 250);
+  postMovingState(bot->moving);
+  postDistanceReading(bot->rangeCm);
+}
+
+void SwarmSimulator::signal(SimBot* bot) {
+  bot->lastSignal = millis();
+  EnvironmentalContext context = getCurrentContext();
+  EmotionalState emotion = getCurrentEmotionalState();
+  int8_t slot = bot->signals->generateSignalForContext(context, emotion);
+  if (slot >= 0 && bot->signals->sendEmergentMessage(slot, context, emotion)) stats.signalsSent++;
+}
+
+void SwarmSimulator::saveGenome(SimBot* bot) {
+  SimGenomeRecord record;
+  record.magic = SIM_GENOME_MAGIC;
+  record.generation = bot->generation;
+  memcpy(record.genes, bot->genes, sizeof(record.genes));
+  EEPROM.put(0, record);
+  EEPROM.commit();
+}
+
+bool SwarmSimulator::loadGenome(SimBot* bot) {
+  SimGenomeRecord record;
+  EEPROM.get(0, record);
+  if (record.magic != SIM_GENOME_MAGIC) return false;
+
+  for (uint8_t g = 0; g < SIM_GENE_COUNT; g++) {
+    bot->genes[g] = constrain(record.genes[g], SIM_GENE_BOUNDS[g].minValue, SIM_GENE_BOUNDS[g].maxValue);
+  }
+  bot->generation = record.generation;
+  return true;
+}
+
+// Us plus the peers heard from lately, as activePeerCount + 1 on hardware.
+// The ecosystem registers us in our own registry; that entry is skipped.
+uint8_t SwarmSimulator::expectedVoters(SimBot* bot) {
+  const SwarmPeerRegistry& registry = bot->swarm.peerRegistry;
+  unsigned long now = millis();
+  uint8_t voters = 1;
+  for (PeerId id = 0; id < registry.getCapacity(); id++) {
+    if (!registry.isValid(id) || memcmp(registry.getMac(id), bot->node.mac, 6) == 0) continue;
+    if (now - registry.getLastSeen(id) < PEER_TIMEOUT) voters++;
+  }
+  return voters;
+}
+
+uint8_t SwarmSimulator::choiceFor(const SimBot* bot, uint16_t proposalId) const {
+  uint32_t h = mix32(((uint32_t)proposalId << 8) ^ (bot->index + 1) ^ (config.seed * 0x85EBCA6B));
+  if (h % 100 < SIM_VOTE_AGREEMENT) return bestChoiceFor(config.seed, proposalId);
+  return (h / 100) % SIM_CONSENSUS_CHOICES;
+}
+
+// ═══════════════════════════════════════════════════════════
+// 🌍 WORLD
+// ═══════════════════════════════════════════════════════════
+
+float SwarmSimulator::trueFitness(const int16_t* genes) const {
+  float error = 0.0f;
+  for (uint8_t g = 0; g < SIM_GENE_COUNT; g++) {
+    float d = (float)(genes[g] - optimum[g]) / (SIM_GENE_BOUNDS[g].maxValue - SIM_GENE_BOUNDS[g].minValue);
+    error += d * d;
+  }
+  return 1.0f / (1.0f + 4.0f * error);
+}
+
+float SwarmSimulator::measureFitness(const int16_t* genes) {
+  float noise = (random(0, 2001) - 1000) / 1000.0f * SIM_FITNESS_NOISE;
+  return constrain(trueFitness(genes) + noise, 0.0f, 1.0f);
+}
+
+// mutateGenome(): 1-3 genes, each by up to its mutation step
+void SwarmSimulator::mutate(int16_t* genes) {
+  int count = random(1, 4);
+  for (int i = 0; i < count; i++) {
+    uint8_t g = random(0, SIM_GENE_COUNT);
+    int step = SIM_GENE_BOUNDS[g].mutationStep;
+    genes[g] = constrain(genes[g] + random(-step, step + 1),
+                         (int)SIM_GENE_BOUNDS[g].minValue, (int)SIM_GENE_BOUNDS[g].maxValue);
+  }
+}
+
+void SwarmSimulator::powerOffLeader() {
+  uint8_t agreeing = 0;
+  int leader = leaderIndex(&agreeing);
+  if (leader < 0 || failoverPending) return;
+
+  SimBot* bot = bots[leader];
+  bot->online = false;
+  failoverPending = true;
+  failoverStartUs = nowUs;
+  memcpy(failedLeader, bot->node.mac, 6);
+  schedule(nowUs + (uint64_t)config.downMs * 1000, SIM_EVENT_POWER_ON, leader);
+
+  if (config.events) {
+    printf("{\"event\":\"power_off\",\"t_ms\":%llu,\"bot\":%d}\n", (unsigned long long)(nowUs / 1000), leader);
+  }
+}
+
+// Done once every bot that is up follows the same, new leader
+void SwarmSimulator::checkFailover() {
+  const uint8_t* agreed = nullptr;
+  for (uint8_t i = 0; i < config.botCount; i++) {
+    SimBot* bot = bots[i];
+    if (!bot->online) continue;
+    SwarmLeaderElection& election = electionOf(bot);
+    if (!election.hasLeader(millis())) return;
+    const uint8_t* leader = election.getLeader();
+    if (memcmp(leader, failedLeader, 6) == 0) return;
+    if (agreed != nullptr && memcmp(leader, agreed, 6) != 0) return;
+    agreed = leader;
+  }
+  if (agreed == nullptr) return;
+
+  uint32_t elapsedMs = (nowUs - failoverStartUs) / 1000;
+  failoverPending = false;
+  stats.failovers++;
+  stats.failoverTotalMs += elapsedMs;
+  stats.failoverMaxMs = max(stats.failoverMaxMs, elapsedMs);
+  stats.failoverMinMs = min(stats.failoverMinMs, elapsedMs);
+
+  if (config.events) {
+    printf("{\"event\":\"failover\",\"t_ms\":%llu,\"leader\":%d,\"ms\":%u}\n",
+           (unsigned long long)(nowUs / 1000), agreed[5] - 1, elapsedMs);
+  }
+}
+
+// The leader most bots that are up follow, -1 if nobody has one
+int SwarmSimulator::leaderIndex(uint8_t* agreeing) {
+  uint8_t votes[SIM_MAX_BOTS] = {0};
+  for (uint8_t i = 0; i < config.botCount; i++) {
+    SimBot* bot = bots[i];
+    if (!bot->online) continue;
+    SwarmLeaderElection& election = electionOf(bot);
+    if (!election.hasLeader(millis())) continue;
+    int leader = election.getLeader()[5] - 1;
+    if (leader >= 0 && leader < config.botCount) votes[leader]++;
+  }
+
+  int best = -1;
+  for (uint8_t i = 0; i < config.botCount; i++) {
+    if (votes[i] > 0 && (best < 0 || votes[i] > votes[best])) best = i;
+  }
+  *agreeing = best < 0 ? 0 : votes[best];
+  return best;
+}
+
+// ═══════════════════════════════════════════════════════════
+// 📡 RADIO AND LISTENERS
+// ═══════════════════════════════════════════════════════════
+
+// Every other bot that is up hears a broadcast, each with its own loss and latency
+bool SwarmSimulator::radio(HalNode* from, const uint8_t* destMac, const uint8_t* data, size_t len) {
+  SwarmSimulator* sim = active;
+  if (sim == nullptr) return false;
+  SimBot* sender = (SimBot*)from->owner;
+  bool broadcast = memcmp(destMac, SIM_BROADCAST, 6) == 0;
+
+  int32_t slot;
+  if (!sim->freeFrames.empty()) {
+    slot = sim->freeFrames.back();
+    sim->freeFrames.pop_back();
+  } else {
+    slot = sim->frames.size();
+    sim->frames.push_back(SimFrame());
+  }
+  SimFrame& frame = sim->frames[slot];
+  frame.from = sender->index;
+  frame.length = len;
+  frame.pending = 0;
+  memcpy(frame.data, data, len);
+  sim->stats.framesSent++;
+
+  uint32_t lossCutoff = (uint32_t)(sim->config.lossRate * 10000.0f);
+  for (uint8_t i = 0; i < sim->config.botCount; i++) {
+    SimBot* receiver = sim->bots[i];
+    if (receiver == sender || !receiver->online) continue;
+    if (!broadcast && memcmp(destMac, receiver->node.mac, 6) != 0) continue;
+
+    if (halRandom() % 10000 < lossCutoff) {
+      sim->stats.framesLost++;
+      continue;
+    }
+    uint64_t delayUs = sim->config.latencyUs + (sim->config.jitterUs ? halRandom() % (sim->config.jitterUs + 1) : 0);
+    sim->frames[slot].pending++;
+    sim->schedule(sim->nowUs + delayUs, SIM_EVENT_DELIVER, i, slot);
+  }
+
+  if (sim->frames[slot].pending == 0) sim->freeFrames.push_back(slot);
+  return true;
+}
+
+// Every bot resolves each proposal (the proposer on its tally, the rest by
+// adopting its outcome); they should all agree
+void SwarmSimulator::onResolved(const ConsensusProposal& proposal) {
+  if (active == nullptr) return;
+  auto it = active->decisions.find(proposal.proposalId);
+  if (it == active->decisions.end()) return;
+  SimDecision& decision = it->second;
+  SimStats& stats = active->stats;
+
+  if (decision.resolvers++ > 0) {
+    if (proposal.winningChoice != decision.winner) {
+      decision.disagreements++;
+      stats.disagreements++;
+    }
+    return;
+  }
+
+  decision.winner = proposal.winningChoice;
+  decision.firstResolvedUs = active->nowUs;
+  decision.early = proposal.resolvedTime < proposal.votingDeadline;
+  if (decision.winner == CONSENSUS_NO_CHOICE) {
+    stats.failedDecisions++;
+  } else {
+    stats.resolved++;
+    if (decision.early) stats.resolvedEarly++;
+    if (decision.winner == decision.bestChoice) stats.correctDecisions++;
+    stats.resolveTotalMs += (decision.firstResolvedUs - decision.createdUs) / 1000;
+  }
+
+  if (active->config.events) {
+    printf("{\"event\":\"decision\",\"t_ms\":%llu,\"proposal\":%u,\"winner\":%d,\"best\":%u,\"ms\":%llu,\"early\":%s}\n",
+           (unsigned long long)(active->nowUs / 1000), proposal.proposalId,
+           decision.winner == CONSENSUS_NO_CHOICE ? -1 : decision.winner, decision.bestChoice,
+           (unsigned long long)((decision.firstResolvedUs - decision.createdUs) / 1000),
+           decision.early ? "true" : "false");
+  }
+}
+
+// ═══════════════════════════════════════════════════════════
+// 📊 RESULTS (JSON LINES)
+// ═══════════════════════════════════════════════════════════
+
+void SwarmSimulator::report() {
+  uint8_t online = 0;
+  uint16_t maxGeneration = 0;
+  float best = 0.0f;
+  float total = 0.0f;
+  for (uint8_t i = 0; i < config.botCount; i++) {
+    if (!bots[i]->online) continue;
+    float f = trueFitness(bots[i]->genes);
+    best = max(best, f);
+    total += f;
+    maxGeneration = max(maxGeneration, bots[i]->generation);
+    online++;
+  }
+
+  uint8_t agreeing = 0;
+  int leader = leaderIndex(&agreeing);
+  unsigned term = leader >= 0 ? electionOf(bots[leader]).getTerm() : 0;
+
+  printf("{\"event\":\"snapshot\",\"t_s\":%llu,\"online\":%u,\"leader\":%d,\"following\":%u,\"term\":%u,"
+         "\"best_fitness\":%.4f,\"mean_fitness\":%.4f,\"generation\":%u,\"evaluations\":%llu,"
+         "\"proposals\":%u,\"resolved\":%u,\"failed\":%u,\"frames\":%llu,\"lost\":%llu}\n",
+         (unsigned long long)(nowUs / 1000000), online, leader, agreeing, term,
+         best, online ? total / online : 0.0f, maxGeneration, (unsigned long long)stats.evaluations,
+         stats.proposals, stats.resolved, stats.failedDecisions,
+         (unsigned long long)stats.framesSent, (unsigned long long)stats.framesLost);
+}
+
+void SwarmSimulator::printSummary(double wallSeconds) const {
+  float best = 0.0f;
+  float total = 0.0f;
+  uint32_t vocabulary = 0;
+  for (uint8_t i = 0; i < config.botCount; i++) {
+    float f = trueFitness(bots[i]->genes);
+    best = max(best, f);
+    total += f;
+    vocabulary += bots[i]->signals->getVocabularySize();
+  }
+  double virtualSeconds = nowUs / 1e6;
+
+  printf("{\"event\":\"summary\",\"bots\":%u,\"seed\":%u,\"mode\":\"%s\",\"loss\":%.3f,"
+         "\"virtual_s\":%.1f,\"wall_s\":%.3f,\"speedup\":%.0f,\"events\":%llu,"
+         "\"frames\":%llu,\"deliveries\":%llu,\"lost\":%llu,\"dropped\":%llu,\"bad_frames\":%llu,"
+         "\"evaluations\":%llu,\"migrants\":%llu,\"best_fitness\":%.4f,\"mean_fitness\":%.4f,"
+         "\"signals\":%llu,\"signals_heard\":%llu,\"vocabulary_mean\":%.1f,"
+         "\"leader_changes\":%u,\"failovers\":%u,\"failovers_missed\":%u,"
+         "\"failover_ms_mean\":%.1f,\"failover_ms_min\":%u,\"failover_ms_max\":%u,"
+         "\"proposals\":%u,\"resolved\":%u,\"resolved_early\":%u,\"failed\":%u,"
+         "\"correct\":%u,\"disagreements\":%u,\"resolve_ms_mean\":%.1f}\n",
+         config.botCount, config.seed, config.islandMode ? "island" : "solo", config.lossRate,
+         virtualSeconds, wallSeconds, wallSeconds > 0 ? virtualSeconds / wallSeconds : 0.0,
+         (unsigned long long)stats.events,
+         (unsigned long long)stats.framesSent, (unsigned long long)stats.deliveries,
+         (unsigned long long)stats.framesLost, (unsigned long long)stats.framesDropped,
+         (unsigned long long)stats.badFrames,
+         (unsigned long long)stats.evaluations, (unsigned long long)stats.migrantsMerged,
+         best, total / config.botCount,
+         (unsigned long long)stats.signalsSent, (unsigned long long)stats.signalsHeard,
+         (double)vocabulary / config.botCount,
+         stats.leaderChanges, stats.failovers, stats.failoversMissed,
+         stats.failovers ? (double)stats.failoverTotalMs / stats.failovers : 0.0,
+         stats.failovers ? stats.failoverMinMs : 0, stats.failoverMaxMs,
+         stats.proposals, stats.resolved, stats.resolvedEarly, stats.failedDecisions,
+         stats.correctDecisions, stats.disagreements,
+         stats.resolved ? (double)stats.resolveTotalMs / stats.resolved : 0.0);
+}
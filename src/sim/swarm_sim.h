@@ -0,0 +1,233 @@
+#pragma once
+
+#include <Arduino.h>
+#include <map>
+#include <queue>
+#include <vector>
+#include "native_hal.h"
+#include "swarm_espnow.h"
+#include "swarm_node.h"
+#include "swarm_ecosystem_manager.h"
+#include "emergent_signal.h"
+#include "swarm_intelligence.h"
+#include "swarm_evolution.h"
+
+// ═══════════════════════════════════════════════════════════
+// 🧪 SWARM SIMULATOR - DETERMINISTIC DISCRETE EVENTS
+// ═══════════════════════════════════════════════════════════
+// Runs up to SIM_MAX_BOTS virtual bots in one process, on a virtual
+// clock that jumps from event to event instead of waiting:
+// - Every bot owns a SwarmNode (peer registry, ecosystem, context
+//   detection, swarm intelligence) and a gene pool. Leader election and
+//   consensus run through swarm_intelligence.cpp: updateSwarmIntelligence()
+//   per tick, handleLeaderElection()/handleConsensusVotes() per frame
+// - Each bot wanders: its range and moving state feed context
+//   detection, and it broadcasts an emergent signal for its context
+//   now and then, which the others learn from
+// - Frames are real SwarmMessage frames through esp_now_send(); the
+//   radio delivers each broadcast to every other bot that is up,
+//   after latency + jitter, or loses it
+// - Fitness comes from a hidden optimum genome plus noise; the genes
+//   each bot runs are saved to its EEPROM and restored on reboot
+// - Leaders can be powered off on a schedule to measure failover
+// Events at the same instant run in the order they were scheduled and
+// all randomness comes from one seeded generator, so a seed always
+// replays the same run. Results are JSON lines on stdout.
+
+#define SIM_MAX_BOTS PEER_REGISTRY_CAPACITY  // 32: each bot's registry holds itself and every peer
+#define SIM_TICK_MS 50                  // Comms tick
+#define SIM_SIGNAL_MS 5000              // An emergent signal this often
+#define SIM_GENE_COUNT 8
+#define SIM_GENOME_LAYOUT 0x7E          // Keeps simulated genomes apart from real ones
+#define SIM_GENOME_MAGIC 0x53494D47     // "SIMG"
+#define SIM_CONSENSUS_CHOICES 4
+#define SIM_VOTE_AGREEMENT 70           // % of bots that back a proposal's best choice
+#define SIM_FITNESS_NOISE 0.05f         // ± measurement noise per evaluation
+
+struct SimConfig {
+  uint8_t botCount = 12;
+  uint32_t durationS = 3600;
+  uint32_t seed = 1;
+  float lossRate = 0.05f;               // Per receiver, per frame
+  uint32_t latencyUs = 2000;            // One hop
+  uint32_t jitterUs = 3000;             // Added uniformly, 0..jitterUs
+  uint32_t evolutionMs = 45000;
+  uint32_t proposalMs = 5000;           // The leader opens a vote this often (0 = never)
+  uint32_t failLeaderMs = 0;            // Power the leader off this often (0 = never)
+  uint32_t downMs = 10000;              // ...for this long, then reboot it
+  uint32_t reportMs = 60000;            // Snapshot lines (0 = summary only)
+  bool islandMode = true;               // false: every bot hill-climbs alone
+  bool events = false;                  // A line per leader change and decision too
+  bool serial = false;                  // Bots' Serial output to stderr
+};
+
+enum SimEventType : uint8_t {
+  SIM_EVENT_TICK = 0,
+  SIM_EVENT_DELIVER,
+  SIM_EVENT_EVOLVE,
+  SIM_EVENT_POWER_OFF,
+  SIM_EVENT_POWER_ON,
+  SIM_EVENT_REPORT
+};
+
+struct SimEvent {
+  uint64_t timeUs;
+  uint32_t order;                 // Scheduling order: breaks ties deterministically
+  SimEventType type;
+  uint8_t bot;
+  uint16_t epoch;                 // Bot's boot count when scheduled; stale after a reboot
+  int32_t frame;                  // DELIVER: index into the frame pool
+};
+
+struct SimEventLater {
+  bool operator()(const SimEvent& a, const SimEvent& b) const {
+    return a.timeUs != b.timeUs ? a.timeUs > b.timeUs : a.order > b.order;
+  }
+};
+
+struct SimFrame {
+  uint8_t from;
+  uint8_t length;
+  uint16_t pending;               // Deliveries still to run
+  uint8_t data[ESP_NOW_MAX_DATA_LEN];
+};
+
+// What a bot keeps in EEPROM
+struct SimGenomeRecord {
+  uint32_t magic;
+  uint16_t generation;
+  int16_t genes[SIM_GENE_COUNT];
+} __attribute__((packed));
+
+struct SimBot {
+  HalNode node;
+  uint8_t index;
+  uint16_t epoch;
+  bool online;
+
+  SwarmNode swarm;                // Registry, ecosystem, context, intelligence (swarm_node.h)
+  EmergentSignalGenerator* signals;
+  SwarmGenePool genePool;
+
+  int16_t genes[SIM_GENE_COUNT];
+  int16_t bestGenes[SIM_GENE_COUNT];    // Solo hill climb: best so far
+  float bestFitness;
+  float fitness;                  // Last measured
+  uint16_t generation;
+  unsigned long lastProposal;
+  unsigned long lastHeartbeat;
+  unsigned long lastSignal;
+  bool leading;                   // Last seen isLeader, to count leader changes
+
+  // World: what the bot's sensors would read
+  int rangeCm;
+  bool moving;
+
+  SimBot();
+  ~SimBot();
+};
+
+// One proposal, as seen by every bot that resolved it
+struct SimDecision {
+  uint64_t createdUs;
+  uint64_t firstResolvedUs;
+  uint8_t bestChoice;             // What most bots prefer
+  uint8_t winner;                 // First resolver's result
+  uint16_t resolvers;
+  uint16_t disagreements;         // Resolved to a different result than the first
+  bool early;
+};
+
+struct SimStats {
+  uint64_t events;
+  uint64_t framesSent;
+  uint64_t deliveries;
+  uint64_t framesLost;
+  uint64_t framesDropped;         // Receiver was down
+  uint64_t badFrames;
+  uint64_t evaluations;
+  uint64_t migrantsMerged;
+  uint64_t signalsSent;
+  uint64_t signalsHeard;
+  uint32_t leaderChanges;
+  uint32_t failovers;
+  uint64_t failoverTotalMs;
+  uint32_t failoverMaxMs;
+  uint32_t failoverMinMs;
+  uint32_t failoversMissed;       // The old leader came back before anyone took over
+  uint32_t proposals;
+  uint32_t resolved;
+  uint32_t resolvedEarly;
+  uint32_t failedDecisions;
+  uint32_t correctDecisions;
+  uint32_t disagreements;
+  uint64_t resolveTotalMs;
+};
+
+class SwarmSimulator {
+public:
+  explicit SwarmSimulator(const SimConfig& config);
+  ~SwarmSimulator();
+
+  void run();
+  void printSummary(double wallSeconds) const;
+
+  const SimStats& getStats() const { return stats; }
+
+private:
+  SimConfig config;
+  SimBot* bots[SIM_MAX_BOTS];
+  uint64_t nowUs;
+  uint64_t endUs;
+  uint32_t nextOrder;
+  std::priority_queue<SimEvent, std::vector<SimEvent>, SimEventLater> queue;
+  std::vector<SimFrame> frames;
+  std::vector<int32_t> freeFrames;
+  std::map<uint16_t, SimDecision> decisions;
+  int16_t optimum[SIM_GENE_COUNT];
+  SimStats stats;
+  SwarmNode* hostNode;            // swarmNode before the run, put back after
+
+  // Failover measurement: the leader that was powered off
+  bool failoverPending;
+  uint64_t failoverStartUs;
+  uint8_t failedLeader[6];
+
+  static SwarmSimulator* active;  // Engine listeners carry no context
+
+  void schedule(uint64_t atUs, SimEventType type, uint8_t bot, int32_t frame = -1);
+  void enter(SimBot* bot);
+  SwarmLeaderElection& electionOf(SimBot* bot);
+
+  // Bot behaviour, mirroring the firmware
+  void boot(uint8_t index);
+  void reboot(uint8_t index);
+  void tick(SimBot* bot);
+  void receive(SimBot* bot, const uint8_t* senderMac, const uint8_t* data, int len);
+  void evolve(SimBot* bot);
+  void fillSelfReport(SimBot* bot);
+  void noteLeadership(SimBot* bot);
+  void propose(SimBot* bot);
+  void voteOnOpen(SimBot* bot, const ConsensusBatchPayload& batch, size_t length);
+  void send(SimBot* bot, uint8_t type, const void* payload, size_t length);
+  void sendGenome(SimBot* bot);
+  void sense(SimBot* bot);
+  void signal(SimBot* bot);
+  void saveGenome(SimBot* bot);
+  bool loadGenome(SimBot* bot);
+  uint8_t expectedVoters(SimBot* bot);
+  uint8_t choiceFor(const SimBot* bot, uint16_t proposalId) const;
+
+  // World
+  float trueFitness(const int16_t* genes) const;
+  float measureFitness(const int16_t* genes);
+  void mutate(int16_t* genes);
+  void powerOffLeader();
+  void checkFailover();
+  int leaderIndex(uint8_t* agreeing);
+  void report();
+
+  static bool radio(HalNode* from, const uint8_t* destMac, const uint8_t* data, size_t len);
+  static void onReceive(const uint8_t* mac, const uint8_t* data, int len);
+  static void onResolved(const ConsensusProposal& proposal);
+};
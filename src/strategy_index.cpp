@@ -0,0 +1,119 @@
+#include "strategy_index.h"
+
+// ═══════════════════════════════════════════════════════════
+// 🧭 STRATEGY DISTANCE-BAND INDEX IMPLEMENTATION
+// ═══════════════════════════════════════════════════════════
+
+StrategyBandIndex::StrategyBandIndex() {
+  clear();
+}
+
+void StrategyBandIndex::clear() {
+  memset(distance, 0, sizeof(distance));
+  memset(tag, 0, sizeof(tag));
+  memset(score, 0, sizeof(score));
+  memset(band, STRATEGY_NO_ENTRY, sizeof(band));
+  memset(next, STRATEGY_NO_ENTRY, sizeof(next));
+  memset(head, STRATEGY_NO_ENTRY, sizeof(head));
+  memset(bandBest, STRATEGY_NO_ENTRY, sizeof(bandBest));
+  count = 0;
+}
+
+uint8_t StrategyBandIndex::bandOf(int distanceCm) {
+  if (distanceCm < 0) return 0;
+  int b = distanceCm / STRATEGY_BAND_CM;
+  return b >= STRATEGY_MAX_BANDS ? STRATEGY_MAX_BANDS - 1 : b;
+}
+
+void StrategyBandIndex::unlink(uint8_t i) {
+  uint8_t b = band[i];
+  uint8_t* link = &head[b];
+  while (*link != i) link = &next[*link];
+  *link = next[i];
+  next[i] = STRATEGY_NO_ENTRY;
+  band[i] = STRATEGY_NO_ENTRY;
+  count--;
+}
+
+// Ties go to the lower index, as a front-to-back scan would pick
+void StrategyBandIndex::rescanBand(uint8_t b) {
+  uint8_t bestEntry = STRATEGY_NO_ENTRY;
+  for (uint8_t e = head[b]; e != STRATEGY_NO_ENTRY; e = next[e]) {
+    if (bestEntry == STRATEGY_NO_ENTRY || score[e] > score[bestEntry] ||
+        (score[e] == score[bestEntry] && e < bestEntry)) {
+      bestEntry = e;
+    }
+  }
+  bandBest[b] = bestEntry;
+}
+
+void StrategyBandIndex::set(uint8_t i, int distanceCm, uint8_t entryTag, float entryScore) {
+  if (i >= STRATEGY_INDEX_CAPACITY) return;
+  uint8_t b = bandOf(distanceCm);
+
+  uint8_t oldBand = band[i];
+  bool wasBest = oldBand != STRATEGY_NO_ENTRY && bandBest[oldBand] == i;
+  float oldScore = score[i];
+  if (oldBand != b) {
+    if (oldBand != STRATEGY_NO_ENTRY) {
+      unlink(i);
+      if (wasBest) rescanBand(oldBand);
+    }
+    band[i] = b;
+    next[i] = head[b];
+    head[b] = i;
+    count++;
+    wasBest = false;
+  }
+
+  distance[i] = distanceCm;
+  tag[i] = entryTag;
+  score[i] = entryScore;
+
+  uint8_t current = bandBest[b];
+  if (wasBest && entryScore < oldScore) {
+    rescanBand(b);   // Our best got worse: someone else may lead now
+  } else if (current == STRATEGY_NO_ENTRY || entryScore > score[current] ||
+             (entryScore == score[current] && i < current)) {
+    bandBest[b] = i;
+  }
+}
+
+void StrategyBandIndex::remove(uint8_t i) {
+  if (i >= STRATEGY_INDEX_CAPACITY || band[i] == STRATEGY_NO_ENTRY) return;
+  uint8_t b = band[i];
+  unlink(i);
+  if (bandBest[b] == i) rescanBand(b);
+}
+
+int StrategyBandIndex::best(int distanceCm, uint8_t matchBands) const {
+  int center = bandOf(distanceCm);
+  int first = max(center - (int)matchBands, 0);
+  int last = min(center + (int)matchBands, STRATEGY_MAX_BANDS - 1);
+
+  int bestEntry = -1;
+  for (int b = first; b <= last; b++) {
+    uint8_t e = bandBest[b];
+    if (e == STRATEGY_NO_ENTRY) continue;
+    if (bestEntry < 0 || score[e] > score[bestEntry] ||
+        (score[e] == score[bestEntry] && e < bestEntry)) {
+      bestEntry = e;
+    }
+  }
+  return bestEntry;
+}
+
+int StrategyBandIndex::findSimilar(int distanceCm, int tolerance, uint8_t entryTag) const {
+  int first = bandOf(distanceCm - tolerance);
+  int last = bandOf(distanceCm + tolerance);
+
+  int found = -1;
+  for (int b = first; b <= last; b++) {
+    for (uint8_t e = head[b]; e != STRATEGY_NO_ENTRY; e = next[e]) {
+      if (tag[e] == entryTag && abs(distance[e] - distanceCm) < tolerance && (found < 0 || e < found)) {
+        found = e;
+      }
+    }
+  }
+  return found;
+}
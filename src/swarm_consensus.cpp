@@ -0,0 +1,335 @@
+#include "swarm_consensus.h"
+
+// ═══════════════════════════════════════════════════════════
+// 🗳️ SWARM CONSENSUS ENGINE IMPLEMENTATION
+// ═══════════════════════════════════════════════════════════
+
+SwarmConsensus::SwarmConsensus() {
+  memset(proposals, 0, sizeof(proposals));
+  idPrefix = 0;
+  nextSequence = 1;
+  selfVoter = CONSENSUS_NO_VOTER;
+  changed = false;
+  urgent = false;
+  lastBatch = 0;
+  resolvedListener = nullptr;
+  memset(&stats, 0, sizeof(stats));
+}
+
+void SwarmConsensus::begin(const uint8_t* selfMac, uint8_t voter) {
+  idPrefix = selfMac[5];
+  selfVoter = voter;
+}
+
+static bool deadlineReached(uint32_t deadline, unsigned long now) {
+  return (int32_t)(now - deadline) >= 0;
+}
+
+// The choice's part of all votes cast (or weight, for WEIGHTED_VOTE)
+static float shareOf(const ConsensusProposal& p, uint8_t choice) {
+  if (choice == CONSENSUS_NO_CHOICE) return 0.0f;
+  float total = 0.0f;
+  for (uint8_t i = 0; i < CONSENSUS_MAX_CHOICES; i++) total += p.score[i];
+  return total > 0 ? p.score[choice] / total : 0.0f;
+}
+
+const ConsensusProposal* SwarmConsensus::find(uint16_t proposalId) const {
+  for (uint8_t i = 0; i < MAX_CONSENSUS_PROPOSALS; i++) {
+    if (proposals[i].isActive && proposals[i].proposalId == proposalId) return &proposals[i];
+  }
+  return nullptr;
+}
+
+ConsensusProposal* SwarmConsensus::findMutable(uint16_t proposalId) {
+  return const_cast<ConsensusProposal*>(find(proposalId));
+}
+
+uint8_t SwarmConsensus::getOpenCount() const {
+  uint8_t open = 0;
+  for (uint8_t i = 0; i < MAX_CONSENSUS_PROPOSALS; i++) {
+    if (proposals[i].isActive && !proposals[i].isResolved) open++;
+  }
+  return open;
+}
+
+// Free slot, else the longest-resolved one; open proposals are never evicted
+ConsensusProposal* SwarmConsensus::allocate(uint16_t proposalId, DecisionTopic topic, ConsensusType type,
+                                            uint8_t expectedVoters, uint32_t deadline, unsigned long now) {
+  ConsensusProposal* slot = nullptr;
+  for (uint8_t i = 0; i < MAX_CONSENSUS_PROPOSALS; i++) {
+    ConsensusProposal& p = proposals[i];
+    if (!p.isActive) {
+      slot = &p;
+      break;
+    }
+    if (p.isResolved && (slot == nullptr || (int32_t)(p.resolvedTime - slot->resolvedTime) < 0)) slot = &p;
+  }
+  if (slot == nullptr) return nullptr;
+
+  memset(slot, 0, sizeof(*slot));
+  slot->proposalId = proposalId;
+  slot->topic = topic;
+  slot->consensusType = type;
+  slot->expertVoter = CONSENSUS_NO_VOTER;
+  slot->createdTime = now;
+  slot->votingDeadline = deadline;
+  slot->totalVoters = constrain(expectedVoters, 1, CONSENSUS_MAX_VOTERS);
+  slot->leader = CONSENSUS_NO_CHOICE;
+  slot->runnerUp = CONSENSUS_NO_CHOICE;
+  slot->winningChoice = CONSENSUS_NO_CHOICE;
+  slot->myChoice = CONSENSUS_NO_CHOICE;
+  slot->isActive = true;
+  return slot;
+}
+
+// ═══════════════════════════════════════════════════════════
+// 📝 PROPOSING & VOTING
+// ═══════════════════════════════════════════════════════════
+
+uint16_t SwarmConsensus::propose(DecisionTopic topic, ConsensusType type, uint8_t expectedVoters, unsigned long now) {
+  uint16_t id;
+  do {
+    id = ((uint16_t)idPrefix << 8) | nextSequence++;
+  } while (id == 0 || find(id) != nullptr);
+
+  uint32_t window = (topic == DECIDE_EMERGENCY_RESPONSE) ? EMERGENCY_VOTING_TIMEOUT : VOTING_TIMEOUT;
+  ConsensusProposal* p = allocate(id, topic, type, expectedVoters, now + window, now);
+  if (p == nullptr) return 0;
+
+  p->isMine = true;
+  p->expertVoter = selfVoter;
+  changed = true;
+  if (topic == DECIDE_EMERGENCY_RESPONSE) urgent = true;
+  stats.proposals++;
+  return id;
+}
+
+bool SwarmConsensus::castVote(uint16_t proposalId, uint8_t choice, float confidence, float fitness, unsigned long now) {
+  ConsensusProposal* p = findMutable(proposalId);
+  if (p == nullptr || p->isResolved || choice >= CONSENSUS_MAX_CHOICES) return false;
+  if (p->myChoice != CONSENSUS_NO_CHOICE) return false;   // One vote each, no changing it
+
+  float weight = constrain(confidence, 0.0f, 1.0f) * constrain(fitness, 0.0f, 1.0f);
+  p->myChoice = choice;
+  p->myConfidence = (uint8_t)(constrain(confidence, 0.0f, 1.0f) * 255);
+  p->myWeight = (uint8_t)(weight * 255);
+  changed = true;
+  if (p->topic == DECIDE_EMERGENCY_RESPONSE) urgent = true;
+
+  return tally(proposalId, selfVoter, choice, weight, now);
+}
+
+bool SwarmConsensus::tally(uint16_t proposalId, uint8_t voter, uint8_t choice, float weight, unsigned long now) {
+  ConsensusProposal* p = findMutable(proposalId);
+  if (p == nullptr || p->isResolved) return false;
+  if (voter >= CONSENSUS_MAX_VOTERS || choice >= CONSENSUS_MAX_CHOICES) return false;
+  uint64_t bit = 1ULL << voter;
+  if (p->voterMask & bit) return false;                    // Repeated batch
+
+  p->voterMask |= bit;
+  p->votesReceived++;
+  p->choiceMask |= 1 << choice;
+  p->score[choice] += (p->consensusType == CONSENSUS_WEIGHTED_VOTE) ? constrain(weight, 0.0f, 1.0f) : 1.0f;
+  stats.votesTallied++;
+
+  // Scores only grow, so leader/runner-up update in place
+  if (p->leader == CONSENSUS_NO_CHOICE) {
+    p->leader = choice;
+  } else if (choice != p->leader) {
+    if (p->score[choice] > p->score[p->leader]) {
+      p->runnerUp = p->leader;
+      p->leader = choice;
+    } else if (p->runnerUp == CONSENSUS_NO_CHOICE || p->score[choice] > p->score[p->runnerUp]) {
+      p->runnerUp = choice;
+    }
+  }
+
+  if (!p->isMine) return true;                              // The proposer's outcome decides
+  if (p->consensusType == CONSENSUS_EXPERT_DECISION && voter == p->expertVoter) {
+    resolve(*p, choice, shareOf(*p, choice), now, true);
+    return true;
+  }
+  evaluate(*p, now, false);
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════
+// ⚖️ RESOLUTION
+// ═══════════════════════════════════════════════════════════
+// With n voters, c votes cast and r = n - c still out, the leader holds
+// score s and nobody else more. Decided: the leader wins even if every
+// remaining vote goes elsewhere. Impossible: not even s + r would win.
+// Only the proposer evaluates while its outcome can still arrive.
+
+void SwarmConsensus::evaluate(ConsensusProposal& p, unsigned long now, bool deadlinePassed) {
+  if (p.isResolved) return;
+
+  if (deadlinePassed && p.votesReceived < MIN_CONSENSUS_PARTICIPANTS &&
+      p.consensusType != CONSENSUS_EXPERT_DECISION) {
+    resolve(p, CONSENSUS_NO_CHOICE, 0.0f, now, false);
+    return;
+  }
+
+  // At the deadline the electorate is whoever answered
+  float n = deadlinePassed ? p.votesReceived : max(p.totalVoters, p.votesReceived);
+  float r = n - p.votesReceived;
+  float s = (p.leader != CONSENSUS_NO_CHOICE) ? p.score[p.leader] : 0.0f;
+  uint8_t outcome = CONSENSUS_NO_CHOICE;
+  bool decided = false;
+
+  switch (p.consensusType) {
+    case CONSENSUS_SIMPLE_MAJORITY:
+      if (2 * s > n) { outcome = p.leader; decided = true; }
+      else if (2 * (s + r) <= n) decided = true;
+      break;
+
+    case CONSENSUS_SUPERMAJORITY:
+      if (3 * s > 2 * n) { outcome = p.leader; decided = true; }
+      else if (3 * (s + r) <= 2 * n) decided = true;
+      break;
+
+    case CONSENSUS_UNANIMOUS:
+      if (p.choiceMask & (p.choiceMask - 1)) decided = true;  // Two different choices
+      else if (r <= 0 && p.votesReceived > 0) { outcome = p.leader; decided = true; }
+      break;
+
+    case CONSENSUS_WEIGHTED_VOTE: {
+      // Each outstanding vote weighs at most 1.0
+      float second = (p.runnerUp != CONSENSUS_NO_CHOICE) ? p.score[p.runnerUp] : 0.0f;
+      if (s - second > r) { outcome = p.leader; decided = true; }
+      else if (r <= 0) decided = true;                        // Tie
+      break;
+    }
+
+    case CONSENSUS_EXPERT_DECISION:
+      // The expert's vote resolves it in tally(); without it there is nothing to decide
+      if (r <= 0 || deadlinePassed) decided = true;
+      break;
+  }
+
+  if (decided) resolve(p, outcome, shareOf(p, outcome), now, !deadlinePassed);
+}
+
+void SwarmConsensus::resolve(ConsensusProposal& p, uint8_t choice, float confidence, unsigned long now, bool early) {
+  p.isResolved = true;
+  p.resolvedTime = now;
+  p.winningChoice = choice;
+  p.winningConfidence = (choice != CONSENSUS_NO_CHOICE) ? confidence : 0.0f;
+
+  // Our outcome goes out with the next batch; everyone else waits on it
+  if (p.isMine) {
+    changed = true;
+    if (p.topic == DECIDE_EMERGENCY_RESPONSE) urgent = true;
+  }
+
+  if (choice == CONSENSUS_NO_CHOICE) stats.failed++;
+  else if (early) stats.resolvedEarly++;
+  else stats.resolvedAtDeadline++;
+
+  if (resolvedListener != nullptr) resolvedListener(p);
+}
+
+void SwarmConsensus::update(unsigned long now) {
+  for (uint8_t i = 0; i < MAX_CONSENSUS_PROPOSALS; i++) {
+    ConsensusProposal& p = proposals[i];
+    if (!p.isActive) continue;
+
+    if (!p.isResolved) {
+      uint32_t deadline = p.isMine ? p.votingDeadline : p.votingDeadline + CONSENSUS_OUTCOME_WAIT_MS;
+      if (deadlineReached(deadline, now)) evaluate(p, now, true);
+    } else if (now - p.resolvedTime >= CONSENSUS_RETAIN_MS) {
+      p.isActive = false;
+    }
+  }
+}
+
+// ═══════════════════════════════════════════════════════════
+// 📦 VOTE BATCHES
+// ═══════════════════════════════════════════════════════════
+
+// Open: our vote, or the announcement of our proposal. Resolved: our
+// outcome, until the slot is recycled
+static bool hasSomethingToSay(const ConsensusProposal& p) {
+  if (!p.isActive) return false;
+  if (p.isResolved) return p.isMine;
+  return p.isMine || p.myChoice != CONSENSUS_NO_CHOICE;
+}
+
+bool SwarmConsensus::isBatchDue(unsigned long now) const {
+  bool content = false;
+  for (uint8_t i = 0; i < MAX_CONSENSUS_PROPOSALS && !content; i++) {
+    content = hasSomethingToSay(proposals[i]);
+  }
+  if (!content) return false;
+  return changed || now - lastBatch >= CONSENSUS_REPEAT_INTERVAL;
+}
+
+size_t SwarmConsensus::buildBatch(ConsensusBatchPayload& batch, unsigned long now) {
+  batch.entryCount = 0;
+  for (uint8_t i = 0; i < MAX_CONSENSUS_PROPOSALS; i++) {
+    ConsensusProposal& p = proposals[i];
+    if (!hasSomethingToSay(p)) continue;
+
+    ConsensusBatchEntry& e = batch.entries[batch.entryCount++];
+    int32_t remaining = (int32_t)(p.votingDeadline - now);
+    e.proposalId = p.proposalId;
+    e.topic = p.topic;
+    e.consensusType = p.consensusType;
+    e.flags = p.isMine ? CONSENSUS_ENTRY_PROPOSER : 0;
+    e.totalVoters = p.totalVoters;
+    e.remainingMs = (uint16_t)constrain(remaining, 0, 65535);
+    if (p.isResolved) {
+      e.flags |= CONSENSUS_ENTRY_OUTCOME;
+      e.choice = p.winningChoice;
+      e.confidence = (uint8_t)(p.winningConfidence * 255);
+      e.weight = 0;
+    } else {
+      e.choice = p.myChoice;
+      e.confidence = p.myConfidence;
+      e.weight = p.myWeight;
+    }
+  }
+
+  changed = false;
+  urgent = false;
+  if (batch.entryCount == 0) return 0;
+  lastBatch = now;
+  stats.batchesSent++;
+  return 1 + batch.entryCount * sizeof(ConsensusBatchEntry);
+}
+
+void SwarmConsensus::mergeBatch(uint8_t senderVoter, const ConsensusBatchPayload& batch, size_t length, unsigned long now) {
+  if (length < 1) return;
+  uint8_t count = min((size_t)batch.entryCount, (length - 1) / sizeof(ConsensusBatchEntry));
+  count = min(count, (uint8_t)MAX_CONSENSUS_PROPOSALS);
+
+  for (uint8_t i = 0; i < count; i++) {
+    const ConsensusBatchEntry& e = batch.entries[i];
+    if (e.proposalId == 0 || e.consensusType < CONSENSUS_SIMPLE_MAJORITY ||
+        e.consensusType > CONSENSUS_EXPERT_DECISION) continue;
+    bool outcome = (e.flags & CONSENSUS_ENTRY_OUTCOME) != 0;
+    if (outcome && !(e.flags & CONSENSUS_ENTRY_PROPOSER)) continue;
+
+    ConsensusProposal* p = findMutable(e.proposalId);
+    if (p == nullptr) {
+      p = allocate(e.proposalId, (DecisionTopic)e.topic, (ConsensusType)e.consensusType,
+                   e.totalVoters, now + e.remainingMs, now);
+      if (p == nullptr) continue;
+      // Someone else's emergency: our vote should not wait for the next tick either
+      if (e.topic == DECIDE_EMERGENCY_RESPONSE && !outcome) urgent = true;
+    }
+
+    if (outcome) {
+      if (p->isMine || p->isResolved) continue;
+      if (e.choice != CONSENSUS_NO_CHOICE && e.choice >= CONSENSUS_MAX_CHOICES) continue;
+      stats.adopted++;
+      resolve(*p, e.choice, e.confidence / 255.0f, now, !deadlineReached(p->votingDeadline, now));
+      continue;
+    }
+    if ((e.flags & CONSENSUS_ENTRY_PROPOSER) && p->expertVoter == CONSENSUS_NO_VOTER) {
+      p->expertVoter = senderVoter;
+    }
+
+    if (e.choice != CONSENSUS_NO_CHOICE) tally(e.proposalId, senderVoter, e.choice, e.weight / 255.0f, now);
+  }
+}
@@ -0,0 +1,123 @@
+#include "swarm_coverage.h"
+
+// ═══════════════════════════════════════════════════════════
+// 🧭 SHARED COVERAGE MAP IMPLEMENTATION
+// ═══════════════════════════════════════════════════════════
+
+SwarmCoverageSync::SwarmCoverageSync(SwarmSpatialIndex& spatial) : index(spatial) {
+  memset(shared, 0, sizeof(shared));
+  pushTiles = 0;
+  wantTiles = 0;
+  lastShare = 0;
+  memset(&stats, 0, sizeof(stats));
+}
+
+CoverageTileSummary SwarmCoverageSync::summarize(uint8_t tile) const {
+  const uint32_t* rows = index.exploredRows() + tile * COVERAGE_TILE_ROWS;
+
+  uint8_t count = 0;
+  uint32_t fold = 0;
+  for (uint8_t i = 0; i < COVERAGE_TILE_ROWS; i++) {
+    count += __builtin_popcount(rows[i]);
+    fold ^= (rows[i] << (i * 7)) | (rows[i] >> ((32 - i * 7) & 31));  // Rotate so rows do not cancel
+  }
+  fold ^= fold >> 16;
+
+  CoverageTileSummary summary = { count, (uint16_t)fold };
+  return summary;
+}
+
+bool SwarmCoverageSync::hasDelta() const {
+  const uint32_t* rows = index.exploredRows();
+  for (uint8_t row = 0; row < SPATIAL_GRID_DIM; row++) {
+    if (rows[row] & ~shared[row]) return true;
+  }
+  return false;
+}
+
+bool SwarmCoverageSync::isShareDue(unsigned long now) const {
+  if (pushTiles || wantTiles) return now - lastShare >= COVERAGE_REPLY_SPACING;
+  if (now - lastShare < COVERAGE_SYNC_INTERVAL) return false;
+  return hasDelta() || now - lastShare >= COVERAGE_SUMMARY_INTERVAL;
+}
+
+// ═══════════════════════════════════════════════════════════
+// 📤 BUILDING SHARES
+// ═══════════════════════════════════════════════════════════
+
+size_t SwarmCoverageSync::buildShare(CoverageSharePayload& share, unsigned long now) {
+  const uint32_t* rows = index.exploredRows();
+
+  share.flags = (pushTiles != 0) ? COVERAGE_SHARE_REPLY : 0;
+  share.wantTiles = wantTiles;
+  uint16_t known = 0;
+  for (uint8_t tile = 0; tile < COVERAGE_TILES; tile++) {
+    share.tiles[tile] = summarize(tile);
+    known += share.tiles[tile].count;
+  }
+  if (known == 0 && wantTiles == 0) return 0;  // Nothing explored, nothing to ask for
+
+  // Delta rows, or whole rows for tiles a peer is behind on
+  share.rowCount = 0;
+  for (uint8_t row = 0; row < SPATIAL_GRID_DIM; row++) {
+    bool fullTile = (pushTiles >> (row / COVERAGE_TILE_ROWS)) & 1;
+    uint32_t bits = fullTile ? rows[row] : (rows[row] & ~shared[row]);
+    if (bits == 0) continue;
+
+    share.rows[share.rowCount].row = row;
+    share.rows[share.rowCount].bits = bits;
+    share.rowCount++;
+    shared[row] |= rows[row];
+  }
+
+  pushTiles = 0;
+  wantTiles = 0;
+  lastShare = now;
+  stats.sharesSent++;
+  stats.rowsSent += share.rowCount;
+  return COVERAGE_SHARE_HEADER_SIZE + share.rowCount * sizeof(CoverageRow);
+}
+
+// ═══════════════════════════════════════════════════════════
+// 📥 MERGING SHARES
+// ═══════════════════════════════════════════════════════════
+
+bool SwarmCoverageSync::mergeShare(const CoverageSharePayload& share, size_t length) {
+  if (length < COVERAGE_SHARE_HEADER_SIZE) return false;
+  uint8_t rowCount = min((size_t)share.rowCount, (length - COVERAGE_SHARE_HEADER_SIZE) / sizeof(CoverageRow));
+  stats.sharesReceived++;
+
+  for (uint8_t i = 0; i < rowCount; i++) {
+    uint8_t row = share.rows[i].row;
+    if (row >= SPATIAL_GRID_DIM) continue;
+    uint32_t news = index.mergeExploredRow(row, share.rows[i].bits);
+    stats.cellsLearned += __builtin_popcount(news);
+    // Whoever sent it has already told the neighbourhood
+    shared[row] |= share.rows[i].bits;
+  }
+
+  // Compare the sender's version vector with ours, after the merge
+  for (uint8_t tile = 0; tile < COVERAGE_TILES; tile++) {
+    CoverageTileSummary mine = summarize(tile);
+    const CoverageTileSummary& theirs = share.tiles[tile];
+    uint8_t bit = 1 << tile;
+
+    if ((share.wantTiles & bit) && mine.count > 0) pushTiles |= bit;
+    if (mine.count == theirs.count && mine.fingerprint == theirs.fingerprint) continue;
+
+    // Counts only grow: more bits than us means we are missing some; a
+    // different map of the same size means both of us are
+    if (mine.count < theirs.count) {
+      wantTiles |= bit;
+    } else if (mine.count > theirs.count) {
+      pushTiles |= bit;
+    } else {
+      wantTiles |= bit;
+      pushTiles |= bit;
+    }
+  }
+
+  // Replies do not ask for more: the next periodic share settles the rest
+  if (share.flags & COVERAGE_SHARE_REPLY) wantTiles = 0;
+  return pushTiles != 0 || wantTiles != 0;
+}
@@ -1,63 +1,88 @@
 #include "swarm_ecosystem_manager.h"
-#include <EEPROM.h>
 #include <WiFi.h>
 
 // ═══════════════════════════════════════════════════════════
 // 🌐 SWARM ECOSYSTEM MANAGER IMPLEMENTATION
 // ═══════════════════════════════════════════════════════════
 
-// Global ecosystem manager instance
-SwarmEcosystemManager* ecosystemManager = nullptr;
-
 SwarmEcosystemManager::SwarmEcosystemManager() {
+  // Profiles first: sizeof(BotProfile) keeps the matrix aligned
+  size_t profileBytes = MAX_BOT_PROFILES * sizeof(BotProfile);
+  uint8_t* pool = (uint8_t*)calloc(1, profileBytes + TRUST_MATRIX_CELLS * sizeof(BotRelationship));
+  botProfiles = (BotProfile*)pool;
+  trustMatrix = (pool != nullptr) ? (BotRelationship*)(pool + profileBytes) : nullptr;
   botCount = 0;
+  wheelieCount = 0;
+  speedieCount = 0;
+  selfId = INVALID_PEER_ID;
   relationshipCount = 0;
   verificationLogIndex = 0;
-  lastReputationUpdate = 0;
+  verificationLogCount = 0;
+  memset(verificationBuckets, VERIFICATION_NO_ENTRY, sizeof(verificationBuckets));
+  memset(verificationBloom, 0, sizeof(verificationBloom));
+  currentBloom = 0;
+  bloomRotatedAt = 0;
   lastEcosystemAnalysis = 0;
+  sweepCursor = 0;
+  analysisStart = INVALID_PEER_ID;
+}
+
+SwarmEcosystemManager::~SwarmEcosystemManager() {
+  free(botProfiles);
 }
 
 void SwarmEcosystemManager::initialize() {
   Serial.println("🌐 Initializing Swarm Ecosystem Manager...");
   
   // Clear all profiles and relationships
-  memset(botProfiles, 0, sizeof(botProfiles));
-  memset(relationships, 0, sizeof(relationships));
+  memset(botProfiles, 0, MAX_BOT_PROFILES * sizeof(BotProfile));
+  memset(trustMatrix, 0, TRUST_MATRIX_CELLS * sizeof(BotRelationship));
   memset(verificationLog, 0, sizeof(verificationLog));
+  memset(verificationBuckets, VERIFICATION_NO_ENTRY, sizeof(verificationBuckets));
+  memset(verificationBloom, 0, sizeof(verificationBloom));
+  verificationLogIndex = 0;
+  verificationLogCount = 0;
+  currentBloom = 0;
+  bloomRotatedAt = millis();
+  botCount = 0;
+  wheelieCount = 0;
+  speedieCount = 0;
+  relationshipCount = 0;
   
   // Initialize timing
-  lastReputationUpdate = millis();
   lastEcosystemAnalysis = millis();
+  sweepCursor = 0;
+  analysisStart = INVALID_PEER_ID;
   
   Serial.printf("🌐 Ecosystem Manager ready (Max %d bots, %d relationships)\n", 
-                MAX_BOT_PROFILES, MAX_RELATIONSHIPS);
+                MAX_BOT_PROFILES, TRUST_MATRIX_CELLS);
 }
 
 // ═══════════════════════════════════════════════════════════
 // 🤖 BOT PROFILE MANAGEMENT
 // ═══════════════════════════════════════════════════════════
 
-void SwarmEcosystemManager::registerBot(uint8_t* mac, BotType type, const char* name) {
-  // Check if bot already exists
-  BotProfile* existing = getBotProfile(mac);
-  if (existing != nullptr) {
-    Serial.printf("🔄 Bot %s already registered, updating...\n", name);
-    existing->lastSeenTimestamp = millis();
-    return;
+PeerId SwarmEcosystemManager::registerBot(uint8_t* mac, BotType type, const char* name) {
+  PeerId id = swarmNode->peerRegistry.findOrAdd(mac);
+  if (id == INVALID_PEER_ID) {
+    Serial.println("⚠️ Bot registry full - cannot register new bot");
+    return INVALID_PEER_ID;
   }
   
-  if (botCount >= MAX_BOT_PROFILES) {
-    Serial.println("⚠️ Bot registry full - cannot register new bot");
-    return;
+  BotProfile* profile = &botProfiles[id];
+  if (profile->isRegistered) {
+    profile->lastSeenTimestamp = millis();
+    return id;
   }
   
-  BotProfile* profile = &botProfiles[botCount];
+  memset(profile, 0, sizeof(BotProfile));
+  profile->isRegistered = true;
   
   // Initialize identity
   memcpy(profile->botMAC, mac, 6);
   strncpy(profile->botName, name, sizeof(profile->botName) - 1);
   profile->botType = type;
-  profile->serialNumber = botCount + 1000; // Simple serial numbering
+  profile->serialNumber = id + 1000; // Simple serial numbering
   profile->activationTimestamp = millis();
   
   // Initialize metrics to reasonable defaults
@@ -77,8 +102,9 @@ void SwarmEcosystemManager::registerBot(uint8_t* mac, BotType type, const char*
   profile->dataVerifiedBad = 0;
   
   // Initialize reputation
-  profile->reputationScore = 50.0f;       // Start neutral
+  profile->reputationScore = 50.0f;       // Start neutral until we have evidence
   profile->lastReputationUpdate = millis();
+  profile->hasLocalEvidence = false;
   
   // Initialize health
   profile->health = HEALTH_GOOD;          // Assume new bots are healthy
@@ -90,13 +116,16 @@ void SwarmEcosystemManager::registerBot(uint8_t* mac, BotType type, const char*
   // Initialize ecosystem tracking
   profile->lastSeenTimestamp = millis();
   profile->consecutiveFailures = 0;
+  profile->lastTimeoutCheck = millis();
   profile->needsInspection = false;
   profile->isBlacklisted = false;
   
   botCount++;
+  countType(type, 1);
   
-  Serial.printf("✅ Registered bot %s (MAC: %s, Type: %d)\n", 
-                name, WiFi.macAddress().c_str(), type);
+  Serial.printf("✅ Registered bot %s (MAC: %s, Type: %d, Id: %d)\n", 
+                name, macToString(mac).c_str(), type, id);
+  return id;
 }
 
 void SwarmEcosystemManager::updateBotStatus(uint8_t* mac, uint32_t generation, float fitness) {
@@ -106,7 +135,10 @@ void SwarmEcosystemManager::updateBotStatus(uint8_t* mac, uint32_t generation, f
   profile->generation = generation;
   profile->fitness = fitness;
   profile->lastSeenTimestamp = millis();
-  profile->consecutiveFailures = 0; // Reset failure count on successful communication
+  if (profile->consecutiveFailures > 0) {
+    profile->consecutiveFailures = 0; // Reset failure count on successful communication
+    refreshReputation(profile);
+  }
   
   // Update runtime estimation
   profile->totalRuntime = (millis() - profile->activationTimestamp) / 3600000; // Convert to hours
@@ -116,8 +148,10 @@ void SwarmEcosystemManager::updateBotHealth(uint8_t* mac, BotHealth health) {
   BotProfile* profile = getBotProfile(mac);
   if (profile == nullptr) return;
   
+  bool changed = (profile->health != health);
   profile->health = health;
   profile->lastSeenTimestamp = millis();
+  if (changed) refreshReputation(profile);
   
   // Flag for inspection if health is poor
   if (health <= HEALTH_FAILING) {
@@ -128,128 +162,188 @@ void SwarmEcosystemManager::updateBotHealth(uint8_t* mac, BotHealth health) {
 }
 
 BotProfile* SwarmEcosystemManager::getBotProfile(uint8_t* mac) {
-  for (uint8_t i = 0; i < botCount; i++) {
-    if (memcmp(botProfiles[i].botMAC, mac, 6) == 0) {
-      return &botProfiles[i];
-    }
-  }
-  return nullptr;
+  return getBotProfile(swarmNode->peerRegistry.find(mac));
+}
+
+BotProfile* SwarmEcosystemManager::getBotProfile(PeerId id) {
+  if (id < 0 || id >= MAX_BOT_PROFILES || !botProfiles[id].isRegistered) return nullptr;
+  return &botProfiles[id];
 }
 
 void SwarmEcosystemManager::deactivateBot(uint8_t* mac) {
-  BotProfile* profile = getBotProfile(mac);
+  PeerId id = swarmNode->peerRegistry.find(mac);
+  BotProfile* profile = getBotProfile(id);
   if (profile == nullptr) return;
   
   Serial.printf("📴 Deactivating bot %s\n", profile->botName);
+  forgetPeer(id);
+}
+
+void SwarmEcosystemManager::forgetPeer(PeerId id) {
+  if (id < 0 || id >= MAX_BOT_PROFILES) return;
   
-  // Mark all relationships with this bot as inactive
-  for (uint8_t i = 0; i < relationshipCount; i++) {
-    if (memcmp(relationships[i].botA_MAC, mac, 6) == 0 || 
-        memcmp(relationships[i].botB_MAC, mac, 6) == 0) {
-      relationships[i].isActive = false;
+  // Clear this bot's row/column of the trust matrix
+  for (PeerId other = 0; other < MAX_BOT_PROFILES; other++) {
+    BotRelationship* relationship = getRelationship(id, other);
+    if (relationship != nullptr && relationship->isActive) {
+      memset(relationship, 0, sizeof(BotRelationship));
+      relationshipCount--;
     }
   }
   
-  // Remove from bot registry by shifting array
-  for (uint8_t i = 0; i < botCount; i++) {
-    if (memcmp(botProfiles[i].botMAC, mac, 6) == 0) {
-      // Shift remaining profiles down
-      for (uint8_t j = i; j < botCount - 1; j++) {
-        botProfiles[j] = botProfiles[j + 1];
-      }
-      botCount--;
-      break;
-    }
+  if (botProfiles[id].isRegistered) {
+    countType(botProfiles[id].botType, -1);
+    memset(&botProfiles[id], 0, sizeof(BotProfile));
+    botCount--;
   }
+  if (id == selfId) selfId = INVALID_PEER_ID;
 }
 
 // ═══════════════════════════════════════════════════════════
 // 🤝 TRUST & RELATIONSHIP MANAGEMENT
 // ═══════════════════════════════════════════════════════════
 
+// Cell for the unordered pair {a, b}: row max(a, b), column min(a, b)
+int SwarmEcosystemManager::relationshipIndex(PeerId a, PeerId b) {
+  if (a < 0 || b < 0 || a >= MAX_BOT_PROFILES || b >= MAX_BOT_PROFILES || a == b) return -1;
+  if (a < b) {
+    PeerId swap = a;
+    a = b;
+    b = swap;
+  }
+  return (a * (a - 1)) / 2 + b;
+}
+
+BotRelationship* SwarmEcosystemManager::getRelationship(PeerId a, PeerId b) {
+  int index = relationshipIndex(a, b);
+  return (index < 0) ? nullptr : &trustMatrix[index];
+}
+
+void SwarmEcosystemManager::countType(BotType type, int delta) {
+  if (type == BOT_WHEELIE) wheelieCount += delta;
+  else if (type == BOT_SPEEDIE) speedieCount += delta;
+}
+
 void SwarmEcosystemManager::recordInteraction(uint8_t* botA, uint8_t* botB, 
                                             InteractionType type, InteractionResult result) {
-  // Find or create relationship
-  BotRelationship* relationship = nullptr;
-  
-  for (uint8_t i = 0; i < relationshipCount; i++) {
-    if ((memcmp(relationships[i].botA_MAC, botA, 6) == 0 && 
-         memcmp(relationships[i].botB_MAC, botB, 6) == 0) ||
-        (memcmp(relationships[i].botA_MAC, botB, 6) == 0 && 
-         memcmp(relationships[i].botB_MAC, botA, 6) == 0)) {
-      relationship = &relationships[i];
-      break;
-    }
-  }
+  BotRelationship* relationship = getRelationship(swarmNode->peerRegistry.findOrAdd(botA),
+                                                  swarmNode->peerRegistry.findOrAdd(botB));
+  if (relationship == nullptr) return; // Registry full, or a bot paired with itself
   
-  // Create new relationship if not found
-  if (relationship == nullptr && relationshipCount < MAX_RELATIONSHIPS) {
-    relationship = &relationships[relationshipCount];
-    memcpy(relationship->botA_MAC, botA, 6);
-    memcpy(relationship->botB_MAC, botB, 6);
-    relationship->trustScore = 0.5f; // Start neutral
-    relationship->interactionCount = 0;
-    relationship->successfulInteractions = 0;
-    relationship->failedInteractions = 0;
-    relationship->interactionIndex = 0;
+  unsigned long now = millis();
+  
+  // First interaction: start neutral (no evidence either way)
+  if (!relationship->isActive) {
+    memset(relationship, 0, sizeof(BotRelationship));
+    relationship->lastInteraction = now;
     relationship->isActive = true;
     relationshipCount++;
   }
   
-  if (relationship == nullptr) return; // Couldn't create relationship
-  
-  // Record the interaction
-  relationship->recentInteractions[relationship->interactionIndex] = type;
-  relationship->recentResults[relationship->interactionIndex] = result;
-  relationship->recentTimestamps[relationship->interactionIndex] = millis();
-  relationship->interactionIndex = (relationship->interactionIndex + 1) % 10;
-  
-  relationship->interactionCount++;
-  if (result == RESULT_SUCCESS || result == RESULT_PARTIAL) {
-    relationship->successfulInteractions++;
-  } else {
-    relationship->failedInteractions++;
-  }
+  // Bring the evidence up to date, then add this interaction's weight
+  unsigned long elapsed = now - relationship->lastInteraction;
+  float decay = exp2f(-(float)elapsed / TRUST_HALF_LIFE_MS);
+  relationship->successWeight *= decay;
+  relationship->failureWeight *= decay;
   
-  // Update trust score based on interaction result
-  float trustDelta = 0.0f;
   switch (result) {
     case RESULT_SUCCESS:
-      trustDelta = 0.05f;  // Small positive adjustment
+      relationship->successWeight += 1.0f;
       break;
     case RESULT_PARTIAL:
-      trustDelta = 0.01f;  // Tiny positive adjustment
+      relationship->successWeight += 0.5f;  // Some issues but overall okay
       break;
     case RESULT_FAILURE:
-      trustDelta = -0.03f; // Small negative adjustment
+      relationship->failureWeight += 1.0f;
       break;
     case RESULT_CONTRADICTED:
-      trustDelta = -0.1f;  // Large negative adjustment for bad data
+      relationship->failureWeight += 3.0f;  // Bad data weighs heaviest
       break;
   }
   
-  relationship->trustScore = constrain(relationship->trustScore + trustDelta, 0.0f, 1.0f);
-  relationship->lastInteraction = millis();
+  // Quantized history: seconds since the previous entry as a log2 bucket
+  uint8_t ageCode = 0;
+  for (unsigned long seconds = elapsed / 1000; seconds > 0 && ageCode < 7; seconds >>= 1) ageCode++;
+  relationship->history[relationship->historyHead] = TRUST_HISTORY_ENTRY(type, result, ageCode);
+  relationship->historyHead = (relationship->historyHead + 1) % TRUST_HISTORY_LENGTH;
+  if (relationship->historyCount < TRUST_HISTORY_LENGTH) relationship->historyCount++;
+  
+  if (relationship->interactionCount < UINT16_MAX) relationship->interactionCount++;
+  if (result == RESULT_SUCCESS || result == RESULT_PARTIAL) {
+    if (relationship->successfulInteractions < UINT16_MAX) relationship->successfulInteractions++;
+  } else {
+    if (relationship->failedInteractions < UINT16_MAX) relationship->failedInteractions++;
+  }
+  relationship->lastInteraction = now;
   
   Serial.printf("🤝 Recorded interaction between bots (Type: %d, Result: %d, New trust: %.3f)\n", 
-                type, result, relationship->trustScore);
+                type, result, trustOf(relationship, now));
+}
+
+float SwarmEcosystemManager::trustOf(const BotRelationship* relationship, unsigned long now) {
+  float decay = exp2f(-(float)(now - relationship->lastInteraction) / TRUST_HALF_LIFE_MS);
+  float success = relationship->successWeight * decay;
+  float failure = relationship->failureWeight * decay;
+  return (success + 1.0f) / (success + failure + 2.0f);
 }
 
 void SwarmEcosystemManager::recordDataVerification(uint8_t* sender, uint8_t* verifier, 
                                                  uint32_t dataHash, bool isCorrect, float confidence) {
-  // Add to verification log
-  DataVerificationEntry* entry = &verificationLog[verificationLogIndex];
+  unsigned long now = millis();
+  rotateVerificationBloom(now);
+  BotProfile* senderProfile = getBotProfile(sender);
+  
+  // Same verifier checking the same data again: collapse into one entry
+  DataVerificationEntry* entry = findVerification(sender, verifier, dataHash, now);
+  if (entry != nullptr) {
+    bool changed = entry->isVerification != isCorrect;
+    entry->isVerification = isCorrect;
+    entry->timestamp = now;
+    entry->dataConfidence = confidence;
+    bloomInsert(dataHash);        // Keep it visible for the refreshed window
+    if (!changed) return;
+    
+    // Verdict flipped: move the count rather than adding one
+    if (senderProfile != nullptr) {
+      if (isCorrect) {
+        if (senderProfile->dataVerifiedBad > 0) senderProfile->dataVerifiedBad--;
+        senderProfile->dataVerifiedGood++;
+      } else {
+        if (senderProfile->dataVerifiedGood > 0) senderProfile->dataVerifiedGood--;
+        senderProfile->dataVerifiedBad++;
+      }
+      updateDataAccuracy(sender);
+      refreshReputation(senderProfile);
+    }
+    recordInteraction(sender, verifier, INTERACTION_DATA_SHARE, isCorrect ? RESULT_SUCCESS : RESULT_CONTRADICTED);
+    return;
+  }
+  
+  // Add to verification log, evicting the oldest entry once full
+  uint8_t slot = verificationLogIndex;
+  if (verificationLogCount == VERIFICATION_LOG_SIZE) {
+    unlinkVerification(slot);
+  } else {
+    verificationLogCount++;
+  }
+  
+  entry = &verificationLog[slot];
   memcpy(entry->senderMAC, sender, 6);
   memcpy(entry->verifierMAC, verifier, 6);
   entry->dataHash = dataHash;
   entry->isVerification = isCorrect;
-  entry->timestamp = millis();
+  entry->timestamp = now;
   entry->dataConfidence = confidence;
   
-  verificationLogIndex = (verificationLogIndex + 1) % 100;
+  uint8_t bucket = verificationBucket(dataHash);
+  entry->nextInBucket = verificationBuckets[bucket];
+  verificationBuckets[bucket] = slot;
+  
+  bloomInsert(dataHash);
+  
+  verificationLogIndex = (verificationLogIndex + 1) % VERIFICATION_LOG_SIZE;
   
   // Update bot profile data accuracy
-  BotProfile* senderProfile = getBotProfile(sender);
   if (senderProfile != nullptr) {
     senderProfile->totalDataSent++;
     if (isCorrect) {
@@ -258,8 +352,9 @@ void SwarmEcosystemManager::recordDataVerification(uint8_t* sender, uint8_t* ver
       senderProfile->dataVerifiedBad++;
     }
     
-    // Recalculate data accuracy
+    // Recalculate data accuracy, and the reputation built on it
     updateDataAccuracy(sender);
+    refreshReputation(senderProfile);
   }
   
   // Record interaction between sender and verifier
@@ -267,16 +362,107 @@ void SwarmEcosystemManager::recordDataVerification(uint8_t* sender, uint8_t* ver
   recordInteraction(sender, verifier, INTERACTION_DATA_SHARE, result);
 }
 
-float SwarmEcosystemManager::getTrustScore(uint8_t* botA, uint8_t* botB) {
-  for (uint8_t i = 0; i < relationshipCount; i++) {
-    if ((memcmp(relationships[i].botA_MAC, botA, 6) == 0 && 
-         memcmp(relationships[i].botB_MAC, botB, 6) == 0) ||
-        (memcmp(relationships[i].botA_MAC, botB, 6) == 0 && 
-         memcmp(relationships[i].botB_MAC, botA, 6) == 0)) {
-      return relationships[i].trustScore;
+bool SwarmEcosystemManager::getVerificationSummary(uint8_t* sender, uint32_t dataHash, 
+                                                   VerificationSummary* summary) {
+  unsigned long now = millis();
+  rotateVerificationBloom(now);
+  if (!bloomMayContain(dataHash)) return false; // Common case: unseen data
+  
+  uint8_t verified = 0, contradicted = 0;
+  float confidence = 0.0f;
+  for (uint8_t slot = verificationBuckets[verificationBucket(dataHash)]; 
+       slot != VERIFICATION_NO_ENTRY; slot = verificationLog[slot].nextInBucket) {
+    DataVerificationEntry* entry = &verificationLog[slot];
+    if (entry->dataHash != dataHash || memcmp(entry->senderMAC, sender, 6) != 0) continue;
+    if (now - entry->timestamp > DATA_VERIFICATION_WINDOW) continue;
+    if (entry->isVerification) verified++; else contradicted++;
+    confidence += entry->dataConfidence;
+  }
+  
+  if (verified + contradicted == 0) return false; // Bloom false positive, or another sender
+  summary->verified = verified;
+  summary->contradicted = contradicted;
+  summary->confidence = confidence / (verified + contradicted);
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════
+// 🔎 VERIFICATION INDEX
+// ═══════════════════════════════════════════════════════════
+
+uint8_t SwarmEcosystemManager::verificationBucket(uint32_t dataHash) {
+  // Fibonacci hashing: "value * 100" style hashes have weak low bits
+  return (dataHash * 0x9E3779B1u) >> 26 & (VERIFICATION_HASH_BUCKETS - 1);
+}
+
+void SwarmEcosystemManager::rotateVerificationBloom(unsigned long now) {
+  // Each filter covers half the window; together they cover all of it
+  unsigned long elapsed = now - bloomRotatedAt;
+  if (elapsed < DATA_VERIFICATION_WINDOW / 2) return;
+  
+  if (elapsed >= DATA_VERIFICATION_WINDOW) {
+    memset(verificationBloom, 0, sizeof(verificationBloom));
+  } else {
+    currentBloom ^= 1;
+    memset(verificationBloom[currentBloom], 0, sizeof(verificationBloom[currentBloom]));
+  }
+  bloomRotatedAt = now;
+}
+
+void SwarmEcosystemManager::bloomInsert(uint32_t dataHash) {
+  uint32_t h = dataHash;
+  for (uint8_t i = 0; i < VERIFICATION_BLOOM_PROBES; i++) {
+    h = h * 0x9E3779B1u + 0x7F4A7C15u;
+    uint16_t bit = h >> 23 & (VERIFICATION_BLOOM_BITS - 1);
+    verificationBloom[currentBloom][bit >> 5] |= 1u << (bit & 31);
+  }
+}
+
+bool SwarmEcosystemManager::bloomMayContain(uint32_t dataHash) const {
+  uint32_t h = dataHash;
+  bool inCurrent = true, inPrevious = true;
+  for (uint8_t i = 0; i < VERIFICATION_BLOOM_PROBES; i++) {
+    h = h * 0x9E3779B1u + 0x7F4A7C15u;
+    uint16_t bit = h >> 23 & (VERIFICATION_BLOOM_BITS - 1);
+    uint32_t mask = 1u << (bit & 31);
+    inCurrent = inCurrent && (verificationBloom[currentBloom][bit >> 5] & mask);
+    inPrevious = inPrevious && (verificationBloom[currentBloom ^ 1][bit >> 5] & mask);
+  }
+  return inCurrent || inPrevious;
+}
+
+void SwarmEcosystemManager::unlinkVerification(uint8_t slot) {
+  uint8_t* link = &verificationBuckets[verificationBucket(verificationLog[slot].dataHash)];
+  while (*link != VERIFICATION_NO_ENTRY) {
+    if (*link == slot) {
+      *link = verificationLog[slot].nextInBucket;
+      return;
     }
+    link = &verificationLog[*link].nextInBucket;
   }
-  return 0.5f; // Default neutral trust for unknown relationships
+}
+
+DataVerificationEntry* SwarmEcosystemManager::findVerification(const uint8_t* sender, const uint8_t* verifier,
+                                                               uint32_t dataHash, unsigned long now) {
+  if (!bloomMayContain(dataHash)) return nullptr;
+  
+  for (uint8_t slot = verificationBuckets[verificationBucket(dataHash)]; 
+       slot != VERIFICATION_NO_ENTRY; slot = verificationLog[slot].nextInBucket) {
+    DataVerificationEntry* entry = &verificationLog[slot];
+    if (entry->dataHash == dataHash && now - entry->timestamp <= DATA_VERIFICATION_WINDOW &&
+        memcmp(entry->senderMAC, sender, 6) == 0 && memcmp(entry->verifierMAC, verifier, 6) == 0) {
+      return entry;
+    }
+  }
+  return nullptr;
+}
+
+float SwarmEcosystemManager::getTrustScore(uint8_t* botA, uint8_t* botB) {
+  BotRelationship* relationship = getRelationship(swarmNode->peerRegistry.find(botA), swarmNode->peerRegistry.find(botB));
+  if (relationship == nullptr || !relationship->isActive) {
+    return 0.5f; // Default neutral trust for unknown relationships
+  }
+  return trustOf(relationship, millis());
 }
 
 bool SwarmEcosystemManager::shouldTrustBot(uint8_t* mac, float minTrustThreshold) {
@@ -301,20 +487,26 @@ bool SwarmEcosystemManager::shouldTrustBot(uint8_t* mac, float minTrustThreshold
 // 📊 REPUTATION CALCULATION
 // ═══════════════════════════════════════════════════════════
 
+// Reputations are refreshed as their inputs change; a full pass is only
+// needed after editing profiles directly
 void SwarmEcosystemManager::updateAllReputations() {
   Serial.println("📊 Updating all bot reputations...");
   
-  for (uint8_t i = 0; i < botCount; i++) {
-    calculateReputation(botProfiles[i].botMAC);
+  for (PeerId id = 0; id < MAX_BOT_PROFILES; id++) {
+    if (botProfiles[id].isRegistered) refreshReputation(&botProfiles[id]);
   }
-  
-  lastReputationUpdate = millis();
 }
 
 float SwarmEcosystemManager::calculateReputation(uint8_t* mac) {
   BotProfile* profile = getBotProfile(mac);
   if (profile == nullptr) return 0.0f;
   
+  refreshReputation(profile);
+  return profile->reputationScore;
+}
+
+// O(1): called by every path that changes one of the inputs below
+void SwarmEcosystemManager::refreshReputation(BotProfile* profile) {
   // Reputation components (weighted)
   float dataAccuracyWeight = 0.3f;
   float missionSuccessWeight = 0.25f;
@@ -350,8 +542,7 @@ float SwarmEcosystemManager::calculateReputation(uint8_t* mac) {
   
   profile->reputationScore = constrain(reputation, 0.0f, 100.0f);
   profile->lastReputationUpdate = millis();
-  
-  return profile->reputationScore;
+  profile->hasLocalEvidence = true;
 }
 
 void SwarmEcosystemManager::updateDataAccuracy(uint8_t* mac) {
@@ -388,104 +579,94 @@ void SwarmEcosystemManager::performEcosystemAnalysis() {
 void SwarmEcosystemManager::identifyWeakBots() {
   Serial.println("🔍 Identifying weak bots...");
   
-  for (uint8_t i = 0; i < botCount; i++) {
-    BotProfile* profile = &botProfiles[i];
-    
-    bool isWeak = false;
-    String weaknessReasons = "";
-    
-    // Check reputation
-    if (profile->reputationScore < 30.0f) {
-      isWeak = true;
-      weaknessReasons += "Low reputation ";
-    }
-    
-    // Check data accuracy
-    if (profile->dataAccuracy < 0.6f) {
-      isWeak = true;
-      weaknessReasons += "Poor data accuracy ";
-    }
-    
-    // Check health
-    if (profile->health <= HEALTH_DEGRADED) {
-      isWeak = true;
-      weaknessReasons += "Health issues ";
-    }
-    
-    // Check consecutive failures
-    if (profile->consecutiveFailures > 5) {
-      isWeak = true;
-      weaknessReasons += "Communication failures ";
-    }
-    
-    if (isWeak) {
-      profile->needsInspection = true;
-      Serial.printf("⚠️ Weak bot identified: %s - %s\n", 
-                    profile->botName, weaknessReasons.c_str());
-    }
+  for (uint8_t i = 0; i < MAX_BOT_PROFILES; i++) {
+    if (botProfiles[i].isRegistered) checkWeakBot(&botProfiles[i]);
   }
 }
 
-void SwarmEcosystemManager::identifyCapabilityGaps() {
-  // Count bots by type
-  uint8_t scoutCount = 0;
-  uint8_t manipulatorCount = 0;
-  uint8_t heavyCount = 0;
-  uint8_t aerialCount = 0;
-  
-  for (uint8_t i = 0; i < botCount; i++) {
-    switch (botProfiles[i].botType) {
-      case BOT_SCOUT: scoutCount++; break;
-      case BOT_MANIPULATOR: manipulatorCount++; break;
-      case BOT_HEAVY: heavyCount++; break;
-      case BOT_AERIAL: aerialCount++; break;
-      default: break;
-    }
+bool SwarmEcosystemManager::checkWeakBot(BotProfile* profile) {
+  bool isWeak = false;
+  String weaknessReasons = "";
+  
+  // Check reputation
+  if (profile->reputationScore < 30.0f) {
+    isWeak = true;
+    weaknessReasons += "Low reputation ";
   }
   
-  Serial.printf("🔍 Bot type distribution: Scouts=%d, Manipulators=%d, Heavy=%d, Aerial=%d\n",
-                scoutCount, manipulatorCount, heavyCount, aerialCount);
+  // Check data accuracy
+  if (profile->dataAccuracy < 0.6f) {
+    isWeak = true;
+    weaknessReasons += "Poor data accuracy ";
+  }
   
-  // Identify gaps (basic logic)
-  if (scoutCount == 0) {
-    Serial.println("🚨 CRITICAL GAP: No scout bots available!");
+  // Check health
+  if (profile->health <= HEALTH_DEGRADED) {
+    isWeak = true;
+    weaknessReasons += "Health issues ";
   }
-  if (manipulatorCount == 0 && botCount > 2) {
-    Serial.println("⚠️ GAP: No manipulator bots for complex tasks");
+  
+  // Check consecutive failures
+  if (profile->consecutiveFailures > 5) {
+    isWeak = true;
+    weaknessReasons += "Communication failures ";
   }
-  if (heavyCount == 0 && botCount > 4) {
-    Serial.println("💡 SUGGESTION: Heavy bot would improve capability diversity");
+  
+  if (isWeak) {
+    profile->needsInspection = true;
+    Serial.printf("⚠️ Weak bot identified: %s - %s\n", 
+                  profile->botName, weaknessReasons.c_str());
+  }
+  return isWeak;
+}
+
+void SwarmEcosystemManager::identifyCapabilityGaps() {
+  // Type counts are kept by registerBot()/forgetPeer()
+  uint8_t otherCount = botCount - wheelieCount - speedieCount;
+  
+  Serial.printf("🔍 Bot type distribution: WHEELIE=%d, SPEEDIE=%d, Other=%d\n",
+                wheelieCount, speedieCount, otherCount);
+  
+  // Identify gaps (basic logic)
+  if (wheelieCount == 0) {
+    Serial.println("⚠️ GAP: No precision scout (WHEELIE) in the swarm");
+  }
+  if (speedieCount == 0) {
+    Serial.println("⚠️ GAP: No fast responder (SPEEDIE) in the swarm");
   }
 }
 
 void SwarmEcosystemManager::generateUpgradeRecommendations() {
   Serial.println("🔧 Generating upgrade recommendations...");
   
-  for (uint8_t i = 0; i < botCount; i++) {
-    BotProfile* profile = &botProfiles[i];
-    
-    // Check if bot needs upgrades
-    bool needsUpgrade = false;
-    
-    if (profile->health <= HEALTH_DEGRADED) {
-      Serial.printf("🔧 %s: Recommend hardware maintenance/replacement\n", profile->botName);
-      needsUpgrade = true;
-    }
-    
-    if (profile->dataAccuracy < 0.7f) {
-      Serial.printf("🔧 %s: Recommend sensor calibration/upgrade\n", profile->botName);
-      needsUpgrade = true;
-    }
-    
-    if (profile->fitness < 0.5f && profile->generation > 20) {
-      Serial.printf("🔧 %s: Recommend genome reset/fresh start\n", profile->botName);
-      needsUpgrade = true;
-    }
-    
-    profile->needsUpgrade = needsUpgrade;
+  for (uint8_t i = 0; i < MAX_BOT_PROFILES; i++) {
+    if (botProfiles[i].isRegistered) checkUpgradeNeeds(&botProfiles[i]);
   }
 }
 
+bool SwarmEcosystemManager::checkUpgradeNeeds(BotProfile* profile) {
+  // Check if bot needs upgrades
+  bool needsUpgrade = false;
+  
+  if (profile->health <= HEALTH_DEGRADED) {
+    Serial.printf("🔧 %s: Recommend hardware maintenance/replacement\n", profile->botName);
+    needsUpgrade = true;
+  }
+  
+  if (profile->dataAccuracy < 0.7f) {
+    Serial.printf("🔧 %s: Recommend sensor calibration/upgrade\n", profile->botName);
+    needsUpgrade = true;
+  }
+  
+  if (profile->fitness < 0.5f && profile->generation > 20) {
+    Serial.printf("🔧 %s: Recommend genome reset/fresh start\n", profile->botName);
+    needsUpgrade = true;
+  }
+  
+  profile->needsUpgrade = needsUpgrade;
+  return needsUpgrade;
+}
+
 // ═══════════════════════════════════════════════════════════
 // 📈 SWARM HEALTH MONITORING
 // ═══════════════════════════════════════════════════════════
@@ -494,8 +675,8 @@ float SwarmEcosystemManager::getOverallSwarmHealth() {
   if (botCount == 0) return 0.0f;
   
   float totalHealth = 0.0f;
-  for (uint8_t i = 0; i < botCount; i++) {
-    totalHealth += (float)botProfiles[i].health;
+  for (uint8_t i = 0; i < MAX_BOT_PROFILES; i++) {
+    if (botProfiles[i].isRegistered) totalHealth += (float)botProfiles[i].health;
   }
   
   return (totalHealth / (botCount * 5.0f)) * 100.0f; // Convert to percentage
@@ -503,8 +684,8 @@ float SwarmEcosystemManager::getOverallSwarmHealth() {
 
 uint8_t SwarmEcosystemManager::getHealthyBotCount() {
   uint8_t count = 0;
-  for (uint8_t i = 0; i < botCount; i++) {
-    if (botProfiles[i].health >= HEALTH_GOOD) {
+  for (uint8_t i = 0; i < MAX_BOT_PROFILES; i++) {
+    if (botProfiles[i].isRegistered && botProfiles[i].health >= HEALTH_GOOD) {
       count++;
     }
   }
@@ -513,8 +694,8 @@ uint8_t SwarmEcosystemManager::getHealthyBotCount() {
 
 uint8_t SwarmEcosystemManager::getDegradedBotCount() {
   uint8_t count = 0;
-  for (uint8_t i = 0; i < botCount; i++) {
-    if (botProfiles[i].health <= HEALTH_DEGRADED) {
+  for (uint8_t i = 0; i < MAX_BOT_PROFILES; i++) {
+    if (botProfiles[i].isRegistered && botProfiles[i].health <= HEALTH_DEGRADED) {
       count++;
     }
   }
@@ -525,6 +706,29 @@ uint8_t SwarmEcosystemManager::getDegradedBotCount() {
 // 🎯 TASK ASSIGNMENT INTELLIGENCE
 // ═══════════════════════════════════════════════════════════
 
+// Reputation, accuracy and success rate are kept current, so this is O(1)
+float SwarmEcosystemManager::getTaskSuitability(PeerId id) {
+  BotProfile* profile = getBotProfile(id);
+  if (profile == nullptr) return -1.0f;
+  
+  // Skip blacklisted or severely degraded bots
+  if (profile->isBlacklisted || profile->health <= HEALTH_FAILING) return -1.0f;
+  
+  // Calculate suitability score (0-100)
+  float score = profile->reputationScore * 0.4f +
+                profile->dataAccuracy * 30.0f +
+                profile->missionSuccessRate * 20.0f +
+                (float)profile->health * 2.0f;
+  
+  // Our own experience with this bot, when we have any
+  BotRelationship* relationship = getRelationship(selfId, id);
+  if (relationship != nullptr && relationship->isActive) {
+    score *= 0.5f + 0.5f * trustOf(relationship, millis());
+  }
+  
+  return score / 100.0f;
+}
+
 uint8_t* SwarmEcosystemManager::selectBestBotForTask(TaskType task, uint8_t* candidateMACs, uint8_t candidateCount) {
   if (candidateCount == 0) return nullptr;
   
@@ -533,17 +737,8 @@ uint8_t* SwarmEcosystemManager::selectBestBotForTask(TaskType task, uint8_t* can
   
   for (uint8_t i = 0; i < candidateCount; i++) {
     uint8_t* mac = &candidateMACs[i * 6];
-    BotProfile* profile = getBotProfile(mac);
-    if (profile == nullptr) continue;
-    
-    // Skip blacklisted or severely degraded bots
-    if (profile->isBlacklisted || profile->health <= HEALTH_FAILING) continue;
-    
-    // Calculate suitability score
-    float score = profile->reputationScore * 0.4f +
-                  profile->dataAccuracy * 30.0f +
-                  profile->missionSuccessRate * 20.0f +
-                  (float)profile->health * 2.0f;
+    float score = getTaskSuitability(swarmNode->peerRegistry.find(mac));
+    if (score < 0) continue;
     
     if (score > bestScore) {
       bestScore = score;
@@ -570,6 +765,7 @@ void SwarmEcosystemManager::blacklistBot(uint8_t* mac, const char* reason) {
   
   profile->isBlacklisted = true;
   profile->needsInspection = true;
+  refreshReputation(profile);
   
   Serial.printf("🚫 Bot %s BLACKLISTED: %s\n", profile->botName, reason);
 }
@@ -595,27 +791,50 @@ void SwarmEcosystemManager::rehabilitateBot(uint8_t* mac) {
 void SwarmEcosystemManager::update() {
   unsigned long now = millis();
   
-  // Update reputations every 10 minutes
-  if (now - lastReputationUpdate > REPUTATION_UPDATE_INTERVAL) {
-    updateAllReputations();
+  // Hourly analysis rides on the sweep: one profile at a time
+  if (analysisStart == INVALID_PEER_ID && now - lastEcosystemAnalysis > ECOSYSTEM_ANALYSIS_INTERVAL) {
+    Serial.println("🔍 Performing ecosystem analysis...");
+    analysisStart = sweepCursor;
+    lastEcosystemAnalysis = now;
   }
   
-  // Perform ecosystem analysis every hour
-  if (now - lastEcosystemAnalysis > ECOSYSTEM_ANALYSIS_INTERVAL) {
-    performEcosystemAnalysis();
+  uint32_t start = micros();
+  for (uint8_t step = 0; step < ECOSYSTEM_SWEEP_STEPS; step++) {
+    PeerId id = sweepCursor;
+    sweepCursor = (sweepCursor + 1) % MAX_BOT_PROFILES;
+    if (botProfiles[id].isRegistered) sweepProfile(id, now);
+    
+    if (analysisStart != INVALID_PEER_ID && sweepCursor == analysisStart) {
+      identifyCapabilityGaps(); // Pass complete; O(1) from the type counts
+      analysisStart = INVALID_PEER_ID;
+    }
+    if (micros() - start >= ECOSYSTEM_UPDATE_BUDGET_US) break;
   }
+}
+
+void SwarmEcosystemManager::sweepProfile(PeerId id, unsigned long now) {
+  BotProfile* profile = &botProfiles[id];
   
-  // Check for timeout bots
-  for (uint8_t i = 0; i < botCount; i++) {
-    if (now - botProfiles[i].lastSeenTimestamp > 30000) { // 30 second timeout
-      botProfiles[i].consecutiveFailures++;
+  if (id == selfId) {
+    profile->lastSeenTimestamp = now; // We never time ourselves out
+  } else if (now - profile->lastTimeoutCheck >= BOT_TIMEOUT_MS) {
+    // One check-in window per BOT_TIMEOUT_MS
+    profile->lastTimeoutCheck = now;
+    if (now - profile->lastSeenTimestamp > BOT_TIMEOUT_MS) {
+      profile->consecutiveFailures++;
       
-      if (botProfiles[i].consecutiveFailures > 10) {
-        Serial.printf("📴 Bot %s appears offline (timeout)\n", botProfiles[i].botName);
-        botProfiles[i].availabilityScore *= 0.9f; // Reduce availability score
+      if (profile->consecutiveFailures > 10) {
+        Serial.printf("📴 Bot %s appears offline (timeout)\n", profile->botName);
+        profile->availabilityScore *= 0.9f; // Reduce availability score
       }
+      refreshReputation(profile);
     }
   }
+  
+  if (analysisStart != INVALID_PEER_ID) {
+    checkWeakBot(profile);
+    checkUpgradeNeeds(profile);
+  }
 }
 
 // ═══════════════════════════════════════════════════════════
@@ -628,14 +847,15 @@ void SwarmEcosystemManager::printSwarmReport() {
   Serial.println("╚════════════════════════════════════════╝");
   
   Serial.printf("📊 Total Bots: %d/%d\n", botCount, MAX_BOT_PROFILES);
-  Serial.printf("🔗 Active Relationships: %d/%d\n", relationshipCount, MAX_RELATIONSHIPS);
+  Serial.printf("🔗 Active Relationships: %d/%d\n", relationshipCount, TRUST_MATRIX_CELLS);
   Serial.printf("💚 Overall Swarm Health: %.1f%%\n", getOverallSwarmHealth());
   Serial.printf("✅ Healthy Bots: %d\n", getHealthyBotCount());
   Serial.printf("⚠️ Degraded Bots: %d\n", getDegradedBotCount());
   
   Serial.println("\n🤖 Bot Profiles:");
-  for (uint8_t i = 0; i < botCount; i++) {
+  for (uint8_t i = 0; i < MAX_BOT_PROFILES; i++) {
     BotProfile* bot = &botProfiles[i];
+    if (!bot->isRegistered) continue;
     Serial.printf("  %s: Rep=%.1f, Health=%d, Trust=%.3f%s%s\n",
                   bot->botName, bot->reputationScore, bot->health, bot->dataAccuracy,
                   bot->needsInspection ? " [INSPECT]" : "",
@@ -666,14 +886,30 @@ void SwarmEcosystemManager::printBotProfile(uint8_t* mac) {
 }
 
 void SwarmEcosystemManager::printTrustNetwork() {
+  static const char resultCodes[] = "SPFC"; // InteractionResult
+  unsigned long now = millis();
+  
   Serial.println("\n🤝 Trust Network:");
-  for (uint8_t i = 0; i < relationshipCount; i++) {
-    BotRelationship* rel = &relationships[i];
-    if (!rel->isActive) continue;
-    
-    Serial.printf("  Trust=%.3f, Interactions=%lu (%lu success, %lu failed)\n",
-                  rel->trustScore, rel->interactionCount, 
-                  rel->successfulInteractions, rel->failedInteractions);
+  for (PeerId a = 1; a < MAX_BOT_PROFILES; a++) {
+    for (PeerId b = 0; b < a; b++) {
+      BotRelationship* rel = getRelationship(a, b);
+      if (!rel->isActive) continue;
+      
+      Serial.printf("  %d<->%d: Trust=%.3f, Interactions=%lu (%lu success, %lu failed)\n",
+                    b, a, trustOf(rel, now), (unsigned long)rel->interactionCount, 
+                    (unsigned long)rel->successfulInteractions, (unsigned long)rel->failedInteractions);
+      
+      // Oldest first, e.g. "0S 3F<8s": type, result, gap before it
+      Serial.print("    Recent:");
+      for (uint8_t i = 0; i < rel->historyCount; i++) {
+        uint8_t slot = (rel->historyHead + TRUST_HISTORY_LENGTH - rel->historyCount + i) % TRUST_HISTORY_LENGTH;
+        uint8_t entry = rel->history[slot];
+        uint8_t ageCode = entry >> 5;
+        Serial.printf(" %u%c", (unsigned)(entry & 0x07), resultCodes[(entry >> 3) & 0x03]);
+        if (ageCode > 0) Serial.printf("<%us", 1u << ageCode);
+      }
+      Serial.println();
+    }
   }
 }
 
@@ -681,48 +917,70 @@ void SwarmEcosystemManager::printTrustNetwork() {
 // 🔧 INTEGRATION HELPER FUNCTIONS
 // ═══════════════════════════════════════════════════════════
 
-void initializeEcosystemManager() {
-  if (ecosystemManager == nullptr) {
-    ecosystemManager = new SwarmEcosystemManager();
-    ecosystemManager->initialize();
+// Registry reclaimed an id: its profile and trust row belong to someone else now
+static void releaseEcosystemPeer(PeerId id) {
+  if (swarmNode->ecosystem != nullptr) swarmNode->ecosystem->forgetPeer(id);
+}
+
+void initializeEcosystemManager(BotType selfType, const char* selfName) {
+  SwarmNode* node = swarmNode;
+  if (node->ecosystem == nullptr) {
+    SwarmEcosystemManager* ecosystem = new SwarmEcosystemManager();
+    if (!ecosystem->hasStorage()) {
+      Serial.println("❌ Ecosystem manager: out of memory");
+      delete ecosystem;
+      return;
+    }
+    node->ecosystem = ecosystem;
+    node->ecosystem->initialize();
+    node->peerRegistry.addReleaseListener(releaseEcosystemPeer);
     
     // Register self
     uint8_t myMac[6];
     WiFi.macAddress(myMac);
-    ecosystemManager->registerBot(myMac, BOT_SCOUT, "SPEEDIE"); // Adjust as needed
+    node->ecosystem->setSelf(node->ecosystem->registerBot(myMac, selfType, selfName));
   }
 }
 
 void handleEcosystemMessage(const uint8_t* senderMac, SwarmMessage* message) {
-  if (ecosystemManager == nullptr) return;
+  if (swarmNode->ecosystem == nullptr) return;
   
   // Handle ecosystem-specific message types here
   // This would be integrated with your existing handleSwarmMessage function
 }
 
 bool verifyDataWithEcosystem(uint8_t* senderMac, uint32_t dataHash, float* trustMultiplier) {
-  if (ecosystemManager == nullptr) {
+  SwarmEcosystemManager* ecosystem = swarmNode->ecosystem;
+  if (ecosystem == nullptr) {
     *trustMultiplier = 1.0f;
     return true;
   }
   
-  BotProfile* profile = ecosystemManager->getBotProfile(senderMac);
+  BotProfile* profile = ecosystem->getBotProfile(senderMac);
   if (profile == nullptr) {
     *trustMultiplier = 0.5f; // Unknown bot - moderate trust
     return true;
   }
   
-  // Apply trust multiplier based on reputation
-  *trustMultiplier = profile->reputationScore / 100.0f;
+  // Apply trust multiplier based on reputation and verified accuracy
+  *trustMultiplier = (profile->reputationScore / 100.0f) * profile->dataAccuracy;
+  
+  // Peers already checked this exact data: their verdicts outweigh history
+  VerificationSummary summary;
+  if (ecosystem->getVerificationSummary(senderMac, dataHash, &summary)) {
+    float agreement = (float)summary.verified / (summary.verified + summary.contradicted);
+    *trustMultiplier *= 0.5f + agreement * summary.confidence;
+    if (summary.contradicted > summary.verified) return false;
+  }
   
-  return ecosystemManager->shouldTrustBot(senderMac);
+  return ecosystem->shouldTrustBot(senderMac);
 }
 
 void reportInteractionToEcosystem(uint8_t* peerMac, InteractionType type, InteractionResult result) {
-  if (ecosystemManager == nullptr) return;
+  if (swarmNode->ecosystem == nullptr) return;
   
   uint8_t myMac[6];
   WiFi.macAddress(myMac);
   
-  ecosystemManager->recordInteraction(myMac, peerMac, type, result);
+  swarmNode->ecosystem->recordInteraction(myMac, peerMac, type, result);
 }
\ No newline at end of file
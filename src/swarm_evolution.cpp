@@ -0,0 +1,192 @@
+#include "swarm_evolution.h"
+
+// ═══════════════════════════════════════════════════════════
+// 🧬 SWARM GENE POOL IMPLEMENTATION
+// ═══════════════════════════════════════════════════════════
+
+SwarmGenePool::SwarmGenePool(const GeneBounds* geneBounds, uint8_t count, uint8_t layout) {
+  bounds = geneBounds;
+  geneCount = min(count, (uint8_t)GENOME_MAX_GENES);
+  layoutId = layout;
+  memset(selfMac, 0, sizeof(selfMac));
+  memset(entries, 0, sizeof(entries));
+  selfEntry = -1;
+  shareDirty = false;
+  lastShare = 0;
+  memset(&stats, 0, sizeof(stats));
+}
+
+void SwarmGenePool::begin(const uint8_t* mac) {
+  memcpy(selfMac, mac, 6);
+}
+
+bool SwarmGenePool::isFresh(const GenePoolEntry& entry, unsigned long now) const {
+  return entry.isActive && now - entry.evaluatedAt < GENE_POOL_TTL_MS;
+}
+
+int16_t SwarmGenePool::clampGene(uint8_t gene, int32_t value) const {
+  return (int16_t)constrain(value, (int32_t)bounds[gene].minValue, (int32_t)bounds[gene].maxValue);
+}
+
+// Moves the gene by 1..mutationStep in a random direction, away from the
+// bound it sits on, so the result always differs from the input
+int16_t SwarmGenePool::mutateGene(uint8_t gene, int16_t value) const {
+  int32_t magnitude = random(1, max((int32_t)bounds[gene].mutationStep, (int32_t)1) + 1);
+  int32_t step = random(0, 2) == 0 ? -magnitude : magnitude;
+  int16_t moved = clampGene(gene, value + step);
+  return moved != value ? moved : clampGene(gene, value - step);
+}
+
+bool SwarmGenePool::isSameGenome(const GenePoolEntry& entry, const uint8_t* mac, const int16_t* genes) const {
+  return memcmp(entry.mac, mac, 6) == 0 && memcmp(entry.genes, genes, geneCount * sizeof(int16_t)) == 0;
+}
+
+// The same genome from the same bot → its slot (re-share or re-run); then a
+// free or stale slot; then the weakest entry, if this result beats it
+int8_t SwarmGenePool::slotFor(const uint8_t* mac, const int16_t* genes, float fitness, unsigned long now) {
+  int8_t weakest = -1;
+  for (int8_t i = 0; i < GENE_POOL_SIZE; i++) {
+    if (entries[i].isActive && isSameGenome(entries[i], mac, genes)) return i;
+  }
+  for (int8_t i = 0; i < GENE_POOL_SIZE; i++) {
+    if (!isFresh(entries[i], now)) return i;
+    if (weakest < 0 || entries[i].fitness < entries[weakest].fitness) weakest = i;
+  }
+  return fitness > entries[weakest].fitness ? weakest : -1;
+}
+
+void SwarmGenePool::recordEvaluation(const int16_t* genes, float fitness, uint16_t generation, unsigned long now) {
+  stats.evaluations++;
+  int8_t slot = slotFor(selfMac, genes, fitness, now);
+  if (slot < 0) {
+    selfEntry = -1;   // Worse than the whole pool: nothing worth sharing
+    return;
+  }
+
+  GenePoolEntry& entry = entries[slot];
+  memcpy(entry.mac, selfMac, 6);
+  memcpy(entry.genes, genes, geneCount * sizeof(int16_t));
+  entry.fitness = fitness;
+  entry.generation = generation;
+  entry.evaluatedAt = now;
+  entry.isActive = true;
+  selfEntry = slot;
+  shareDirty = true;
+}
+
+bool SwarmGenePool::mergeShare(const uint8_t* senderMac, const GenomePayload& share, unsigned long now) {
+  if (share.reserved[0] != layoutId || share.reserved[1] != geneCount ||
+      !(share.fitnessScore >= 0.0f && share.fitnessScore < 100.0f)) {
+    stats.migrantsRejected++;
+    return false;
+  }
+  if (memcmp(senderMac, selfMac, 6) == 0) return false;
+
+  int16_t genes[GENOME_MAX_GENES];
+  memcpy(genes, share.parameters, geneCount * sizeof(int16_t));   // Packed bytes, unaligned
+  for (uint8_t g = 0; g < geneCount; g++) genes[g] = clampGene(g, genes[g]);
+
+  int8_t slot = slotFor(senderMac, genes, share.fitnessScore, now);
+  if (slot < 0) return false;   // Weaker than everything we hold
+
+  GenePoolEntry& entry = entries[slot];
+  memcpy(entry.mac, senderMac, 6);
+  memcpy(entry.genes, genes, geneCount * sizeof(int16_t));
+  entry.fitness = share.fitnessScore;
+  entry.generation = share.generation;
+  entry.evaluatedAt = now;
+  entry.isActive = true;
+  if (slot == selfEntry) selfEntry = -1;
+  stats.migrantsReceived++;
+  return true;
+}
+
+bool SwarmGenePool::isShareDue(unsigned long now) const {
+  if (selfEntry < 0 || !isFresh(entries[selfEntry], now)) return false;
+  return shareDirty || now - lastShare >= GENE_SHARE_REPEAT_MS;
+}
+
+bool SwarmGenePool::buildShare(GenomePayload& out, unsigned long now) {
+  if (selfEntry < 0) return false;
+  const GenePoolEntry& entry = entries[selfEntry];
+
+  memset(&out, 0, sizeof(out));
+  out.generation = entry.generation;
+  out.fitnessScore = entry.fitness;
+  memcpy(out.parameters, entry.genes, geneCount * sizeof(int16_t));
+  out.mutationRate = GENE_MUTATION_PERCENT;
+  out.reserved[0] = layoutId;
+  out.reserved[1] = geneCount;
+
+  shareDirty = false;
+  lastShare = now;
+  return true;
+}
+
+uint8_t SwarmGenePool::getPopulation(unsigned long now) const {
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < GENE_POOL_SIZE; i++) {
+    if (isFresh(entries[i], now)) count++;
+  }
+  return count;
+}
+
+uint8_t SwarmGenePool::getMigrantCount(unsigned long now) const {
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < GENE_POOL_SIZE; i++) {
+    if (isFresh(entries[i], now) && memcmp(entries[i].mac, selfMac, 6) != 0) count++;
+  }
+  return count;
+}
+
+const GenePoolEntry* SwarmGenePool::getBest(unsigned long now) const {
+  const GenePoolEntry* best = nullptr;
+  for (uint8_t i = 0; i < GENE_POOL_SIZE; i++) {
+    if (isFresh(entries[i], now) && (best == nullptr || entries[i].fitness > best->fitness)) {
+      best = &entries[i];
+    }
+  }
+  return best;
+}
+
+// Best of GENE_TOURNAMENT_SIZE random picks; exclude is skipped when anyone else is left
+int8_t SwarmGenePool::tournament(unsigned long now, int8_t exclude) const {
+  int8_t fresh[GENE_POOL_SIZE];
+  uint8_t freshCount = 0;
+  for (int8_t i = 0; i < GENE_POOL_SIZE; i++) {
+    if (isFresh(entries[i], now) && i != exclude) fresh[freshCount++] = i;
+  }
+  if (freshCount == 0) return exclude;
+
+  int8_t winner = -1;
+  for (uint8_t round = 0; round < GENE_TOURNAMENT_SIZE; round++) {
+    int8_t pick = fresh[random(0, freshCount)];
+    if (winner < 0 || entries[pick].fitness > entries[winner].fitness) winner = pick;
+  }
+  return winner;
+}
+
+bool SwarmGenePool::breed(int16_t* child, unsigned long now) {
+  if (getMigrantCount(now) == 0) return false;
+
+  int8_t first = tournament(now, -1);
+  int8_t second = tournament(now, first);
+  if (second != first) stats.crossovers++;
+
+  // Uniform crossover, then mutation; at least one gene always moves
+  bool mutated = false;
+  for (uint8_t g = 0; g < geneCount; g++) {
+    child[g] = entries[random(0, 2) == 0 ? first : second].genes[g];
+    if (random(0, 100) < GENE_MUTATION_PERCENT) {
+      child[g] = mutateGene(g, child[g]);
+      mutated = true;
+    }
+  }
+  if (!mutated) {
+    uint8_t g = random(0, geneCount);
+    child[g] = mutateGene(g, child[g]);
+  }
+
+  stats.offspring++;
+  return true;
+}
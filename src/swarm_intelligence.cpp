@@ -16,135 +16,185 @@
  */
 
 #include "swarm_intelligence.h"
+#include "swarm_node.h"
+#include "swarm_consensus.h"
+#include "swarm_leadership.h"
+#include "swarm_task_scheduler.h"
+#include "swarm_ecosystem_manager.h"
 #include <Arduino.h>
+#include <esp_now.h>
 
 // ═══════════════════════════════════════════════════════════
-// 🌊 GLOBAL SWARM STATE VARIABLES
+// 🌊 PER-NODE SWARM STATE
 // ═══════════════════════════════════════════════════════════
 
-// Leadership state
-LeadershipBid leadershipCandidates[MAX_LEADERSHIP_CANDIDATES];
-int candidateCount = 0;
-uint8_t currentLeader[6] = {0};
-bool isLeader = false;
-unsigned long lastLeadershipCheck = 0;
-
-// Task management
-SwarmTask activeTasks[MAX_SWARM_TASKS];
-int activeTaskCount = 0;
-uint16_t nextTaskId = 1;
-
-// Exploration zones
-ExplorationZone explorationZones[MAX_EXPLORATION_ZONES];
-int activeZoneCount = 0;
+SwarmIntelligenceState::SwarmIntelligenceState() {
+  memset(leadershipCandidates, 0, sizeof(leadershipCandidates));
+  candidateCount = 0;
+  memset(currentLeader, 0, sizeof(currentLeader));
+  isLeader = false;
+  leaderElectionStarted = false;
+  memset(explorationZones, 0, sizeof(explorationZones));
+  activeZones = 0;
+  memset(&currentFormation, 0, sizeof(currentFormation));
+  memset(&myPosition, 0, sizeof(myPosition));
+  memset(&emergentState, 0, sizeof(emergentState));
+  consensusStarted = false;
+}
 
-// Formation state
-SwarmFormation currentFormation;
-FormationPosition myPosition;
+SwarmIntelligenceState& swarmIntelligence() {
+  SwarmNode* node = swarmNode;
+  if (node->intelligence == nullptr) node->intelligence = new SwarmIntelligenceState();
+  return *node->intelligence;
+}
 
-// Emergent behavior state
-EmergentState emergentState;
+// Forward declarations
+static void setupLineFormation(float scale);
+static void setupCircularFormation(float scale);
+static void setupDispersedFormation(float scale);
+static void setupDefaultFormation(float scale);
 
 // ═══════════════════════════════════════════════════════════
 // 🏆 LEADER ELECTION IMPLEMENTATION
 // ═══════════════════════════════════════════════════════════
 
+// Our bid from the node's self report; refreshed before every election tick
+static void fillSelfBid(LeadershipBid& bid) {
+  const SwarmSelfReport& self = swarmNode->self;
+  
+  memset(&bid, 0, sizeof(bid));
+  WiFi.macAddress((uint8_t*)bid.candidateMac);
+  bid.botType = self.botType;
+  bid.generation = self.generation;
+  bid.fitnessScore = self.fitness;
+  bid.batteryLevel = 100; // Placeholder - could read actual battery
+  bid.strategiesLearned = self.strategiesLearned;
+  bid.uptime = millis();
+  bid.bidTimestamp = millis();
+}
+
+static void onLeaderChange(const uint8_t* leaderMac, bool isSelf) {
+  SwarmIntelligenceState& intel = swarmIntelligence();
+  memcpy(intel.currentLeader, leaderMac, 6);
+  intel.isLeader = isSelf;
+  
+  if (isSelf) {
+    Serial.printf("👑 I am elected as swarm leader! (term %d)\n", intel.leaderElection.getTerm());
+  } else if (intel.leaderElection.getRole() == LEADER_ROLE_FOLLOWER) {
+    Serial.printf("👑 Leader elected: %s (term %d)\n",
+                  macToString(leaderMac).c_str(), intel.leaderElection.getTerm());
+  }
+}
+
+static void ensureLeaderElectionStarted() {
+  SwarmIntelligenceState& intel = swarmIntelligence();
+  if (intel.leaderElectionStarted) return;
+  uint8_t myMac[6];
+  WiFi.macAddress(myMac);
+  
+  LeadershipBid myBid;
+  fillSelfBid(myBid);
+  intel.leaderElection.begin(myMac, ELECT_BY_FITNESS, millis());
+  intel.leaderElection.setSelfBid(myBid);
+  intel.leaderElection.setLeaderChangeListener(onLeaderChange);
+  intel.leaderElectionStarted = true;
+}
+
+// Heartbeat or candidacy, whichever the engine has queued
+static void sendLeaderElection() {
+  SwarmIntelligenceState& intel = swarmIntelligence();
+  static SwarmMessage message;
+  
+  LeaderElectionPayload payload;
+  if (!intel.leaderElection.pollMessage(payload)) return;
+  
+  memcpy(message.payload.rawData, &payload, sizeof(payload));
+  message.header.messageType = MSG_LEADER_ELECTION;
+  message.header.priority = PRIORITY_HIGH;
+  message.header.senderType = swarmNode->self.botType;
+  message.header.sequenceNumber = 0;
+  message.header.timestamp = millis();
+  size_t frameLength = finalizeSwarmMessage(&message, sizeof(payload));
+  
+  uint8_t broadcastAddress[] = BROADCAST_MAC;
+  esp_now_send(broadcastAddress, (uint8_t*)&message, frameLength);
+}
+
 bool initiateLeaderElection(LeadershipCriteria criteria) {
+  SwarmIntelligenceState& intel = swarmIntelligence();
   Serial.println("🗳️ Initiating leader election...");
+  ensureLeaderElectionStarted();
   
   // Clear previous candidates
-  candidateCount = 0;
-  memset(leadershipCandidates, 0, sizeof(leadershipCandidates));
+  intel.candidateCount = 0;
+  memset(intel.leadershipCandidates, 0, sizeof(intel.leadershipCandidates));
   
   // Submit our own candidacy
   LeadershipBid myBid;
-  WiFi.macAddress((uint8_t*)myBid.candidateMac);
-  
-  // Get bot type and current stats (these would be externally accessible)
-  extern BotType myBotType;
-  extern EvolvingGenome currentGenome;
-  extern int strategyCount;
-  
-  myBid.botType = myBotType;
-  myBid.generation = currentGenome.generation;
-  myBid.fitnessScore = currentGenome.fitnessScore;
-  myBid.batteryLevel = 100; // Placeholder - could read actual battery
-  myBid.strategiesLearned = strategyCount;
-  myBid.uptime = millis();
-  myBid.votes = 0;
-  myBid.bidTimestamp = millis();
-  
+  fillSelfBid(myBid);
   submitLeadershipBid(&myBid);
   
-  // Broadcast leadership election message
-  // This would trigger other bots to submit their bids
-  
-  lastLeadershipCheck = millis();
+  // New term under these criteria; peers answer with their bids
+  intel.leaderElection.setCriteria(criteria);
+  intel.leaderElection.setSelfBid(myBid);
+  intel.leaderElection.startElection(millis());
+  sendLeaderElection();
   return true;
 }
 
 void submitLeadershipBid(LeadershipBid* bid) {
-  if (candidateCount >= MAX_LEADERSHIP_CANDIDATES) {
-    Serial.println("⚠️ Too many leadership candidates");
-    return;
-  }
-  
+  SwarmIntelligenceState& intel = swarmIntelligence();
   // Check if this candidate already exists (update instead of add)
-  for (int i = 0; i < candidateCount; i++) {
-    if (memcmp(leadershipCandidates[i].candidateMac, bid->candidateMac, 6) == 0) {
-      leadershipCandidates[i] = *bid;
-      Serial.printf("📝 Updated leadership bid from %s\n", 
-                    macToString(bid->candidateMac).c_str());
+  for (int i = 0; i < intel.candidateCount; i++) {
+    if (memcmp(intel.leadershipCandidates[i].candidateMac, bid->candidateMac, 6) == 0) {
+      intel.leadershipCandidates[i] = *bid;
       return;
     }
   }
   
+  if (intel.candidateCount >= MAX_LEADERSHIP_CANDIDATES) {
+    Serial.println("⚠️ Too many leadership candidates");
+    return;
+  }
+  
   // Add new candidate
-  leadershipCandidates[candidateCount] = *bid;
-  candidateCount++;
+  intel.leadershipCandidates[intel.candidateCount] = *bid;
+  intel.candidateCount++;
   
   Serial.printf("📝 Leadership bid from %s (Gen:%d, Fit:%.3f)\n",
                 macToString(bid->candidateMac).c_str(),
                 bid->generation, bid->fitnessScore);
 }
 
+// Offline ranking of a bid list, with the same order the election uses
 uint8_t* electLeader(LeadershipBid candidates[], int candidateCount) {
+  SwarmIntelligenceState& intel = swarmIntelligence();
   if (candidateCount == 0) return nullptr;
   
-  // Simple fitness-based election
+  static uint8_t winner[6];
+  LeadershipCriteria criteria = intel.leaderElection.getCriteria();
+  uint16_t term = intel.leaderElection.getTerm();
   int bestCandidate = 0;
-  float bestScore = candidates[0].fitnessScore;
   
   for (int i = 1; i < candidateCount; i++) {
-    float score = candidates[i].fitnessScore;
-    
-    // Tie-breaker: higher generation wins
-    if (score == bestScore) {
-      if (candidates[i].generation > candidates[bestCandidate].generation) {
-        bestCandidate = i;
-      }
-    } else if (score > bestScore) {
-      bestScore = score;
+    if (SwarmLeaderElection::compareBids(candidates[i], candidates[bestCandidate], criteria, term) > 0) {
       bestCandidate = i;
     }
   }
   
-  // Check if we are the winner
-  uint8_t myMac[6];
-  WiFi.macAddress(myMac);
-  
-  if (memcmp(candidates[bestCandidate].candidateMac, myMac, 6) == 0) {
-    isLeader = true;
-    Serial.println("👑 I am elected as swarm leader!");
-  } else {
-    isLeader = false;
-    Serial.printf("👑 Leader elected: %s (Fitness: %.3f)\n",
-                  macToString(candidates[bestCandidate].candidateMac).c_str(),
-                  candidates[bestCandidate].fitnessScore);
-  }
+  memcpy(winner, candidates[bestCandidate].candidateMac, 6);
+  return winner;
+}
+
+void handleLeaderElection(const uint8_t* senderMac, const SwarmMessage* message) {
+  SwarmIntelligenceState& intel = swarmIntelligence();
+  if (message->header.payloadLength < sizeof(LeaderElectionPayload)) return;
+  ensureLeaderElectionStarted();
   
-  memcpy(currentLeader, candidates[bestCandidate].candidateMac, 6);
-  return currentLeader;
+  LeaderElectionPayload payload;
+  memcpy(&payload, message->payload.rawData, sizeof(payload));
+  intel.leaderElection.handleMessage(senderMac, payload, millis());
+  sendLeaderElection(); // Bids and leader conflicts are answered at once
 }
 
 // ═══════════════════════════════════════════════════════════
@@ -152,39 +202,17 @@ uint8_t* electLeader(LeadershipBid candidates[], int candidateCount) {
 // ═══════════════════════════════════════════════════════════
 
 uint16_t createSwarmTask(TaskCategory category, TaskType type, uint8_t priority) {
-  if (activeTaskCount >= MAX_SWARM_TASKS) {
+  SwarmIntelligenceState& intel = swarmIntelligence();
+  // Requester is ourselves
+  uint8_t myMac[6];
+  WiFi.macAddress(myMac);
+  
+  SwarmTask* task = intel.taskScheduler.create(category, type, priority, myMac, millis());
+  if (!task) {
     Serial.println("⚠️ Task queue full");
     return 0;
   }
   
-  // Find empty task slot
-  int taskIndex = -1;
-  for (int i = 0; i < MAX_SWARM_TASKS; i++) {
-    if (activeTasks[i].taskId == 0) {
-      taskIndex = i;
-      break;
-    }
-  }
-  
-  if (taskIndex == -1) return 0;
-  
-  SwarmTask* task = &activeTasks[taskIndex];
-  task->taskId = nextTaskId++;
-  task->category = category;
-  task->taskType = type;
-  task->priority = priority;
-  task->status = TASK_STATUS_PENDING;
-  task->createdTime = millis();
-  task->deadlineTime = millis() + TASK_TIMEOUT;
-  task->progressPercent = 0;
-  task->retryCount = 0;
-  task->requiresConfirmation = true;
-  
-  // Set requester as ourselves
-  WiFi.macAddress((uint8_t*)task->requesterBot);
-  
-  activeTaskCount++;
-  
   Serial.printf("📋 Created task %d: Category=%d, Type=%d, Priority=%d\n",
                 task->taskId, category, type, priority);
   
@@ -192,18 +220,15 @@ uint16_t createSwarmTask(TaskCategory category, TaskType type, uint8_t priority)
 }
 
 bool assignTask(uint16_t taskId, uint8_t* botMac) {
+  SwarmIntelligenceState& intel = swarmIntelligence();
   SwarmTask* task = findTask(taskId);
   if (!task) return false;
   
-  if (task->status != TASK_STATUS_PENDING) {
+  if (!intel.taskScheduler.assign(taskId, swarmNode->peerRegistry.find(botMac), botMac, millis())) {
     Serial.printf("⚠️ Task %d not in pending state\n", taskId);
     return false;
   }
   
-  memcpy(task->assignedBot, botMac, 6);
-  task->status = TASK_STATUS_ASSIGNED;
-  task->startTime = millis();
-  
   Serial.printf("📋 Task %d assigned to %s\n", taskId, macToString(botMac).c_str());
   
   // Send task assignment message to the bot
@@ -213,67 +238,101 @@ bool assignTask(uint16_t taskId, uint8_t* botMac) {
 }
 
 void reportTaskProgress(uint16_t taskId, uint8_t progressPercent) {
-  SwarmTask* task = findTask(taskId);
-  if (!task) return;
-  
-  task->progressPercent = progressPercent;
-  task->status = TASK_STATUS_ACTIVE;
-  
-  if (progressPercent >= 100) {
-    completeTask(taskId, true);
-  }
+  SwarmIntelligenceState& intel = swarmIntelligence();
+  intel.taskScheduler.reportProgress(taskId, progressPercent, millis());
 }
 
 void completeTask(uint16_t taskId, bool successful) {
+  SwarmIntelligenceState& intel = swarmIntelligence();
   SwarmTask* task = findTask(taskId);
-  if (!task) return;
-  
-  task->status = successful ? TASK_STATUS_COMPLETED : TASK_STATUS_FAILED;
-  task->completionTime = millis();
-  task->progressPercent = successful ? 100 : task->progressPercent;
+  if (!task || !intel.taskScheduler.complete(taskId, successful, millis())) return;
   
-  Serial.printf("📋 Task %d %s in %ldms\n", 
+  Serial.printf("📋 Task %d %s in %lums\n", 
                 taskId, 
                 successful ? "completed" : "failed",
-                task->completionTime - task->startTime);
-  
-  // Clean up completed tasks after a delay
-  // For now, just mark as completed
+                (unsigned long)(task->completionTime - task->startTime));
 }
 
 SwarmTask* findTask(uint16_t taskId) {
-  for (int i = 0; i < MAX_SWARM_TASKS; i++) {
-    if (activeTasks[i].taskId == taskId) {
-      return &activeTasks[i];
-    }
+  SwarmIntelligenceState& intel = swarmIntelligence();
+  return intel.taskScheduler.find(taskId);
+}
+
+static void onTaskExpired(const SwarmTask& task) {
+  if (task.status == TASK_STATUS_PENDING) {
+    Serial.printf("⏰ Task %d timed out, retry %d/%d\n", task.taskId, task.retryCount, MAX_TASK_RETRIES);
+  } else {
+    Serial.printf("⏰ Task %d failed after %d retries\n", task.taskId, task.retryCount);
+  }
+}
+
+// One pass over every pending task: candidates are scored once per tick
+static void assignPendingTasks(unsigned long now) {
+  SwarmIntelligenceState& intel = swarmIntelligence();
+  SwarmEcosystemManager* ecosystem = swarmNode->ecosystem;
+  if (intel.taskScheduler.getPendingCount() == 0 || ecosystem == nullptr) return;
+  
+  TaskCandidate candidates[PEER_REGISTRY_CAPACITY];
+  uint8_t candidateCount = 0;
+  for (PeerId id = 0; id < PEER_REGISTRY_CAPACITY; id++) {
+    BotProfile* profile = ecosystem->getBotProfile(id);
+    if (profile == nullptr) continue;
+    float suitability = ecosystem->getTaskSuitability(id);
+    if (suitability < 0) continue;
+    
+    candidates[candidateCount].peer = id;
+    candidates[candidateCount].botType = profile->botType;
+    candidates[candidateCount].suitability = suitability;
+    candidateCount++;
+  }
+  
+  TaskAssignment assignments[MAX_SWARM_TASKS];
+  uint8_t assigned = intel.taskScheduler.assignPending(candidates, candidateCount,
+                                                 assignments, MAX_SWARM_TASKS, now);
+  for (uint8_t i = 0; i < assigned; i++) {
+    Serial.printf("📋 Task %d assigned to %s\n", assignments[i].taskId,
+                  macToString(swarmNode->peerRegistry.getMac(assignments[i].peer)).c_str());
   }
-  return nullptr;
 }
 
 // ═══════════════════════════════════════════════════════════
 // 🗺️ EXPLORATION COORDINATION
 // ═══════════════════════════════════════════════════════════
 
+#define ZONE_UNIT_CM 100.0f   // Zones are in metres, the spatial index in cm
+
+static_assert(MAX_EXPLORATION_ZONES <= 16, "activeZones is one bit per zone slot");
+
+static SpatialRect zoneRect(const ExplorationZone* zone) {
+  SpatialRect rect;
+  rect.minX = (zone->centerX - zone->width / 2) * ZONE_UNIT_CM;
+  rect.minY = (zone->centerY - zone->height / 2) * ZONE_UNIT_CM;
+  rect.maxX = (zone->centerX + zone->width / 2) * ZONE_UNIT_CM;
+  rect.maxY = (zone->centerY + zone->height / 2) * ZONE_UNIT_CM;
+  return rect;
+}
+
 bool assignExplorationZone(uint8_t* botMac, ExplorationZone* zone) {
-  if (activeZoneCount >= MAX_EXPLORATION_ZONES) return false;
-  
-  // Find empty zone slot
-  int zoneIndex = -1;
-  for (int i = 0; i < MAX_EXPLORATION_ZONES; i++) {
-    if (!explorationZones[i].isActive) {
-      zoneIndex = i;
-      break;
-    }
+  SwarmIntelligenceState& intel = swarmIntelligence();
+  uint16_t freeSlots = ~intel.activeZones & ((1UL << MAX_EXPLORATION_ZONES) - 1);
+  if (freeSlots == 0) return false;
+  
+  // Two bots sweeping the same cells is wasted time
+  SpatialRect rect = zoneRect(zone);
+  if (swarmNode->spatialIndex.zonesOverlapping(rect) != 0) {
+    Serial.printf("🗺️ Zone (%.1f,%.1f) overlaps an active zone - not assigned\n",
+                  zone->centerX, zone->centerY);
+    return false;
   }
   
-  if (zoneIndex == -1) return false;
-  
-  explorationZones[zoneIndex] = *zone;
-  memcpy(explorationZones[zoneIndex].assignedBot, botMac, 6);
-  explorationZones[zoneIndex].isActive = true;
-  explorationZones[zoneIndex].startTime = millis();
+  int zoneIndex = __builtin_ctz(freeSlots);
+  intel.explorationZones[zoneIndex] = *zone;
+  memcpy(intel.explorationZones[zoneIndex].assignedBot, botMac, 6);
+  intel.explorationZones[zoneIndex].isActive = true;
+  intel.explorationZones[zoneIndex].startTime = millis();
+  swarmNode->spatialIndex.setZone(zoneIndex, rect);
   
-  activeZoneCount++;
+  intel.activeZones |= 1U << zoneIndex;
   
   Serial.printf("🗺️ Zone assigned to %s: (%.1f,%.1f) %dx%d\n",
                 macToString(botMac).c_str(),
@@ -284,15 +343,17 @@ bool assignExplorationZone(uint8_t* botMac, ExplorationZone* zone) {
 }
 
 void reportExplorationProgress(uint16_t zoneId, uint8_t progressPercent) {
+  SwarmIntelligenceState& intel = swarmIntelligence();
   // Find zone by ID (simplified - using array index as ID)
-  if (zoneId < MAX_EXPLORATION_ZONES && explorationZones[zoneId].isActive) {
-    explorationZones[zoneId].completionPercent = progressPercent;
+  if (zoneId < MAX_EXPLORATION_ZONES && intel.explorationZones[zoneId].isActive) {
+    intel.explorationZones[zoneId].completionPercent = progressPercent;
     
     Serial.printf("🗺️ Zone %d progress: %d%%\n", zoneId, progressPercent);
     
     if (progressPercent >= 100) {
-      explorationZones[zoneId].isActive = false;
-      activeZoneCount--;
+      intel.explorationZones[zoneId].isActive = false;
+      swarmNode->spatialIndex.clearZone(zoneId);
+      intel.activeZones &= ~(1U << zoneId);
       Serial.printf("✅ Zone %d exploration completed\n", zoneId);
     }
   }
@@ -300,6 +361,16 @@ void reportExplorationProgress(uint16_t zoneId, uint8_t progressPercent) {
 
 ExplorationStrategy selectOptimalStrategy(ExplorationZone* zone, BotType botType) {
   // Select strategy based on bot capabilities and zone characteristics
+  SpatialRect rect = zoneRect(zone);
+  
+  // What the swarm already knows about the area comes first
+  PeerId occupant;
+  if (swarmNode->spatialIndex.peersInRect(rect, &occupant, 1) > 0) {
+    return EXPLORE_SWARM_DISPERSION; // Someone is already in there - spread out
+  }
+  if (swarmNode->spatialIndex.exploredFraction(rect) > 0.5f) {
+    return EXPLORE_GRID_COVERAGE;    // Mostly covered - sweep the gaps
+  }
   
   if (botType == BOT_WHEELIE) {
     // WHEELIE with precision sensors good for detailed exploration
@@ -320,11 +391,93 @@ ExplorationStrategy selectOptimalStrategy(ExplorationZone* zone, BotType botType
   return EXPLORE_RANDOM_WALK; // Default fallback
 }
 
+// ═══════════════════════════════════════════════════════════
+// 🗳️ CONSENSUS PROTOCOLS
+// ═══════════════════════════════════════════════════════════
+
+#define CONSENSUS_SELF_VOTER PEER_REGISTRY_CAPACITY // Peers vote as their PeerId
+
+static void ensureConsensusStarted() {
+  SwarmIntelligenceState& intel = swarmIntelligence();
+  if (intel.consensusStarted) return;
+  uint8_t myMac[6];
+  WiFi.macAddress(myMac);
+  intel.swarmConsensus.begin(myMac, CONSENSUS_SELF_VOTER);
+  intel.consensusStarted = true;
+}
+
+// One broadcast carries our vote for every open proposal
+static void sendConsensusVotes() {
+  SwarmIntelligenceState& intel = swarmIntelligence();
+  static SwarmMessage message;
+  
+  size_t length = intel.swarmConsensus.buildBatch(*(ConsensusBatchPayload*)message.payload.rawData, millis());
+  if (length == 0) return;
+  
+  message.header.messageType = MSG_CONSENSUS_VOTE;
+  message.header.priority = PRIORITY_HIGH;
+  message.header.senderType = swarmNode->self.botType;
+  message.header.sequenceNumber = 0;
+  message.header.timestamp = millis();
+  size_t frameLength = finalizeSwarmMessage(&message, length);
+  
+  uint8_t broadcastAddress[] = BROADCAST_MAC;
+  esp_now_send(broadcastAddress, (uint8_t*)&message, frameLength);
+}
+
+uint16_t proposeDecision(DecisionTopic topic, ConsensusType type) {
+  SwarmIntelligenceState& intel = swarmIntelligence();
+  ensureConsensusStarted();
+  
+  uint16_t proposalId = intel.swarmConsensus.propose(topic, type, swarmNode->self.activePeers + 1, millis());
+  if (proposalId == 0) {
+    Serial.println("🗳️ No free proposal slot");
+    return 0;
+  }
+  
+  Serial.printf("🗳️ Proposal %04X: topic %d, type %d\n", proposalId, topic, type);
+  if (intel.swarmConsensus.isBatchUrgent()) sendConsensusVotes();
+  return proposalId;
+}
+
+void castVote(uint16_t proposalId, uint8_t choice, float confidence) {
+  SwarmIntelligenceState& intel = swarmIntelligence();
+  ensureConsensusStarted();
+  
+  // Votes weigh by our fitness, as reported to the node
+  if (!intel.swarmConsensus.castVote(proposalId, choice, confidence, swarmNode->self.fitness, millis())) return;
+  if (intel.swarmConsensus.isBatchUrgent()) sendConsensusVotes();
+}
+
+bool checkConsensusReached(uint16_t proposalId) {
+  SwarmIntelligenceState& intel = swarmIntelligence();
+  const ConsensusProposal* proposal = intel.swarmConsensus.find(proposalId);
+  return proposal != nullptr && proposal->isResolved && proposal->winningChoice != CONSENSUS_NO_CHOICE;
+}
+
+uint8_t getConsensusResult(uint16_t proposalId) {
+  SwarmIntelligenceState& intel = swarmIntelligence();
+  const ConsensusProposal* proposal = intel.swarmConsensus.find(proposalId);
+  return (proposal != nullptr && proposal->isResolved) ? proposal->winningChoice : CONSENSUS_NO_CHOICE;
+}
+
+void handleConsensusVotes(const uint8_t* senderMac, const SwarmMessage* message) {
+  SwarmIntelligenceState& intel = swarmIntelligence();
+  ensureConsensusStarted();
+  PeerId voter = swarmNode->peerRegistry.find(senderMac);
+  if (voter == INVALID_PEER_ID) return; // Strangers do not vote
+  
+  intel.swarmConsensus.mergeBatch(voter, *(const ConsensusBatchPayload*)message->payload.rawData,
+                            message->header.payloadLength, millis());
+  if (intel.swarmConsensus.isBatchUrgent()) sendConsensusVotes();
+}
+
 // ═══════════════════════════════════════════════════════════
 // 🚨 EMERGENCY RESPONSE PROTOCOLS
 // ═══════════════════════════════════════════════════════════
 
 void triggerEmergencyResponse(uint8_t emergencyType, float x, float y) {
+  SwarmIntelligenceState& intel = swarmIntelligence();
   Serial.printf("🚨 EMERGENCY: Type=%d at (%.1f, %.1f)\n", emergencyType, x, y);
   
   // Create high-priority emergency task
@@ -337,9 +490,9 @@ void triggerEmergencyResponse(uint8_t emergencyType, float x, float y) {
   setFormation(FORMATION_DISPERSED, 2.0); // Spread out for safety
   
   // Change swarm behavior to emergency mode
-  emergentState.currentBehavior = EMERGENT_COOPERATIVE;
-  emergentState.intensity = 1.0;
-  emergentState.behaviorStartTime = millis();
+  intel.emergentState.currentBehavior = EMERGENT_COOPERATIVE;
+  intel.emergentState.intensity = 1.0;
+  intel.emergentState.behaviorStartTime = millis();
 }
 
 // ═══════════════════════════════════════════════════════════
@@ -347,10 +500,12 @@ void triggerEmergencyResponse(uint8_t emergencyType, float x, float y) {
 // ═══════════════════════════════════════════════════════════
 
 void setFormation(FormationType type, float scale) {
-  currentFormation.type = type;
-  currentFormation.scale = scale;
-  currentFormation.isActive = true;
-  currentFormation.lastUpdate = millis();
+  SwarmIntelligenceState& intel = swarmIntelligence();
+  intel.currentFormation.type = type;
+  intel.currentFormation.scale = scale;
+  intel.currentFormation.isActive = true;
+  intel.currentFormation.lastUpdate = millis();
+  intel.currentFormation.activeBots = 0;
   
   Serial.printf("🔄 Formation set: Type=%d, Scale=%.1f\n", type, scale);
   
@@ -371,124 +526,156 @@ void setFormation(FormationType type, float scale) {
   }
 }
 
-void setupLineFormation(float scale) {
+static void setupLineFormation(float scale) {
+  SwarmIntelligenceState& intel = swarmIntelligence();
   // Simple line formation - bots arranged in a line
-  currentFormation.positions[0].relativeX = -scale;
-  currentFormation.positions[0].relativeY = 0;
-  currentFormation.positions[1].relativeX = scale;
-  currentFormation.positions[1].relativeY = 0;
+  intel.currentFormation.positions[0].relativeX = -scale;
+  intel.currentFormation.positions[0].relativeY = 0;
+  intel.currentFormation.positions[1].relativeX = scale;
+  intel.currentFormation.positions[1].relativeY = 0;
   
   for (int i = 0; i < 2; i++) {
-    currentFormation.positions[i].heading = 0; // Face forward
-    currentFormation.positions[i].priority = i + 1;
-    currentFormation.positions[i].isOccupied = false;
+    intel.currentFormation.positions[i].heading = 0; // Face forward
+    intel.currentFormation.positions[i].priority = i + 1;
+    intel.currentFormation.positions[i].isOccupied = false;
   }
 }
 
-void setupCircularFormation(float scale) {
+static void setupCircularFormation(float scale) {
+  SwarmIntelligenceState& intel = swarmIntelligence();
   // Circular formation - bots arranged in a circle
   float angle = 0;
   float angleStep = 2 * PI / 2; // For 2 bots
   
   for (int i = 0; i < 2; i++) {
-    currentFormation.positions[i].relativeX = scale * cos(angle);
-    currentFormation.positions[i].relativeY = scale * sin(angle);
-    currentFormation.positions[i].heading = angle + PI/2; // Face tangent
-    currentFormation.positions[i].priority = i + 1;
-    currentFormation.positions[i].isOccupied = false;
+    intel.currentFormation.positions[i].relativeX = scale * cos(angle);
+    intel.currentFormation.positions[i].relativeY = scale * sin(angle);
+    intel.currentFormation.positions[i].heading = angle + PI/2; // Face tangent
+    intel.currentFormation.positions[i].priority = i + 1;
+    intel.currentFormation.positions[i].isOccupied = false;
     angle += angleStep;
   }
 }
 
-void setupDispersedFormation(float scale) {
+static void setupDispersedFormation(float scale) {
+  SwarmIntelligenceState& intel = swarmIntelligence();
   // Dispersed formation - maximize distance between bots
-  currentFormation.positions[0].relativeX = -scale * 1.5;
-  currentFormation.positions[0].relativeY = -scale * 1.5;
-  currentFormation.positions[1].relativeX = scale * 1.5;
-  currentFormation.positions[1].relativeY = scale * 1.5;
+  intel.currentFormation.positions[0].relativeX = -scale * 1.5;
+  intel.currentFormation.positions[0].relativeY = -scale * 1.5;
+  intel.currentFormation.positions[1].relativeX = scale * 1.5;
+  intel.currentFormation.positions[1].relativeY = scale * 1.5;
   
   for (int i = 0; i < 2; i++) {
-    currentFormation.positions[i].heading = 0;
-    currentFormation.positions[i].priority = i + 1;
-    currentFormation.positions[i].isOccupied = false;
+    intel.currentFormation.positions[i].heading = 0;
+    intel.currentFormation.positions[i].priority = i + 1;
+    intel.currentFormation.positions[i].isOccupied = false;
   }
 }
 
-void setupDefaultFormation(float scale) {
+static void setupDefaultFormation(float scale) {
+  SwarmIntelligenceState& intel = swarmIntelligence();
   // Default formation - simple side-by-side
-  currentFormation.positions[0].relativeX = -scale * 0.5;
-  currentFormation.positions[0].relativeY = 0;
-  currentFormation.positions[1].relativeX = scale * 0.5;
-  currentFormation.positions[1].relativeY = 0;
+  intel.currentFormation.positions[0].relativeX = -scale * 0.5;
+  intel.currentFormation.positions[0].relativeY = 0;
+  intel.currentFormation.positions[1].relativeX = scale * 0.5;
+  intel.currentFormation.positions[1].relativeY = 0;
   
   for (int i = 0; i < 2; i++) {
-    currentFormation.positions[i].heading = 0;
-    currentFormation.positions[i].priority = i + 1;
-    currentFormation.positions[i].isOccupied = false;
+    intel.currentFormation.positions[i].heading = 0;
+    intel.currentFormation.positions[i].priority = i + 1;
+    intel.currentFormation.positions[i].isOccupied = false;
   }
 }
 
+#define FORMATION_UNIT_CM 100.0f        // Formation offsets are in metres, like zones
+#define FORMATION_CLAIM_RANGE_CM 400.0f // A tracked peer this close to a free slot has first claim
+
+// The slot a bot holds. A bot without one takes the first free slot it is
+// the closest tracked peer to; a bot with no tracked position (ourselves,
+// or a peer nobody has ranged) takes the first free slot no tracked peer
+// is near. Slots with priority 0 are not part of the formation.
+FormationPosition* getAssignedPosition(uint8_t* botMac) {
+  SwarmIntelligenceState& intel = swarmIntelligence();
+  SwarmFormation& formation = intel.currentFormation;
+  if (!formation.isActive) return nullptr;
+  
+  for (int i = 0; i < MAX_SWARM_MEMBERS; i++) {
+    FormationPosition& slot = formation.positions[i];
+    if (slot.priority != 0 && slot.isOccupied && memcmp(slot.assignedBot, botMac, 6) == 0) return &slot;
+  }
+  
+  PeerId id = swarmNode->peerRegistry.find(botMac);
+  if (!swarmNode->spatialIndex.hasPeer(id)) id = INVALID_PEER_ID;
+  
+  for (int i = 0; i < MAX_SWARM_MEMBERS; i++) {
+    FormationPosition& slot = formation.positions[i];
+    if (slot.priority == 0 || slot.isOccupied) continue;
+    
+    float x = (formation.centerX + slot.relativeX) * FORMATION_UNIT_CM;
+    float y = (formation.centerY + slot.relativeY) * FORMATION_UNIT_CM;
+    if (swarmNode->spatialIndex.nearestPeer(x, y, FORMATION_CLAIM_RANGE_CM) != id) continue;
+    
+    memcpy(slot.assignedBot, botMac, 6);
+    slot.isOccupied = true;
+    formation.activeBots++;
+    return &slot;
+  }
+  return nullptr;
+}
+
 // ═══════════════════════════════════════════════════════════
 // 🧠 EMERGENT BEHAVIOR DETECTION
 // ═══════════════════════════════════════════════════════════
 
 EmergentBehavior detectEmergentBehavior() {
+  SwarmIntelligenceState& intel = swarmIntelligence();
   // Simple behavior detection based on current state
   unsigned long currentTime = millis();
   
   // Check if we've been in formation for a while
-  if (currentFormation.isActive && 
-      (currentTime - currentFormation.lastUpdate > 30000)) {
+  if (intel.currentFormation.isActive && 
+      (currentTime - intel.currentFormation.lastUpdate > 30000)) {
     // Been in formation for 30+ seconds - stable formation behavior
-    emergentState.currentBehavior = EMERGENT_FLOCKING;
-    emergentState.intensity = 0.8;
-    emergentState.isStable = true;
+    intel.emergentState.currentBehavior = EMERGENT_FLOCKING;
+    intel.emergentState.intensity = 0.8;
+    intel.emergentState.isStable = true;
     return EMERGENT_FLOCKING;
   }
   
   // Check for competitive behavior (multiple tasks, high priority)
-  int highPriorityTasks = 0;
-  for (int i = 0; i < MAX_SWARM_TASKS; i++) {
-    if (activeTasks[i].taskId > 0 && activeTasks[i].priority >= 7) {
-      highPriorityTasks++;
-    }
-  }
+  int highPriorityTasks = intel.taskScheduler.getHighPriorityCount();
   
   if (highPriorityTasks > 1) {
-    emergentState.currentBehavior = EMERGENT_COMPETITIVE;
-    emergentState.intensity = (float)highPriorityTasks / 5.0; // Scale by task count
+    intel.emergentState.currentBehavior = EMERGENT_COMPETITIVE;
+    intel.emergentState.intensity = (float)highPriorityTasks / 5.0; // Scale by task count
     return EMERGENT_COMPETITIVE;
   }
   
   // Default to cooperative behavior
-  emergentState.currentBehavior = EMERGENT_COOPERATIVE;
-  emergentState.intensity = 0.5;
+  intel.emergentState.currentBehavior = EMERGENT_COOPERATIVE;
+  intel.emergentState.intensity = 0.5;
   return EMERGENT_COOPERATIVE;
 }
 
 float measureSwarmCoherence() {
+  SwarmIntelligenceState& intel = swarmIntelligence();
   // Simple coherence measure based on synchronized activity
   float coherence = 0.5; // Base coherence
   
   // Increase coherence if in active formation
-  if (currentFormation.isActive) {
+  if (intel.currentFormation.isActive) {
     coherence += 0.3;
   }
   
   // Increase coherence if tasks are being completed
-  int activeTasks = 0;
-  for (int i = 0; i < MAX_SWARM_TASKS; i++) {
-    if (activeTasks[i].taskId > 0 && activeTasks[i].status == TASK_STATUS_ACTIVE) {
-      activeTasks++;
-    }
-  }
+  int activeTasks = intel.taskScheduler.getCount(TASK_STATUS_ACTIVE);
   
   if (activeTasks > 0) {
     coherence += 0.2;
   }
   
   // Cap at 1.0
-  return min(coherence, 1.0);
+  return min(coherence, 1.0f);
 }
 
 // ═══════════════════════════════════════════════════════════
@@ -496,37 +683,34 @@ float measureSwarmCoherence() {
 // ═══════════════════════════════════════════════════════════
 
 void updateSwarmIntelligence() {
+  SwarmIntelligenceState& intel = swarmIntelligence();
   unsigned long currentTime = millis();
   
-  // Check for leadership timeout
-  if (currentTime - lastLeadershipCheck > 30000) { // 30 seconds
-    if (candidateCount > 0) {
-      electLeader(leadershipCandidates, candidateCount);
-    }
-    lastLeadershipCheck = currentTime;
-  }
+  // Leader lease: heartbeat while leading, elect as soon as the lease runs out
+  LeadershipBid myBid;
+  ensureLeaderElectionStarted();
+  fillSelfBid(myBid);
+  intel.leaderElection.setSelfBid(myBid);
+  intel.leaderElection.update(currentTime);
+  sendLeaderElection();
   
-  // Clean up expired tasks
-  for (int i = 0; i < MAX_SWARM_TASKS; i++) {
-    SwarmTask* task = &activeTasks[i];
-    if (task->taskId > 0 && 
-        task->status != TASK_STATUS_COMPLETED &&
-        task->status != TASK_STATUS_FAILED &&
-        currentTime > task->deadlineTime) {
-      
-      Serial.printf("⏰ Task %d timed out\n", task->taskId);
-      task->status = TASK_STATUS_FAILED;
-    }
-  }
+  // Task deadlines (only the due ones are touched), then one assignment pass
+  intel.taskScheduler.setExpiredListener(onTaskExpired);
+  intel.taskScheduler.expire(currentTime);
+  assignPendingTasks(currentTime);
   
   // Update emergent behavior detection
   EmergentBehavior detectedBehavior = detectEmergentBehavior();
-  if (detectedBehavior != emergentState.currentBehavior) {
+  if (detectedBehavior != intel.emergentState.currentBehavior) {
     Serial.printf("🌊 Emergent behavior change: %d -> %d\n", 
-                  emergentState.currentBehavior, detectedBehavior);
-    emergentState.lastBehaviorChange = currentTime;
+                  intel.emergentState.currentBehavior, detectedBehavior);
+    intel.emergentState.lastBehaviorChange = currentTime;
   }
   
   // Update coherence measurement
-  emergentState.coherence = measureSwarmCoherence();
+  intel.emergentState.coherence = measureSwarmCoherence();
+  
+  // Consensus deadlines, and re-sending votes that are still open
+  intel.swarmConsensus.update(currentTime);
+  if (intel.swarmConsensus.isBatchDue(currentTime)) sendConsensusVotes();
 }
\ No newline at end of file
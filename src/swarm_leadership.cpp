@@ -0,0 +1,276 @@
+#include "swarm_leadership.h"
+
+// ═══════════════════════════════════════════════════════════
+// 👑 LEASE-BASED LEADER ELECTION IMPLEMENTATION
+// ═══════════════════════════════════════════════════════════
+
+static const uint8_t NO_LEADER[6] = {0, 0, 0, 0, 0, 0};
+
+static bool timeReached(unsigned long deadline, unsigned long now) {
+  return (long)(now - deadline) >= 0;
+}
+
+SwarmLeaderElection::SwarmLeaderElection() {
+  memset(selfMac, 0, sizeof(selfMac));
+  memset(&selfBid, 0, sizeof(selfBid));
+  memset(&bestBid, 0, sizeof(bestBid));
+  memset(leaderMac, 0, sizeof(leaderMac));
+  memset(formerLeader, 0, sizeof(formerLeader));
+  criteria = ELECT_BY_FITNESS;
+  role = LEADER_ROLE_FOLLOWER;
+  term = 0;
+  bidTerm = 0;
+  leaseExpiry = 0;
+  electionDeadline = 0;
+  lastHeartbeat = 0;
+  electionStart = 0;
+  pending = LEADER_MSG_NONE;
+  changeListener = nullptr;
+  memset(&stats, 0, sizeof(stats));
+}
+
+void SwarmLeaderElection::begin(const uint8_t* mac, LeadershipCriteria electionCriteria, unsigned long now) {
+  memcpy(selfMac, mac, 6);
+  memcpy(selfBid.candidateMac, mac, 6);
+  criteria = electionCriteria;
+  role = LEADER_ROLE_FOLLOWER;
+  leaseExpiry = now + LEADER_LEASE_MS;   // Listen for a sitting leader first
+}
+
+void SwarmLeaderElection::setSelfBid(const LeadershipBid& bid) {
+  selfBid = bid;
+  memcpy(selfBid.candidateMac, selfMac, 6);
+  if (role == LEADER_ROLE_CANDIDATE && memcmp(bestBid.candidateMac, selfMac, 6) == 0) bestBid = selfBid;
+}
+
+bool SwarmLeaderElection::hasLeader(unsigned long now) const {
+  if (role == LEADER_ROLE_LEADER) return true;
+  return role == LEADER_ROLE_FOLLOWER && memcmp(leaderMac, NO_LEADER, 6) != 0 && !timeReached(leaseExpiry, now);
+}
+
+// ═══════════════════════════════════════════════════════════
+// ⚖️ RANKING
+// ═══════════════════════════════════════════════════════════
+
+static uint32_t randomRank(const uint8_t* mac, uint16_t term) {
+  uint32_t hash = 2166136261UL ^ term;             // FNV-1a: same on every bot
+  for (uint8_t i = 0; i < 6; i++) hash = (hash ^ mac[i]) * 16777619UL;
+  return hash;
+}
+
+template <typename T>
+static int compareValues(T a, T b) {
+  return (a > b) - (a < b);
+}
+
+int SwarmLeaderElection::compareBids(const LeadershipBid& a, const LeadershipBid& b,
+                                     LeadershipCriteria criteria, uint16_t term) {
+  int result = 0;
+  switch (criteria) {
+    case ELECT_BY_GENERATION:
+      result = compareValues(a.generation, b.generation);
+      break;
+    case ELECT_BY_BATTERY:
+      result = compareValues(a.batteryLevel, b.batteryLevel);
+      break;
+    case ELECT_BY_SENSOR_QUALITY:
+      // WHEELIE carries the precision sensors
+      result = compareValues(a.botType == BOT_WHEELIE, b.botType == BOT_WHEELIE);
+      break;
+    case ELECT_BY_EXPERIENCE:
+      result = compareValues(a.strategiesLearned, b.strategiesLearned);
+      break;
+    case ELECT_BY_RANDOM:
+      result = compareValues(randomRank(a.candidateMac, term), randomRank(b.candidateMac, term));
+      break;
+    case ELECT_BY_FITNESS:
+    case ELECT_BY_CONSENSUS:  // Ranked by fitness; DECIDE_LEADER_SELECTION votes are separate
+    default:
+      break;
+  }
+
+  // Ties: fitness, then generation, then the lower MAC, so every bot agrees
+  if (result == 0) result = compareValues((int)(a.fitnessScore * 1000), (int)(b.fitnessScore * 1000));
+  if (result == 0) result = compareValues(a.generation, b.generation);
+  if (result == 0) result = -memcmp(a.candidateMac, b.candidateMac, 6);
+  return result;
+}
+
+void SwarmLeaderElection::bidFromMessage(const uint8_t* mac, const LeaderElectionPayload& message, LeadershipBid& bid) {
+  memset(&bid, 0, sizeof(bid));
+  memcpy(bid.candidateMac, mac, 6);
+  bid.botType = (BotType)message.botType;
+  bid.generation = message.generation;
+  bid.fitnessScore = message.fitness / 1000.0f;
+  bid.batteryLevel = message.batteryLevel;
+  bid.strategiesLearned = message.strategiesLearned;
+  bid.uptime = message.uptime;
+}
+
+void SwarmLeaderElection::considerBid(const LeadershipBid& bid) {
+  if (compareBids(bid, bestBid, criteria, term) > 0) bestBid = bid;
+}
+
+// ═══════════════════════════════════════════════════════════
+// 🔁 ROLE CHANGES
+// ═══════════════════════════════════════════════════════════
+
+void SwarmLeaderElection::setLeader(const uint8_t* mac, unsigned long now) {
+  if (memcmp(leaderMac, mac, 6) == 0) return;
+  memcpy(leaderMac, mac, 6);
+
+  bool hasOne = memcmp(mac, NO_LEADER, 6) != 0;
+  if (hasOne) {
+    stats.leaderChanges++;
+    if (electionStart != 0) stats.lastElectionMs = now - electionStart;
+    electionStart = 0;
+  }
+  if (changeListener != nullptr) changeListener(leaderMac, memcmp(mac, selfMac, 6) == 0);
+}
+
+void SwarmLeaderElection::adoptTerm(uint16_t newTerm, LeadershipCriteria newCriteria) {
+  term = newTerm;
+  criteria = newCriteria;
+  bestBid = selfBid;
+  if (role == LEADER_ROLE_LEADER) role = LEADER_ROLE_FOLLOWER;
+}
+
+void SwarmLeaderElection::startElection(unsigned long now) {
+  adoptTerm(term + 1, criteria);
+  stats.elections++;
+  becomeCandidate(now);
+}
+
+void SwarmLeaderElection::becomeCandidate(unsigned long now) {
+  if (role != LEADER_ROLE_CANDIDATE) {
+    if (electionStart == 0) electionStart = max(now, 1UL);
+    role = LEADER_ROLE_CANDIDATE;
+    electionDeadline = now + LEADER_ELECTION_WINDOW;
+    memcpy(formerLeader, leaderMac, 6);
+    setLeader(NO_LEADER, now);
+  }
+  if (bidTerm != term) {
+    bidTerm = term;
+    pending = LEADER_MSG_CANDIDATE;   // One bid per term
+  }
+}
+
+void SwarmLeaderElection::becomeLeader(unsigned long now) {
+  if (role != LEADER_ROLE_LEADER) stats.termsLed++;
+  role = LEADER_ROLE_LEADER;
+  pending = LEADER_MSG_HEARTBEAT;
+  lastHeartbeat = now;
+  setLeader(selfMac, now);
+}
+
+void SwarmLeaderElection::followLeader(const uint8_t* mac, unsigned long leaseMs, unsigned long now) {
+  role = LEADER_ROLE_FOLLOWER;
+  leaseExpiry = now + leaseMs;
+  setLeader(mac, now);
+}
+
+// ═══════════════════════════════════════════════════════════
+// ⏱️ TIMERS & MESSAGES
+// ═══════════════════════════════════════════════════════════
+
+void SwarmLeaderElection::update(unsigned long now) {
+  switch (role) {
+    case LEADER_ROLE_LEADER:
+      if (now - lastHeartbeat >= LEADER_HEARTBEAT_INTERVAL) {
+        pending = LEADER_MSG_HEARTBEAT;
+        lastHeartbeat = now;
+      }
+      break;
+
+    case LEADER_ROLE_CANDIDATE:
+      if (!timeReached(electionDeadline, now)) break;
+      if (memcmp(bestBid.candidateMac, selfMac, 6) == 0) {
+        becomeLeader(now);
+      } else {
+        // The winner should heartbeat within one round; if not, elect again
+        role = LEADER_ROLE_FOLLOWER;
+        leaseExpiry = now + LEADER_LEASE_MS;
+      }
+      break;
+
+    case LEADER_ROLE_FOLLOWER:
+      if (timeReached(leaseExpiry, now)) startElection(now);
+      break;
+  }
+}
+
+void SwarmLeaderElection::handleMessage(const uint8_t* senderMac, const LeaderElectionPayload& message, unsigned long now) {
+  if (memcmp(senderMac, selfMac, 6) == 0) return;
+  if ((int16_t)(message.term - term) < 0) {
+    // Stale sender: a sitting leader tells it about the current term
+    if (role == LEADER_ROLE_LEADER) pending = LEADER_MSG_HEARTBEAT;
+    return;
+  }
+
+  LeadershipBid bid;
+  bidFromMessage(senderMac, message, bid);
+
+  if (message.type == LEADER_MSG_CANDIDATE) {
+    if (role == LEADER_ROLE_LEADER) {
+      // The bidder lost our heartbeats, but we are alive: lead its term at
+      // once instead of stepping down and leaving everyone leaderless
+      if (message.term != term) adoptTerm(message.term, (LeadershipCriteria)message.criteria);
+      bidTerm = term;
+      becomeLeader(now);
+      return;
+    }
+    if (role == LEADER_ROLE_FOLLOWER && hasLeader(now) && memcmp(senderMac, leaderMac, 6) != 0) {
+      return;                            // Pre-vote: our lease is live, the leader answers it
+    }
+  }
+
+  if (message.term != term) {
+    adoptTerm(message.term, (LeadershipCriteria)message.criteria);
+    if (message.type == LEADER_MSG_HEARTBEAT) {
+      // Joining, or we missed the election: just follow
+      bestBid = bid;
+      followLeader(senderMac, message.leaseMs, now);
+      return;
+    }
+  }
+
+  if (message.type == LEADER_MSG_CANDIDATE) {
+    considerBid(bid);
+    becomeCandidate(now);
+    return;
+  }
+
+  if (message.type == LEADER_MSG_HEARTBEAT) {
+    bool weAreBetter = compareBids(selfBid, bid, criteria, term) > 0;
+    if (role == LEADER_ROLE_LEADER && weAreBetter) {
+      pending = LEADER_MSG_HEARTBEAT;    // Two leaders in one term: the better one stays
+      return;
+    }
+    if (role == LEADER_ROLE_CANDIDATE && weAreBetter &&
+        memcmp(bestBid.candidateMac, selfMac, 6) == 0 &&
+        memcmp(senderMac, formerLeader, 6) != 0) {
+      becomeLeader(now);                 // Bully: a worse bidder claimed our term
+      return;
+    }
+    considerBid(bid);                    // (The leader we lost is back: keep it)
+    followLeader(senderMac, message.leaseMs, now);
+  }
+}
+
+bool SwarmLeaderElection::pollMessage(LeaderElectionPayload& out) {
+  if (pending == LEADER_MSG_NONE) return false;
+
+  memset(&out, 0, sizeof(out));
+  out.type = pending;
+  out.criteria = criteria;
+  out.term = term;
+  out.leaseMs = LEADER_LEASE_MS;
+  out.botType = selfBid.botType;
+  out.batteryLevel = selfBid.batteryLevel;
+  out.generation = selfBid.generation;
+  out.fitness = (uint16_t)(constrain(selfBid.fitnessScore, 0.0f, 65.0f) * 1000);
+  out.strategiesLearned = selfBid.strategiesLearned;
+  out.uptime = selfBid.uptime;
+  pending = LEADER_MSG_NONE;
+  return true;
+}
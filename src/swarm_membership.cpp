@@ -0,0 +1,384 @@
+#include "swarm_membership.h"
+
+// ═══════════════════════════════════════════════════════════
+// 🗣️ GOSSIP MEMBERSHIP IMPLEMENTATION
+// ═══════════════════════════════════════════════════════════
+
+SwarmMembership::SwarmMembership() {
+  index = nullptr;
+  members = nullptr;
+  capacity = 0;
+  selfId = INVALID_PEER_ID;
+  aliveCount = 0;
+  neighbourCount = 0;
+  digestCursor = 0;
+  updateCursor = 0;
+  lastGossipHeard = 0;
+  statusListener = nullptr;
+  memset(&stats, 0, sizeof(stats));
+}
+
+SwarmMembership::~SwarmMembership() {
+  delete index;
+  free(members);
+}
+
+bool SwarmMembership::begin(const uint8_t* selfMac, uint8_t requestedCapacity) {
+  if (members != nullptr) return true;
+
+  // Capacity is fixed from here on: one pool, no per-member allocation
+  capacity = constrain(requestedCapacity, 2, PEER_REGISTRY_MAX_CAPACITY);
+  index = new SwarmPeerRegistry(capacity);
+  members = (GossipMember*)calloc(capacity, sizeof(GossipMember));
+  if (members == nullptr || index->getCapacity() != capacity) {
+    Serial.println("❌ Membership: out of memory");
+    delete index;
+    index = nullptr;
+    free(members);
+    members = nullptr;
+    capacity = 0;
+    return false;
+  }
+
+  selfId = index->findOrAdd(selfMac);
+  GossipMember& self = members[selfId];
+  self.heartbeat = 1;
+  self.rssi = GOSSIP_RSSI_UNKNOWN;
+  markAlive(selfId);
+
+  Serial.printf("🗣️ Gossip membership ready (%u members max)\n", (unsigned)capacity);
+  return true;
+}
+
+bool SwarmMembership::isNewerVersion(uint8_t a, uint8_t b) {
+  if (a == 0) return false;   // 0 = no status at all
+  if (b == 0) return true;
+  return (int8_t)(a - b) > 0;
+}
+
+static uint8_t nextVersion(uint8_t version) {
+  return (version == 0xFF) ? 1 : version + 1;
+}
+
+PeerId SwarmMembership::lookup(const uint8_t* mac, bool create) {
+  if (members == nullptr) return INVALID_PEER_ID;
+
+  PeerId id = index->find(mac);
+  if (id != INVALID_PEER_ID || !create) return id;
+
+  // Never let the index reclaim on its own: our pool would go stale
+  if (index->getCount() >= capacity) return INVALID_PEER_ID;
+
+  id = index->findOrAdd(mac);
+  if (id != INVALID_PEER_ID) {
+    memset(&members[id], 0, sizeof(GossipMember));
+    members[id].rssi = GOSSIP_RSSI_UNKNOWN;
+  }
+  return id;
+}
+
+void SwarmMembership::markAlive(PeerId id) {
+  GossipMember& member = members[id];
+  if (member.state != MEMBER_ALIVE) aliveCount++;
+  member.state = MEMBER_ALIVE;
+  member.lastAdvance = millis();
+}
+
+void SwarmMembership::setSelfStatus(const GossipStatus& status) {
+  if (members == nullptr) return;
+
+  GossipMember& self = members[selfId];
+  if (self.statusVersion != 0 && memcmp(&self.status, &status, sizeof(GossipStatus)) == 0) return;
+  self.status = status;
+  // Random first version: after a reboot, peers still holding our old one
+  // are unlikely to hold exactly this one and miss the new status
+  self.statusVersion = (self.statusVersion == 0) ? (uint8_t)random(1, 256) : nextVersion(self.statusVersion);
+}
+
+void SwarmMembership::observeDirect(const uint8_t* mac, int8_t rssi) {
+  PeerId id = lookup(mac, true);
+  if (id == INVALID_PEER_ID || id == selfId) return;
+
+  // Hearing a bot is proof of life, whatever its heartbeat says
+  GossipMember& member = members[id];
+  markAlive(id);
+  member.lastDirect = millis();
+  if (rssi != GOSSIP_RSSI_UNKNOWN) {
+    member.rssi = (member.rssi == GOSSIP_RSSI_UNKNOWN) ? rssi : (int8_t)((3 * member.rssi + rssi) / 4);
+  }
+}
+
+// Returns true if the heartbeat was news
+bool SwarmMembership::mergeHeartbeat(PeerId id, uint16_t heartbeat) {
+  GossipMember& member = members[id];
+
+  if (id == selfId) {
+    // Someone remembers us from before a reboot: jump past it
+    if (isNewer(heartbeat, member.heartbeat)) member.heartbeat = heartbeat + 1;
+    return false;
+  }
+
+  if (member.state == MEMBER_FREE) {
+    member.heartbeat = heartbeat;
+    markAlive(id);
+    return true;
+  }
+  if (!isNewer(heartbeat, member.heartbeat)) return false;
+
+  member.heartbeat = heartbeat;
+  markAlive(id);
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════
+// 🔄 GOSSIP ROUNDS
+// ═══════════════════════════════════════════════════════════
+
+void SwarmMembership::expireMembers() {
+  unsigned long now = millis();
+
+  for (PeerId id = 0; id < capacity; id++) {
+    GossipMember& member = members[id];
+    if (id == selfId || member.state == MEMBER_FREE) continue;
+
+    if (member.state == MEMBER_ALIVE && now - member.lastAdvance > GOSSIP_FAIL_TIMEOUT_MS) {
+      member.state = MEMBER_FAILED;
+      member.lastAdvance = now;  // Now: time of failure
+      member.isNeighbour = false;
+      aliveCount--;
+      stats.membersFailed++;
+    } else if (member.state == MEMBER_FAILED && now - member.lastAdvance > GOSSIP_CLEANUP_MS) {
+      index->release(id);
+      memset(&member, 0, sizeof(GossipMember));
+    }
+  }
+}
+
+void SwarmMembership::selectNeighbours() {
+  unsigned long now = millis();
+  neighbourCount = 0;
+
+  for (PeerId id = 0; id < capacity; id++) {
+    members[id].isNeighbour = false;
+  }
+
+  // Repeated max-pick: k * N with k, N both small
+  while (neighbourCount < GOSSIP_NEIGHBOUR_COUNT) {
+    PeerId best = INVALID_PEER_ID;
+    for (PeerId id = 0; id < capacity; id++) {
+      const GossipMember& member = members[id];
+      if (id == selfId || member.state != MEMBER_ALIVE || member.isNeighbour) continue;
+      if (member.rssi == GOSSIP_RSSI_UNKNOWN || now - member.lastDirect > GOSSIP_DIRECT_TIMEOUT_MS) continue;
+      if (best == INVALID_PEER_ID || member.rssi > members[best].rssi) best = id;
+    }
+    if (best == INVALID_PEER_ID) break;
+    members[best].isNeighbour = true;
+    neighbourCount++;
+  }
+}
+
+uint8_t SwarmMembership::beginRound(uint8_t targets[][6], uint8_t maxTargets) {
+  if (members == nullptr) return 0;
+
+  stats.rounds++;
+  members[selfId].heartbeat++;
+  members[selfId].lastAdvance = millis();
+  expireMembers();
+  selectNeighbours();
+
+  // Fan-out 1 + floor(log2(N))
+  uint8_t fanout = 1;
+  for (uint8_t n = aliveCount; n > 1; n >>= 1) fanout++;
+  fanout = min(fanout, (uint8_t)min((int)GOSSIP_MAX_FANOUT, (int)maxTargets));
+
+  PeerId neighbours[GOSSIP_NEIGHBOUR_COUNT];
+  PeerId others[PEER_REGISTRY_MAX_CAPACITY];
+  uint8_t neighbourTotal = 0, otherTotal = 0;
+  unsigned long now = millis();
+  for (PeerId id = 0; id < capacity; id++) {
+    const GossipMember& member = members[id];
+    if (member.isNeighbour) {
+      neighbours[neighbourTotal++] = id;
+    } else if (id != selfId && member.state == MEMBER_ALIVE && member.lastDirect != 0 &&
+               now - member.lastDirect <= GOSSIP_DIRECT_TIMEOUT_MS) {
+      others[otherTotal++] = id;   // In range, just not among the strongest
+    }
+  }
+
+  // One slot for a random non-neighbour keeps RSSI clusters connected
+  uint8_t chosen = 0;
+  if (otherTotal > 0 && (fanout > 1 || neighbourTotal == 0)) {
+    memcpy(targets[chosen++], index->getMac(others[random(otherTotal)]), 6);
+  }
+
+  // Partial Fisher-Yates over the neighbour set for the rest
+  while (chosen < fanout && neighbourTotal > 0) {
+    uint8_t pick = random(neighbourTotal);
+    memcpy(targets[chosen++], index->getMac(neighbours[pick]), 6);
+    neighbours[pick] = neighbours[--neighbourTotal];
+  }
+  return chosen;
+}
+
+size_t SwarmMembership::buildDigest(GossipDigestPayload& digest, uint8_t flags) {
+  digest.flags = flags;
+  digest.memberCount = aliveCount;
+  digest.entryCount = 0;
+  if (members == nullptr) return GOSSIP_DIGEST_HEADER_SIZE;
+
+  // Self first, then as many others as fit, starting where the last one stopped
+  PeerId id = selfId;
+  for (uint8_t visited = 0; visited <= capacity && digest.entryCount < GOSSIP_MAX_DIGEST_ENTRIES; visited++) {
+    const GossipMember& member = members[id];
+    if (member.state == MEMBER_ALIVE && (visited == 0 || id != selfId)) {
+      GossipDigestEntry& entry = digest.entries[digest.entryCount++];
+      memcpy(entry.mac, index->getMac(id), 6);
+      entry.heartbeat = member.heartbeat;
+      entry.statusVersion = member.statusVersion;
+    }
+    id = (visited == 0) ? digestCursor : (id + 1) % capacity;
+  }
+  digestCursor = id;
+
+  stats.digestsSent++;
+  return GOSSIP_DIGEST_HEADER_SIZE + digest.entryCount * sizeof(GossipDigestEntry);
+}
+
+bool SwarmMembership::appendUpdate(GossipUpdatePayload& update, PeerId id) const {
+  if (update.entryCount >= GOSSIP_MAX_UPDATE_ENTRIES) return false;
+
+  const GossipMember& member = members[id];
+  GossipUpdateEntry& entry = update.entries[update.entryCount++];
+  memcpy(entry.mac, index->getMac(id), 6);
+  entry.heartbeat = member.heartbeat;
+  entry.statusVersion = member.statusVersion;
+  entry.status = member.status;
+  return true;
+}
+
+bool SwarmMembership::mergeDigest(const GossipDigestPayload& digest, size_t length,
+                                  GossipUpdatePayload& update, size_t& updateLength) {
+  update.entryCount = 0;
+  updateLength = 0;
+  if (members == nullptr || length < GOSSIP_DIGEST_HEADER_SIZE ||
+      digest.entryCount > GOSSIP_MAX_DIGEST_ENTRIES ||
+      length < GOSSIP_DIGEST_HEADER_SIZE + digest.entryCount * sizeof(GossipDigestEntry)) {
+    return false;
+  }
+
+  stats.digestsReceived++;
+  lastGossipHeard = millis();
+
+  uint64_t listed = 0;
+  bool senderKnowsMore = digest.memberCount > aliveCount;
+
+  for (uint8_t i = 0; i < digest.entryCount; i++) {
+    const GossipDigestEntry& entry = digest.entries[i];
+    PeerId id = lookup(entry.mac, true);
+    if (id == INVALID_PEER_ID) continue;
+    listed |= (uint64_t)1 << id;
+
+    mergeHeartbeat(id, entry.heartbeat);
+    GossipMember& member = members[id];
+    if (member.state != MEMBER_ALIVE) continue;
+
+    if (id == selfId && isNewerVersion(entry.statusVersion, member.statusVersion)) {
+      // Our status from a previous boot is still circulating
+      member.statusVersion = nextVersion(entry.statusVersion);
+    }
+
+    if (isNewerVersion(entry.statusVersion, member.statusVersion)) {
+      senderKnowsMore = true;
+    } else if (isNewerVersion(member.statusVersion, entry.statusVersion)) {
+      appendUpdate(update, id);
+    }
+  }
+
+  // The sender is missing members altogether: push some, rotating
+  if (digest.memberCount < aliveCount) {
+    for (uint8_t visited = 0; visited < capacity && update.entryCount < GOSSIP_MAX_UPDATE_ENTRIES; visited++) {
+      PeerId id = updateCursor;
+      updateCursor = (updateCursor + 1) % capacity;
+      if (members[id].state == MEMBER_ALIVE && members[id].statusVersion != 0 &&
+          !(listed & ((uint64_t)1 << id))) {
+        appendUpdate(update, id);
+      }
+    }
+  }
+
+  if (update.entryCount > 0) {
+    updateLength = 1 + update.entryCount * sizeof(GossipUpdateEntry);
+    stats.updatesSent++;
+  }
+  return senderKnowsMore && !(digest.flags & GOSSIP_DIGEST_REPLY);
+}
+
+void SwarmMembership::mergeUpdate(const GossipUpdatePayload& update, size_t length) {
+  if (members == nullptr || length < 1 || update.entryCount > GOSSIP_MAX_UPDATE_ENTRIES ||
+      length < 1 + update.entryCount * sizeof(GossipUpdateEntry)) {
+    return;
+  }
+  lastGossipHeard = millis();
+
+  for (uint8_t i = 0; i < update.entryCount; i++) {
+    const GossipUpdateEntry& entry = update.entries[i];
+    PeerId id = lookup(entry.mac, true);
+    if (id == INVALID_PEER_ID) continue;
+
+    mergeHeartbeat(id, entry.heartbeat);
+    GossipMember& member = members[id];
+
+    if (id == selfId) {
+      if (isNewerVersion(entry.statusVersion, member.statusVersion)) {
+        member.statusVersion = nextVersion(entry.statusVersion);
+      }
+      continue;
+    }
+
+    if (member.state != MEMBER_ALIVE || !isNewerVersion(entry.statusVersion, member.statusVersion)) continue;
+    member.statusVersion = entry.statusVersion;
+    member.status = entry.status;
+    stats.entriesApplied++;
+    if (statusListener != nullptr) statusListener(entry.mac, member.status);
+  }
+}
+
+// ═══════════════════════════════════════════════════════════
+// 📊 QUERIES
+// ═══════════════════════════════════════════════════════════
+
+bool SwarmMembership::isGossipMode() const {
+  if (aliveCount > MAX_SWARM_PEERS) return true;
+  return lastGossipHeard != 0 && millis() - lastGossipHeard < GOSSIP_MODE_HOLD_MS;
+}
+
+bool SwarmMembership::isNeighbour(const uint8_t* mac) const {
+  if (members == nullptr) return false;
+  PeerId id = index->find(mac);
+  return id != INVALID_PEER_ID && members[id].isNeighbour;
+}
+
+int8_t SwarmMembership::getRssi(const uint8_t* mac) const {
+  if (members == nullptr) return GOSSIP_RSSI_UNKNOWN;
+  PeerId id = index->find(mac);
+  return (id != INVALID_PEER_ID) ? members[id].rssi : GOSSIP_RSSI_UNKNOWN;
+}
+
+void SwarmMembership::printMembers() const {
+  Serial.printf("🗣️ Membership: %u alive, %u neighbours, %s mode | rounds %lu, digests %lu/%lu, "
+                "updates %lu, applied %lu, failed %lu\n",
+                (unsigned)aliveCount, (unsigned)neighbourCount, isGossipMode() ? "gossip" : "broadcast",
+                (unsigned long)stats.rounds, (unsigned long)stats.digestsSent,
+                (unsigned long)stats.digestsReceived, (unsigned long)stats.updatesSent,
+                (unsigned long)stats.entriesApplied, (unsigned long)stats.membersFailed);
+
+  for (PeerId id = 0; id < capacity; id++) {
+    const GossipMember& member = members[id];
+    if (id == selfId || member.state != MEMBER_ALIVE) continue;
+    const uint8_t* mac = index->getMac(id);
+    Serial.printf("   %02X:%02X:%02X:%02X:%02X:%02X hb=%u v=%u rssi=%d%s gen=%u\n",
+                  mac[0], mac[1], mac[2], mac[3], mac[4], mac[5],
+                  (unsigned)member.heartbeat, (unsigned)member.statusVersion, (int)member.rssi,
+                  member.isNeighbour ? " [N]" : "", (unsigned)member.status.generation);
+  }
+}
@@ -0,0 +1,25 @@
+#include "swarm_node.h"
+#include "swarm_ecosystem_manager.h"
+#include "context_detection.h"
+#include "swarm_intelligence.h"
+
+// ═══════════════════════════════════════════════════════════
+// 🤖 SWARM NODE IMPLEMENTATION
+// ═══════════════════════════════════════════════════════════
+
+static SwarmNode firmwareNode;
+SwarmNode* swarmNode = &firmwareNode;
+
+SwarmNode::SwarmNode() {
+  memset(&self, 0, sizeof(self));
+  self.botType = BOT_UNKNOWN;
+  ecosystem = nullptr;
+  context = nullptr;
+  intelligence = nullptr;
+}
+
+SwarmNode::~SwarmNode() {
+  delete ecosystem;
+  delete context;
+  delete intelligence;
+}
@@ -0,0 +1,169 @@
+#include "swarm_peer_registry.h"
+
+// ═══════════════════════════════════════════════════════════
+// 🗂️ PEER REGISTRY IMPLEMENTATION
+// ═══════════════════════════════════════════════════════════
+
+SwarmPeerRegistry::SwarmPeerRegistry(uint8_t requestedCapacity) {
+  capacity = constrain(requestedCapacity, 1, PEER_REGISTRY_MAX_CAPACITY);
+  uint16_t slotCount = 2;
+  while (slotCount < 2 * capacity) slotCount <<= 1;
+  slotMask = slotCount - 1;
+
+  // One allocation for every table; the id-indexed arrays come first so
+  // the uint32_t array stays aligned
+  size_t bytes = capacity * (sizeof(uint32_t) + 6 + sizeof(bool)) + slotCount;
+  uint8_t* block = (uint8_t*)calloc(1, bytes);
+  if (block == nullptr) {
+    Serial.println("❌ Peer registry: out of memory");
+    capacity = 0;
+    lastSeen = nullptr;
+    macs = nullptr;
+    used = nullptr;
+    slots = nullptr;
+  } else {
+    lastSeen = (uint32_t*)block;
+    macs = (uint8_t (*)[6])(block + capacity * sizeof(uint32_t));
+    used = (bool*)(block + capacity * (sizeof(uint32_t) + 6));
+    slots = (int8_t*)(block + capacity * (sizeof(uint32_t) + 6 + sizeof(bool)));
+    memset(slots, -1, slotCount);
+  }
+  count = 0;
+  listenerCount = 0;
+  retentionRank = nullptr;
+}
+
+SwarmPeerRegistry::~SwarmPeerRegistry() {
+  free(lastSeen);
+}
+
+// FNV-1a over all six bytes; the vendor prefix alone would cluster
+uint32_t SwarmPeerRegistry::hashMac(const uint8_t* mac) {
+  uint32_t hash = 2166136261u;
+  for (int i = 0; i < 6; i++) {
+    hash = (hash ^ mac[i]) * 16777619u;
+  }
+  return hash;
+}
+
+int SwarmPeerRegistry::findSlot(const uint8_t* mac) const {
+  uint32_t slot = hashMac(mac) & slotMask;
+
+  if (slots == nullptr) return -1;
+  for (int probes = 0; probes <= slotMask; probes++) {
+    int8_t id = slots[slot];
+    if (id < 0) return -1;
+    if (memcmp(macs[id], mac, 6) == 0) return slot;
+    slot = (slot + 1) & slotMask;
+  }
+  return -1;
+}
+
+PeerId SwarmPeerRegistry::find(const uint8_t* mac) const {
+  int slot = findSlot(mac);
+  return (slot < 0) ? INVALID_PEER_ID : slots[slot];
+}
+
+PeerId SwarmPeerRegistry::findOrAdd(const uint8_t* mac) {
+  PeerId id = find(mac);
+  if (id != INVALID_PEER_ID) {
+    touch(id);
+    return id;
+  }
+
+  if (count >= capacity) {
+    if (capacity == 0) return INVALID_PEER_ID;
+    id = reclaimOldest();
+    if (id == INVALID_PEER_ID) id = evictWeakest(mac);
+    if (id == INVALID_PEER_ID) return INVALID_PEER_ID;
+  } else {
+    for (id = 0; id < capacity && used[id]; id++) {}
+  }
+
+  memcpy(macs[id], mac, 6);
+  used[id] = true;
+  lastSeen[id] = millis();
+  count++;
+
+  uint32_t slot = hashMac(mac) & slotMask;
+  while (slots[slot] >= 0) {
+    slot = (slot + 1) & slotMask;
+  }
+  slots[slot] = id;
+  return id;
+}
+
+void SwarmPeerRegistry::touch(PeerId id) {
+  if (isValid(id)) lastSeen[id] = millis();
+}
+
+PeerId SwarmPeerRegistry::reclaimOldest() {
+  PeerId oldest = INVALID_PEER_ID;
+  uint32_t now = millis();
+
+  for (PeerId id = 0; id < capacity; id++) {
+    if (!used[id] || now - lastSeen[id] < PEER_RECLAIM_AFTER_MS) continue;
+    if (oldest == INVALID_PEER_ID || (int32_t)(lastSeen[id] - lastSeen[oldest]) < 0) {
+      oldest = id;
+    }
+  }
+
+  if (oldest != INVALID_PEER_ID) release(oldest);
+  return oldest;
+}
+
+// Nobody is quiet enough to reclaim: make room only for a better peer
+PeerId SwarmPeerRegistry::evictWeakest(const uint8_t* newcomer) {
+  if (retentionRank == nullptr) return INVALID_PEER_ID;
+  int16_t weakestRank = retentionRank(newcomer);
+  PeerId weakest = INVALID_PEER_ID;
+
+  for (PeerId id = 0; id < capacity; id++) {
+    if (!used[id]) continue;
+    int16_t rank = retentionRank(macs[id]);
+    if (rank == PEER_RANK_KEEP) continue;
+    bool staler = weakest != INVALID_PEER_ID && (int32_t)(lastSeen[id] - lastSeen[weakest]) < 0;
+    if (rank < weakestRank || (rank == weakestRank && staler)) {
+      weakest = id;
+      weakestRank = rank;
+    }
+  }
+
+  if (weakest != INVALID_PEER_ID) release(weakest);
+  return weakest;
+}
+
+void SwarmPeerRegistry::release(PeerId id) {
+  if (!isValid(id)) return;
+
+  for (uint8_t i = 0; i < listenerCount; i++) {
+    listeners[i](id);
+  }
+
+  // Backward-shift deletion keeps every probe chain gap-free
+  int hole = findSlot(macs[id]);
+  slots[hole] = -1;
+  uint32_t slot = (hole + 1) & slotMask;
+  while (slots[slot] >= 0) {
+    uint32_t home = hashMac(macs[slots[slot]]) & slotMask;
+    // Move the entry back unless its home lies cyclically in (hole, slot]
+    bool homeInRange = (hole <= (int)slot) ? (home > (uint32_t)hole && home <= slot)
+                                           : (home > (uint32_t)hole || home <= slot);
+    if (!homeInRange) {
+      slots[hole] = slots[slot];
+      slots[slot] = -1;
+      hole = slot;
+    }
+    slot = (slot + 1) & slotMask;
+  }
+
+  used[id] = false;
+  memset(macs[id], 0, 6);
+  count--;
+}
+
+bool SwarmPeerRegistry::addReleaseListener(PeerReleaseListener listener) {
+  if (listenerCount >= PEER_MAX_RELEASE_LISTENERS) return false;
+  listeners[listenerCount++] = listener;
+  return true;
+}
@@ -0,0 +1,299 @@
+#include "swarm_persistent_store.h"
+#include <rom/crc.h>
+
+// ═══════════════════════════════════════════════════════════
+// 💾 PERSISTENT STORE IMPLEMENTATION
+// ═══════════════════════════════════════════════════════════
+// On flash each record is [payload][CRC32 of payload], stored as one
+// NVS blob under the record's key. The "toc" blob lists the layout of
+// every record written; it is rewritten after the records it describes,
+// so a power cut between the two leaves the old entry, which no longer
+// matches, and the record is simply not loaded.
+
+static const char* MANIFEST_KEY = "toc";
+
+SwarmPersistentStore::SwarmPersistentStore() {
+  opened = false;
+  recordCount = 0;
+  memset(records, 0, sizeof(records));
+  memset(&stats, 0, sizeof(stats));
+  memset(&manifest, 0, sizeof(manifest));
+  manifestState = MANIFEST_MISSING;
+  manifestDirty = false;
+}
+
+bool SwarmPersistentStore::begin(const char* nameSpace, uint16_t schemaVersion) {
+  opened = prefs.begin(nameSpace, false);
+  if (!opened) {
+    Serial.printf("❌ NVS namespace '%s' unavailable\n", nameSpace);
+    return false;
+  }
+
+  readManifest(schemaVersion);
+  if (manifestState == MANIFEST_SCHEMA_CHANGED || manifestState == MANIFEST_CORRUPT) {
+    // Nothing in here can be trusted any more; free the space
+    Serial.printf("⚠️ Store '%s': %s manifest, starting empty\n", nameSpace,
+                  manifestState == MANIFEST_CORRUPT ? "corrupt" : "old schema");
+    prefs.clear();
+  }
+  return true;
+}
+
+uint32_t SwarmPersistentStore::checksum(const void* data, size_t length) {
+  return crc32_le(0, (const uint8_t*)data, length);
+}
+
+int SwarmPersistentStore::addRecord(const char* key, void* data, size_t length, uint8_t version) {
+  if (recordCount >= STORE_MAX_RECORDS || length == 0 || length > STORE_MAX_RECORD_SIZE ||
+      strlen(key) >= STORE_KEY_LENGTH) {
+    Serial.printf("❌ Store: cannot register record '%s' (%u bytes)\n", key, (unsigned)length);
+    return -1;
+  }
+
+  // The manifest identifies records by hash only
+  uint32_t keyHash = checksum(key, strlen(key));
+  for (int i = 0; i < recordCount; i++) {
+    if (records[i].keyHash == keyHash) {
+      Serial.printf("❌ Store: record '%s' clashes with '%s'\n", key, records[i].key);
+      return -1;
+    }
+  }
+
+  StoreRecord& record = records[recordCount];
+  strncpy(record.key, key, STORE_KEY_LENGTH - 1);
+  record.keyHash = keyHash;
+  record.data = data;
+  record.length = (uint16_t)length;
+  record.version = version;
+  record.stored = false;
+  record.dirty = false;
+  return recordCount++;
+}
+
+// ═══════════════════════════════════════════════════════════
+// 📖 MANIFEST & LOAD
+// ═══════════════════════════════════════════════════════════
+
+void SwarmPersistentStore::readManifest(uint16_t schemaVersion) {
+  manifestDirty = false;
+  manifestState = MANIFEST_MISSING;
+
+  if (prefs.isKey(MANIFEST_KEY)) {
+    size_t length = prefs.getBytesLength(MANIFEST_KEY);
+    manifestState = MANIFEST_CORRUPT;
+
+    if (length >= sizeof(StoreManifestHeader) && length <= sizeof(manifest) &&
+        prefs.getBytes(MANIFEST_KEY, &manifest, length) == length) {
+      const StoreManifestHeader& header = manifest.header;
+      size_t entriesLength = header.entryCount * sizeof(StoreManifestEntry);
+
+      if (header.magic == STORE_MANIFEST_MAGIC && header.formatVersion == STORE_FORMAT_VERSION &&
+          sizeof(StoreManifestHeader) + entriesLength == length &&
+          checksum(manifest.entries, entriesLength) == header.entriesCrc) {
+        manifestState = (header.schemaVersion == schemaVersion) ? MANIFEST_VALID : MANIFEST_SCHEMA_CHANGED;
+      }
+    }
+  }
+
+  if (manifestState != MANIFEST_VALID) {
+    memset(&manifest, 0, sizeof(manifest));
+  }
+  manifest.header.magic = STORE_MANIFEST_MAGIC;
+  manifest.header.formatVersion = STORE_FORMAT_VERSION;
+  manifest.header.schemaVersion = schemaVersion;
+}
+
+int SwarmPersistentStore::findManifestEntry(uint32_t keyHash) const {
+  for (int i = 0; i < manifest.header.entryCount; i++) {
+    if (manifest.entries[i].keyHash == keyHash) return i;
+  }
+  return -1;
+}
+
+bool SwarmPersistentStore::load(int id, void* destination) {
+  if (!opened || id < 0 || id >= recordCount) return false;
+  StoreRecord& record = records[id];
+
+  // Layout check against the manifest, before any record read
+  int entry = findManifestEntry(record.keyHash);
+  if (entry < 0) return false;
+  if (manifest.entries[entry].length != record.length || manifest.entries[entry].version != record.version) {
+    stats.layoutMismatches++;
+    Serial.printf("⚠️ Store: '%s' layout changed (v%u → v%u), using defaults\n", record.key,
+                  (unsigned)manifest.entries[entry].version, (unsigned)record.version);
+    return false;
+  }
+
+  size_t expected = record.length + sizeof(uint32_t);
+  if (prefs.getBytesLength(record.key) != expected ||
+      prefs.getBytes(record.key, scratch, expected) != expected) {
+    stats.loadFailures++;
+    return false;
+  }
+
+  uint32_t crc;
+  memcpy(&crc, scratch + record.length, sizeof(crc));
+  if (crc != checksum(scratch, record.length)) {
+    stats.loadFailures++;
+    Serial.printf("⚠️ Store: CRC mismatch on '%s', ignoring it\n", record.key);
+    return false;
+  }
+
+  memcpy(destination ? destination : record.data, scratch, record.length);
+  record.storedCrc = crc;
+  record.stored = true;
+  record.dirty = false;
+  return true;
+}
+
+bool SwarmPersistentStore::isStored(int id) const {
+  return id >= 0 && id < recordCount && records[id].stored;
+}
+
+// ═══════════════════════════════════════════════════════════
+// ✍️ DIRTY TRACKING & DEFERRED WRITES
+// ═══════════════════════════════════════════════════════════
+
+bool SwarmPersistentStore::stage(int id) {
+  if (id < 0 || id >= recordCount) return false;
+  StoreRecord& record = records[id];
+
+  if (record.stored && checksum(record.data, record.length) == record.storedCrc) {
+    // Changed back to what flash already holds
+    record.dirty = false;
+    stats.unchangedSkips++;
+    return false;
+  }
+
+  if (!record.dirty) {
+    record.dirty = true;
+    record.dirtySince = millis();
+  }
+  return true;
+}
+
+int SwarmPersistentStore::oldestDirty() const {
+  int oldest = -1;
+  for (int i = 0; i < recordCount; i++) {
+    if (records[i].dirty &&
+        (oldest < 0 || (long)(records[i].dirtySince - records[oldest].dirtySince) < 0)) {
+      oldest = i;
+    }
+  }
+  return oldest;
+}
+
+bool SwarmPersistentStore::writeRecord(StoreRecord& record) {
+  // Snapshot into scratch first so payload and CRC always agree
+  memcpy(scratch, record.data, record.length);
+  uint32_t crc = checksum(scratch, record.length);
+  record.dirty = false;
+
+  if (record.stored && crc == record.storedCrc) {
+    stats.unchangedSkips++;
+    return true;
+  }
+
+  memcpy(scratch + record.length, &crc, sizeof(crc));
+  size_t total = record.length + sizeof(crc);
+  if (prefs.putBytes(record.key, scratch, total) != total) {
+    stats.writeErrors++;
+    record.dirty = true; // Try again on a later flush
+    return false;
+  }
+
+  record.storedCrc = crc;
+  record.stored = true;
+  stats.writes++;
+  stats.bytesWritten += total;
+  updateManifestEntry(record);
+  return true;
+}
+
+void SwarmPersistentStore::updateManifestEntry(const StoreRecord& record) {
+  StoreManifestHeader& header = manifest.header;
+  int entry = findManifestEntry(record.keyHash);
+
+  if (entry < 0) {
+    if (header.entryCount >= STORE_MAX_RECORDS) {
+      // Full: drop entries of records this firmware no longer registers
+      int kept = 0;
+      for (int i = 0; i < header.entryCount; i++) {
+        bool registered = false;
+        for (int j = 0; j < recordCount && !registered; j++) {
+          registered = (records[j].keyHash == manifest.entries[i].keyHash);
+        }
+        if (registered) manifest.entries[kept++] = manifest.entries[i];
+      }
+      header.entryCount = kept;
+    }
+    entry = header.entryCount++;
+  } else if (manifest.entries[entry].length == record.length &&
+             manifest.entries[entry].version == record.version) {
+    return;
+  }
+
+  manifest.entries[entry].keyHash = record.keyHash;
+  manifest.entries[entry].length = record.length;
+  manifest.entries[entry].version = record.version;
+  manifest.entries[entry].reserved = 0;
+  manifestDirty = true;
+}
+
+bool SwarmPersistentStore::writeManifest() {
+  size_t entriesLength = manifest.header.entryCount * sizeof(StoreManifestEntry);
+  manifest.header.entriesCrc = checksum(manifest.entries, entriesLength);
+
+  size_t total = sizeof(StoreManifestHeader) + entriesLength;
+  if (prefs.putBytes(MANIFEST_KEY, &manifest, total) != total) {
+    stats.writeErrors++;
+    return false;
+  }
+
+  manifestDirty = false;
+  manifestState = MANIFEST_VALID;
+  stats.writes++;
+  stats.bytesWritten += total;
+  return true;
+}
+
+size_t SwarmPersistentStore::flush(uint32_t budgetUs) {
+  if (!opened) return getDirtyCount();
+
+  uint32_t start = micros();
+  int attempts = 0;
+
+  int id;
+  while ((id = oldestDirty()) >= 0 && attempts < recordCount) {
+    attempts++;
+    if (!writeRecord(records[id])) break; // Flash trouble: leave the rest for later
+    if (micros() - start >= budgetUs) break;
+  }
+  if (manifestDirty) writeManifest();
+
+  uint32_t elapsed = micros() - start;
+  if (elapsed > stats.maxFlushUs) stats.maxFlushUs = elapsed;
+  return getDirtyCount();
+}
+
+size_t SwarmPersistentStore::getDirtyCount() const {
+  size_t dirty = 0;
+  for (int i = 0; i < recordCount; i++) {
+    if (records[i].dirty) dirty++;
+  }
+  return dirty;
+}
+
+unsigned long SwarmPersistentStore::getOldestDirtyAge() const {
+  int id = oldestDirty();
+  return (id < 0) ? 0 : millis() - records[id].dirtySince;
+}
+
+void SwarmPersistentStore::printStats() const {
+  Serial.printf("💾 Store: %u records, %u dirty, %lu writes (%lu bytes), %lu unchanged, "
+                "%lu load failures, %lu layout mismatches, %lu write errors, max flush %luus\n",
+                (unsigned)recordCount, (unsigned)getDirtyCount(),
+                (unsigned long)stats.writes, (unsigned long)stats.bytesWritten,
+                (unsigned long)stats.unchangedSkips, (unsigned long)stats.loadFailures,
+                (unsigned long)stats.layoutMismatches, (unsigned long)stats.writeErrors, (unsigned long)stats.maxFlushUs);
+}
@@ -0,0 +1,301 @@
+#include "swarm_spatial.h"
+
+// ═══════════════════════════════════════════════════════════
+// 🗺️ SWARM SPATIAL INDEX IMPLEMENTATION
+// ═══════════════════════════════════════════════════════════
+
+#define SPATIAL_HALF_DIM (SPATIAL_GRID_DIM / 2)
+
+SwarmSpatialIndex::SwarmSpatialIndex() {
+  clear();
+}
+
+void SwarmSpatialIndex::clear() {
+  memset(explored, 0, sizeof(explored));
+  memset(peerBuckets, INVALID_PEER_ID, sizeof(peerBuckets));
+  memset(peerNext, INVALID_PEER_ID, sizeof(peerNext));
+  for (uint8_t i = 0; i < PEER_REGISTRY_CAPACITY; i++) peerCell[i] = -1;
+  memset(zoneMasks, 0, sizeof(zoneMasks));
+  memset(zoneRects, 0, sizeof(zoneRects));
+  activeZones = 0;
+}
+
+void SwarmSpatialIndex::cellOf(float x, float y, int& cx, int& cy) {
+  cx = (int)floorf(x / SPATIAL_CELL_SIZE) + SPATIAL_HALF_DIM;
+  cy = (int)floorf(y / SPATIAL_CELL_SIZE) + SPATIAL_HALF_DIM;
+  cx = constrain(cx, 0, SPATIAL_GRID_DIM - 1);
+  cy = constrain(cy, 0, SPATIAL_GRID_DIM - 1);
+}
+
+void SwarmSpatialIndex::cellCenter(int cx, int cy, float& x, float& y) {
+  x = (cx - SPATIAL_HALF_DIM + 0.5f) * SPATIAL_CELL_SIZE;
+  y = (cy - SPATIAL_HALF_DIM + 0.5f) * SPATIAL_CELL_SIZE;
+}
+
+void SwarmSpatialIndex::cellRange(const SpatialRect& rect, int& minX, int& minY, int& maxX, int& maxY) {
+  cellOf(min(rect.minX, rect.maxX), min(rect.minY, rect.maxY), minX, minY);
+  cellOf(max(rect.minX, rect.maxX), max(rect.minY, rect.maxY), maxX, maxY);
+}
+
+// Bits minX..maxX of a row
+uint32_t SwarmSpatialIndex::rowMask(int minX, int maxX) {
+  int width = maxX - minX + 1;
+  if (width <= 0) return 0;
+  if (width >= 32) return 0xFFFFFFFFUL;
+  return ((1UL << width) - 1) << minX;
+}
+
+bool SwarmSpatialIndex::intersects(const SpatialRect& a, const SpatialRect& b) {
+  return a.minX <= b.maxX && b.minX <= a.maxX &&
+         a.minY <= b.maxY && b.minY <= a.maxY;
+}
+
+// ═══════════════════════════════════════════════════════════
+// 🧭 COVERAGE
+// ═══════════════════════════════════════════════════════════
+
+void SwarmSpatialIndex::markExplored(float x, float y) {
+  int cx, cy;
+  cellOf(x, y, cx, cy);
+  explored[cy] |= 1UL << cx;
+}
+
+void SwarmSpatialIndex::markExplored(const SpatialRect& rect) {
+  int minX, minY, maxX, maxY;
+  cellRange(rect, minX, minY, maxX, maxY);
+  uint32_t mask = rowMask(minX, maxX);
+  for (int cy = minY; cy <= maxY; cy++) explored[cy] |= mask;
+}
+
+bool SwarmSpatialIndex::isExplored(float x, float y) const {
+  int cx, cy;
+  cellOf(x, y, cx, cy);
+  return (explored[cy] >> cx) & 1;
+}
+
+uint32_t SwarmSpatialIndex::mergeExploredRow(uint8_t row, uint32_t bits) {
+  if (row >= SPATIAL_GRID_DIM) return 0;
+  uint32_t news = bits & ~explored[row];
+  explored[row] |= news;
+  return news;
+}
+
+float SwarmSpatialIndex::exploredFraction(const SpatialRect& rect) const {
+  int minX, minY, maxX, maxY;
+  cellRange(rect, minX, minY, maxX, maxY);
+  uint32_t mask = rowMask(minX, maxX);
+
+  uint16_t done = 0;
+  for (int cy = minY; cy <= maxY; cy++) done += __builtin_popcount(explored[cy] & mask);
+  return (float)done / ((maxX - minX + 1) * (maxY - minY + 1));
+}
+
+// Rings of growing Chebyshev radius around the query cell. A cell in
+// ring r is at least (r - 0.5) cells from any point of the centre cell,
+// so once that exceeds the best distance found no later ring can win.
+bool SwarmSpatialIndex::nearestUnexplored(float x, float y, float& outX, float& outY) const {
+  int qx, qy;
+  cellOf(x, y, qx, qy);
+
+  float bestD2 = -1.0f;
+  for (int r = 0; r < SPATIAL_GRID_DIM; r++) {
+    if (bestD2 >= 0.0f) {
+      float bound = (r - 0.5f) * SPATIAL_CELL_SIZE;
+      if (bound > 0.0f && bound * bound > bestD2) break;
+    }
+
+    int minX = max(qx - r, 0);
+    int maxX = min(qx + r, SPATIAL_GRID_DIM - 1);
+    for (int cy = max(qy - r, 0); cy <= min(qy + r, SPATIAL_GRID_DIM - 1); cy++) {
+      // Whole span on the ring's top/bottom rows, only the two ends elsewhere
+      uint32_t ring = (cy == qy - r || cy == qy + r)
+          ? rowMask(minX, maxX)
+          : (((qx - r >= 0) ? 1UL << (qx - r) : 0) | ((qx + r < SPATIAL_GRID_DIM) ? 1UL << (qx + r) : 0));
+      uint32_t open = ~explored[cy] & ring;
+
+      while (open) {
+        int cx = __builtin_ctz(open);
+        open &= open - 1;
+        float px, py;
+        cellCenter(cx, cy, px, py);
+        float d2 = (px - x) * (px - x) + (py - y) * (py - y);
+        if (bestD2 < 0.0f || d2 < bestD2) {
+          bestD2 = d2;
+          outX = px;
+          outY = py;
+        }
+      }
+    }
+  }
+  return bestD2 >= 0.0f;
+}
+
+// ═══════════════════════════════════════════════════════════
+// 🤖 PEER HASH
+// ═══════════════════════════════════════════════════════════
+
+uint8_t SwarmSpatialIndex::bucketOf(int16_t cell) {
+  return (uint8_t)(((uint16_t)cell * 40503U) >> 8) & (SPATIAL_PEER_BUCKETS - 1);
+}
+
+void SwarmSpatialIndex::unlinkPeer(PeerId id) {
+  int8_t* link = &peerBuckets[bucketOf(peerCell[id])];
+  while (*link != INVALID_PEER_ID && *link != id) link = &peerNext[*link];
+  if (*link == id) *link = peerNext[id];
+  peerNext[id] = INVALID_PEER_ID;
+  peerCell[id] = -1;
+}
+
+void SwarmSpatialIndex::updatePeer(PeerId id, float x, float y) {
+  if (id < 0 || id >= PEER_REGISTRY_CAPACITY) return;
+
+  int cx, cy;
+  cellOf(x, y, cx, cy);
+  int16_t cell = cy * SPATIAL_GRID_DIM + cx;
+  peerX[id] = x;
+  peerY[id] = y;
+  if (peerCell[id] == cell) return;           // Same cell: the usual case for a position update
+
+  if (peerCell[id] >= 0) unlinkPeer(id);
+  uint8_t bucket = bucketOf(cell);
+  peerCell[id] = cell;
+  peerNext[id] = peerBuckets[bucket];
+  peerBuckets[bucket] = id;
+}
+
+void SwarmSpatialIndex::removePeer(PeerId id) {
+  if (id < 0 || id >= PEER_REGISTRY_CAPACITY || peerCell[id] < 0) return;
+  unlinkPeer(id);
+}
+
+PeerId SwarmSpatialIndex::nearestPeer(float x, float y, float maxRange, PeerId exclude) const {
+  int qx, qy;
+  cellOf(x, y, qx, qy);
+  int maxRing = min((int)(maxRange / SPATIAL_CELL_SIZE) + 1, SPATIAL_GRID_DIM - 1);
+
+  PeerId best = INVALID_PEER_ID;
+  float bestD2 = maxRange * maxRange;
+
+  // Wide searches: fewer peers than cells, check every tracked peer
+  if ((2 * maxRing + 1) * (2 * maxRing + 1) > PEER_REGISTRY_CAPACITY) {
+    for (PeerId id = 0; id < PEER_REGISTRY_CAPACITY; id++) {
+      if (peerCell[id] < 0 || id == exclude) continue;
+      float d2 = (peerX[id] - x) * (peerX[id] - x) + (peerY[id] - y) * (peerY[id] - y);
+      if (d2 <= bestD2) {
+        bestD2 = d2;
+        best = id;
+      }
+    }
+    return best;
+  }
+
+  // A peer in ring r is at least (r - 1) cells away: it can sit anywhere in its cell
+  for (int r = 0; r <= maxRing; r++) {
+    float bound = (r - 1) * SPATIAL_CELL_SIZE;
+    if (best != INVALID_PEER_ID && bound > 0.0f && bound * bound > bestD2) break;
+
+    for (int cy = max(qy - r, 0); cy <= min(qy + r, SPATIAL_GRID_DIM - 1); cy++) {
+      bool edgeRow = (cy == qy - r || cy == qy + r);
+      int step = edgeRow ? 1 : max(2 * r, 1);
+      for (int cx = qx - r; cx <= qx + r; cx += step) {
+        if (cx < 0 || cx >= SPATIAL_GRID_DIM) continue;
+        int16_t cell = cy * SPATIAL_GRID_DIM + cx;
+
+        for (int8_t id = peerBuckets[bucketOf(cell)]; id != INVALID_PEER_ID; id = peerNext[id]) {
+          if (peerCell[id] != cell || id == exclude) continue;
+          float d2 = (peerX[id] - x) * (peerX[id] - x) + (peerY[id] - y) * (peerY[id] - y);
+          if (d2 <= bestD2) {
+            bestD2 = d2;
+            best = id;
+          }
+        }
+      }
+    }
+  }
+  return best;
+}
+
+uint8_t SwarmSpatialIndex::peersInRect(const SpatialRect& rect, PeerId* out, uint8_t maxOut) const {
+  int minX, minY, maxX, maxY;
+  cellRange(rect, minX, minY, maxX, maxY);
+  uint8_t found = 0;
+
+  // Large rectangles: fewer peers than cells, check every tracked peer
+  if ((maxX - minX + 1) * (maxY - minY + 1) > PEER_REGISTRY_CAPACITY) {
+    for (PeerId id = 0; id < PEER_REGISTRY_CAPACITY && found < maxOut; id++) {
+      if (peerCell[id] < 0) continue;
+      if (peerX[id] >= rect.minX && peerX[id] <= rect.maxX &&
+          peerY[id] >= rect.minY && peerY[id] <= rect.maxY) {
+        out[found++] = id;
+      }
+    }
+    return found;
+  }
+
+  for (int cy = minY; cy <= maxY; cy++) {
+    for (int cx = minX; cx <= maxX; cx++) {
+      int16_t cell = cy * SPATIAL_GRID_DIM + cx;
+      for (int8_t id = peerBuckets[bucketOf(cell)]; id != INVALID_PEER_ID; id = peerNext[id]) {
+        if (found >= maxOut) return found;
+        if (peerCell[id] != cell) continue;
+        if (peerX[id] >= rect.minX && peerX[id] <= rect.maxX &&
+            peerY[id] >= rect.minY && peerY[id] <= rect.maxY) {
+          out[found++] = id;
+        }
+      }
+    }
+  }
+  return found;
+}
+
+// ═══════════════════════════════════════════════════════════
+// 🧩 ZONES
+// ═══════════════════════════════════════════════════════════
+
+void SwarmSpatialIndex::addZoneMask(uint8_t zone, const SpatialRect& rect, bool set) {
+  int minX, minY, maxX, maxY;
+  cellRange(rect, minX, minY, maxX, maxY);
+  uint16_t bit = 1U << zone;
+
+  for (int by = minY / SPATIAL_ZONE_BLOCK; by <= maxY / SPATIAL_ZONE_BLOCK; by++) {
+    for (int bx = minX / SPATIAL_ZONE_BLOCK; bx <= maxX / SPATIAL_ZONE_BLOCK; bx++) {
+      if (set) zoneMasks[by][bx] |= bit;
+      else zoneMasks[by][bx] &= ~bit;
+    }
+  }
+}
+
+void SwarmSpatialIndex::setZone(uint8_t zone, const SpatialRect& rect) {
+  if (zone >= SPATIAL_MAX_ZONES) return;
+  clearZone(zone);
+  zoneRects[zone] = rect;
+  activeZones |= 1U << zone;
+  addZoneMask(zone, rect, true);
+}
+
+void SwarmSpatialIndex::clearZone(uint8_t zone) {
+  if (zone >= SPATIAL_MAX_ZONES || !(activeZones & (1U << zone))) return;
+  addZoneMask(zone, zoneRects[zone], false);
+  activeZones &= ~(1U << zone);
+}
+
+uint16_t SwarmSpatialIndex::zonesOverlapping(const SpatialRect& rect) const {
+  int minX, minY, maxX, maxY;
+  cellRange(rect, minX, minY, maxX, maxY);
+
+  uint16_t candidates = 0;
+  for (int by = minY / SPATIAL_ZONE_BLOCK; by <= maxY / SPATIAL_ZONE_BLOCK; by++) {
+    for (int bx = minX / SPATIAL_ZONE_BLOCK; bx <= maxX / SPATIAL_ZONE_BLOCK; bx++) {
+      candidates |= zoneMasks[by][bx];
+    }
+  }
+
+  // Blocks are coarse: confirm each candidate against its real rectangle
+  uint16_t overlapping = 0;
+  while (candidates) {
+    int zone = __builtin_ctz(candidates);
+    candidates &= candidates - 1;
+    if (intersects(zoneRects[zone], rect)) overlapping |= 1U << zone;
+  }
+  return overlapping;
+}
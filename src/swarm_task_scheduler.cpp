@@ -0,0 +1,381 @@
+#include "swarm_task_scheduler.h"
+#include "swarm_node.h"
+
+// ═══════════════════════════════════════════════════════════
+// 🎯 SWARM TASK SCHEDULER IMPLEMENTATION
+// ═══════════════════════════════════════════════════════════
+
+static const uint8_t NO_MAC[6] = {0, 0, 0, 0, 0, 0};
+
+static bool deadlineReached(uint32_t deadline, unsigned long now) {
+  return (int32_t)(now - deadline) >= 0;
+}
+
+static bool isFinished(TaskStatus status) {
+  return status == TASK_STATUS_COMPLETED || status == TASK_STATUS_FAILED ||
+         status == TASK_STATUS_CANCELLED;
+}
+
+SwarmTaskScheduler::SwarmTaskScheduler() {
+  memset(tasks, 0, sizeof(tasks));
+  memset(idTable, TASK_NO_SLOT, sizeof(idTable));
+  memset(heap, 0, sizeof(heap));
+  memset(heapIndex, 0, sizeof(heapIndex));
+  memset(statusCount, 0, sizeof(statusCount));
+  memset(peerLoad, 0, sizeof(peerLoad));
+  for (uint8_t i = 0; i < MAX_SWARM_TASKS; i++) {
+    assignee[i] = INVALID_PEER_ID;
+    lapsedBy[i] = INVALID_PEER_ID;
+  }
+  heapSize = 0;
+  freeMask = 0xFFFFFFFFUL;
+  pendingMask = 0;
+  taskCount = 0;
+  highPriorityCount = 0;
+  nextTaskId = 1;
+  expiredListener = nullptr;
+  memset(&stats, 0, sizeof(stats));
+}
+
+// ═══════════════════════════════════════════════════════════
+// 🔑 ID → SLOT TABLE (linear probing, backward-shift deletion)
+// ═══════════════════════════════════════════════════════════
+
+uint8_t SwarmTaskScheduler::slotOf(uint16_t taskId) const {
+  if (taskId == 0) return TASK_NO_SLOT;
+  for (uint8_t probe = 0, b = taskId & (TASK_ID_BUCKETS - 1); probe < TASK_ID_BUCKETS;
+       probe++, b = (b + 1) & (TASK_ID_BUCKETS - 1)) {
+    uint8_t slot = idTable[b];
+    if (slot == TASK_NO_SLOT) return TASK_NO_SLOT;
+    if (tasks[slot].taskId == taskId) return slot;
+  }
+  return TASK_NO_SLOT;
+}
+
+void SwarmTaskScheduler::idInsert(uint16_t taskId, uint8_t slot) {
+  uint8_t b = taskId & (TASK_ID_BUCKETS - 1);
+  while (idTable[b] != TASK_NO_SLOT) b = (b + 1) & (TASK_ID_BUCKETS - 1);
+  idTable[b] = slot;
+}
+
+void SwarmTaskScheduler::idRemove(uint16_t taskId) {
+  uint8_t b = taskId & (TASK_ID_BUCKETS - 1);
+  while (idTable[b] != TASK_NO_SLOT && tasks[idTable[b]].taskId != taskId) {
+    b = (b + 1) & (TASK_ID_BUCKETS - 1);
+  }
+  if (idTable[b] == TASK_NO_SLOT) return;
+
+  // Pull later entries of the run back so probing never stops early
+  uint8_t hole = b;
+  for (uint8_t next = (hole + 1) & (TASK_ID_BUCKETS - 1); idTable[next] != TASK_NO_SLOT;
+       next = (next + 1) & (TASK_ID_BUCKETS - 1)) {
+    uint8_t home = tasks[idTable[next]].taskId & (TASK_ID_BUCKETS - 1);
+    if (((next - home) & (TASK_ID_BUCKETS - 1)) >= ((next - hole) & (TASK_ID_BUCKETS - 1))) {
+      idTable[hole] = idTable[next];
+      hole = next;
+    }
+  }
+  idTable[hole] = TASK_NO_SLOT;
+}
+
+SwarmTask* SwarmTaskScheduler::find(uint16_t taskId) {
+  uint8_t slot = slotOf(taskId);
+  return slot == TASK_NO_SLOT ? nullptr : &tasks[slot];
+}
+
+const SwarmTask* SwarmTaskScheduler::find(uint16_t taskId) const {
+  uint8_t slot = slotOf(taskId);
+  return slot == TASK_NO_SLOT ? nullptr : &tasks[slot];
+}
+
+// ═══════════════════════════════════════════════════════════
+// ⏱️ DEADLINE HEAP
+// ═══════════════════════════════════════════════════════════
+
+bool SwarmTaskScheduler::heapLess(uint8_t a, uint8_t b) const {
+  return (int32_t)(tasks[a].deadlineTime - tasks[b].deadlineTime) < 0;
+}
+
+void SwarmTaskScheduler::heapSwap(uint8_t i, uint8_t j) {
+  uint8_t slot = heap[i];
+  heap[i] = heap[j];
+  heap[j] = slot;
+  heapIndex[heap[i]] = i;
+  heapIndex[heap[j]] = j;
+}
+
+void SwarmTaskScheduler::heapUp(uint8_t i) {
+  while (i > 0) {
+    uint8_t parent = (i - 1) / 2;
+    if (!heapLess(heap[i], heap[parent])) break;
+    heapSwap(i, parent);
+    i = parent;
+  }
+}
+
+void SwarmTaskScheduler::heapDown(uint8_t i) {
+  while (true) {
+    uint8_t smallest = i;
+    uint8_t left = 2 * i + 1;
+    uint8_t right = left + 1;
+    if (left < heapSize && heapLess(heap[left], heap[smallest])) smallest = left;
+    if (right < heapSize && heapLess(heap[right], heap[smallest])) smallest = right;
+    if (smallest == i) return;
+    heapSwap(i, smallest);
+    i = smallest;
+  }
+}
+
+void SwarmTaskScheduler::heapPush(uint8_t slot) {
+  heap[heapSize] = slot;
+  heapIndex[slot] = heapSize;
+  heapUp(heapSize++);
+}
+
+void SwarmTaskScheduler::heapRemove(uint8_t slot) {
+  uint8_t i = heapIndex[slot];
+  heapSize--;
+  if (i == heapSize) return;
+  heapSwap(i, heapSize);
+  uint8_t moved = heap[i];                // The old last entry, now in the gap
+  heapUp(i);
+  heapDown(heapIndex[moved]);
+}
+
+void SwarmTaskScheduler::reschedule(uint8_t slot, uint32_t deadline) {
+  tasks[slot].deadlineTime = deadline;
+  heapUp(heapIndex[slot]);
+  heapDown(heapIndex[slot]);
+}
+
+// ═══════════════════════════════════════════════════════════
+// 📊 STATUS BOOKKEEPING
+// ═══════════════════════════════════════════════════════════
+
+// Status 0 = slot free; keeps the counters and the pending mask in step
+void SwarmTaskScheduler::setStatus(uint8_t slot, TaskStatus status) {
+  SwarmTask& task = tasks[slot];
+  TaskStatus old = task.status;
+  bool wasOpen = old != 0 && !isFinished(old);
+  bool isOpen = status != 0 && !isFinished(status);
+
+  if (old != 0) statusCount[old]--;
+  if (status != 0) statusCount[status]++;
+  if (task.priority >= 7) highPriorityCount += (int)isOpen - (int)wasOpen;
+
+  if (status == TASK_STATUS_PENDING) pendingMask |= 1UL << slot;
+  else pendingMask &= ~(1UL << slot);
+  task.status = status;
+}
+
+void SwarmTaskScheduler::setAssignee(uint8_t slot, PeerId peer) {
+  if (assignee[slot] >= 0 && assignee[slot] < PEER_REGISTRY_CAPACITY) peerLoad[assignee[slot]]--;
+  assignee[slot] = peer;
+  if (peer >= 0 && peer < PEER_REGISTRY_CAPACITY) peerLoad[peer]++;
+}
+
+uint8_t SwarmTaskScheduler::getPeerLoad(PeerId peer) const {
+  return (peer >= 0 && peer < PEER_REGISTRY_CAPACITY) ? peerLoad[peer] : 0;
+}
+
+uint8_t SwarmTaskScheduler::getPendingCount() const {
+  return __builtin_popcount(pendingMask);
+}
+
+void SwarmTaskScheduler::finish(uint8_t slot, TaskStatus status, unsigned long now) {
+  SwarmTask& task = tasks[slot];
+  setStatus(slot, status);
+  setAssignee(slot, INVALID_PEER_ID);   // assignedBot stays readable
+  task.completionTime = now;
+  if (status == TASK_STATUS_COMPLETED) task.progressPercent = 100;
+  reschedule(slot, now + TASK_RETAIN_MS);
+}
+
+void SwarmTaskScheduler::release(uint8_t slot) {
+  heapRemove(slot);
+  idRemove(tasks[slot].taskId);
+  setAssignee(slot, INVALID_PEER_ID);
+  setStatus(slot, (TaskStatus)0);
+  memset(&tasks[slot], 0, sizeof(SwarmTask));
+  lapsedBy[slot] = INVALID_PEER_ID;
+  freeMask |= 1UL << slot;
+  taskCount--;
+}
+
+// ═══════════════════════════════════════════════════════════
+// 📋 TASK LIFECYCLE
+// ═══════════════════════════════════════════════════════════
+
+SwarmTask* SwarmTaskScheduler::create(TaskCategory category, TaskType type, uint8_t priority,
+                                      const uint8_t* requesterMac, unsigned long now) {
+  if (freeMask == 0) {
+    stats.rejected++;
+    return nullptr;
+  }
+  uint8_t slot = __builtin_ctz(freeMask);
+  freeMask &= ~(1UL << slot);
+
+  // Ids wrap; skip 0 and any id still on a live task
+  while (nextTaskId == 0 || slotOf(nextTaskId) != TASK_NO_SLOT) nextTaskId++;
+
+  SwarmTask& task = tasks[slot];
+  memset(&task, 0, sizeof(task));
+  task.taskId = nextTaskId++;
+  task.category = category;
+  task.taskType = type;
+  task.priority = priority;
+  task.createdTime = now;
+  task.deadlineTime = now + TASK_TIMEOUT;
+  task.requiresConfirmation = true;
+  if (requesterMac != nullptr) memcpy(task.requesterBot, requesterMac, 6);
+
+  assignee[slot] = INVALID_PEER_ID;
+  lapsedBy[slot] = INVALID_PEER_ID;
+  setStatus(slot, TASK_STATUS_PENDING);
+  idInsert(task.taskId, slot);
+  heapPush(slot);
+  taskCount++;
+  stats.created++;
+  return &task;
+}
+
+bool SwarmTaskScheduler::assign(uint16_t taskId, PeerId peer, const uint8_t* botMac, unsigned long now) {
+  uint8_t slot = slotOf(taskId);
+  if (slot == TASK_NO_SLOT || tasks[slot].status != TASK_STATUS_PENDING) return false;
+
+  SwarmTask& task = tasks[slot];
+  memcpy(task.assignedBot, botMac != nullptr ? botMac : NO_MAC, 6);
+  task.startTime = now;
+  setAssignee(slot, peer);
+  setStatus(slot, TASK_STATUS_ASSIGNED);
+  stats.assigned++;
+  return true;
+}
+
+bool SwarmTaskScheduler::reportProgress(uint16_t taskId, uint8_t progressPercent, unsigned long now) {
+  uint8_t slot = slotOf(taskId);
+  if (slot == TASK_NO_SLOT) return false;
+  if (tasks[slot].status != TASK_STATUS_ASSIGNED && tasks[slot].status != TASK_STATUS_ACTIVE) return false;
+
+  tasks[slot].progressPercent = progressPercent;
+  if (tasks[slot].status != TASK_STATUS_ACTIVE) setStatus(slot, TASK_STATUS_ACTIVE);
+  if (progressPercent >= 100) return complete(taskId, true, now);
+  return true;
+}
+
+bool SwarmTaskScheduler::complete(uint16_t taskId, bool successful, unsigned long now) {
+  uint8_t slot = slotOf(taskId);
+  if (slot == TASK_NO_SLOT || isFinished(tasks[slot].status)) return false;
+
+  if (successful) stats.completed++;
+  else stats.failed++;
+  finish(slot, successful ? TASK_STATUS_COMPLETED : TASK_STATUS_FAILED, now);
+  return true;
+}
+
+void SwarmTaskScheduler::expire(unsigned long now) {
+  while (heapSize > 0) {
+    uint8_t slot = heap[0];
+    SwarmTask& task = tasks[slot];
+    if (!deadlineReached(task.deadlineTime, now)) return;
+
+    if (isFinished(task.status)) {
+      release(slot);
+      continue;
+    }
+
+    if (task.retryCount < MAX_TASK_RETRIES) {
+      task.retryCount++;
+      lapsedBy[slot] = assignee[slot];
+      setAssignee(slot, INVALID_PEER_ID);
+      memset(task.assignedBot, 0, 6);
+      task.progressPercent = 0;
+      setStatus(slot, TASK_STATUS_PENDING);
+      reschedule(slot, now + TASK_TIMEOUT);
+      stats.retried++;
+    } else {
+      stats.failed++;
+      finish(slot, TASK_STATUS_FAILED, now);
+    }
+    if (expiredListener != nullptr) expiredListener(task);
+  }
+}
+
+// ═══════════════════════════════════════════════════════════
+// 🤝 BATCHED ASSIGNMENT
+// ═══════════════════════════════════════════════════════════
+
+float SwarmTaskScheduler::capabilityFit(BotType botType, TaskType taskType) {
+  switch (botType) {
+    case BOT_SPEEDIE:   // Speed scout: covers ground, weaker at holding station
+      switch (taskType) {
+        case TASK_GUARD_PERIMETER: return 0.6f;
+        case TASK_MONITOR_POSITION: return 0.5f;
+        case TASK_FOLLOW_PATH: return 0.9f;
+        default: return 1.0f;
+      }
+    case BOT_WHEELIE:   // Precision scout: VL53L0X + motion sensor
+      switch (taskType) {
+        case TASK_EXPLORE_AREA: return 0.7f;
+        case TASK_SEARCH_OBJECT:
+        case TASK_FOLLOW_PATH: return 0.8f;
+        default: return 1.0f;
+      }
+    default:
+      return 0.5f;
+  }
+}
+
+uint8_t SwarmTaskScheduler::assignPending(const TaskCandidate* candidates, uint8_t candidateCount,
+                                          TaskAssignment* out, uint8_t maxOut, unsigned long now) {
+  if (pendingMask == 0 || candidateCount == 0 || maxOut == 0) return 0;
+
+  // Pending slots, highest priority first, then earliest deadline
+  uint8_t order[MAX_SWARM_TASKS];
+  uint8_t orderCount = 0;
+  for (uint32_t mask = pendingMask; mask != 0; mask &= mask - 1) {
+    uint8_t slot = __builtin_ctz(mask);
+    uint8_t i = orderCount++;
+    while (i > 0) {
+      const SwarmTask& prev = tasks[order[i - 1]];
+      const SwarmTask& task = tasks[slot];
+      bool before = task.priority > prev.priority ||
+                    (task.priority == prev.priority &&
+                     (int32_t)(task.deadlineTime - prev.deadlineTime) < 0);
+      if (!before) break;
+      order[i] = order[i - 1];
+      i--;
+    }
+    order[i] = slot;
+  }
+
+  uint8_t assigned = 0;
+  for (uint8_t k = 0; k < orderCount && assigned < maxOut; k++) {
+    uint8_t slot = order[k];
+    SwarmTask& task = tasks[slot];
+
+    int best = -1;
+    float bestScore = 0.0f;
+    for (uint8_t c = 0; c < candidateCount; c++) {
+      const TaskCandidate& candidate = candidates[c];
+      if (candidate.suitability < 0) continue;
+
+      // Loads include what this pass already handed out
+      float score = candidate.suitability * capabilityFit(candidate.botType, task.taskType) /
+                    (1.0f + getPeerLoad(candidate.peer) * TASK_LOAD_PENALTY);
+      if (candidate.peer == lapsedBy[slot]) score *= TASK_RETRY_PENALTY;
+      if (score > bestScore) {
+        bestScore = score;
+        best = c;
+      }
+    }
+    if (best < 0) continue;
+
+    PeerId peer = candidates[best].peer;
+    if (!assign(task.taskId, peer, swarmNode->peerRegistry.getMac(peer), now)) continue;
+    out[assigned].taskId = task.taskId;
+    out[assigned].peer = peer;
+    assigned++;
+  }
+  return assigned;
+}
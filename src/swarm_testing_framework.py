@@ -31,6 +31,8 @@ from collections import defaultdict, deque
 from enum import Enum
 import threading
 import queue
+import argparse
+import subprocess
 
 # Set up logging
 logging.basicConfig(
@@ -724,6 +726,104 @@ class TestResultVisualizer:
         
         return filename
 
+# Host-side simulation
+class SimulationRunner:
+    """
+    Drive the native swarm simulator (src/sim, `pio run -e native`)
+    
+    Each run is deterministic for its seed and covers hours of swarm
+    time in seconds, so batches of seeds give evolution and consensus
+    statistics without lab time.
+    """
+    
+    def __init__(self, program: str = ".pio/build/native/program", build: bool = True):
+        self.program = program
+        self.needs_build = build
+    
+    def build(self) -> bool:
+        """Build the native simulator with PlatformIO"""
+        result = subprocess.run(["pio", "run", "-e", "native"], capture_output=True, text=True)
+        if result.returncode != 0:
+            logger.error(f"❌ Native build failed:\n{result.stdout[-2000:]}{result.stderr[-2000:]}")
+            return False
+        self.needs_build = False
+        return True
+    
+    def run(self, bots: int = 12, duration: int = 3600, seed: int = 1, **options) -> Dict:
+        """One simulation; options map to the simulator's flags (fail_leader_ms -> --fail-leader-ms)"""
+        if self.needs_build and not self.build():
+            return {}
+        
+        args = [self.program, "--bots", str(bots), "--duration", str(duration), "--seed", str(seed)]
+        for key, value in options.items():
+            flag = "--" + key.replace("_", "-")
+            if value is True:
+                args.append(flag)
+            elif value is not False and value is not None:
+                args += [flag, str(value)]
+        
+        result = subprocess.run(args, capture_output=True, text=True)
+        if result.returncode != 0:
+            logger.error(f"❌ Simulator exited with {result.returncode}: {result.stderr.strip()}")
+            return {}
+        
+        run = {"summary": {}, "snapshots": [], "events": []}
+        for line in result.stdout.splitlines():
+            record = json.loads(line)
+            kind = record.get("event")
+            if kind == "summary":
+                run["summary"] = record
+            elif kind == "snapshot":
+                run["snapshots"].append(record)
+            else:
+                run["events"].append(record)
+        return run
+    
+    def run_batch(self, seeds: List[int], **options) -> Dict:
+        """Several seeds of one scenario, with mean/stdev of the headline metrics"""
+        summaries = []
+        for seed in seeds:
+            run = self.run(seed=seed, **options)
+            if run.get("summary"):
+                summaries.append(run["summary"])
+        if not summaries:
+            return {}
+        
+        def spread(key: str) -> Dict[str, float]:
+            values = [s[key] for s in summaries]
+            return {
+                "mean": statistics.mean(values),
+                "stdev": statistics.stdev(values) if len(values) > 1 else 0.0,
+                "min": min(values),
+                "max": max(values)
+            }
+        
+        report = {
+            "timestamp": datetime.now().isoformat(),
+            "options": options,
+            "runs": len(summaries),
+            "virtual_hours": sum(s["virtual_s"] for s in summaries) / 3600,
+            "wall_seconds": sum(s["wall_s"] for s in summaries),
+            "best_fitness": spread("best_fitness"),
+            "mean_fitness": spread("mean_fitness"),
+            "failover_ms": spread("failover_ms_mean"),
+            "resolve_ms": spread("resolve_ms_mean"),
+            "decision_accuracy": sum(s["correct"] for s in summaries) / max(1, sum(s["proposals"] for s in summaries)),
+            "disagreements": sum(s["disagreements"] for s in summaries),
+            "summaries": summaries
+        }
+        
+        filename = f"simulation_report_{int(time.time())}.json"
+        with open(filename, 'w') as f:
+            json.dump(report, f, indent=2)
+        
+        logger.info(f"🧪 {report['runs']} simulated runs ({report['virtual_hours']:.1f} swarm-hours "
+                    f"in {report['wall_seconds']:.1f}s): best fitness {report['best_fitness']['mean']:.3f}, "
+                    f"failover {report['failover_ms']['mean']:.0f}ms, "
+                    f"decision accuracy {report['decision_accuracy']:.1%}")
+        logger.info(f"📋 Simulation report saved: {filename}")
+        return report
+
 # Example usage
 async def main():
     """Example usage of the testing framework"""
@@ -747,4 +847,19 @@ async def main():
             logger.info(f"📊 Visualization saved: {fitness_plot}, {results_plot}")
 
 if __name__ == "__main__":
-    asyncio.run(main())
\ No newline at end of file
+    parser = argparse.ArgumentParser(description="Project Jumbo swarm testing")
+    parser.add_argument("--sim", action="store_true", help="Run the native simulator instead of real bots")
+    parser.add_argument("--bots", type=int, default=12)
+    parser.add_argument("--duration", type=int, default=3600, help="Virtual seconds per run")
+    parser.add_argument("--runs", type=int, default=10, help="Seeds per batch")
+    parser.add_argument("--loss", type=float, default=0.05)
+    parser.add_argument("--fail-leader-ms", type=int, default=0)
+    parser.add_argument("--solo", action="store_true", help="No gene sharing between bots")
+    cli = parser.parse_args()
+    
+    if cli.sim:
+        SimulationRunner().run_batch(list(range(1, cli.runs + 1)), bots=cli.bots, duration=cli.duration,
+                                     loss=cli.loss, fail_leader_ms=cli.fail_leader_ms,
+                                     solo=cli.solo, report_ms=0)
+    else:
+        asyncio.run(main())
\ No newline at end of file
@@ -0,0 +1,263 @@
+#include "swarm_transmit_queue.h"
+
+// ═══════════════════════════════════════════════════════════
+// 📤 TRANSMIT QUEUE IMPLEMENTATION
+// ═══════════════════════════════════════════════════════════
+
+SwarmTransmitQueue::SwarmTransmitQueue() {
+  freeCount = TX_POOL_SIZE;
+  for (int i = 0; i < TX_POOL_SIZE; i++) {
+    freeList[i] = i;
+  }
+  for (int level = 0; level < TX_PRIORITY_LEVELS; level++) {
+    queueHead[level] = 0;
+    queueCount[level] = 0;
+  }
+  inFlight = -1;
+  inFlightSince = 0;
+  sendState.store(SEND_IDLE);
+  inFlightSend.store(0);
+  sendsAccepted = 0;
+  callbacksSeen.store(0);
+  lateCallbacks.store(0);
+  memset(&stats, 0, sizeof(stats));
+}
+
+bool SwarmTransmitQueue::isBroadcast(const uint8_t* mac) {
+  static const uint8_t broadcast[6] = BROADCAST_MAC;
+  return macEquals(mac, broadcast);
+}
+
+int SwarmTransmitQueue::priorityLevel(uint8_t priority) {
+  return constrain((int)priority, (int)PRIORITY_LOW, (int)PRIORITY_URGENT) - PRIORITY_LOW;
+}
+
+// ═══════════════════════════════════════════════════════════
+// 🗂️ POOL & QUEUE PRIMITIVES
+// ═══════════════════════════════════════════════════════════
+
+int SwarmTransmitQueue::allocateFrame() {
+  if (freeCount == 0) return -1;
+  return freeList[--freeCount];
+}
+
+void SwarmTransmitQueue::freeFrame(int index) {
+  freeList[freeCount++] = index;
+}
+
+void SwarmTransmitQueue::pushBack(int level, int index) {
+  uint8_t slot = (queueHead[level] + queueCount[level]) % TX_POOL_SIZE;
+  queues[level][slot] = index;
+  queueCount[level]++;
+}
+
+void SwarmTransmitQueue::pushFront(int level, int index) {
+  queueHead[level] = (queueHead[level] + TX_POOL_SIZE - 1) % TX_POOL_SIZE;
+  queues[level][queueHead[level]] = index;
+  queueCount[level]++;
+}
+
+int SwarmTransmitQueue::popFront(int level) {
+  if (queueCount[level] == 0) return -1;
+  int index = queues[level][queueHead[level]];
+  queueHead[level] = (queueHead[level] + 1) % TX_POOL_SIZE;
+  queueCount[level]--;
+  return index;
+}
+
+// Make room for a more important frame by dropping the oldest less important one
+bool SwarmTransmitQueue::evictLowestPriority(int belowLevel) {
+  for (int level = 0; level < belowLevel; level++) {
+    int index = popFront(level);
+    if (index >= 0) {
+      freeFrame(index);
+      stats.dropped++;
+      return true;
+    }
+  }
+  return false;
+}
+
+int SwarmTransmitQueue::findCoalescable(const uint8_t* destMac, uint8_t messageType) {
+  int level = priorityLevel(PRIORITY_LOW);
+  for (int i = 0; i < queueCount[level]; i++) {
+    int index = queues[level][(queueHead[level] + i) % TX_POOL_SIZE];
+    if (pool[index].messageType == messageType && macEquals(pool[index].destMac, destMac)) {
+      return index;
+    }
+  }
+  return -1;
+}
+
+// ═══════════════════════════════════════════════════════════
+// 📨 PUBLIC API
+// ═══════════════════════════════════════════════════════════
+
+bool SwarmTransmitQueue::enqueue(const uint8_t* destMac, const void* frame, size_t length) {
+  if (destMac == nullptr || frame == nullptr ||
+      length < sizeof(MessageHeader) || length > ESP_NOW_MAX_DATA_LEN) {
+    stats.dropped++;
+    return false;
+  }
+
+  const MessageHeader* header = (const MessageHeader*)frame;
+  uint8_t messageType = header->messageType;
+  uint8_t priority = (messageType == MSG_EMERGENCY_STOP) ? (uint8_t)PRIORITY_URGENT : header->priority;
+  int level = priorityLevel(priority);
+
+  // Newer low-priority data supersedes what is still waiting
+  if (level == priorityLevel(PRIORITY_LOW)) {
+    int existing = findCoalescable(destMac, messageType);
+    if (existing >= 0) {
+      memcpy(pool[existing].data, frame, length);
+      pool[existing].length = length;
+      stats.coalesced++;
+      return true;
+    }
+  }
+
+  int index = allocateFrame();
+  if (index < 0 && evictLowestPriority(level)) {
+    index = allocateFrame();
+  }
+  if (index < 0) {
+    stats.dropped++;
+    return false;
+  }
+
+  TxFrame& tx = pool[index];
+  memcpy(tx.destMac, destMac, 6);
+  tx.messageType = messageType;
+  tx.priority = priority;
+  tx.retriesLeft = isBroadcast(destMac) ? 0 : MAX_RETRIES;
+  tx.length = length;
+  memcpy(tx.data, frame, length);
+
+  pushBack(level, index);
+  stats.enqueued++;
+
+  size_t queued = getQueuedCount();
+  if (queued > stats.maxQueued) stats.maxQueued = queued;
+
+  // Idle radio: go straight out instead of waiting for the next service()
+  if (inFlight < 0) startNextSend();
+  return true;
+}
+
+// Callbacks come in send order, so the n-th one answers the n-th accepted
+// send. It settles the in-flight slot only if it is that send's, is for
+// the same destination, and the slot is still waiting; anything else
+// (e.g. a frame service() already timed out) is counted and dropped
+// instead of being credited to whatever is in flight now.
+void SwarmTransmitQueue::onSendComplete(const uint8_t* mac, esp_now_send_status_t status) {
+  uint32_t answered = callbacksSeen.fetch_add(1) + 1;
+  uint8_t pending = SEND_PENDING;
+  uint8_t result = (status == ESP_NOW_SEND_SUCCESS) ? SEND_OK : SEND_FAILED;
+  if (answered != inFlightSend.load() || mac == nullptr || !macEquals(mac, inFlightMac) ||
+      !sendState.compare_exchange_strong(pending, result)) {
+    lateCallbacks.fetch_add(1);
+  }
+}
+
+void SwarmTransmitQueue::service() {
+  stats.lateCallbacks = lateCallbacks.load();
+  if (inFlight >= 0) {
+    uint8_t state = sendState.load();
+    if (state == SEND_PENDING) {
+      if (millis() - inFlightSince < TX_SEND_TIMEOUT_MS) return;
+      // Take the slot back; if the callback got there first, use its result
+      if (sendState.compare_exchange_strong(state, SEND_IDLE)) {
+        stats.timeouts++;
+        // Its callback is presumed lost: count on from the sends we made,
+        // or every later callback would answer the wrong send
+        inFlightSend.store(0);
+        callbacksSeen.store(sendsAccepted);
+        completeInFlight(false);
+      } else {
+        completeInFlight(state == SEND_OK);
+      }
+    } else {
+      completeInFlight(state == SEND_OK);
+    }
+  }
+
+  startNextSend();
+}
+
+// ═══════════════════════════════════════════════════════════
+// 🚀 SEND PACING
+// ═══════════════════════════════════════════════════════════
+
+void SwarmTransmitQueue::startNextSend() {
+  if (inFlight >= 0) return;
+
+  int index = -1;
+  for (int level = TX_PRIORITY_LEVELS - 1; level >= 0 && index < 0; level--) {
+    index = popFront(level);
+  }
+  if (index < 0) return;
+
+  TxFrame& tx = pool[index];
+  memcpy(inFlightMac, tx.destMac, 6);
+  inFlightSend.store(sendsAccepted + 1); // Before the send: its callback may beat the return
+  sendState.store(SEND_PENDING);
+  inFlight = index;
+  inFlightSince = millis();
+  stats.sent++;
+
+  if (esp_now_send(tx.destMac, tx.data, tx.length) != ESP_OK) {
+    // No callback will follow; service() handles it like a failed delivery
+    inFlightSend.store(0);
+    sendState.store(SEND_FAILED);
+  } else {
+    sendsAccepted++;
+  }
+}
+
+void SwarmTransmitQueue::completeInFlight(bool success) {
+  int index = inFlight;
+  inFlight = -1;
+  sendState.store(SEND_IDLE);
+  TxFrame& tx = pool[index];
+
+  if (success) {
+    stats.delivered++;
+    freeFrame(index);
+    return;
+  }
+
+  if (tx.retriesLeft > 0) {
+    // Retry ahead of everything else at the same priority
+    tx.retriesLeft--;
+    stats.retries++;
+    pushFront(priorityLevel(tx.priority), index);
+    return;
+  }
+
+  stats.failed++;
+  freeFrame(index);
+}
+
+size_t SwarmTransmitQueue::getQueuedCount() const {
+  size_t total = 0;
+  for (int level = 0; level < TX_PRIORITY_LEVELS; level++) {
+    total += queueCount[level];
+  }
+  return total;
+}
+
+size_t SwarmTransmitQueue::getQueuedCount(MessagePriority priority) const {
+  return queueCount[priorityLevel(priority)];
+}
+
+void SwarmTransmitQueue::printStats() const {
+  Serial.printf("📤 TX: %lu queued (U%u H%u N%u L%u), %lu sent, %lu ok, %lu retries, %lu failed\n",
+                (unsigned long)getQueuedCount(),
+                queueCount[3], queueCount[2], queueCount[1], queueCount[0],
+                (unsigned long)stats.sent, (unsigned long)stats.delivered,
+                (unsigned long)stats.retries, (unsigned long)stats.failed);
+  Serial.printf("📤 TX: %lu coalesced, %lu dropped, %lu timeouts (%lu late callbacks), peak depth %lu\n",
+                (unsigned long)stats.coalesced, (unsigned long)stats.dropped,
+                (unsigned long)stats.timeouts, (unsigned long)stats.lateCallbacks,
+                (unsigned long)stats.maxQueued);
+}
@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+"""
+⏱️ Benchmark results: collect and compare
+Reads `pio test -f test_benchmarks -v` output (a file or stdin), keeps
+the "BENCH {...}" lines and compares them with a saved baseline.
+
+    pio test -e SPEEDIE -f test_benchmarks -v > run.log
+    python test/bench_compare.py run.log --save bench_speedie.json
+    python test/bench_compare.py run.log --baseline bench_speedie.json
+
+Regressions are judged on min cycles (the run with no interrupts in
+it); exit status 1 if any benchmark got slower than --tolerance allows.
+"""
+
+import argparse
+import json
+import sys
+
+BENCH_PREFIX = "BENCH "
+
+
+def parse_results(lines):
+    results = {}
+    for line in lines:
+        start = line.find(BENCH_PREFIX)
+        if start < 0:
+            continue
+        try:
+            result = json.loads(line[start + len(BENCH_PREFIX):])
+        except json.JSONDecodeError:
+            continue  # Line cut short by the runner
+        results[f"{result['env']}/{result['name']}"] = result
+    return results
+
+
+def compare(results, baseline, tolerance):
+    regressions = 0
+    print(f"{'benchmark':<44} {'base min':>10} {'min':>10} {'change':>8}")
+    for key in sorted(set(results) | set(baseline)):
+        now, before = results.get(key), baseline.get(key)
+        if now is None or before is None:
+            print(f"{key:<44} {'-' if before is None else before['min']:>10} "
+                  f"{'-' if now is None else now['min']:>10} {'missing':>8}")
+            continue
+
+        change = (now["min"] - before["min"]) / max(before["min"], 1)
+        flag = ""
+        if change > tolerance:
+            flag = "  ⚠️ slower"
+            regressions += 1
+        elif change < -tolerance:
+            flag = "  ✅ faster"
+        print(f"{key:<44} {before['min']:>10} {now['min']:>10} {change:>+8.1%}{flag}")
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Collect and compare test_benchmarks results")
+    parser.add_argument("log", nargs="?", help="pio test -v output (default: stdin)")
+    parser.add_argument("--save", help="write the results to this JSON file")
+    parser.add_argument("--baseline", help="compare against a file written by --save")
+    parser.add_argument("--tolerance", type=float, default=0.10,
+                        help="allowed slowdown of min cycles (default 0.10)")
+    args = parser.parse_args()
+
+    if args.log:
+        with open(args.log, encoding="utf-8", errors="replace") as log:
+            results = parse_results(log)
+    else:
+        results = parse_results(sys.stdin)
+
+    if not results:
+        print("❌ No BENCH lines found (run pio test with -v)")
+        return 2
+
+    if args.save:
+        with open(args.save, "w", encoding="utf-8") as out:
+            json.dump(results, out, indent=2, sort_keys=True)
+        print(f"💾 {len(results)} results saved to {args.save}")
+
+    if args.baseline:
+        with open(args.baseline, encoding="utf-8") as base:
+            regressions = compare(results, json.load(base), args.tolerance)
+        if regressions:
+            print(f"❌ {regressions} benchmark(s) slower than baseline")
+            return 1
+        print("✅ No regressions")
+    elif not args.save:
+        json.dump(results, sys.stdout, indent=2, sort_keys=True)
+        print()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
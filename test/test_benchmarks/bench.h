@@ -0,0 +1,85 @@
+#pragma once
+
+#include <Arduino.h>
+#include <esp_idf_version.h>
+
+// ═══════════════════════════════════════════════════════════
+// ⏱️ CYCLE-COUNT MICROBENCHMARKS
+// ═══════════════════════════════════════════════════════════
+// Times a body with the CPU cycle counter (CCOUNT) of the core running
+// the test:
+// - One untimed warm-up call fills caches and lazily built state
+// - Each sample is one call; the cost of reading the counter twice is
+//   measured first and subtracted, so an empty body scores ~0
+// - Interrupts stay on (flash writes need them): min is the clean cost,
+//   mean and max show what ISRs and the Wi-Fi task add
+// Every result is one line on Serial, "BENCH " then a JSON object, so
+// test/bench_compare.py can pick them out of `pio test -v` output.
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+#include <esp_cpu.h>
+static inline uint32_t benchCycles() { return (uint32_t)esp_cpu_get_cycle_count(); }
+#else
+static inline uint32_t benchCycles() { return ESP.getCycleCount(); }   // IDF 4.x: same register
+#endif
+
+#if defined(BOT_TYPE_SPEEDIE)
+#define BENCH_ENV "SPEEDIE"
+#elif defined(BOT_TYPE_WHEELIE)
+#define BENCH_ENV "WHEELIE"
+#else
+#define BENCH_ENV "unknown"
+#endif
+
+struct BenchResult {
+  const char* name;
+  uint32_t iterations;
+  uint32_t minCycles;
+  uint32_t maxCycles;
+  uint64_t totalCycles;
+};
+
+// Results land here so the compiler cannot drop the calls being timed
+extern volatile int32_t benchSink;
+
+inline uint32_t benchOverhead() {
+  uint32_t best = UINT32_MAX;
+  for (int i = 0; i < 32; i++) {
+    uint32_t start = benchCycles();
+    uint32_t cycles = benchCycles() - start;
+    if (cycles < best) best = cycles;
+  }
+  return best;
+}
+
+inline void benchReport(const BenchResult& result) {
+  uint32_t mhz = getCpuFrequencyMhz();
+  uint32_t mean = (uint32_t)(result.totalCycles / result.iterations);
+  Serial.printf("BENCH {\"env\":\"%s\",\"name\":\"%s\",\"iterations\":%lu,"
+                "\"min\":%lu,\"mean\":%lu,\"max\":%lu,\"mean_us\":%.3f,\"cpu_mhz\":%lu}\n",
+                BENCH_ENV, result.name, (unsigned long)result.iterations,
+                (unsigned long)result.minCycles, (unsigned long)mean,
+                (unsigned long)result.maxCycles, (float)mean / mhz, (unsigned long)mhz);
+}
+
+// body(i) runs once per sample; i lets it rotate through its inputs
+template <typename Body>
+BenchResult benchMeasure(const char* name, uint32_t iterations, Body body) {
+  BenchResult result = {name, iterations, UINT32_MAX, 0, 0};
+  uint32_t overhead = benchOverhead();
+  body(0);
+
+  for (uint32_t i = 0; i < iterations; i++) {
+    uint32_t start = benchCycles();
+    body(i);
+    uint32_t cycles = benchCycles() - start;
+    cycles = (cycles > overhead) ? cycles - overhead : 0;
+
+    result.totalCycles += cycles;
+    if (cycles < result.minCycles) result.minCycles = cycles;
+    if (cycles > result.maxCycles) result.maxCycles = cycles;
+  }
+
+  benchReport(result);
+  return result;
+}
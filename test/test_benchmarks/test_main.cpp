@@ -0,0 +1,267 @@
+/*
+ * ⏱️ Project Jumbo: Hot-Path Microbenchmarks
+ * Cycle counts for the code that runs per frame, per tick or per save,
+ * on the target itself.
+ *
+ * Run:
+ *   pio test -e SPEEDIE -f test_benchmarks -v | python test/bench_compare.py
+ *   pio test -e wheelie -f test_benchmarks -v | python test/bench_compare.py
+ *
+ * Both envs link their firmware build (test_build_src), which carries
+ * the shared modules, and time those (signals, ecosystem trust, ECS
+ * reports). SPEEDIE also times message dispatch, peer lookup, strategy
+ * lookup and every NVS save; WHEELIE's firmware is its motor test, which
+ * has none.
+ * Timed calls that log to Serial include the logging: that is what they
+ * cost on the bot today.
+ */
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <esp_now.h>
+#include <unity.h>
+#include "bench.h"
+#include "swarm_espnow.h"
+#include "swarm_peer_registry.h"
+#include "swarm_ecosystem_manager.h"
+#include "emergent_signal.h"
+#include "ecs_integration.h"
+
+#ifdef BOT_TYPE_SPEEDIE
+// src/SPEEDIE/main.cpp
+struct LearnedStrategy;
+void handleSwarmMessage(const uint8_t* senderMac, SwarmMessage* message);
+int findPeer(const uint8_t* mac);
+int findOrCreatePeer(const uint8_t* mac);
+void learnStrategy(int distance, int direction, int backupTime, int turnTime, bool succeeded, unsigned long completionTime);
+LearnedStrategy* getBestStrategy(int currentDistance);
+int createNewSignal(int contextType, int emotionalValence);
+void benchOpenPersistentStore(const char* nameSpace);
+void benchStageGenome(bool change);
+void benchStageMetrics(bool change);
+void benchStageStrategies(bool change);
+void benchStageVocabulary(bool change);
+size_t benchFlushPersisted();
+
+#define BENCH_SELF_TYPE BOT_SPEEDIE
+#else
+#define BENCH_SELF_TYPE BOT_WHEELIE
+#endif
+
+#define BENCH_PEERS 6                     // Fits MAX_SWARM_PEERS: no evictions mid-run
+#define BENCH_ECS_PARAMS ECS_PARAM_COUNT
+#define BENCH_STORE_NAMESPACE "jmbbench"  // Never the bots' own namespaces
+#define BENCH_STRATEGIES 10
+
+volatile int32_t benchSink = 0;
+
+static const uint8_t broadcastAddress[] = BROADCAST_MAC;
+static const uint8_t STRANGER_MAC[6] = {0x02, 0xBE, 0x4C, 0xFF, 0xFF, 0xFF};
+static uint8_t peerMacs[BENCH_PEERS][6];
+
+static const EnvironmentalContext BENCH_CONTEXTS[] = {
+  CONTEXT_OBSTACLE_NEAR, CONTEXT_OPEN_SPACE, CONTEXT_PEER_DETECTED, CONTEXT_TASK_SUCCESS,
+  CONTEXT_TASK_FAILURE, CONTEXT_RESOURCE_FOUND, CONTEXT_DANGER_SENSED, CONTEXT_EXPLORATION,
+  CONTEXT_WAITING, CONTEXT_FOLLOWING, CONTEXT_LEADING
+};
+static const uint8_t BENCH_CONTEXT_COUNT = sizeof(BENCH_CONTEXTS) / sizeof(BENCH_CONTEXTS[0]);
+
+static EmergentSignalGenerator* signals = nullptr;
+static SignalWord words[MAX_SIGNAL_VOCABULARY];
+static uint8_t wordCount = 0;
+static char statusJson[384];
+
+#ifdef BOT_TYPE_SPEEDIE
+static SwarmMessage statusFrames[BENCH_PEERS];
+static SwarmMessage ignoredFrame;
+#endif
+
+static EnvironmentalContext benchContext(uint32_t i) {
+  return BENCH_CONTEXTS[i % BENCH_CONTEXT_COUNT];
+}
+
+static EmotionalState benchEmotion(uint32_t i) {
+  return (EmotionalState)((int)((i / BENCH_CONTEXT_COUNT) % 5) - 2);
+}
+
+// ═══════════════════════════════════════════════════════════
+// 🏗️ SWARM STATE THE BENCHMARKS RUN AGAINST
+// ═══════════════════════════════════════════════════════════
+
+static void benchInitialize() {
+  WiFi.mode(WIFI_STA);
+  esp_now_init();
+  esp_now_peer_info_t peerInfo;
+  memset(&peerInfo, 0, sizeof(peerInfo));
+  memcpy(peerInfo.peer_addr, broadcastAddress, 6);
+  esp_now_add_peer(&peerInfo);
+
+  initializeEcosystemManager(BENCH_SELF_TYPE, BENCH_ENV);
+  for (uint8_t i = 0; i < BENCH_PEERS; i++) {
+    const uint8_t mac[6] = {0x02, 0xBE, 0x4C, 0x00, 0x00, (uint8_t)(i + 1)};
+    memcpy(peerMacs[i], mac, 6);
+    swarmNode->ecosystem->registerBot(peerMacs[i], (i & 1) ? BOT_SPEEDIE : BOT_WHEELIE, "bench");
+  }
+
+  // A full vocabulary: the worst case for every lookup
+  signals = new EmergentSignalGenerator();
+  for (uint32_t i = 0; i < 512 && signals->getVocabularySize() < MAX_SIGNAL_VOCABULARY; i++) {
+    signals->generateSignalForContext(benchContext(i), benchEmotion(i));
+  }
+  wordCount = signals->getVocabularySize();
+  for (uint8_t i = 0; i < wordCount; i++) signals->getSignal(i, words[i]);
+
+  ecs.initialize(broadcastAddress);
+  for (uint8_t i = 0; i < BENCH_ECS_PARAMS; i++) {
+    char name[ECS_NAME_LENGTH];
+    snprintf(name, sizeof(name), "bench_p%02u", i);
+    ecs.registerParameter(name, 100 + i, 0, 1000);
+  }
+  for (uint8_t i = 0; i < 64; i++) ecs.reportMetric((MetricType)(i % 8), i / 64.0f);
+
+#ifdef BOT_TYPE_SPEEDIE
+  for (uint8_t i = 0; i < BENCH_PEERS; i++) {
+    findOrCreatePeer(peerMacs[i]);
+
+    SwarmMessage& frame = statusFrames[i];
+    memset(&frame, 0, sizeof(frame));
+    frame.header.messageType = MSG_STATUS_UPDATE;
+    frame.header.senderType = (i & 1) ? BOT_SPEEDIE : BOT_WHEELIE;
+    frame.header.sequenceNumber = i;
+    frame.payload.status.generation = 10 + i;
+    frame.payload.status.fitnessScore = 0.5f;
+    finalizeSwarmMessage(&frame, sizeof(StatusPayload));
+  }
+  memset(&ignoredFrame, 0, sizeof(ignoredFrame));
+  ignoredFrame.header.messageType = MSG_EMOTIONAL_STATE;   // No SPEEDIE handler
+  finalizeSwarmMessage(&ignoredFrame, 0);
+
+  for (int i = 0; i < BENCH_STRATEGIES; i++) {
+    learnStrategy(40 + i * 20, i & 1, 300, 200, true, 800 + i * 10);
+  }
+  for (int i = 0; i < 10; i++) createNewSignal(i % 5, -90 + i * 20);
+  benchOpenPersistentStore(BENCH_STORE_NAMESPACE);
+  benchFlushPersisted();
+#endif
+}
+
+// ═══════════════════════════════════════════════════════════
+// 🗣️ SIGNALS, TRUST, ECS (BOTH ENVS)
+// ═══════════════════════════════════════════════════════════
+
+void test_acoustic_similarity() {
+  TEST_ASSERT_GREATER_THAN(1, wordCount);
+  benchMeasure("calculateAcousticSimilarity", 1000, [](uint32_t i) {
+    uint8_t a = i % wordCount;
+    uint8_t b = (i * 7 + 1) % wordCount;
+    benchSink += (int32_t)(calculateAcousticSimilarity(&words[a], &words[b]) * SIGNAL_SIMILARITY_MAX);
+  });
+  TEST_ASSERT_EQUAL_FLOAT(1.0f, calculateAcousticSimilarity(&words[0], &words[0]));
+}
+
+void test_find_existing_signal() {
+  TEST_ASSERT_EQUAL(MAX_SIGNAL_VOCABULARY, wordCount);
+  benchMeasure("findExistingSignal", 1000, [](uint32_t i) {
+    benchSink += signals->findExistingSignal(benchContext(i), benchEmotion(i));
+  });
+}
+
+void test_record_interaction() {
+  TEST_ASSERT_NOT_NULL(swarmNode->ecosystem);
+  benchMeasure("recordInteraction", 200, [](uint32_t i) {
+    swarmNode->ecosystem->recordInteraction(peerMacs[i % BENCH_PEERS], peerMacs[(i + 1) % BENCH_PEERS],
+                                        INTERACTION_DATA_SHARE, (i & 3) ? RESULT_SUCCESS : RESULT_FAILURE);
+  });
+}
+
+void test_ecs_status_json() {
+  benchMeasure("ecs_getStatusJSON", 200, [](uint32_t) {
+    ecs.getStatusJSON(statusJson, sizeof(statusJson));
+  });
+  size_t length = strlen(statusJson);
+  TEST_ASSERT_EQUAL_CHAR('{', statusJson[0]);
+  TEST_ASSERT_EQUAL_CHAR('}', statusJson[length - 1]);
+}
+
+void test_ecs_performance_report() {
+  TEST_ASSERT_TRUE(ecs.isConnectedToECS());
+#ifdef ECS_JSON_DEBUG
+  const char* name = "ecs_sendPerformanceReport_json";
+#else
+  const char* name = "ecs_sendPerformanceReport_wire";
+#endif
+  benchMeasure(name, 20, [](uint32_t) { ecs.sendPerformanceReport(); });
+}
+
+// ═══════════════════════════════════════════════════════════
+// ⚡ SPEEDIE FIRMWARE PATHS
+// ═══════════════════════════════════════════════════════════
+
+#ifdef BOT_TYPE_SPEEDIE
+void test_handle_swarm_message() {
+  benchMeasure("handleSwarmMessage_status", 1000, [](uint32_t i) {
+    handleSwarmMessage(peerMacs[i % BENCH_PEERS], &statusFrames[i % BENCH_PEERS]);
+  });
+  benchMeasure("handleSwarmMessage_ignored", 1000, [](uint32_t i) {
+    handleSwarmMessage(peerMacs[i % BENCH_PEERS], &ignoredFrame);
+  });
+}
+
+void test_find_peer() {
+  for (uint8_t i = 0; i < BENCH_PEERS; i++) TEST_ASSERT_GREATER_OR_EQUAL(0, findPeer(peerMacs[i]));
+  TEST_ASSERT_EQUAL(-1, findPeer(STRANGER_MAC));
+
+  benchMeasure("findPeer_hit", 1000, [](uint32_t i) { benchSink += findPeer(peerMacs[i % BENCH_PEERS]); });
+  benchMeasure("findPeer_miss", 1000, [](uint32_t) { benchSink += findPeer(STRANGER_MAC); });
+}
+
+void test_get_best_strategy() {
+  TEST_ASSERT_NOT_NULL(getBestStrategy(100));
+  benchMeasure("getBestStrategy", 50, [](uint32_t i) {
+    benchSink += getBestStrategy(40 + (i % BENCH_STRATEGIES) * 20) != nullptr;
+  });
+}
+
+// Unchanged: the CRC compare every persist tick pays. Save: one record
+// changed, staged and written to flash (few samples: flash wear).
+static void benchSave(const char* unchangedName, const char* saveName, void (*stage)(bool)) {
+  benchMeasure(unchangedName, 200, [stage](uint32_t) { stage(false); });
+  benchMeasure(saveName, 8, [stage](uint32_t) {
+    stage(true);
+    benchSink += benchFlushPersisted();
+  });
+  TEST_ASSERT_EQUAL(0, benchFlushPersisted());
+}
+
+void test_persistent_saves() {
+  benchSave("persist_genome_unchanged", "persist_genome_save", benchStageGenome);
+  benchSave("persist_metrics_unchanged", "persist_metrics_save", benchStageMetrics);
+  benchSave("persist_strategies_unchanged", "persist_strategies_save", benchStageStrategies);
+  benchSave("persist_vocabulary_unchanged", "persist_vocabulary_save", benchStageVocabulary);
+}
+#endif
+
+void setUp() {}
+void tearDown() {}
+
+void setup() {
+  delay(2000);   // Board reset by the runner: give the port time to open
+  UNITY_BEGIN();
+  benchInitialize();
+
+  RUN_TEST(test_acoustic_similarity);
+  RUN_TEST(test_find_existing_signal);
+  RUN_TEST(test_record_interaction);
+  RUN_TEST(test_ecs_status_json);
+  RUN_TEST(test_ecs_performance_report);
+#ifdef BOT_TYPE_SPEEDIE
+  RUN_TEST(test_handle_swarm_message);
+  RUN_TEST(test_find_peer);
+  RUN_TEST(test_get_best_strategy);
+  RUN_TEST(test_persistent_saves);
+#endif
+
+  UNITY_END();
+}
+
+void loop() {}
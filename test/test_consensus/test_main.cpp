@@ -0,0 +1,118 @@
+/*
+ * 🗳️ Project Jumbo: Consensus Agreement
+ * Checks that every bot ends a vote with the same result, on the host.
+ *
+ * Run:
+ *   pio test -e native -f test_consensus
+ *
+ * The proposer's tally decides and the other bots adopt its outcome, so
+ * a vote frame that reached only some bots must not split the swarm.
+ * The engine tests walk two SwarmConsensus instances through that hand-
+ * off; the simulator test runs whole swarms over a lossy radio and
+ * counts the bots that resolved a proposal differently from the first.
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include "swarm_consensus.h"
+#include "sim/swarm_sim.h"
+
+#define AGREEMENT_SEEDS 3
+#define AGREEMENT_DURATION_S 900
+#define AGREEMENT_LOSS 0.05f
+
+static const uint8_t PROPOSER_MAC[6] = {0x02, 0, 0, 0, 0, 0x01};
+static const uint8_t VOTER_MAC[6] = {0x02, 0, 0, 0, 0, 0x02};
+static const uint8_t SELF = 31;                     // Each engine's own voter index
+static const uint8_t FROM_PROPOSER = 0;             // The proposer, as the voter sees it
+static const uint8_t FROM_VOTER = 1;                // The voter, as the proposer sees it
+
+// Everything one engine has to say, delivered to the other
+static void deliver(SwarmConsensus& from, SwarmConsensus& to, uint8_t senderVoter, unsigned long now) {
+  ConsensusBatchPayload batch;
+  size_t length = from.buildBatch(batch, now);
+  TEST_ASSERT_TRUE(length > 0);
+  to.mergeBatch(senderVoter, batch, length, now);
+}
+
+void test_voter_adopts_proposer_outcome() {
+  SwarmConsensus proposer;
+  SwarmConsensus voter;
+  proposer.begin(PROPOSER_MAC, SELF);
+  voter.begin(VOTER_MAC, SELF);
+
+  uint16_t id = proposer.propose(DECIDE_FORMATION_CHANGE, CONSENSUS_SIMPLE_MAJORITY, 3, 0);
+  TEST_ASSERT_NOT_EQUAL(0, id);
+  proposer.castVote(id, 2, 1.0f, 1.0f, 10);
+  deliver(proposer, voter, FROM_PROPOSER, 20);
+
+  // Two of three votes settle it, but only on the proposer's tally
+  voter.castVote(id, 2, 1.0f, 1.0f, 30);
+  TEST_ASSERT_FALSE(voter.find(id)->isResolved);
+
+  deliver(voter, proposer, FROM_VOTER, 40);
+  TEST_ASSERT_TRUE(proposer.find(id)->isResolved);
+  TEST_ASSERT_EQUAL_UINT8(2, proposer.find(id)->winningChoice);
+
+  deliver(proposer, voter, FROM_PROPOSER, 50);
+  const ConsensusProposal* adopted = voter.find(id);
+  TEST_ASSERT_TRUE(adopted->isResolved);
+  TEST_ASSERT_EQUAL_UINT8(2, adopted->winningChoice);
+  TEST_ASSERT_EQUAL_UINT32(1, voter.getStats().adopted);
+
+  // The outcome is announced, the voter's vote no longer is
+  ConsensusBatchPayload batch;
+  TEST_ASSERT_EQUAL(0, voter.buildBatch(batch, 60));
+}
+
+void test_voter_falls_back_after_outcome_wait() {
+  SwarmConsensus proposer;
+  SwarmConsensus voter;
+  proposer.begin(PROPOSER_MAC, SELF);
+  voter.begin(VOTER_MAC, SELF);
+
+  uint16_t id = proposer.propose(DECIDE_TASK_PRIORITY, CONSENSUS_SIMPLE_MAJORITY, 3, 0);
+  proposer.castVote(id, 1, 1.0f, 1.0f, 0);
+  deliver(proposer, voter, FROM_PROPOSER, 0);
+  voter.castVote(id, 1, 1.0f, 1.0f, 0);
+
+  // The proposer is never heard from again
+  uint32_t deadline = voter.find(id)->votingDeadline;
+  voter.update(deadline);
+  TEST_ASSERT_FALSE(voter.find(id)->isResolved);
+  voter.update(deadline + CONSENSUS_OUTCOME_WAIT_MS - 1);
+  TEST_ASSERT_FALSE(voter.find(id)->isResolved);
+
+  voter.update(deadline + CONSENSUS_OUTCOME_WAIT_MS);
+  TEST_ASSERT_TRUE(voter.find(id)->isResolved);
+  TEST_ASSERT_EQUAL_UINT8(1, voter.find(id)->winningChoice);
+  TEST_ASSERT_EQUAL_UINT32(0, voter.getStats().adopted);
+}
+
+void test_simulated_swarm_never_disagrees() {
+  for (uint32_t seed = 1; seed <= AGREEMENT_SEEDS; seed++) {
+    SimConfig config;
+    config.seed = seed;
+    config.durationS = AGREEMENT_DURATION_S;
+    config.lossRate = AGREEMENT_LOSS;
+    config.reportMs = 0;
+
+    SwarmSimulator sim(config);
+    sim.run();
+    const SimStats& stats = sim.getStats();
+
+    TEST_ASSERT_TRUE_MESSAGE(stats.resolved > 0, "no proposal resolved");
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, stats.disagreements, "bots resolved a proposal differently");
+  }
+}
+
+void setUp() {}
+void tearDown() {}
+
+int main(int, char**) {
+  UNITY_BEGIN();
+  RUN_TEST(test_voter_adopts_proposer_outcome);
+  RUN_TEST(test_voter_falls_back_after_outcome_wait);
+  RUN_TEST(test_simulated_swarm_never_disagrees);
+  return UNITY_END();
+}
@@ -0,0 +1,128 @@
+/*
+ * 🔊 Project Jumbo: Acoustic Similarity Kernel
+ * Checks the Q8 kernel (acousticSimilarityBatch) against the float
+ * formula it replaced, on random signal patterns, on the host.
+ *
+ * Run:
+ *   pio test -e native -f test_similarity
+ *
+ * Each shared component scores 0.4 for the same component, 0.3 for
+ * durations within 2:1 and 0.3 for intensities within 10:7, averaged
+ * over the components both patterns have. The kernel rounds that down
+ * to 1/255 steps, so it may never be off by more than one step.
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include "emergent_signal.h"
+
+#define SIMILARITY_SEED 17
+#define SIMILARITY_ROUNDS 20000
+#define SIMILARITY_BATCH 16               // Patterns scored per kernel call
+
+static const float Q8_STEP = 1.0f / SIGNAL_SIMILARITY_MAX;
+
+// The float formula, component by component
+static float referenceSimilarity(const SignalPattern& a, const SignalPattern& b) {
+  uint8_t common = min(min(a.length, b.length), (uint8_t)SIGNAL_MAX_COMPONENTS);
+  if (common == 0) return 0.0f;
+
+  float similarity = 0.0f;
+  for (uint8_t i = 0; i < common; i++) {
+    float dMin = min(a.durations[i], b.durations[i]);
+    float dMax = max(a.durations[i], b.durations[i]);
+    float iMin = min(a.intensities[i], b.intensities[i]);
+    float iMax = max(a.intensities[i], b.intensities[i]);
+
+    if (a.components[i] == b.components[i]) similarity += 0.4f / common;
+    if (dMin == dMax || dMin / dMax > 0.5f) similarity += 0.3f / common;
+    if (iMin == iMax || iMin / iMax > 0.7f) similarity += 0.3f / common;
+  }
+  return similarity;
+}
+
+// Values near the 2:1 and 10:7 boundaries come up often, zeros too
+static void randomPattern(SignalPattern& pattern) {
+  memset(&pattern, 0, sizeof(pattern));
+  pattern.length = random(0, SIGNAL_MAX_COMPONENTS + 1);
+  for (uint8_t i = 0; i < SIGNAL_MAX_COMPONENTS; i++) {
+    pattern.components[i] = random(0, 4);
+    pattern.durations[i] = random(0, 8) == 0 ? 0 : random(1, 1200);
+    pattern.intensities[i] = random(0, 8) == 0 ? 0 : random(1, 256);
+  }
+}
+
+// A copy with every value nudged: lands on either side of the ratio tests
+static void nearbyPattern(const SignalPattern& from, SignalPattern& pattern) {
+  pattern = from;
+  pattern.length = random(0, 4) == 0 ? random(0, SIGNAL_MAX_COMPONENTS + 1) : from.length;
+  for (uint8_t i = 0; i < SIGNAL_MAX_COMPONENTS; i++) {
+    if (random(0, 4) == 0) pattern.components[i] = random(0, 4);
+    pattern.durations[i] = constrain((long)from.durations[i] * random(40, 250) / 100, 0L, 65535L);
+    pattern.intensities[i] = constrain((long)from.intensities[i] * random(60, 150) / 100, 0L, 255L);
+  }
+}
+
+void test_batch_matches_float_reference() {
+  SignalPattern probe;
+  SignalPattern patterns[SIMILARITY_BATCH];
+  uint8_t scores[SIMILARITY_BATCH];
+  float worst = 0.0f;
+
+  randomSeed(SIMILARITY_SEED);
+  for (uint32_t round = 0; round < SIMILARITY_ROUNDS; round++) {
+    randomPattern(probe);
+    for (uint8_t w = 0; w < SIMILARITY_BATCH; w++) {
+      if (w & 1) randomPattern(patterns[w]);
+      else nearbyPattern(probe, patterns[w]);
+    }
+    acousticSimilarityBatch(probe, patterns, SIMILARITY_BATCH, scores);
+
+    for (uint8_t w = 0; w < SIMILARITY_BATCH; w++) {
+      float expected = referenceSimilarity(probe, patterns[w]);
+      float actual = scores[w] * Q8_STEP;
+      worst = max(worst, fabsf(expected - actual));
+      TEST_ASSERT_FLOAT_WITHIN(Q8_STEP, expected, actual);
+    }
+  }
+  TEST_ASSERT_TRUE(worst <= Q8_STEP);
+}
+
+void test_identical_patterns_score_max() {
+  SignalPattern pattern;
+  uint8_t score = 0;
+
+  randomSeed(SIMILARITY_SEED);
+  for (uint32_t round = 0; round < 1000; round++) {
+    randomPattern(pattern);
+    if (pattern.length == 0) continue;
+    acousticSimilarityBatch(pattern, &pattern, 1, &score);
+    TEST_ASSERT_EQUAL_UINT8(SIGNAL_SIMILARITY_MAX, score);
+  }
+}
+
+void test_empty_pattern_scores_zero() {
+  SignalPattern empty;
+  SignalPattern pattern;
+  uint8_t score = 1;
+  memset(&empty, 0, sizeof(empty));
+  randomSeed(SIMILARITY_SEED);
+  randomPattern(pattern);
+  pattern.length = 3;
+
+  acousticSimilarityBatch(empty, &pattern, 1, &score);
+  TEST_ASSERT_EQUAL_UINT8(0, score);
+  acousticSimilarityBatch(pattern, &empty, 1, &score);
+  TEST_ASSERT_EQUAL_UINT8(0, score);
+}
+
+void setUp() {}
+void tearDown() {}
+
+int main(int, char**) {
+  UNITY_BEGIN();
+  RUN_TEST(test_batch_matches_float_reference);
+  RUN_TEST(test_identical_patterns_score_max);
+  RUN_TEST(test_empty_pattern_scores_zero);
+  return UNITY_END();
+}
@@ -0,0 +1,142 @@
+/*
+ * 🧭 Project Jumbo: Strategy Distance-Band Index
+ * Checks StrategyBandIndex against a brute-force scan of the same
+ * library, on random edits and queries, on the host.
+ *
+ * Run:
+ *   pio test -e native -f test_strategy_index
+ *
+ * The reference keeps every entry in a flat array and answers each
+ * query by looking at all of them: best() is the highest score among
+ * the entries whose band lies within matchBands of the query's band,
+ * findSimilar() the lowest index with the same tag closer than the
+ * tolerance, and ties always go to the lower index. Scores come from a
+ * small set so ties are common, and distances run past both ends of
+ * the banded range.
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include "strategy_index.h"
+
+#define INDEX_SEED 27
+#define INDEX_ROUNDS 100000               // One edit and two queries each
+#define INDEX_ENTRIES STRATEGY_INDEX_CAPACITY
+
+struct ReferenceEntry {
+  bool used;
+  int distance;
+  uint8_t tag;
+  float score;
+};
+
+static ReferenceEntry reference[INDEX_ENTRIES];
+
+static int referenceBand(int distance) {
+  if (distance < 0) return 0;
+  return min(distance / STRATEGY_BAND_CM, STRATEGY_MAX_BANDS - 1);
+}
+
+static int referenceBest(int distance, uint8_t matchBands) {
+  int center = referenceBand(distance);
+  int found = -1;
+  for (int i = 0; i < INDEX_ENTRIES; i++) {
+    if (!reference[i].used || abs(referenceBand(reference[i].distance) - center) > matchBands) continue;
+    if (found < 0 || reference[i].score > reference[found].score) found = i;
+  }
+  return found;
+}
+
+static int referenceSimilar(int distance, int tolerance, uint8_t tag) {
+  for (int i = 0; i < INDEX_ENTRIES; i++) {
+    if (reference[i].used && reference[i].tag == tag && abs(reference[i].distance - distance) < tolerance) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+static uint8_t referenceCount() {
+  uint8_t count = 0;
+  for (int i = 0; i < INDEX_ENTRIES; i++) count += reference[i].used;
+  return count;
+}
+
+static int randomDistance() {
+  return random(-20, STRATEGY_MAX_BANDS * STRATEGY_BAND_CM + 60);
+}
+
+void test_matches_brute_force_scan() {
+  StrategyBandIndex index;
+  memset(reference, 0, sizeof(reference));
+
+  randomSeed(INDEX_SEED);
+  for (uint32_t round = 0; round < INDEX_ROUNDS; round++) {
+    uint8_t i = random(0, INDEX_ENTRIES);
+    long op = random(0, 1000);
+
+    if (op == 0) {
+      index.clear();
+      memset(reference, 0, sizeof(reference));
+    } else if (op < 250) {
+      index.remove(i);
+      reference[i].used = false;
+    } else {
+      // Half the time keep the entry where it is and only move its score
+      ReferenceEntry& entry = reference[i];
+      if (!entry.used || random(0, 2) == 0) entry.distance = randomDistance();
+      entry.used = true;
+      entry.tag = random(0, 2);
+      entry.score = random(0, 8) * 0.25f;
+      index.set(i, entry.distance, entry.tag, entry.score);
+    }
+    TEST_ASSERT_EQUAL_UINT8(referenceCount(), index.getCount());
+
+    int distance = randomDistance();
+    uint8_t matchBands = random(0, 5);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(referenceBest(distance, matchBands), index.best(distance, matchBands),
+                                  "best() differs from the scan");
+
+    int tolerance = random(1, 80);
+    uint8_t tag = random(0, 2);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(referenceSimilar(distance, tolerance, tag),
+                                  index.findSimilar(distance, tolerance, tag),
+                                  "findSimilar() differs from the scan");
+  }
+}
+
+void test_ties_go_to_lower_index() {
+  StrategyBandIndex index;
+  index.set(5, 70, 0, 1.0f);
+  index.set(2, 75, 0, 1.0f);
+  index.set(9, 65, 0, 1.0f);
+  TEST_ASSERT_EQUAL_INT(2, index.best(70, 0));
+
+  // The band's best losing its score hands the lead to the next in line
+  index.set(2, 75, 0, 0.5f);
+  TEST_ASSERT_EQUAL_INT(5, index.best(70, 0));
+  index.remove(5);
+  TEST_ASSERT_EQUAL_INT(9, index.best(70, 0));
+}
+
+void test_empty_index_finds_nothing() {
+  StrategyBandIndex index;
+  TEST_ASSERT_EQUAL_INT(-1, index.best(100, STRATEGY_MAX_BANDS));
+  TEST_ASSERT_EQUAL_INT(-1, index.findSimilar(100, 1000, 0));
+
+  index.set(3, 100, 1, 1.0f);
+  index.remove(3);
+  TEST_ASSERT_EQUAL_INT(-1, index.best(100, STRATEGY_MAX_BANDS));
+  TEST_ASSERT_EQUAL_UINT8(0, index.getCount());
+}
+
+void setUp() {}
+void tearDown() {}
+
+int main(int, char**) {
+  UNITY_BEGIN();
+  RUN_TEST(test_matches_brute_force_scan);
+  RUN_TEST(test_ties_go_to_lower_index);
+  RUN_TEST(test_empty_index_finds_nothing);
+  return UNITY_END();
+}